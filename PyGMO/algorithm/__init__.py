@@ -830,20 +830,22 @@ sa_corana._orig_init = sa_corana.__init__
 sa_corana.__init__ = _sa_corana_ctor
 
 
-def _bee_colony_ctor(self, gen=100, limit=20):
+def _bee_colony_ctor(self, gen=100, limit=20, memory=False):
     """
     Constructs an Artificial Bee Colony Algorithm
 
-    USAGE: algorithm.bee_colony(gen = 100, limit = 20)
+    USAGE: algorithm.bee_colony(gen = 100, limit = 20, memory = False)
 
     * gen: number of 'generations' (each generation 2*NP function evaluations
             are made where NP is the population size)
     * limit: number of tries after which a source of food is dropped if not improved
+    * memory: when True the trial counters of the food sources are kept through successive calls
     """
     # We set the defaults or the kwargs
     arg_list = []
     arg_list.append(gen)
     arg_list.append(limit)
+    arg_list.append(memory)
     self._orig_init(*arg_list)
 bee_colony._orig_init = bee_colony.__init__
 bee_colony.__init__ = _bee_colony_ctor
@@ -1221,7 +1223,7 @@ cmaes._orig_init = cmaes.__init__
 cmaes.__init__ = _cmaes_ctor
 
 
-def _inverover_ctor(self, gen=100000, ri=0.05, type="random"):
+def _inverover_ctor(self, gen=100000, ri=0.05, type="random", n_neighbours=0):
     """
     Constructs a Inverover algorithm
 
@@ -1229,13 +1231,15 @@ def _inverover_ctor(self, gen=100000, ri=0.05, type="random"):
     G Tao, Z Michalewicz, Parallel Problem Solving from Nature - PPSN V, 1998.
     https://cs.adelaide.edu.au/~zbyszek/Papers/p44.pdf
 
-    USAGE: algorithm.inverover(gen=100000, ri=0.05, type="random")
+    USAGE: algorithm.inverover(gen=100000, ri=0.05, type="random", n_neighbours=0)
 
     * gen: number of generations
     * ri: probability for a random inversion (mutation probability)
     * ini_type: algorithm that is used for the initialization of the population
            1. "random"	random initialization with feasible tours
            2. "nn"	using the Nearest-Neighbor algorithm
+    * n_neighbours: if positive, random inversions connect a city to one of its n_neighbours nearest cities
+           and, for problem.tsp, the final tours are improved by a 2-opt/or-opt local search
     """
 
     from PyGMO.algorithm._algorithm import _tsp_ini_type
@@ -1251,6 +1255,7 @@ def _inverover_ctor(self, gen=100000, ri=0.05, type="random"):
     arg_list.append(gen)
     arg_list.append(ri)
     arg_list.append(initialization_type(type))
+    arg_list.append(n_neighbours)
     self._orig_init(*arg_list)
 inverover._orig_init = inverover.__init__
 inverover.__init__ = _inverover_ctor
@@ -47,6 +47,14 @@ static inline population evolve_copy(const algorithm::base &a, const population
 	return pop_copy;
 }
 
+// Wrapper method for algorithm tell that uses copy instead of pass-by-non-const-reference.
+static inline population tell_copy(const algorithm::base &a, const population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f)
+{
+	population pop_copy(pop);
+	a.tell(pop_copy,x,f);
+	return pop_copy;
+}
+
 // Wrapper to expose algorithms.
 template <class Algorithm>
 static inline class_<Algorithm,bases<algorithm::base> > algorithm_wrapper(const char *name, const char *descr)
@@ -176,6 +184,8 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		// NOTE: This needs special treatment because its prototype changes in the wrapper.
 		.def("evolve",&algorithm::python_base::py_evolve, "Returns the evolved population")
 		.def("human_readable_extra", &algorithm::base::human_readable_extra, &algorithm::python_base::default_human_readable_extra)
+		.def("ask", &algorithm::base::ask, "Returns a batch of candidate decision vectors for the population")
+		.def("tell", &tell_copy, "Returns the population updated with the fitnesses of the asked candidates")
 		.def_pickle(python_class_pickle_suite<algorithm::python_base>());
 
 	// Exposing enums
@@ -259,7 +269,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// Artificial Bee Colony Optimization (ABC).
 	algorithm_wrapper<algorithm::bee_colony>("bee_colony","Artificial Bee Colony optimization (ABC) algorithm.")
-		.def(init<optional<int,int> >());
+		.def(init<optional<int,int,bool> >());
 
 	//InverOver initialization type enum
 	enum_<algorithm::inverover::initialization_type>("_tsp_ini_type")
@@ -268,7 +278,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	//InverOver   
         algorithm_wrapper<algorithm::inverover>("inverover","InverOver Genetic Algorithm.")
-		.def(init<optional<int, double, pagmo::algorithm::inverover::initialization_type> >());
+		.def(init<optional<int, double, pagmo::algorithm::inverover::initialization_type, int> >());
 
 	//Nearest Neighbor Alg. (NN)  
 	algorithm_wrapper<algorithm::nn_tsp>("nn_tsp","Nearest Neighbor Algortihm.")
@@ -26,8 +26,10 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/python/class.hpp>
 #include <boost/python/copy_const_reference.hpp>
+#include <boost/python/dict.hpp>
 #include <boost/python/enum.hpp>
 #include <boost/python/extract.hpp>
+#include <boost/python/list.hpp>
 #include <boost/python/make_function.hpp>
 #include <boost/python/module.hpp>
 #include <boost/python/operators.hpp>
@@ -45,6 +47,7 @@
 #include "../../src/archipelago.h"
 #include "../../src/base_island.h"
 #include "../../src/config.h"
+#include "../../src/evolution_stats.h"
 #include "../../src/exceptions.h"
 #include "../../src/migration/base_r_policy.h"
 #include "../../src/migration/base_s_policy.h"
@@ -120,6 +123,62 @@ inline static void archipelago_set_algorithm(archipelago &archi, int n, const al
 	archi.set_algorithm(boost::numeric_cast<archipelago::size_type>(n),a);
 }
 
+// Conversion of the evolution statistics to dictionaries.
+static inline dict latency_histogram_to_dict(const latency_histogram &h)
+{
+	const std::vector<boost::uint64_t> b = h.get_buckets();
+	list buckets;
+	for (std::vector<boost::uint64_t>::size_type i = 0; i < b.size(); ++i) {
+		buckets.append(b[i]);
+	}
+	dict retval;
+	retval["count"] = h.get_count();
+	retval["total"] = h.get_total();
+	retval["max"] = h.get_max();
+	retval["buckets"] = buckets;
+	return retval;
+}
+
+static inline dict evolution_stats_to_dict(const evolution_stats &s)
+{
+	dict retval;
+	retval["n_evolutions"] = s.n_evolutions;
+	retval["fevals"] = s.fevals;
+	retval["cevals"] = s.cevals;
+	retval["cache_hits"] = s.cache_hits;
+	retval["migrants_sent"] = s.migrants_sent;
+	retval["migrants_received"] = s.migrants_received;
+	retval["migrants_accepted"] = s.migrants_accepted;
+	retval["objfun_time"] = s.objfun_time;
+	retval["algorithm_time"] = s.algorithm_time;
+	retval["migration_time"] = s.migration_time;
+	retval["barrier_time"] = s.barrier_time;
+	retval["evolution_latency"] = latency_histogram_to_dict(s.evolution_latency);
+	retval["migration_latency"] = latency_histogram_to_dict(s.migration_latency);
+	retval["objfun_latency"] = latency_histogram_to_dict(s.objfun_latency);
+	return retval;
+}
+
+static inline dict base_island_get_stats(const base_island &isl)
+{
+	return evolution_stats_to_dict(isl.get_stats());
+}
+
+static inline dict archipelago_get_stats(const archipelago &a)
+{
+	return evolution_stats_to_dict(a.get_stats());
+}
+
+static inline list archipelago_get_island_stats(const archipelago &a)
+{
+	const std::vector<evolution_stats> stats = a.get_island_stats();
+	list retval;
+	for (std::vector<evolution_stats>::size_type i = 0; i < stats.size(); ++i) {
+		retval.append(evolution_stats_to_dict(stats[i]));
+	}
+	return retval;
+}
+
 inline static population::individual_type population_get_individual(const population &pop, int n)
 {
 	return pop.get_individual(boost::numeric_cast<population::size_type>(n));
@@ -130,6 +189,11 @@ inline static void population_set_x(population &pop, int n, const decision_vecto
 	pop.set_x(boost::numeric_cast<population::size_type>(n),x);
 }
 
+inline static void population_set_xf(population &pop, int n, const decision_vector &x, const fitness_vector &f)
+{
+	pop.set_xf(boost::numeric_cast<population::size_type>(n),x,f);
+}
+
 inline static void population_set_v(population &pop, int n, const decision_vector &v)
 {
 	pop.set_v(boost::numeric_cast<population::size_type>(n),v);
@@ -279,6 +343,10 @@ BOOST_PYTHON_MODULE(_core)
 
 	typedef population::size_type (population::*get_best_1_idx)() const;
 	typedef std::vector<population::size_type> (population::*get_best_N_idx)(const population::size_type& N) const;
+	typedef population::size_type (population::*get_worst_1_idx)() const;
+	typedef std::vector<population::size_type> (population::*get_worst_N_idx)(const population::size_type& N) const;
+	typedef void (population::*push_back_x)(const decision_vector &);
+	typedef void (population::*push_back_xf)(const decision_vector &, const fitness_vector &);
 
 
 	class_<population>("population", "Population class.", init<const problem::base &,optional<int, boost::uint32_t> >())
@@ -299,10 +367,13 @@ BOOST_PYTHON_MODULE(_core)
 //		.def("update_pareto_information",&population::update_pareto_information, "updates crowding distance and front informations")
 		.def("get_best_idx",get_best_1_idx(&population::get_best_idx),"Get index of best individual.")
 		.def("get_best_idx",get_best_N_idx(&population::get_best_idx),"Get index of best N individual.")
-		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
+		.def("get_worst_idx",get_worst_1_idx(&population::get_worst_idx),"Get index of worst individual.")
+		.def("get_worst_idx",get_worst_N_idx(&population::get_worst_idx),"Get index of worst N individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
+		.def("set_xf", &population_set_xf,"Set decision vector of individual at position n, with known fitness.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
-		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
+		.def("push_back", push_back_x(&population::push_back),"Append individual with given decision vector at the end of the population.")
+		.def("push_back", push_back_xf(&population::push_back),"Append individual with given decision vector and known fitness at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
 		.def("mean_velocity", &population::mean_velocity, "Calculates the mean velocity across particles")
 		.def("race", &race_return_tuple, "Race the individuals")
@@ -344,6 +415,9 @@ BOOST_PYTHON_MODULE(_core)
 		.def("__repr__",&base_island::human_readable)
 		.def("__len__", &base_island::get_size)
 		.def("get_evolution_time", &base_island::get_evolution_time,"Gives the evolution time in milliseconds.")
+		.def("get_stats", &base_island_get_stats,"Return the evolution statistics as a dictionary (times in nanoseconds).")
+		.def("reset_stats", &base_island::reset_stats,"Reset the evolution statistics.")
+		.def("set_objfun_timing", &base_island::set_objfun_timing,"Enable or disable the timing of the objective function.")
 		.def("evolve", &base_island::evolve,"Evolve island n times.")
 		.def("evolve_t", &base_island::evolve_t,"Evolve island for at least n milliseconds.")
 		.def("join", &base_island::join,"Wait for evolution to complete.")
@@ -395,11 +469,16 @@ BOOST_PYTHON_MODULE(_core)
 		.def("evolve_t", &archipelago::evolve_t,"Evolve archipelago for at least *n* milliseconds.",boost::python::args("n"))
 		.def("join", &archipelago::join,"Wait for evolution to complete.")
 		.def("interrupt", &archipelago::interrupt,"Interrupt evolution.")
+		.def("get_stats", &archipelago_get_stats,"Return the evolution statistics of all the islands merged together, as a dictionary (times in nanoseconds).")
+		.def("get_island_stats", &archipelago_get_island_stats,"Return the list of the evolution statistics of the islands.")
+		.def("reset_stats", &archipelago::reset_stats,"Reset the evolution statistics.")
+		.def("set_objfun_timing", &archipelago::set_objfun_timing,"Enable or disable the timing of the objective function on all islands.")
 		.def("busy", &archipelago::busy,"Check if archipelago is evolving.")
 		.def("push_back", &archipelago::push_back,"Append island.")
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.add_property("reevaluation_threads",&archipelago::get_reevaluation_threads,&archipelago::set_reevaluation_threads,"Maximum number of threads used by each island to re-evaluate its immigrants.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
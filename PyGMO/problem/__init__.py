@@ -426,6 +426,8 @@ def _cec2013_ctor(self, prob_id=1, dim=10, path="input_data/"):
 
     NOTE: this problem requires two files to be put in the path indicated: "M_Dxx.txt" and "shift_data.txt".
     These files can be downloaded from the CEC2013 competition site: http://web.mysites.ntu.edu.sg/epnsugan/PublicSite/Shared%20Documents/CEC2013/cec13-c-code.zip
+    The files are read once per process and shared by all the instances. Binary versions ("M_Dxx.bin" and "shift_data.bin"),
+    memory-mapped instead of parsed, can be written with problem.cec2013.write_binary_data(dim, path).
 
     USAGE: problem.cec2013(dim = 10, prob_id=1, path="input_data/")
 
@@ -84,6 +84,8 @@ static inline class_<Problem,bases<problem::base>,bases<problem::base_stochastic
 	retval.def("cpp_dumps", &py_cpp_dumps<Problem>);
 	retval.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,
 		"Random seed used in the objective function evaluation.");
+	retval.add_property("trial_threads",&problem::base_stochastic::get_trial_threads,&problem::base_stochastic::set_trial_threads,
+		"Number of threads used to average the trials in the objective function evaluation.");
 	return retval;
 }
 
@@ -197,6 +199,7 @@ BOOST_PYTHON_MODULE(_problem) {
 		.add_property("best_c",make_function(&problem::base::get_best_c,return_value_policy<copy_const_reference>()),"Best known constraints vector(s).")
 		.add_property("fevals",&problem::base::get_fevals,"Number of function evaluations.")
 		.add_property("cevals",&problem::base::get_cevals,"Number of constraints evaluations.")
+		.add_property("cache_hits",&problem::base::get_cache_hits,"Number of function and constraints evaluations served by the caches.")
 		.def_pickle(python_class_pickle_suite<problem::python_base>());
 
 	// Expose base stochastic problem class, including the virtual methods. Here we explicitly
@@ -238,6 +241,7 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def("compare_fitness",&problem::base::compare_fitness,"Compare fitness vectors.")
 		// Seed.
 		.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,"Random seed used in the objective function evaluation.")
+		.add_property("trial_threads",&problem::base_stochastic::get_trial_threads,&problem::base_stochastic::set_trial_threads,"Number of threads used to average the trials in the objective function evaluation.")
 		// Virtual methods that can be (re)implemented.
 		.def("get_name",&problem::base::get_name,&problem::python_base_stochastic::default_get_name)
 		.def("human_readable_extra", &problem::base::human_readable_extra, &problem::python_base_stochastic::default_human_readable_extra)
@@ -328,7 +332,9 @@ BOOST_PYTHON_MODULE(_problem) {
 	// CEC2013 Competition Problems.
 	problem_wrapper<problem::cec2013>("cec2013","CEC2013 Competition Problems.")
 		.def(init<unsigned int, problem::base::size_type, const std::string&>())
-		.add_property("origin_shift", &problem::cec2013::origin_shift, "Returns the origin shift used to define the problem");
+		.add_property("origin_shift", &problem::cec2013::origin_shift, "Returns the origin shift used to define the problem")
+		.def("write_binary_data", &problem::cec2013::write_binary_data, "Writes the binary (memory-mapped) versions of the data files for a given dimension")
+		.staticmethod("write_binary_data");
 
 	// SNOPT toy problem.
 	problem_wrapper<problem::snopt_toyprob>("snopt_toyprob","SNOPT toy problem.");
@@ -362,20 +368,20 @@ BOOST_PYTHON_MODULE(_problem) {
 	// Travelling salesman problem (TSP)
 	tsp_problem_wrapper<problem::tsp>("tsp","Travelling salesman problem (TSP and ATSP)")
 		.def(init<const std::vector<std::vector<double> > &, const problem::base_tsp::encoding_type &>())
-		.add_property("weights", make_function(&problem::tsp::get_weights, return_value_policy<copy_const_reference>()));
+		.add_property("weights", &problem::tsp::get_weights);
 
 	// Travelling salesman problem, vehicle routing problem with limited capacity variant (TSP-VRPLC)
 	tsp_problem_wrapper<problem::tsp_vrplc>("tsp_vrplc","Vehicle routing problem with limited capacity (TSP-VRPLC)")
 		.def(init<const std::vector<std::vector<double> > &, const problem::base_tsp::encoding_type &, const double&>())
 		.def("return_tours",&problem::tsp_vrplc::return_tours,"Compute and return list of tours.")
-		.add_property("weights", make_function(&problem::tsp_vrplc::get_weights, return_value_policy<copy_const_reference>()))
+		.add_property("weights", &problem::tsp_vrplc::get_weights)
 		.add_property("capacity", make_function(&problem::tsp_vrplc::get_capacity, return_value_policy<copy_const_reference>()));
 
 	// Travelling salesman problem, city-selection variant (TSP-CS)
 	tsp_problem_wrapper<problem::tsp_cs>("tsp_cs","City-selection Travelling Salesman Problem (TSP-CS)")
 		.def(init<const std::vector<std::vector<double> > &, const std::vector<double>&, const double, const problem::base_tsp::encoding_type &>())
 		.def("find_city_subsequence", &find_subsequence_wrapper_cs)
-		.add_property("weights", make_function(&problem::tsp_cs::get_weights, return_value_policy<copy_const_reference>()))
+		.add_property("weights", &problem::tsp_cs::get_weights)
 		.add_property("values",  make_function(&problem::tsp_cs::get_values, return_value_policy<copy_const_reference>()))
 		.add_property("max_path_length",  &problem::tsp_cs::get_max_path_length);
 
@@ -139,9 +139,8 @@ def _erdos_renyi_ctor(self, p=0.1, nodes=0):
     # We set the defaults or the kwargs
     arg_list = []
     arg_list.append(p)
+    arg_list.append(nodes)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
 erdos_renyi._orig_init = erdos_renyi.__init__
 erdos_renyi.__init__ = _erdos_renyi_ctor
 
@@ -160,9 +159,8 @@ def _barabasi_albert_ctor(self, m0=3, m=3, nodes=0):
     arg_list = []
     arg_list.append(m0)
     arg_list.append(m)
+    arg_list.append(nodes)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
 barabasi_albert._orig_init = barabasi_albert.__init__
 barabasi_albert.__init__ = _barabasi_albert_ctor
 
@@ -183,9 +181,8 @@ def _clustered_ba_ctor(self, m0=3, m=3, p=0.5, nodes=0):
     arg_list.append(m0)
     arg_list.append(m)
     arg_list.append(p)
+    arg_list.append(nodes)
     self._orig_init(*arg_list)
-    for i in range(nodes):
-        self.push_back()
 clustered_ba._orig_init = clustered_ba.__init__
 clustered_ba.__init__ = _clustered_ba_ctor
 
@@ -24,7 +24,10 @@
 
 #include <Python.h>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/python/args.hpp>
 #include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/list.hpp>
 #include <boost/python/module.hpp>
 #include <boost/python/register_ptr_to_python.hpp>
 #include <boost/utility.hpp>
@@ -79,6 +82,20 @@ static inline topology::base::edges_size_type topology_get_num_inv_adjacent_vert
 	return t.get_num_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(n));
 }
 
+static inline dict topology_get_graph_metrics(const topology::base &t, int n_threads)
+{
+	const topology::base::graph_metrics m = t.get_graph_metrics(boost::numeric_cast<unsigned int>(n_threads));
+	list degree_distribution;
+	for (std::vector<double>::size_type i = 0; i < m.degree_distribution.size(); ++i) {
+		degree_distribution.append(m.degree_distribution[i]);
+	}
+	dict retval;
+	retval["average_shortest_path_length"] = m.average_shortest_path_length;
+	retval["clustering_coefficient"] = m.clustering_coefficient;
+	retval["degree_distribution"] = degree_distribution;
+	return retval;
+}
+
 BOOST_PYTHON_MODULE(_topology) {
 	common_module_init();
 	typedef void (topology::base::*set_weight_edge)(const topology::base::vertices_size_type &, const topology::base::vertices_size_type&, double);
@@ -93,6 +110,7 @@ BOOST_PYTHON_MODULE(_topology) {
 		.def("get_average_shortest_path_length",&topology::base::get_average_shortest_path_length,"Calculate average shortest path length.")
 		.def("get_clustering_coefficient",&topology::base::get_clustering_coefficient,"Calculate the clustering coefficient.")
 		.def("get_degree_distribution",&topology::base::get_degree_distribution,"Calculate the degree distribution.")
+		.def("get_graph_metrics",&topology_get_graph_metrics,(arg("n_threads") = 1),"Calculate all the graph metrics at once, returning a dictionary. Use n_threads = 0 for all the hardware threads.")
 		.def("push_back",&topology::base::push_back,"Add vertex to the topology and connect it.")
 		.def("set_weight",set_weight_edge(&topology::base::set_weight),"Set weight.")
 		.def("set_weight",set_weight_vertex(&topology::base::set_weight),"Set weight.")
@@ -106,8 +124,8 @@ BOOST_PYTHON_MODULE(_topology) {
 		.def("get_num_inv_adjacent_vertices",&topology_get_num_inv_adjacent_vertices,"Return number of inversely adjacent vertices.");
 
 	// Topologies.
-	topology_wrapper<topology::barabasi_albert>("barabasi_albert", "Barabasi-Albert topology.").def(init<optional<int,int> >());
-	topology_wrapper<topology::clustered_ba>("clustered_ba", "Clustered Barabasi-Albert topology.").def(init<optional<int,int,double> >());
+	topology_wrapper<topology::barabasi_albert>("barabasi_albert", "Barabasi-Albert topology.").def(init<optional<int,int,int> >());
+	topology_wrapper<topology::clustered_ba>("clustered_ba", "Clustered Barabasi-Albert topology.").def(init<optional<int,int,double,int> >());
 	topology_wrapper<topology::ageing_clustered_ba>("ageing_clustered_ba", "Clustered Barabasi-Albert with Ageing topology.").def(init<optional<int,int,double,int> >());
 	topology_wrapper<topology::custom>("custom", "Custom topology.")
 		.def(init<const topology::base &>())
@@ -115,7 +133,7 @@ BOOST_PYTHON_MODULE(_topology) {
 		.def("remove_edge",&topology::custom::remove_edge,"Remove edge.")
 		.def("remove_all_edges",&topology::custom::remove_all_edges,"Remove all edges.");
 
-	topology_wrapper<topology::erdos_renyi>("erdos_renyi", "Erdos-Renyi topology.").def(init<optional<const double &> >());
+	topology_wrapper<topology::erdos_renyi>("erdos_renyi", "Erdos-Renyi topology.").def(init<optional<const double &,int> >());
 	topology_wrapper<topology::fully_connected>("fully_connected", "Fully connected topology.");
 	topology_wrapper<topology::ring>("ring", "Ring topology.");
 	topology_wrapper<topology::hypercube>("hypercube", "Hypercube topology.");
@@ -55,6 +55,21 @@ using namespace pagmo::util;
 
 namespace pagmo {namespace util{ namespace discrepancy{
 
+// Block of n points of a sequence, starting from the point of index first
+template <class Sequence>
+static inline std::vector<std::vector<double> > generate_block(Sequence &seq, unsigned int n, unsigned int first)
+{
+	const unsigned int dim = seq.get_dimension();
+	std::vector<double> points(n * dim);
+	if (n) {
+		seq.generate(&points[0], n, first);
+	}
+	std::vector<std::vector<double> > retval(n);
+	for (unsigned int k = 0; k < n; ++k) {
+		retval[k].assign(points.begin() + k * dim, points.begin() + (k + 1) * dim);
+	}
+	return retval;
+}
 
 class __PAGMO_VISIBLE py_simplex
 {
@@ -62,6 +77,7 @@ class __PAGMO_VISIBLE py_simplex
 		py_simplex(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<std::vector<double> > generate(unsigned int n, unsigned int first) {return generate_block(m_original_class,n,first);}
 	private:
 		pagmo::util::discrepancy::simplex m_original_class;
 };
@@ -72,6 +88,7 @@ class __PAGMO_VISIBLE py_sobol
 		py_sobol(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<std::vector<double> > generate(unsigned int n, unsigned int first) {return generate_block(m_original_class,n,first);}
 	private:
 		pagmo::util::discrepancy::sobol m_original_class;
 };
@@ -82,6 +99,7 @@ class __PAGMO_VISIBLE py_lhs
 		py_lhs(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<std::vector<double> > generate(unsigned int n, unsigned int first) {return generate_block(m_original_class,n,first);}
 	private:
 		pagmo::util::discrepancy::lhs m_original_class;
 };
@@ -92,6 +110,7 @@ class __PAGMO_VISIBLE py_halton
 		py_halton(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<std::vector<double> > generate(unsigned int n, unsigned int first) {return generate_block(m_original_class,n,first);}
 	private:
 		pagmo::util::discrepancy::halton m_original_class;
 };
@@ -102,6 +121,7 @@ class __PAGMO_VISIBLE py_faure
 		py_faure(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
 		std::vector<double> operator ()() {return m_original_class();}
 		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+		std::vector<std::vector<double> > generate(unsigned int n, unsigned int first) {return generate_block(m_original_class,n,first);}
 	private:
 		pagmo::util::discrepancy::faure m_original_class;
 };
@@ -218,31 +238,36 @@ BOOST_PYTHON_MODULE(_util) {
 	typedef std::vector<double> (discrepancy::py_lhs::*my_second_overload_l)(unsigned int) ;
 	class_<discrepancy::py_lhs>("lhs", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_l(&discrepancy::py_lhs::operator()))
-		.def("next", my_second_overload_l(&discrepancy::py_lhs::operator()));
+		.def("next", my_second_overload_l(&discrepancy::py_lhs::operator()))
+		.def("generate", &discrepancy::py_lhs::generate, "Returns n consecutive points, starting from the point of index first.");
 
 	typedef std::vector<double> (discrepancy::py_sobol::*my_first_overload_s)() ;
 	typedef std::vector<double> (discrepancy::py_sobol::*my_second_overload_s)(unsigned int) ;
 	class_<discrepancy::py_sobol>("sobol", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_s(&discrepancy::py_sobol::operator()))
-		.def("next", my_second_overload_s(&discrepancy::py_sobol::operator()));
+		.def("next", my_second_overload_s(&discrepancy::py_sobol::operator()))
+		.def("generate", &discrepancy::py_sobol::generate, "Returns n consecutive points, starting from the point of index first.");
 
 	typedef std::vector<double> (discrepancy::py_simplex::*my_first_overload)() ;
 	typedef std::vector<double> (discrepancy::py_simplex::*my_second_overload)(unsigned int) ;
 	class_<discrepancy::py_simplex>("simplex", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload(&discrepancy::py_simplex::operator()))
-		.def("next", my_second_overload(&discrepancy::py_simplex::operator()));
+		.def("next", my_second_overload(&discrepancy::py_simplex::operator()))
+		.def("generate", &discrepancy::py_simplex::generate, "Returns n consecutive points, starting from the point of index first.");
 		
 	typedef std::vector<double> (discrepancy::py_halton::*my_first_overload_h)() ;
 	typedef std::vector<double> (discrepancy::py_halton::*my_second_overload_h)(unsigned int) ;
 	class_<discrepancy::py_halton>("halton", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_h(&discrepancy::py_halton::operator()))
-		.def("next", my_second_overload_h(&discrepancy::py_halton::operator()));
+		.def("next", my_second_overload_h(&discrepancy::py_halton::operator()))
+		.def("generate", &discrepancy::py_halton::generate, "Returns n consecutive points, starting from the point of index first.");
 
 	typedef std::vector<double> (discrepancy::py_faure::*my_first_overload_f)() ;
 	typedef std::vector<double> (discrepancy::py_faure::*my_second_overload_f)(unsigned int) ;
 	class_<discrepancy::py_faure>("faure", init<unsigned int , unsigned int>())
 		.def("next", my_first_overload_f(&discrepancy::py_faure::operator()))
-		.def("next", my_second_overload_f(&discrepancy::py_faure::operator()));
+		.def("next", my_second_overload_f(&discrepancy::py_faure::operator()))
+		.def("generate", &discrepancy::py_faure::generate, "Returns n consecutive points, starting from the point of index first.");
 
 	// Racing
 	enum_<racing::race_pop::termination_condition>("_termination_condition")
@@ -256,7 +281,11 @@ BOOST_PYTHON_MODULE(_util) {
 		.def("register_pop", &racing::race_pop::register_population, "Load a population into the race environment")
 		.def("inherit_memory", &racing::race_pop::inherit_memory, "Transfer memory of identical decision vectors")
 		.def("get_mean_fitness", &racing::race_pop::get_mean_fitness, "Returns the mean fitness of the individuals resulted from previously run race")
-		.def("set_seed", &racing::race_pop::set_seed, "Set the ground seed of the race");
+		.def("set_seed", &racing::race_pop::set_seed, "Set the ground seed of the race")
+		.def("share_memory", &racing::race_pop::share_memory, "Share the store of evaluations with another race")
+		.add_property("cache_capacity", &racing::race_pop::get_cache_capacity, &racing::race_pop::set_cache_capacity, "Maximum number of evaluations kept in the store")
+		.add_property("eval_threads", &racing::race_pop::get_eval_threads, &racing::race_pop::set_eval_threads, "Number of threads evaluating a racing round")
+		.add_property("lookahead", &racing::race_pop::get_lookahead, &racing::race_pop::set_lookahead, "Number of racing rounds evaluated in advance by idle threads");
 
 	// Required by race_algo
 	//class_<std::vector<pagmo::algorithm::base_ptr> >("vector_of_algorithm_base_ptr")
@@ -267,7 +296,9 @@ BOOST_PYTHON_MODULE(_util) {
 
 	class_<racing::race_algo>("race_algo", init<const std::vector<pagmo::algorithm::base_ptr> &, const pagmo::problem::base &, unsigned int, unsigned int>())
 	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int>())
-	.def("run", &race_algo_run_return_tuple, "Race the algorithms");
+	.def("run", &race_algo_run_return_tuple, "Race the algorithms")
+	.def("set_eval_threads", &racing::race_algo::set_eval_threads, "Set the number of threads evolving the algorithms")
+	.def("set_lookahead", &racing::race_algo::set_lookahead, "Set the number of racing rounds evolved in advance by idle threads");
 	
 	// Hypervolumes
 	expose_hypervolume();
@@ -26,7 +26,9 @@
 #include <sstream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
+#include "../exceptions.h"
 #include "../population.h"
 #include "../rng.h"
 #include "base.h"
@@ -47,6 +49,70 @@ base::base():m_screen_output(false), m_drng(rng_generator::get<rng_double>()), m
  */
 base::~base() {}
 
+/// Ask for a batch of candidate decision vectors.
+/**
+ * Ask/tell is the externally driven counterpart of evolve(): ask() generates, from the current state of the population,
+ * the decision vectors the algorithm would evaluate in one generation, without evaluating them. The caller is then free
+ * to compute their fitnesses in any way (in parallel, in batches, on a remote scheduler) and to hand them back through
+ * tell(), which performs the selection and updates the population.
+ *
+ * Default implementation throws, algorithms supporting ask/tell need to reimplement both ask() and tell().
+ *
+ * @param[in] pop population the candidates are generated from.
+ *
+ * @return the candidate decision vectors.
+ *
+ * @throws not_implemented_error if the algorithm does not support the ask/tell interface.
+ */
+std::vector<decision_vector> base::ask(const population &pop) const
+{
+	(void)pop;
+	pagmo_throw(not_implemented_error,"the ask/tell interface is not implemented for algorithm " + get_name());
+}
+
+/// Tell the fitnesses of a batch of candidate decision vectors.
+/**
+ * Ingests the fitnesses of the decision vectors returned by the last call to ask() on the same population
+ * and updates the population accordingly. No objective function evaluation is performed.
+ *
+ * Default implementation throws.
+ *
+ * @param[in,out] pop population to be updated.
+ * @param[in] x the candidates returned by ask(), in the same order.
+ * @param[in] f the fitnesses of the candidates.
+ *
+ * @throws not_implemented_error if the algorithm does not support the ask/tell interface.
+ */
+void base::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	(void)pop;
+	(void)x;
+	(void)f;
+	pagmo_throw(not_implemented_error,"the ask/tell interface is not implemented for algorithm " + get_name());
+}
+
+/// Checks the consistency of the arguments passed to tell().
+/**
+ * @param[in] pop population being told.
+ * @param[in] x candidate decision vectors.
+ * @param[in] f candidate fitness vectors.
+ * @param[in] n expected number of candidates.
+ *
+ * @throws value_error if x and f do not both contain n elements, or a fitness vector has not the problem fitness dimension.
+ */
+void base::check_told(const population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f,
+	const std::vector<decision_vector>::size_type &n) const
+{
+	if (x.size() != n || f.size() != n) {
+		pagmo_throw(value_error,"the number of candidates told does not match the number of candidates asked");
+	}
+	for (std::vector<fitness_vector>::size_type i = 0; i < n; ++i) {
+		if (f[i].size() != pop.problem().get_f_dimension()) {
+			pagmo_throw(value_error,"fitness vector is not compatible with problem");
+		}
+	}
+}
+
 /// Get algorithm's name.
 /**
  * Default implementation will return the algorithm's mangled C++ name.
@@ -28,12 +28,14 @@
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "../config.h"
 #include "../population.h"
 #include "../rng.h"
 #include "../serialization.h"
+#include "../types.h"
 
 namespace pagmo
 {
@@ -53,6 +55,8 @@ typedef boost::shared_ptr<base> base_ptr;
 /**
  * All algorithms implemented in PaGMO must derive from this base class. This base class provides each algorithm with one pagmo::rng_double
  * and one pagmo::rng_uint32 random number generators. Each algorithm must implement the base::evolve() method.
+ * Algorithms can also expose one generation at a time through base::ask() and base::tell(), leaving the evaluation
+ * of the candidates to the caller.
  *
  * \section Serialization
  * The algorithm classes are serialized for the purpose of being transmitted over a distributed environment.
@@ -101,6 +105,8 @@ return base_ptr(new derived_algorithm(*this));
 		 */
 		virtual base_ptr clone() const = 0;
 		virtual ~base();
+		virtual std::vector<decision_vector> ask(const population &) const;
+		virtual void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 		std::string human_readable() const;
 		virtual std::string get_name() const;
 		virtual std::string human_readable_extra() const;
@@ -112,6 +118,8 @@ return base_ptr(new derived_algorithm(*this));
 		void reset_rngs(const unsigned int) const;
 
 	protected:
+		void check_told(const population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &,
+			const std::vector<decision_vector>::size_type &) const;
 		/// Indicates to the derived class whether to print stuff on screen
 		bool m_screen_output;
 		/// Random number generator for double-precision floating point values.
@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <boost/random/uniform_int.hpp>
@@ -44,9 +45,10 @@ namespace pagmo { namespace algorithm {
  *
  * @param[in] gen number of generations (2 * pop.size() function evaluations per generation).
  * @param[in] limit number of tries after which a source of food is dropped if not improved
+ * @param[in] memory when true the trial counters of the food sources are preserved through successive calls
  * @throws value_error if number of iterations or limit are negative
  */
-bee_colony::bee_colony(int gen, int limit):base(),m_iter(gen), m_limit(limit) {
+bee_colony::bee_colony(int gen, int limit, bool memory):base(),m_iter(gen), m_limit(limit), m_memory(memory) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -108,7 +110,11 @@ void bee_colony::evolve(population &pop) const
 
 	decision_vector temp_solution(D,0);
 
-	std::vector<int> trial(NP,0);
+	// Trial counters are restarted, unless remembered from a previous call on a population of the same size
+	if (!m_memory || m_trial.size() != NP) {
+		m_trial.assign(NP,0);
+	}
+	std::vector<int> &trial = m_trial;
 
 	std::vector<double> probability(NP);
 
@@ -119,6 +125,12 @@ void bee_colony::evolve(population &pop) const
 	std::vector<double> selectionfitness(NP), cumsum(NP), cumsumTemp(NP);
 	std::vector <population::size_type> selection(NP);
 
+	// Food sources improved during a generation, written back into the population at once
+	std::vector<bool> improved(NP);
+	std::vector<population::size_type> improved_idx;
+	std::vector<decision_vector> improved_X;
+	std::vector<fitness_vector> improved_fit;
+
 
 	double r = 0;
 
@@ -130,6 +142,7 @@ void bee_colony::evolve(population &pop) const
 
 	// Main ABC loop
 	for (int j = 0; j < m_iter; ++j) {
+		std::fill(improved.begin(),improved.end(),false);
 		//1- Send employed bees
 		for (population::size_type ii = 0; ii< NP; ++ii) {
 			//selects a random component (only of the continuous part) of the decision vector
@@ -163,8 +176,8 @@ void bee_colony::evolve(population &pop) const
 			//If the new solution is better than the old one replace it with the mutant one and reset its trial counter
 			if(prob.compare_fitness(fnew, fit[ii])) {
 				X[ii][param2change] = temp_solution[param2change];
-				pop.set_x(ii,X[ii]);
-				prob.objfun(fit[ii], X[ii]); //update the fitness vector
+				fit[ii] = fnew; //update the fitness vector (temp_solution and X[ii] are now equal)
+				improved[ii] = true;
 				trial[ii] = 0;
 			}
 			else {
@@ -236,8 +249,8 @@ void bee_colony::evolve(population &pop) const
 			//If the new solution is better than the old one replace it with the mutant one and reset its trial counter
 			if(prob.compare_fitness(fnew, fit[ii])) {
 				X[ii][param2change] = temp_solution[param2change];
-				pop.set_x(ii,X[ii]);
-				prob.objfun(fit[ii], X[ii]); //update the fitness vector
+				fit[ii] = fnew; //update the fitness vector (temp_solution and X[ii] are now equal)
+				improved[ii] = true;
 				trial[ii] = 0;
 			}
 			else {
@@ -245,6 +258,19 @@ void bee_colony::evolve(population &pop) const
 			}
 		}
 
+		// Write back the improved food sources (fitness already known, single domination update)
+		improved_idx.clear();
+		improved_X.clear();
+		improved_fit.clear();
+		for (population::size_type ii = 0; ii < NP; ++ii) {
+			if (improved[ii]) {
+				improved_idx.push_back(ii);
+				improved_X.push_back(X[ii]);
+				improved_fit.push_back(fit[ii]);
+			}
+		}
+		pop.set_xf(improved_idx,improved_X,improved_fit);
+
 		//3 - Send scout bees
 		int maxtrialindex = 0;
 		for (population::size_type ii=1; ii<NP; ++ii)
@@ -260,7 +286,8 @@ void bee_colony::evolve(population &pop) const
 				X[maxtrialindex][jj] = boost::uniform_real<double>(lb[jj],ub[jj])(m_drng);
 			}
 			trial[maxtrialindex] = 0;
-			pop.set_x(maxtrialindex,X[maxtrialindex]);
+			prob.objfun(fit[maxtrialindex], X[maxtrialindex]); //the abandoned source fitness is replaced too
+			pop.set_xf(maxtrialindex,X[maxtrialindex],fit[maxtrialindex]);
 		}
 
 	} // end of main ABC loop
@@ -283,6 +310,7 @@ std::string bee_colony::human_readable_extra() const
 	std::ostringstream s;
 	s << "gen:" << m_iter << ' ';
 	s << "limit:" << m_limit << ' ';
+	s << "memory:" << m_memory << ' ';
 	return s.str();
 }
 
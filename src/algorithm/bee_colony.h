@@ -26,6 +26,7 @@
 #define PAGMO_ALGORITHM_BEE_COLONY_H
 
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../population.h"
@@ -57,7 +58,7 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE bee_colony: public base
 {
 public:
-	bee_colony(int gen = 1, int limit = 20);
+	bee_colony(int gen = 1, int limit = 20, bool memory = false);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -71,10 +72,16 @@ private:
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_iter);
 		ar & const_cast<int &>(m_limit);   
+		ar & const_cast<bool &>(m_memory);
+		ar & m_trial;
 	}  
 	// Number of generations.
 	const int m_iter;
 	const int m_limit;
+	// Memory option
+	const bool m_memory;
+	// Trial counters of the food sources (kept through successive calls when m_memory is true)
+	mutable std::vector<int> m_trial;
 };
 
 }} //namespaces
@@ -112,24 +112,62 @@ struct cmp_using_cur
 	const population &m_pop;
 };
 
+// Restores the step size on destruction if active, so that an evolve() without memory leaves it unchanged
+// also when it exits with an exception.
+struct sigma_guard
+{
+	sigma_guard(double &sigma, bool active):m_sigma(sigma),m_sigma0(sigma),m_active(active) {}
+	~sigma_guard()
+	{
+		if (m_active) {
+			m_sigma = m_sigma0;
+		}
+	}
+	double		&m_sigma;
+	const double	m_sigma0;
+	const bool	m_active;
+};
 
-/// Evolve implementation.
-/**
- * Run CMAES
- *
- * @param[in,out] pop input/output pagmo::population to be evolved.
- */
+// Recombination weights and learning rates, as derived from the population size and the problem dimension.
+struct cmaes_rates
+{
+	cmaes_rates(population::size_type lam, problem::base::size_type N, double cc_, double cs_, double c1_, double cmu_):
+		mu(boost::numeric_cast<population::size_type>(lam/2)), weights(mu), cc(cc_), cs(cs_), c1(c1_), cmu(cmu_)
+	{
+		// Setting coefficients for Selection
+		for (int i = 0; i < weights.rows(); ++i){
+			weights(i) = std::log(mu+0.5) - std::log(i+1.0);
+		}
+		weights /= weights.sum();					// weights for weighted recombination
+		mueff = 1.0 / (weights.transpose()*weights);			// variance-effectiveness of sum w_i x_i
 
-void cmaes::evolve(population &pop) const
+		// Setting coefficients for Adaptation automatically or to user defined data
+		if (cc == -1) {
+			cc = (4 + mueff/N) / (N+4 + 2*mueff/N);			// t-const for cumulation for C
+		}
+		if (cs == -1) {
+			cs = (mueff+2) / (N+mueff+5);				// t-const for cumulation for sigma control
+		}
+		if (c1 == -1) {
+			c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+		}
+		if (cmu == -1) {
+			cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
+		}
+		damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
+		chiN = std::sqrt(N) * (1-1.0/(4*N)+1.0/(21*N*N));		// expectation of ||N(0,I)|| == norm(randn(N,1))
+	}
+	population::size_type mu;
+	Eigen::VectorXd weights;
+	double mueff, cc, cs, c1, cmu, damps, chiN;
+};
+
+// Checks whether the problem/population are suitable for CMAES
+void cmaes::check_suitability(const population &pop) const
 {
-	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type prob_i_dimension = prob.get_i_dimension(), dim = prob.get_dimension(), N = dim - prob_i_dimension, prob_c_dimension = prob.get_c_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
-	const population::size_type lam = pop.size();
-	const population::size_type mu = boost::numeric_cast<population::size_type>(lam/2);
+	const problem::base::size_type prob_i_dimension = prob.get_i_dimension(), N = prob.get_dimension() - prob_i_dimension;
 
-	//We perform some checks to determine whether the problem/population are suitable for Cross Entropy
 	if ( N == 0 ) {
 		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for CE to optimise");
 	}
@@ -138,7 +176,7 @@ void cmaes::evolve(population &pop) const
 		pagmo_throw(value_error,"The problem is not single objective and CE is not suitable to solve it");
 	}
 
-	if ( prob_c_dimension != 0 ) {
+	if ( prob.get_c_dimension() != 0 ) {
 		pagmo_throw(value_error,"The problem is not box constrained and CE is not suitable to solve it");
 	}
 
@@ -146,146 +184,236 @@ void cmaes::evolve(population &pop) const
 		pagmo_throw(value_error,"The problem has an integer part and CE is not suitable to solve it");
 	}
 
-	if (lam < 5) {
+	if (pop.size() < 5) {
 		pagmo_throw(value_error,"for CE at least 5 individuals in the population are required");
 	}
+}
 
-	// Get out if there is nothing to do.
-	if (m_gen == 0) {
-		return;
+// Resets the algorithm memory: the mean is set to the population champion, the covariance to the box width.
+void cmaes::init_memory(const population &pop) const
+{
+	using namespace Eigen;
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type N = prob.get_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+
+	m_mean.resize(N);
+	for (problem::base::size_type i=0;i<N;++i){
+		m_mean(i) = pop.champion().x[i];
 	}
+	m_newpop = std::vector<VectorXd>(pop.size(),VectorXd::Zero(N));
+	m_variation.resize(N);
 
-	using namespace Eigen;
+	//We define the satrting B,D,C
+	m_B.resize(N,N); m_B = MatrixXd::Identity(N,N);			//B defines the coordinate system
+	m_D.resize(N,N); m_D = MatrixXd::Identity(N,N);			//diagonal D defines the scaling. By default this is the witdh of the box.
+										//If this is too small... then 1e-6 is used
+	for (problem::base::size_type j=0; j<N; ++j){
+		m_D(j,j) = std::max((ub[j]-lb[j]),1e-6);
+	}
+	m_C.resize(N,N); m_C = MatrixXd::Identity(N,N);			//covariance matrix C
+	m_C = m_D*m_D;
+	m_invsqrtC.resize(N,N); m_invsqrtC = MatrixXd::Identity(N,N);	//inverse of sqrt(C)
+	for (problem::base::size_type j=0; j<N; ++j){
+		m_invsqrtC(j,j) = 1 / m_D(j,j);
+	}
+	m_pc.resize(N); m_pc = VectorXd::Zero(N);
+	m_ps.resize(N); m_ps = VectorXd::Zero(N);
+	m_counteval = 0;
+	m_eigeneval = 0;
+}
+
+// True if the algorithm memory has been built for this population size and problem dimension.
+bool cmaes::memory_fits(const population &pop) const
+{
+	return m_newpop.size() == pop.size() && m_newpop.size() && (unsigned int)(m_newpop[0].rows()) == pop.problem().get_dimension();
+}
 
-	// Initializing the random number generators
+// Samples lam new individuals from the current distribution into m_newpop, fixing the bounds.
+// Returns the norm of the last sampled variation, used as a stopping criteria.
+double cmaes::sample(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type N = prob.get_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	boost::normal_distribution<double> normal(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > normally_distributed_number(m_drng,normal);
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > randomly_distributed_number(m_drng,uniform);
 
-	// Setting coefficients for Selection
-	VectorXd weights(mu);
-	for (int i = 0; i < weights.rows(); ++i){
-		weights(i) = std::log(mu+0.5) - std::log(i+1.0);
+	Eigen::VectorXd tmp(N);
+	// The sampling transformation is the same for all individuals
+	const Eigen::MatrixXd BD = m_sigma * m_B * m_D;
+	for (population::size_type i = 0; i<m_newpop.size(); ++i ) {
+		// 1a - we create a randomly normal distributed vector
+		for (problem::base::size_type j=0; j<N; ++j){
+			tmp(j) = normally_distributed_number();
+		}
+		// 1b - and store its transformed value in the newpop
+		m_newpop[i] = m_mean + BD * tmp;
 	}
-	weights /= weights.sum();					// weights for weighted recombination
-	double mueff = 1.0 / (weights.transpose()*weights);		// variance-effectiveness of sum w_i x_i
+	//This is evaluated here on the last generated tmp and will be used only as
+	//a stopping criteria
+	const double var_norm = (BD * tmp).norm();
+
+	// 1c - we fix the bounds
+	for (population::size_type i = 0; i<m_newpop.size(); ++i ) {
+		for (decision_vector::size_type j = 0; j<N; ++j ) {
+			if ( (m_newpop[i](j) < lb[j]) || (m_newpop[i](j) > ub[j]) ) {
+				m_newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+			}
+		}
+	}
+	return var_norm;
+}
 
-	// Setting coefficients for Adaptation automatically or to user defined data
-	double cc(m_cc), cs(m_cs), c1(m_c1), cmu(m_cmu);
-	if (cc == -1) {
-		cc = (4 + mueff/N) / (N+4 + 2*mueff/N);			// t-const for cumulation for C
+// Adapts the distribution (mean, evolution paths, covariance matrix and step size) to the elite of
+// the current population, whose cur_f are the fitnesses of the last sampled individuals.
+void cmaes::adapt(const population &pop) const
+{
+	using namespace Eigen;
+	const problem::base::size_type N = pop.problem().get_dimension();
+	const population::size_type lam = pop.size();
+	const cmaes_rates r(lam,N,m_cc,m_cs,m_c1,m_cmu);
+	const population::size_type mu = r.mu;
+	const VectorXd &weights = r.weights;
+	m_counteval += lam;
+
+	// 2 - We extract the elite from this generation. We use cur_f, equivalent to the
+	// original method
+	std::vector<population::size_type> best_idx;
+	best_idx.reserve(pop.size());
+	for (population::size_type i=0; i<pop.size(); ++i){
+		best_idx.push_back(i);
 	}
-	if (cs == -1) {
-		cs = (mueff+2) / (N+mueff+5);				// t-const for cumulation for sigma control
+	cmp_using_cur cmp(pop);
+	std::sort(best_idx.begin(),best_idx.end(),cmp);
+	best_idx.resize(mu);
+	std::vector<VectorXd> elite(mu,VectorXd::Zero(N));
+	for (population::size_type i = 0; i<mu; ++i ) {
+		for (decision_vector::size_type j = 0; j<N; ++j ) {
+			elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
+		}
 	}
-	if (c1 == -1) {
-		c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+
+	// 3 - Compute the new elite mean storing the old one
+	const VectorXd meanold = m_mean;
+	m_mean = elite[0]*weights(0);
+	for (population::size_type i = 1; i<mu; ++i ) {
+		m_mean += elite[i]*weights(i);
 	}
-	if (cmu == -1) {
-		cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
+
+	// 4 - Update evolution paths
+	m_ps = (1 - r.cs) * m_ps + std::sqrt(r.cs*(2-r.cs)*r.mueff) * m_invsqrtC * (m_mean-meanold) / m_sigma;
+	double hsig = 0;
+	hsig = (m_ps.squaredNorm() / N / (1-std::pow((1-r.cs),(2.0*m_counteval/lam))) ) < (2.0 + 4/(N+1));
+	m_pc = (1-r.cc) * m_pc + hsig * std::sqrt(r.cc*(2-r.cc)*r.mueff) * (m_mean-meanold) / m_sigma;
+
+	// 5 - Adapt Covariance Matrix
+	const MatrixXd Cold = m_C;
+	m_C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
+	for (population::size_type i = 1; i<mu; ++i ) {
+		m_C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
+	}
+	m_C /= m_sigma*m_sigma;
+	m_C = (1-r.c1-r.cmu) * Cold +
+		r.cmu * m_C +
+		r.c1 * ((m_pc * m_pc.transpose()) + (1-hsig) * r.cc * (2-r.cc) * Cold);
+
+	//6 - Adapt sigma
+	m_sigma *= std::exp( std::min( 0.6, (r.cs/r.damps) * (m_ps.norm()/r.chiN - 1) ) );
+	if ( (boost::math::isnan)(m_sigma) || (boost::math::isinf)(m_sigma) ) {
+		std::cout << "B: " << m_B << std::endl;
+		std::cout << "D: " << m_D << std::endl;
+		std::cout << "C: " << m_C << std::endl;
+		std::cout << "invsqrtC: " << m_invsqrtC << std::endl;
+		pagmo_throw(value_error,"NaN!!!!! in CMAES");
 	}
-	
-	double damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
-	double chiN = std::sqrt(N) * (1-1.0/(4*N)+1.0/(21*N*N));		// expectation of ||N(0,I)|| == norm(randn(N,1))
-
-	// Initializing and allocating (here one could use mutable data member to avoid redefinition of non const data)
-
-	// Algorithm's Memory. This allows the algorithm to start from its last "state"
-	VectorXd mean(m_mean);
-	VectorXd variation(m_variation);
-	std::vector<VectorXd> newpop(m_newpop);
-	MatrixXd B(m_B);
-	MatrixXd D(m_D);
-	MatrixXd C(m_C);
-	MatrixXd invsqrtC(m_invsqrtC);
-	VectorXd pc(m_pc);
-	VectorXd ps(m_ps);
-	int counteval(m_counteval);
-	int eigeneval(m_eigeneval);
-	double sigma(m_sigma);
-	double var_norm = 0;
-
-	// Some buffers
-	VectorXd meanold = VectorXd::Zero(N);
-	MatrixXd Dinv = MatrixXd::Identity(N,N);
-	MatrixXd Cold = MatrixXd::Identity(N,N);
-	VectorXd tmp = VectorXd::Zero(N);
-	std::vector<VectorXd> elite(mu,tmp);
-	decision_vector dumb(N,0);
 
-	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
-	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
-		mean.resize(N);
-		for (problem::base::size_type i=0;i<N;++i){
-			mean(i) = pop.champion().x[i];
-		}
-		newpop = std::vector<VectorXd>(lam,tmp);
-		variation.resize(N);
+	//7 - Perform eigen-decomposition of C
+	if ( (m_counteval - m_eigeneval) > (lam/(r.c1+r.cmu)/N/10) ) {		//achieve O(N^2)
+		m_eigeneval = m_counteval;
+		m_C = (m_C+m_C.transpose())/2;				//enforce symmetry
+		SelfAdjointEigenSolver<MatrixXd> es(m_C);		//eigen decomposition
+		if (es.info()==Success) {
+			MatrixXd Dinv = MatrixXd::Identity(N,N);
+			m_B = es.eigenvectors();
+			m_D = es.eigenvalues().asDiagonal();
+			for (decision_vector::size_type j = 0; j<N; ++j ) {
+				m_D(j,j) = std::sqrt( std::max(1e-20,m_D(j,j)) );				//D contains standard deviations now
+			}
+			for (decision_vector::size_type j = 0; j<N; ++j ) {
+				Dinv(j,j) = 1.0 / m_D(j,j);
+			}
+			m_invsqrtC = m_B*Dinv*m_B.transpose();
+		} //if eigendecomposition fails just skip it and keep pevious succesful one.
+	}
+}
 
-		//We define the satrting B,D,C
-		B.resize(N,N); B = MatrixXd::Identity(N,N);			//B defines the coordinate system
-		D.resize(N,N); D = MatrixXd::Identity(N,N);			//diagonal D defines the scaling. By default this is the witdh of the box. 
-										//If this is too small... then 1e-6 is used
-		for (problem::base::size_type j=0; j<N; ++j){
-			D(j,j) = std::max((ub[j]-lb[j]),1e-6);
-		}
-		C.resize(N,N); C = MatrixXd::Identity(N,N);			//covariance matrix C
-		C = D*D;						
-		invsqrtC.resize(N,N); invsqrtC = MatrixXd::Identity(N,N);	//inverse of sqrt(C)
-		for (problem::base::size_type j=0; j<N; ++j){
-			invsqrtC(j,j) = 1 / D(j,j);
-		}
-		pc.resize(N); pc = VectorXd::Zero(N);
-		ps.resize(N); ps = VectorXd::Zero(N);
-		counteval = 0;
-		eigeneval = 0;
+/// Evolve implementation.
+/**
+ * Run CMAES
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
+ */
+void cmaes::evolve(population &pop) const
+{
+	// Let's store some useful variables.
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type N = prob.get_dimension();
+	const population::size_type lam = pop.size();
+
+	check_suitability(pop);
+
+	// Get out if there is nothing to do.
+	if (m_gen == 0) {
+		return;
+	}
+
+	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls.
+	// Without memory, the starting step is also restored on exit.
+	const sigma_guard guard(m_sigma,!m_memory);
+	if ( !memory_fits(pop) || (m_memory==false) ) {
+		init_memory(pop);
 	}
-	
+
 	// ----------------------------------------------//
 	// HERE WE START THE REAL ALGORITHM              //
 	// ----------------------------------------------//
 
 	if (m_screen_output) {
+		const cmaes_rates r(lam,N,m_cc,m_cs,m_c1,m_cmu);
 		std::cout << "CMAES 4 PaGMO: " << std::endl;
-		std::cout << "mu: " << mu
+		std::cout << "mu: " << r.mu
 			<< " - lambda: " << lam
-			<< " - mueff: " << mueff
+			<< " - mueff: " << r.mueff
 			<< " - N: " << N << std::endl;
 
-		std::cout << "cc: " << cc
-			<< " - cs: " << cs
-			<< " - c1: " << c1
-			<< " - cmu: " << cmu
-			<< " - sigma: " << sigma
-			<< " - damps: " << damps
-			<< " - chiN: " << chiN << std::endl;
+		std::cout << "cc: " << r.cc
+			<< " - cs: " << r.cs
+			<< " - c1: " << r.c1
+			<< " - cmu: " << r.cmu
+			<< " - sigma: " << m_sigma
+			<< " - damps: " << r.damps
+			<< " - chiN: " << r.chiN << std::endl;
 	}
-	
-	SelfAdjointEigenSolver<MatrixXd> es(N);
-	for (std::size_t g = 0; g < m_gen; ++g) {
-		// 1 - We generate and evaluate lam new individuals
 
-		for (population::size_type i = 0; i<lam; ++i ) {
-			// 1a - we create a randomly normal distributed vector
-			for (problem::base::size_type j=0; j<N; ++j){
-				tmp(j) = normally_distributed_number();
-			}
-			// 1b - and store its transformed value in the newpop
-			newpop[i] = mean + (sigma * B * D * tmp);
+	decision_vector dumb(N,0);
+	for (std::size_t g = 0; g < m_gen; ++g) {
+		// 1 - We generate lam new individuals
+		const double var_norm = sample(pop);
+		if ( (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
+			pagmo_throw(value_error,"NaN!!!!! in CMAES");
 		}
-		//This is evaluated here on the last generated tmp and will be used only as 
-		//a stopping criteria
-		var_norm = (sigma * B * D * tmp).norm();
-		
-		//1b - Check the exit conditions (every 5 generations) // we need to do it here as 
-		//termination is defined on tmp
+
+		//1b - Check the exit conditions (every 5 generations) // we need to do it here as
+		//termination is defined on the last variation
 		if (g%5 == 0) {
-			if  ( (sigma*B*D*tmp).norm() < m_xtol ) {
-				if (m_screen_output) { 
+			if  ( var_norm < m_xtol ) {
+				if (m_screen_output) {
 					std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
 				}
-				return;
+				break;
 			}
 
 			double mah = std::fabs(pop.get_individual(pop.get_worst_idx()).best_f[0] - pop.get_individual(pop.get_best_idx()).best_f[0]);
@@ -294,16 +422,7 @@ void cmaes::evolve(population &pop) const
 				if (m_screen_output) {
 					std::cout << "Exit condition -- ftol < " <<  m_ftol << std::endl;
 				}
-				return;
-			}
-		}
-
-		// 1c - we fix the bounds 
-		for (population::size_type i = 0; i<lam; ++i ) {
-			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				if ( (newpop[i](j) < lb[j]) || (newpop[i](j) > ub[j]) ) {
-					newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
-				}
+				break;
 			}
 		}
 
@@ -315,134 +434,95 @@ void cmaes::evolve(population &pop) const
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 			for (population::size_type i = 0; i<lam; ++i ) {
 			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
+					dumb[j] = m_newpop[i](j);
 				}
 				pop.push_back(dumb);
 			}
-			counteval += lam;
 		}
 		catch (const std::bad_cast& e)
 		{
 			// Reinsertion (original method)
 			for (population::size_type i = 0; i<lam; ++i ) {
 				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
+					dumb[j] = m_newpop[i](j);
 				}
 				pop.set_x(i,dumb);
 			}
-			counteval += lam;
-		}
-		
-		// 2 - We extract the elite from this generation. We use cur_f, equivalent to the
-		// original method
-		std::vector<population::size_type> best_idx;
-		best_idx.reserve(pop.size());
-		for (population::size_type i=0; i<pop.size(); ++i){
-			best_idx.push_back(i);
-		}
-		cmp_using_cur cmp(pop);
-		std::sort(best_idx.begin(),best_idx.end(),cmp);
-		best_idx.resize(mu);
-		for (population::size_type i = 0; i<mu; ++i ) {
-			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
-			}
 		}
 
-
-		// 3 - Compute the new elite mean storing the old one
-		meanold=mean;
-		mean = elite[0]*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			mean += elite[i]*weights(i);
-		}
-
-		// 4 - Update evolution paths
-		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
-		double hsig = 0;
-		hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
-		pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
-
-		// 5 - Adapt Covariance Matrix
-		Cold = C;
-		C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
-		}
-		C /= sigma*sigma;
-		C = (1-c1-cmu) * Cold +
-			cmu * C +
-			c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
-
-		//6 - Adapt sigma
-		sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
-		if ( (boost::math::isnan)(sigma) || (boost::math::isnan)(sigma) || (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
-			std::cout << "eigen: " << es.info() << std::endl;
-			std::cout << "B: " << B << std::endl;
-			std::cout << "D: " << D << std::endl;
-			std::cout << "Dinv: " << D << std::endl;
-			std::cout << "invsqrtC: " << invsqrtC << std::endl;
-			pagmo_throw(value_error,"NaN!!!!! in CMAES");
-		}
-
-		//7 - Perform eigen-decomposition of C
-		if ( (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
-			eigeneval = counteval;
-			C = (C+C.transpose())/2;				//enforce symmetry
-			es.compute(C);						//eigen decomposition
-			if (es.info()==Success) {
-				B = es.eigenvectors();
-				D = es.eigenvalues().asDiagonal();
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					D(j,j) = std::sqrt( std::max(1e-20,D(j,j)) );				//D contains standard deviations now
-				}
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					Dinv(j,j) = 1.0 / D(j,j);
-				}
-				invsqrtC = B*Dinv*B.transpose();
-			} //if eigendecomposition fails just skip it and keep pevious succesful one.
-		}
-		
-		
+		// 3 - We adapt the distribution to the elite of this generation
+		adapt(pop);
 
 		//8 - We print on screen if required
 		if (m_screen_output) {
 			if (!(g%20)) {
-				std::cout << std::endl << std::left << std::setw(20) << 
-				"Gen." << std::setw(20) << 
-				"Champion " << std::setw(20) << 
-				"Highest " << std::setw(20) << 
-				"Lowest" << std::setw(20) << 
-				"Variation" << std::setw(20) << 
-				"Step" << std::endl; 
+				std::cout << std::endl << std::left << std::setw(20) <<
+				"Gen." << std::setw(20) <<
+				"Champion " << std::setw(20) <<
+				"Highest " << std::setw(20) <<
+				"Lowest" << std::setw(20) <<
+				"Variation" << std::setw(20) <<
+				"Step" << std::endl;
 			}
-				
-			std::cout << std::left << std::setprecision(14) << std::setw(20) << 
-				g << std::setw(20) << 
-				pop.champion().f[0] << std::setw(20) << 
-				pop.get_individual(pop.get_best_idx()).best_f[0] << std::setw(20) << 
-				pop.get_individual(pop.get_worst_idx()).best_f[0] << std::setw(20) << 
+
+			std::cout << std::left << std::setprecision(14) << std::setw(20) <<
+				g << std::setw(20) <<
+				pop.champion().f[0] << std::setw(20) <<
+				pop.get_individual(pop.get_best_idx()).best_f[0] << std::setw(20) <<
+				pop.get_individual(pop.get_worst_idx()).best_f[0] << std::setw(20) <<
 				var_norm << std::setw(20) <<
-				sigma << std::endl;
+				m_sigma << std::endl;
+		}
+	} // end loop on g
+}
+
+/// Ask for one generation of CMAES samples.
+/**
+ * Samples pop.size() individuals from the current search distribution. The distribution is the algorithm memory:
+ * it is initialised around the population champion the first time ask() is called for a given problem dimension
+ * and population size, and it is adapted by tell() regardless of the memory flag.
+ *
+ * @param[in] pop population defining the problem and the number of samples.
+ *
+ * @return the sampled decision vectors.
+ * @throws value_error if the problem/population are not suitable for CMAES
+ */
+std::vector<decision_vector> cmaes::ask(const population &pop) const
+{
+	check_suitability(pop);
+	if (!memory_fits(pop)) {
+		init_memory(pop);
+	}
+	sample(pop);
+	const problem::base::size_type N = pop.problem().get_dimension();
+	std::vector<decision_vector> retval(pop.size(),decision_vector(N));
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		for (decision_vector::size_type j = 0; j < N; ++j) {
+			retval[i][j] = m_newpop[i](j);
 		}
+	}
+	return retval;
+}
 
-	// Update algorithm memory
-	if (m_memory) {
-		m_mean = mean;
-		m_variation = variation;
-		m_newpop = newpop;
-		m_B = B;
-		m_D = D;
-		m_C = C;
-		m_invsqrtC = invsqrtC;
-		m_pc = pc;
-		m_ps = ps;
-		m_counteval = counteval;
-		m_eigeneval = eigeneval;
-		m_sigma = sigma;
+/// Tell the fitnesses of the CMAES samples.
+/**
+ * The samples replace the individuals of pop and the search distribution is adapted to their elite.
+ *
+ * @param[in,out] pop population the samples were asked from.
+ * @param[in] x the samples returned by ask().
+ * @param[in] f the fitnesses of the samples.
+ * @throws value_error if x and f do not contain one element per individual, or no ask() preceded the call.
+ */
+void cmaes::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	check_told(pop,x,f,pop.size());
+	if (!memory_fits(pop)) {
+		pagmo_throw(value_error,"tell() must follow an ask() on a population of the same size");
 	}
-		
-	} // end loop on g
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		pop.set_xf(i,x[i],f[i]);
+	}
+	adapt(pop);
 }
 
 /// Setter for m_gen 
@@ -26,6 +26,7 @@
 #define PAGMO_ALGORITHM_CMAES_H
 
 #include <string>
+#include <vector>
 
 
 #include "../config.h"
@@ -51,6 +52,8 @@ public:
 	cmaes(int gen = 500, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0=0.5, double ftol = 1e-6, double xtol = 1e-6, bool memory = true);
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 
 	// Setters and Getters (needed for all if we fine control the iterations .... )
@@ -81,6 +84,12 @@ public:
 protected:
 	std::string human_readable_extra() const;
 private:
+	void check_suitability(const population &) const;
+	void init_memory(const population &) const;
+	bool memory_fits(const population &) const;
+	double sample(const population &) const;
+	void adapt(const population &) const;
+
 	friend class boost::serialization::access;
 		template <class Archive>
 	void serialize(Archive &ar, const unsigned int)
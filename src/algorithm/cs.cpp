@@ -149,7 +149,7 @@ void cs::evolve(population &pop) const
 		}
 	} //end while
 	std::transform(x.begin(), x.end(), pop.get_individual(bestidx).cur_x.begin(), newx.begin(),std::minus<double>()); // newx is now velocity
-	pop.set_x(bestidx,x); //new evaluation is possible here......
+	pop.set_xf(bestidx,x,f); //fitness already known, no new evaluation
 	pop.set_v(bestidx,newx);
 }
 
@@ -22,8 +22,6 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
 #include <string>
 #include <vector>
 
@@ -32,6 +30,7 @@
 #include "../types.h"
 #include "base.h"
 #include "de.h"
+#include "de_kernels.h"
 
 namespace pagmo { namespace algorithm {
 
@@ -125,169 +124,29 @@ void de::evolve(population &pop) const
 	// container for the best decision vector of generation
 	gbIter = gbX;
 
+	// The strategy kernel is resolved once, the index sampler and the crossover mask are reused for all trials.
+	const de_kernels::trial_function<rng_double>::type trial = de_kernels::select_strategy<rng_double>(m_strategy);
+	de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5;	//indexes to the selected population members
+	size_t r[5];	//indexes to the selected population members
+	const double *rx[de_kernels::max_random];
 	for (int gen = 0; gen < m_gen; ++gen) {
 		//Start of the loop through the deme
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-
-
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (m_strategy == 1) { /* strategy DE0 (not in our paper) */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (m_strategy == 2) { /* strategy DE1 in the techreport */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and m_cr=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (m_strategy == 3) { /* similiar to DE2 but generally better */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (m_strategy == 4) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (m_strategy == 5) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 6) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (m_strategy == 7) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (m_strategy == 8) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 9) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 10) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
+			/* Pick five distinct random population members, all different from i */
+			sampler.draw(i,5,r,m_urng);
+			for (size_t k = 0; k < 5; ++k) {
+				rx[k] = &popold[r[k]][0];
 			}
 
+			/*=======Build the trial vector in tmp[] (see de_kernels.h for the strategies)================================*/
+			trial(tmp,popold[i],gbIter,rx,m_f,m_cr,Dc,de_kernels::uniform_index(m_urng,Dc),m_drng,mask);
 
 			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
 			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = boost::uniform_real<double>(lb[i2],ub[i2])(m_drng);
-				++i2;
-			}
+			de_kernels::resample_out_of_bounds(tmp,lb,ub,Dc,m_drng);
 
 			//b) how good?
 			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
@@ -297,8 +156,8 @@ void de::evolve(population &pop) const
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
 				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				//updates x and v (the fitness is already known, no re-evaluation is needed)
+				pop.set_xf(i,popnew[i],newfitness);
 				pop.set_v(i,tmp);
 				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
 					/* if so...*/
@@ -360,6 +219,79 @@ void de::evolve(population &pop) const
 
 }
 
+/// Ask for one generation of DE trial vectors.
+/**
+ * Builds one trial vector per individual of pop, exactly as one generation of evolve() would, using the
+ * population best as best individual. The i-th trial is meant to compete with the i-th individual in tell().
+ *
+ * @param[in] pop population the trial vectors are built from.
+ *
+ * @return the NP trial vectors.
+ * @throws value_error if the problem/population are not suitable for DE (see evolve())
+ */
+std::vector<decision_vector> de::ask(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type NP = pop.size();
+
+	if ( Dc == 0 ) {
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for DE to optimise");
+	}
+	if ( prob.get_c_dimension() != 0 ) {
+		pagmo_throw(value_error,"The problem is not box constrained and DE is not suitable to solve it");
+	}
+	if ( prob.get_f_dimension() != 1 ) {
+		pagmo_throw(value_error,"The problem is not single objective and DE is not suitable to solve it");
+	}
+	if (NP < 6) {
+		pagmo_throw(value_error,"for DE at least 6 individuals in the population are needed");
+	}
+
+	const de_kernels::trial_function<rng_double>::type trial = de_kernels::select_strategy<rng_double>(m_strategy);
+	de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+	const decision_vector &best = pop.champion().x;
+	std::vector<decision_vector> retval(NP,decision_vector(D));
+
+	size_t r[5];
+	const double *rx[de_kernels::max_random];
+	for (size_t i = 0; i < NP; ++i) {
+		sampler.draw(i,5,r,m_urng);
+		for (size_t k = 0; k < 5; ++k) {
+			rx[k] = &pop.get_individual(r[k]).cur_x[0];
+		}
+		trial(retval[i],pop.get_individual(i).cur_x,best,rx,m_f,m_cr,Dc,de_kernels::uniform_index(m_urng,Dc),m_drng,mask);
+		de_kernels::resample_out_of_bounds(retval[i],lb,ub,Dc,m_drng);
+	}
+	return retval;
+}
+
+/// Tell the fitnesses of the DE trial vectors.
+/**
+ * Each trial vector replaces the corresponding individual if its fitness is better, updating its velocity as evolve() does.
+ *
+ * @param[in,out] pop population the trial vectors were asked from.
+ * @param[in] x the trial vectors returned by ask().
+ * @param[in] f the fitnesses of the trial vectors.
+ * @throws value_error if x and f do not contain one element per individual.
+ */
+void de::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	check_told(pop,x,f,pop.size());
+	decision_vector v;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		// Same selection rule as evolve(): the trial replaces the target only if strictly better.
+		if (pop.problem().compare_fitness(f[i],pop.get_individual(i).cur_f)) {
+			v = x[i];
+			std::transform(v.begin(), v.end(), pop.get_individual(i).cur_x.begin(), v.begin(),std::minus<double>());
+			pop.set_xf(i,x[i],f[i]);
+			pop.set_v(i,v);
+		}
+	}
+}
+
 /// Algorithm name
 std::string de::get_name() const
 {
@@ -73,6 +73,8 @@ public:
 	de(int = 100, double  = 0.8, double = 0.9, int = 2, double = 1e-6, double = 1e-6);
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 	void set_cr(double cr);
 	double get_cr() const;
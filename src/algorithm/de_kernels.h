@@ -0,0 +1,403 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_ALGORITHM_DE_KERNELS_H
+#define PAGMO_ALGORITHM_DE_KERNELS_H
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Building blocks shared by the Differential Evolution family.
+/**
+ * The DE variants (pagmo::algorithm::de, pagmo::algorithm::jde, pagmo::algorithm::de_1220 and,
+ * partially, pagmo::algorithm::mde_pbx) all build a trial vector out of a handful of distinct random
+ * population members, a mutation formula and a crossover scheme. In this namespace each mutation formula
+ * and each crossover is a small policy class and a complete strategy is the compile-time combination
+ * of the two. Algorithms resolve the strategy index into a function pointer once per evolve() call
+ * (see de_kernels::select_strategy()), so that the inner loop is free from branching on the variant.
+ *
+ * Trial generation does not allocate: random members are drawn with a partial Fisher-Yates shuffle
+ * over a reusable index buffer (de_kernels::index_sampler) and the binomial crossover
+ * first draws its mask and then blends donor and target in a single branch-free loop the compiler
+ * is able to vectorise.
+ *
+ * The random number streams are not consumed as in the original scalar implementation, which drew each member
+ * with boost::uniform_int and retried on collisions: seeded runs of de, jde, de_1220 and mde_pbx give different
+ * results than before the kernels were introduced.
+ */
+namespace de_kernels {
+
+/// Uniform integer in [0,n).
+/**
+ * Multiply-shift mapping of a 32 bits engine output with rejection of the (rare) biased draws. Contrary to
+ * boost::uniform_int it does not need a distribution object and it never performs a division in the common case.
+ *
+ * @param[in] urng 32 bits unsigned integer engine (typically pagmo::rng_uint32).
+ * @param[in] n size of the range, must be in [1,2^32).
+ *
+ * @return a uniformly distributed index in [0,n).
+ */
+template <class Urng>
+inline std::size_t uniform_index(Urng &urng, std::size_t n)
+{
+	const boost::uint32_t range = static_cast<boost::uint32_t>(n);
+	boost::uint64_t m = static_cast<boost::uint64_t>(static_cast<boost::uint32_t>(urng())) * range;
+	boost::uint32_t low = static_cast<boost::uint32_t>(m);
+	if (low < range) {
+		const boost::uint32_t threshold = static_cast<boost::uint32_t>(-range) % range;
+		while (low < threshold) {
+			m = static_cast<boost::uint64_t>(static_cast<boost::uint32_t>(urng())) * range;
+			low = static_cast<boost::uint32_t>(m);
+		}
+	}
+	return static_cast<std::size_t>(m >> 32);
+}
+
+/// Sampler of distinct population indices.
+/**
+ * Keeps a permutation of [0,NP) together with its inverse. Drawing k indices different from a given one
+ * moves the excluded index out of the sampling range and performs k steps of a Fisher-Yates shuffle.
+ * The buffer is never reset, as any permutation is a valid starting point for the next draw, so that
+ * each call costs O(k) irrespective of the population size.
+ */
+class index_sampler
+{
+	public:
+		/// Constructor from population size.
+		explicit index_sampler(std::size_t np):m_idx(np),m_pos(np)
+		{
+			for (std::size_t j = 0; j < np; ++j) {
+				m_idx[j] = j;
+				m_pos[j] = j;
+			}
+		}
+		/// Draw k distinct indices all different from i.
+		/**
+		 * @param[in] i index to exclude.
+		 * @param[in] k number of indices to draw, must be smaller than the population size.
+		 * @param[out] r array of at least k elements receiving the indices.
+		 * @param[in] urng 32 bits unsigned integer engine.
+		 */
+		template <class Urng>
+		void draw(std::size_t i, std::size_t k, std::size_t *r, Urng &urng)
+		{
+			const std::size_t last = m_idx.size() - 1;
+			swap_at(m_pos[i], last);
+			for (std::size_t j = 0; j < k; ++j) {
+				swap_at(j, j + uniform_index(urng, last - j));
+				r[j] = m_idx[j];
+			}
+		}
+		/// Population size the sampler was built for.
+		std::size_t size() const
+		{
+			return m_idx.size();
+		}
+	private:
+		void swap_at(std::size_t a, std::size_t b)
+		{
+			std::swap(m_idx[a], m_idx[b]);
+			m_pos[m_idx[a]] = a;
+			m_pos[m_idx[b]] = b;
+		}
+		std::vector<std::size_t> m_idx;
+		std::vector<std::size_t> m_pos;
+};
+
+/// Maximum number of random members used by any strategy.
+static const std::size_t max_random = 7;
+
+/// Mutation DE/best/1: best + F (r2 - r3).
+struct best_1 {
+	static double donor(std::size_t n, const double *, const double *best, const double *const *r, double F)
+	{
+		return best[n] + F * (r[1][n] - r[2][n]);
+	}
+};
+
+/// Mutation DE/rand/1: r1 + F (r2 - r3).
+struct rand_1 {
+	static double donor(std::size_t n, const double *, const double *, const double *const *r, double F)
+	{
+		return r[0][n] + F * (r[1][n] - r[2][n]);
+	}
+};
+
+/// Mutation DE/rand-to-best/1: x + F (best - x) + F (r1 - r2).
+struct rand_to_best_1 {
+	static double donor(std::size_t n, const double *x, const double *best, const double *const *r, double F)
+	{
+		return x[n] + F * (best[n] - x[n]) + F * (r[0][n] - r[1][n]);
+	}
+};
+
+/// Mutation DE/best/2: best + F (r1 + r2 - r3 - r4).
+struct best_2 {
+	static double donor(std::size_t n, const double *, const double *best, const double *const *r, double F)
+	{
+		return best[n] + (r[0][n] + r[1][n] - r[2][n] - r[3][n]) * F;
+	}
+};
+
+/// Mutation DE/rand/2: r5 + F (r1 + r2 - r3 - r4).
+struct rand_2 {
+	static double donor(std::size_t n, const double *, const double *, const double *const *r, double F)
+	{
+		return r[4][n] + (r[0][n] + r[1][n] - r[2][n] - r[3][n]) * F;
+	}
+};
+
+/// Mutation DE/best/3: best + F (r1 - r2) + F (r3 - r4) + F (r5 - r6).
+struct best_3 {
+	static double donor(std::size_t n, const double *, const double *best, const double *const *r, double F)
+	{
+		return best[n] + F * (r[0][n] - r[1][n]) + F * (r[2][n] - r[3][n]) + F * (r[4][n] - r[5][n]);
+	}
+};
+
+/// Mutation DE/rand/3: r7 + F (r1 - r2) + F (r3 - r4) + F (r5 - r6).
+struct rand_3 {
+	static double donor(std::size_t n, const double *, const double *, const double *const *r, double F)
+	{
+		return r[6][n] + F * (r[0][n] - r[1][n]) + F * (r[2][n] - r[3][n]) + F * (r[4][n] - r[5][n]);
+	}
+};
+
+/// Mutation DE/rand-to-current/2: r7 + F (r1 - x) + F (r3 - r4).
+struct rand_to_current_2 {
+	static double donor(std::size_t n, const double *x, const double *, const double *const *r, double F)
+	{
+		return r[6][n] + F * (r[0][n] - x[n]) + F * (r[2][n] - r[3][n]);
+	}
+};
+
+/// Mutation DE/rand-to-best-and-current/2: r7 + F (r1 - x) + F (best - r4).
+struct rand_to_best_and_current_2 {
+	static double donor(std::size_t n, const double *x, const double *best, const double *const *r, double F)
+	{
+		return r[6][n] + F * (r[0][n] - x[n]) + F * (best[n] - r[3][n]);
+	}
+};
+
+/// Exponential crossover.
+/**
+ * Starting from component n, a run of consecutive components (wrapping around Dc) is taken from the donor.
+ * The run length is drawn first, then the donor is written in at most two contiguous, vectorisable, segments.
+ */
+struct exponential {
+	template <class Mutation, class Drng>
+	static void apply(double *tmp, const double *x, const double *best, const double *const *r, double F, double CR,
+		std::size_t Dc, std::size_t n, Drng &drng, std::vector<char> &)
+	{
+		std::size_t L = 1;
+		while ((drng() < CR) && (L < Dc)) {
+			++L;
+		}
+		const std::size_t end = std::min(n + L, Dc);
+		for (std::size_t j = n; j < end; ++j) {
+			tmp[j] = Mutation::donor(j, x, best, r, F);
+		}
+		for (std::size_t j = 0; j < n + L - end; ++j) {
+			tmp[j] = Mutation::donor(j, x, best, r, F);
+		}
+	}
+};
+
+/// Binomial crossover.
+/**
+ * Each component is taken from the donor with probability CR, component (n + Dc - 1) % Dc always is.
+ * The mask is drawn first, then donor and target are blended without branches.
+ */
+struct binomial {
+	template <class Mutation, class Drng>
+	static void apply(double *tmp, const double *x, const double *best, const double *const *r, double F, double CR,
+		std::size_t Dc, std::size_t n, Drng &drng, std::vector<char> &mask)
+	{
+		for (std::size_t L = 0; L < Dc; ++L) {
+			mask[n] = (drng() < CR);
+			n = (n + 1 == Dc) ? 0 : n + 1;
+		}
+		mask[(n + Dc - 1) % Dc] = 1;
+		for (std::size_t j = 0; j < Dc; ++j) {
+			const double d = Mutation::donor(j, x, best, r, F);
+			tmp[j] = mask[j] ? d : x[j];
+		}
+	}
+};
+
+/// A complete DE strategy: mutation and crossover bound at compile time.
+template <class Mutation, class Crossover>
+struct strategy {
+	/// Build the trial vector.
+	/**
+	 * @param[out] tmp trial vector, the first Dc components are written, the others are copied from x.
+	 * @param[in] x target vector.
+	 * @param[in] best best vector of the previous generation.
+	 * @param[in] r pointers to the (distinct) random members, at least max_random of them for the /3 and /2-current strategies.
+	 * @param[in] F weight coefficient.
+	 * @param[in] CR crossover probability.
+	 * @param[in] Dc dimension of the continuous part.
+	 * @param[in] n starting component of the crossover.
+	 * @param[in] drng functor returning doubles in [0,1).
+	 * @param[in] mask scratch buffer of at least Dc elements.
+	 */
+	template <class Drng>
+	static void trial(decision_vector &tmp, const decision_vector &x, const decision_vector &best, const double *const *r,
+		double F, double CR, std::size_t Dc, std::size_t n, Drng &drng, std::vector<char> &mask)
+	{
+		std::copy(x.begin(), x.end(), tmp.begin());
+		Crossover::template apply<Mutation>(&tmp[0], &x[0], &best[0], r, F, CR, Dc, n, drng, mask);
+	}
+};
+
+/// Function pointer type of a strategy using the random stream Drng.
+template <class Drng>
+struct trial_function {
+	typedef void (*type)(decision_vector &, const decision_vector &, const decision_vector &, const double *const *,
+		double, double, std::size_t, std::size_t, Drng &, std::vector<char> &);
+};
+
+/// Resolve a strategy index into its kernel.
+/**
+ * Strategy indices follow the numbering of pagmo::algorithm::jde: 1 ... 5 and 11, 13, 15, 17 use exponential crossover,
+ * 6 ... 10 and 12, 14, 16, 18 their binomial counterparts.
+ *
+ * @param[in] variant strategy index in 1 ... 18.
+ *
+ * @return pointer to the strategy kernel.
+ *
+ * @throws value_error if variant is not in 1 ... 18.
+ */
+template <class Drng>
+inline typename trial_function<Drng>::type select_strategy(int variant)
+{
+	switch (variant) {
+		case 1: return &strategy<best_1,exponential>::template trial<Drng>;
+		case 2: return &strategy<rand_1,exponential>::template trial<Drng>;
+		case 3: return &strategy<rand_to_best_1,exponential>::template trial<Drng>;
+		case 4: return &strategy<best_2,exponential>::template trial<Drng>;
+		case 5: return &strategy<rand_2,exponential>::template trial<Drng>;
+		case 6: return &strategy<best_1,binomial>::template trial<Drng>;
+		case 7: return &strategy<rand_1,binomial>::template trial<Drng>;
+		case 8: return &strategy<rand_to_best_1,binomial>::template trial<Drng>;
+		case 9: return &strategy<best_2,binomial>::template trial<Drng>;
+		case 10: return &strategy<rand_2,binomial>::template trial<Drng>;
+		case 11: return &strategy<best_3,exponential>::template trial<Drng>;
+		case 12: return &strategy<best_3,binomial>::template trial<Drng>;
+		case 13: return &strategy<rand_3,exponential>::template trial<Drng>;
+		case 14: return &strategy<rand_3,binomial>::template trial<Drng>;
+		case 15: return &strategy<rand_to_current_2,exponential>::template trial<Drng>;
+		case 16: return &strategy<rand_to_current_2,binomial>::template trial<Drng>;
+		case 17: return &strategy<rand_to_best_and_current_2,exponential>::template trial<Drng>;
+		case 18: return &strategy<rand_to_best_and_current_2,binomial>::template trial<Drng>;
+	}
+	pagmo_throw(value_error,"strategy index must be one of 1 ... 18");
+}
+
+/// Self-adaptation of F or CR by differential perturbation (jDE/DE_1220 m_variant_adptv = 2).
+/**
+ * The adapted value is built out of the values associated to the same members used by the mutation of
+ * the given strategy, so that the parameters evolve alongside the chromosomes.
+ *
+ * @param[in] variant strategy index in 1 ... 18.
+ * @param[in] p current values of the parameter, one per individual.
+ * @param[in] best value of the parameter associated to the best individual.
+ * @param[in] i index of the target individual.
+ * @param[in] r indices of the random members.
+ * @param[in] n_dist functor returning standard normal deviates.
+ *
+ * @return the perturbed parameter.
+ */
+template <class Ndist>
+inline double adapt_parameter(int variant, const std::vector<double> &p, double best, std::size_t i, const std::size_t *r, Ndist &n_dist)
+{
+	double retval = 0;
+	switch (variant) {
+		case 1: case 6:
+			retval = best + n_dist() * 0.5 * (p[r[1]] - p[r[2]]);
+			break;
+		case 2: case 7:
+			retval = p[r[0]] + n_dist() * 0.5 * (p[r[1]] - p[r[2]]);
+			break;
+		case 3: case 8:
+			retval = p[i] + n_dist() * 0.5 * (best - p[i]);
+			retval += n_dist() * 0.5 * (p[r[0]] - p[r[1]]);
+			break;
+		case 4: case 9:
+			retval = best + n_dist() * 0.5 * (p[r[0]] - p[r[2]]);
+			retval += n_dist() * 0.5 * (p[r[1]] - p[r[3]]);
+			break;
+		case 5: case 10:
+			retval = p[r[4]] + n_dist() * 0.5 * (p[r[0]] - p[r[2]]);
+			retval += n_dist() * 0.5 * (p[r[1]] - p[r[3]]);
+			break;
+		case 11: case 12:
+			retval = best + n_dist() * 0.5 * (p[r[0]] - p[r[1]]);
+			retval += n_dist() * 0.5 * (p[r[2]] - p[r[3]]);
+			retval += n_dist() * 0.5 * (p[r[4]] - p[r[5]]);
+			break;
+		case 13: case 14:
+			retval = p[r[6]] + n_dist() * 0.5 * (p[r[0]] - p[r[1]]);
+			retval += n_dist() * 0.5 * (p[r[2]] - p[r[3]]);
+			retval += n_dist() * 0.5 * (p[r[4]] - p[r[5]]);
+			break;
+		case 15: case 16:
+			retval = p[r[6]] + n_dist() * 0.5 * (p[r[0]] - p[i]);
+			retval += n_dist() * 0.5 * (p[r[2]] - p[r[3]]);
+			retval += n_dist() * 0.5 * (p[r[4]] - p[r[5]]);
+			break;
+		case 17: case 18:
+			retval = p[r[6]] + n_dist() * 0.5 * (p[r[0]] - p[i]);
+			retval += n_dist() * 0.5 * (best - p[r[3]]);
+			break;
+		default:
+			pagmo_throw(value_error,"strategy index must be one of 1 ... 18");
+	}
+	return retval;
+}
+
+/// Force the continuous part of a trial vector back in the box.
+/**
+ * Out of bounds components are resampled uniformly within the bounds.
+ */
+template <class Drng>
+inline void resample_out_of_bounds(decision_vector &tmp, const decision_vector &lb, const decision_vector &ub, std::size_t Dc, Drng &drng)
+{
+	for (std::size_t j = 0; j < Dc; ++j) {
+		if ((tmp[j] < lb[j]) || (tmp[j] > ub[j])) {
+			tmp[j] = drng() * (ub[j] - lb[j]) + lb[j];
+		}
+	}
+}
+
+}}}
+
+#endif
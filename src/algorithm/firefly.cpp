@@ -181,8 +181,8 @@ void firefly::evolve(population &pop) const
 
 				prob.objfun(test_fit, X[ii]);
 				if(moveIItoJJ || prob.compare_fitness(test_fit, fit[ii])) { // only if moving ii towards jj or if new location has better fitness, update population and fitness
-					pop.set_x(ii, X[ii]);
-                                        fit[ii] = test_fit;
+					pop.set_xf(ii, X[ii], test_fit);
+					fit[ii] = test_fit;
 				}
 				else {
 					X[ii] = X_start;
@@ -33,6 +33,7 @@
 #include "../serialization.h"
 #include "../population.h"
 #include "../problem/base_tsp.h"
+#include "../problem/tsp.h"
 #include "../algorithm/nn_tsp.h"
 #include "base.h"
 #include "inverover.h"
@@ -45,9 +46,11 @@ namespace pagmo { namespace algorithm {
  *
  * @param[in] gen Number of generations to evolve.
  * @param[in] ri Probability of performing a random invert (mutation probability)
+ * @param[in] ini_type Method used to initialize the infeasible individuals
+ * @param[in] n_neighbours Number of nearest cities used by random inversions and by the final local search (0 to disable both)
 */
-inverover::inverover(int gen, double ri, initialization_type ini_type)
-	:base(),m_gen(gen),m_ri(ri),m_ini_type(ini_type)
+inverover::inverover(int gen, double ri, initialization_type ini_type, int n_neighbours)
+	:base(),m_gen(gen),m_ri(ri),m_ini_type(ini_type),m_n_neighbours(n_neighbours)
 {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
@@ -55,6 +58,9 @@ inverover::inverover(int gen, double ri, initialization_type ini_type)
 	if (ri > 1 || ri < 0) {
 		pagmo_throw(value_error,"random invert probability must be in the [0,1] range");
 	}
+	if (n_neighbours < 0) {
+		pagmo_throw(value_error,"number of neighbours must be nonnegative");
+	}
 }
 
 
@@ -83,6 +89,10 @@ void inverover::evolve(population &pop) const
 		pagmo_throw(value_error,"Problem not of type pagmo::problem::base_tsp");
 	}
 
+	// For the plain TSP the objective function is the tour length, whose change under an inversion
+	// can be computed incrementally (see problem::base_tsp::inversion_delta).
+	const bool incremental = (dynamic_cast<const problem::tsp *>(prob) != 0);
+
 	// Let's store some useful variables.
 	const population::size_type NP = pop.size();
 	const problem::base::size_type Nv = prob->get_n_cities();
@@ -97,6 +107,13 @@ void inverover::evolve(population &pop) const
 	boost::uniform_int<int> Nvless1(0, Nv - 2);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > unif_Nvless1(m_urng, Nvless1);
 
+	// Candidate lists for the random inversions
+	const std::vector<unsigned int> no_neighbours;
+	const std::vector<unsigned int> &neighbours = (m_n_neighbours > 0) ? prob->neighbour_lists(m_n_neighbours) : no_neighbours;
+	const size_t k = neighbours.size() / Nv;
+	boost::uniform_int<int> k_(0, std::max<int>(k, 1) - 1);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > unif_k(m_urng, k_);
+
 	//create own local population
 	std::vector<decision_vector> my_pop(NP, decision_vector(Nv));
 
@@ -186,9 +203,13 @@ void inverover::evolve(population &pop) const
 
 	std::vector<fitness_vector>  fitness(NP, fitness_vector(1));
 	for(size_t i=0; i < NP; i++){
+		if (incremental) {
+			fitness[i][0] = prob->tour_length(my_pop[i]);
+			continue;
+		}
 		switch( prob->get_encoding() ) {
 			case problem::base_tsp::FULL:
-				fitness[i] = prob->objfun(prob->full2cities(my_pop[i]));
+				fitness[i] = prob->objfun(prob->cities2full(my_pop[i]));
 				break;
 			case problem::base_tsp::RANDOMKEYS:
 				fitness[i] = prob->objfun(prob->cities2randomkeys(my_pop[i], pop.get_individual(i).cur_x));
@@ -204,6 +225,7 @@ void inverover::evolve(population &pop) const
 	bool stop, changed;
 	size_t rnd_num, i2, pos1_c1, pos1_c2, pos2_c1, pos2_c2; //pos2_c1 denotes the position of city1 in parent2
 	fitness_vector fitness_tmp;
+	double delta;
 
 	//InverOver main loop
 	for(int iter = 0; iter < m_gen; iter++) {
@@ -212,10 +234,16 @@ void inverover::evolve(population &pop) const
 			pos1_c1 = unif_Nv();
 			stop = false;
 			changed = false;
+			delta = 0;
 			while(!stop){
 				if(unif_01() < m_ri) {
-					rnd_num = unif_Nvless1();
-					pos1_c2 = (rnd_num == pos1_c1? Nv-1:rnd_num);
+					if(k > 0) {
+						const double c2 = neighbours[static_cast<size_t>(tmp_tour[pos1_c1]) * k + unif_k()];
+						pos1_c2 = std::find(tmp_tour.begin(),tmp_tour.end(),c2)-tmp_tour.begin();
+					} else {
+						rnd_num = unif_Nvless1();
+						pos1_c2 = (rnd_num == pos1_c1? Nv-1:rnd_num);
+					}
 				} else {
 					i2 = unif_NPless1();
 					i2 = (i2 == i1? NP-1:i2);
@@ -223,16 +251,23 @@ void inverover::evolve(population &pop) const
 					pos2_c2 = (pos2_c1 == Nv-1? 0:pos2_c1+1);
 					pos1_c2 = std::find(tmp_tour.begin(),tmp_tour.end(),my_pop[i2][pos2_c2])-tmp_tour.begin();
 				}
-				stop = (abs(pos1_c1-pos1_c2)==1 || static_cast<problem::base::size_type>(abs(pos1_c1-pos1_c2))==Nv-1);
+				size_t dist_c1_c2 = (pos1_c1 > pos1_c2 ? pos1_c1-pos1_c2 : pos1_c2-pos1_c1);
+				stop = (dist_c1_c2==1 || dist_c1_c2==Nv-1);
 				if(!stop) {
 					changed = true;
 					if(pos1_c1<pos1_c2) {
+						if (incremental) {
+							delta += prob->inversion_delta(tmp_tour,pos1_c1+1,pos1_c2);
+						}
 						for(size_t l=0; l < (double (pos1_c2-pos1_c1-1)/2); l++) {
 							std::swap(tmp_tour[pos1_c1+1+l],tmp_tour[pos1_c2-l]);
 						}
 						pos1_c1 = pos1_c2;
 					} else {
 						//inverts the section from c1 to c2 (see documentation Note3)
+						if (incremental) {
+							delta += prob->inversion_delta(tmp_tour,pos1_c2,pos1_c1-1);
+						}
 						for(size_t l=0; l < (double (pos1_c1-pos1_c2-1)/2); l++) {
 							std::swap(tmp_tour[pos1_c2+l],tmp_tour[pos1_c1-l-1]);
 						}
@@ -241,10 +276,15 @@ void inverover::evolve(population &pop) const
 					
 				}
 			} //end of while loop (looping over a single indvidual)
-			if(changed) {
+			if(changed && incremental) {
+				if(delta < 0) { //replace individual?
+					my_pop[i1] = tmp_tour;
+					fitness[i1][0] += delta;
+				}
+			} else if(changed) {
 				switch(prob->get_encoding()) {
 					case problem::base_tsp::FULL:
-						fitness_tmp = prob->objfun(prob->full2cities(tmp_tour));
+						fitness_tmp = prob->objfun(prob->cities2full(tmp_tour));
 						break;
 					case problem::base_tsp::RANDOMKEYS: //using "randomly" index 0 as a temporary template
 						fitness_tmp = prob->objfun(prob->cities2randomkeys(tmp_tour, pop.get_individual(0).cur_x));
@@ -261,6 +301,13 @@ void inverover::evolve(population &pop) const
 		} // end of loop over population
 	} // end of loop over generations
 
+	//polish the final tours
+	if (incremental && k > 0) {
+		for (size_t ii = 0; ii < NP; ii++) {
+			prob->local_search(my_pop[ii],k);
+		}
+	}
+
 	//change representation of tour
 	for (size_t ii = 0; ii < NP; ii++) {
 		switch(prob->get_encoding()) {
@@ -294,7 +341,8 @@ std::string inverover::human_readable_extra() const
 	s << "generations: " << m_gen << " ";
 	s << "mutation probability: " << m_ri << " ";
 	std::string ini_str = (m_ini_type==0) ? ("Random") : ("Nearest Neighbour");
-	s << "initialization method: " << ini_str;
+	s << "initialization method: " << ini_str << " ";
+	s << "neighbours: " << m_n_neighbours;
 	return s.str();
 }
 
@@ -50,6 +50,13 @@ namespace pagmo { namespace algorithm {
  * chosen as in the original paper (city1 -> city2). Some papers invert the complementary part of the tour
  * (city2 -> city1).
  *
+ * Note4: When solving a pagmo::problem::tsp the tour lengths are updated incrementally after each inversion
+ * (see pagmo::problem::base_tsp::inversion_delta) and the objective function is only called when writing back the population.
+ *
+ * Note5: If a number of neighbours is given, random inversions connect a city to one of its nearest cities
+ * (see pagmo::problem::base_tsp::neighbour_lists) rather than to any city, and when solving a pagmo::problem::tsp the
+ * final tours are further improved by pagmo::problem::base_tsp::local_search.
+ *
  * @author Ingmar Getzner (ingmar.getzner@gmail.com)
  */
 class __PAGMO_VISIBLE inverover: public base
@@ -60,7 +67,7 @@ public:
 		random = 0, // The initial population is randomly sampled from possible permutations
 		nn = 1 // The initial population is generated by pagmo::algorithm::nn_tsp (i.e. a nearest neighbours)
 	};
-	inverover(int gen = 10000, double ri = 0.05, initialization_type ini_type = random);
+	inverover(int gen = 10000, double ri = 0.05, initialization_type ini_type = random, int n_neighbours = 0);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -77,6 +84,7 @@ private:
 		ar & const_cast<int &>(m_gen);
 		ar & const_cast<double &>(m_ri);
 		ar & m_ini_type;
+		ar & const_cast<int &>(m_n_neighbours);
 	}
 	//Number of generations
 	const int m_gen;
@@ -84,6 +92,8 @@ private:
 	const double m_ri;
 	//Method for initialization
 	initialization_type m_ini_type;
+	//Number of nearest cities used for random inversions and local search (0 to disable)
+	const int m_n_neighbours;
 };
 
 }} //namespaces
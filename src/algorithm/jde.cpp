@@ -22,7 +22,6 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -34,6 +33,7 @@
 #include "../types.h"
 #include "base.h"
 #include "jde.h"
+#include "de_kernels.h"
 
 namespace pagmo { namespace algorithm {
 
@@ -133,34 +133,23 @@ void jde::evolve(population &pop) const
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > n_dist(m_drng,normal);
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
-	boost::uniform_int<int> r_p_idx(0,NP-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,r_p_idx);
-	boost::uniform_int<int> r_c_idx(0,Dc-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > c_idx(m_urng,r_c_idx);
 
 	
 	// Initialize the F and CR vectors
-	if ( (m_cr.size() != NP) || (m_f.size() != NP) || (!m_memory) ) {
-		m_cr.resize(NP); m_f.resize(NP);
-		if (m_variant_adptv==1) {
-			for (size_t i = 0; i < NP; ++i) {
-				m_cr[i] = r_dist();
-				m_f[i]  = r_dist() * 0.9 + 0.1;
-			}
-		}
-		else if (m_variant_adptv==2) {
-			for (size_t i = 0; i < NP; ++i) {
-				m_cr[i] = n_dist() * 0.15 + 0.5;
-				m_f[i]  = n_dist() * 0.15 + 0.5;
-			}
-		}
-	}
+	init_parameters(NP);
 	// We initialize the global best for F and CR as the first individual (this will soon be forgotten)
 	double gbIterF = m_f[0];
 	double gbIterCR = m_cr[0];
 
+	// The strategy kernel is resolved once, the index sampler and the crossover mask are reused for all trials.
+	typedef boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist_type;
+	const de_kernels::trial_function<r_dist_type>::type trial = de_kernels::select_strategy<r_dist_type>(m_variant);
+	de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5,r6,r7;	//indexes to the selected population members
+	size_t r[de_kernels::max_random];	//indexes to the selected population members
+	const double *rx[de_kernels::max_random];
 	for (int gen = 0; gen < m_gen; ++gen) {
 		//0 - Check the exit conditions (every 10 generations)
 		if (gen % 5 == 0) {
@@ -189,38 +178,11 @@ void jde::evolve(population &pop) const
 
 		//Start of the loop through the deme
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = p_idx();
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = p_idx();
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = p_idx();
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 7 !!!     */
-				r6 = p_idx();
-			} while ((r6==i) || (r6==r1) || (r6==r2) || (r6==r3) || (r6==r4) || (r6==r5));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 8 !!!     */
-				r7 = p_idx();
-			} while ((r7==i) || (r7==r1) || (r7==r2) || (r7==r3) || (r7==r4) || (r7==r5) || (r7==r6));
+			/* Pick seven distinct random population members, all different from i */
+			sampler.draw(i,de_kernels::max_random,r,m_urng);
+			for (size_t k = 0; k < de_kernels::max_random; ++k) {
+				rx[k] = &popold[r[k]][0];
+			}
 
 			// Adapt amplification factor and crossover probability
 			double F=0, CR=0;
@@ -229,294 +191,17 @@ void jde::evolve(population &pop) const
 				CR = (r_dist() < 0.9) ? m_cr[i] : r_dist();
 			}
 					
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (m_variant == 1) { /* strategy DE0 (not in our paper) */
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (m_variant == 2) { /* strategy DE1 in the techreport */
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and c=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (m_variant == 3) { /* similiar to DE2 but generally better */
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (m_variant == 4) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
+			if (m_variant_adptv==2) {
+				F =  de_kernels::adapt_parameter(m_variant,m_f,gbIterF,i,r,n_dist);
+				CR = de_kernels::adapt_parameter(m_variant,m_cr,gbIterCR,i,r,n_dist);
 			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (m_variant == 5) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
 
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (m_variant == 6) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (m_variant == 7) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (m_variant == 8) {
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (m_variant == 9) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (m_variant == 10) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-
-			/*-------DE/best/3/exp--------------------------------------------------------------------*/
-			if (m_variant == 11) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/3/bin--------------------------------------------------------------------*/
-			else if (m_variant == 12) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/3/exp--------------------------------------------------------------------*/
-			if (m_variant == 13) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand/3/bin--------------------------------------------------------------------*/
-			else if (m_variant == 14) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-current/2/exp---------------------------------------------------------*/
-			if (m_variant == 15) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-current/2/bin---------------------------------------------------------*/
-			else if (m_variant == 16) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best-and-current/2/exp------------------------------------------------*/
-			if (m_variant == 17) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-best-and-current/2/bin------------------------------------------------*/
-			else if (m_variant == 18) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
+			/*=======Build the trial vector in tmp[] (see de_kernels.h for the strategies)================================*/
+			trial(tmp,popold[i],gbIter,rx,F,CR,Dc,de_kernels::uniform_index(m_urng,Dc),r_dist,mask);
 
 			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
 			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = r_dist() * (ub[i2]-lb[i2]) + lb[i2];
-				++i2;
-			}
+			de_kernels::resample_out_of_bounds(tmp,lb,ub,Dc,r_dist);
 
 			//b) how good?
 			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
@@ -532,8 +217,8 @@ void jde::evolve(population &pop) const
 				// and thus can evaluate a new velocity
 				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
 				
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				//updates x and v (the fitness is already known, no re-evaluation is needed)
+				pop.set_xf(i,popnew[i],newfitness);
 				pop.set_v(i,tmp);
 				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
 					/* if so...*/
@@ -558,6 +243,128 @@ void jde::evolve(population &pop) const
 	}
 }
 
+// Initialises the self-adapted F and CR, unless they are remembered from a previous call on a population of the same size.
+void jde::init_parameters(population::size_type NP) const
+{
+	if ( (m_cr.size() == NP) && (m_f.size() == NP) && m_memory ) {
+		return;
+	}
+	boost::normal_distribution<double> normal(0.0,1.0);
+	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > n_dist(m_drng,normal);
+	boost::uniform_real<double> uniform(0.0,1.0);
+	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
+	m_cr.resize(NP); m_f.resize(NP);
+	if (m_variant_adptv==1) {
+		for (size_t i = 0; i < NP; ++i) {
+			m_cr[i] = r_dist();
+			m_f[i]  = r_dist() * 0.9 + 0.1;
+		}
+	}
+	else if (m_variant_adptv==2) {
+		for (size_t i = 0; i < NP; ++i) {
+			m_cr[i] = n_dist() * 0.15 + 0.5;
+			m_f[i]  = n_dist() * 0.15 + 0.5;
+		}
+	}
+}
+
+/// Ask for one generation of jDE trial vectors.
+/**
+ * Builds one trial vector per individual of pop as one generation of evolve() would, self-adapting F and CR.
+ * The F and CR used for each trial are kept and adopted by tell() if the trial succeeds.
+ *
+ * @param[in] pop population the trial vectors are built from.
+ *
+ * @return the NP trial vectors.
+ * @throws value_error if the problem/population are not suitable for jDE (see evolve())
+ */
+std::vector<decision_vector> jde::ask(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type NP = pop.size();
+
+	if ( Dc == 0 ) {
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for DE to optimise");
+	}
+	if ( prob.get_c_dimension() != 0 ) {
+		pagmo_throw(value_error,"The problem is not box constrained and DE is not suitable to solve it");
+	}
+	if ( prob.get_f_dimension() != 1 ) {
+		pagmo_throw(value_error,"The problem is not single objective and DE is not suitable to solve it");
+	}
+	if (NP < 8) {
+		pagmo_throw(value_error,"for jDE at least 8 individuals in the population are needed");
+	}
+
+	boost::normal_distribution<double> normal(0.0,1.0);
+	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > n_dist(m_drng,normal);
+	boost::uniform_real<double> uniform(0.0,1.0);
+	typedef boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist_type;
+	r_dist_type r_dist(m_drng,uniform);
+
+	init_parameters(NP);
+	const population::size_type best_idx = pop.get_best_idx();
+	const double bestF = m_f[best_idx], bestCR = m_cr[best_idx];
+
+	const de_kernels::trial_function<r_dist_type>::type trial = de_kernels::select_strategy<r_dist_type>(m_variant);
+	de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+	std::vector<decision_vector> retval(NP,decision_vector(D));
+	m_trial_f.resize(NP);
+	m_trial_cr.resize(NP);
+
+	size_t r[de_kernels::max_random];
+	const double *rx[de_kernels::max_random];
+	for (size_t i = 0; i < NP; ++i) {
+		sampler.draw(i,de_kernels::max_random,r,m_urng);
+		for (size_t k = 0; k < de_kernels::max_random; ++k) {
+			rx[k] = &pop.get_individual(r[k]).cur_x[0];
+		}
+		if (m_variant_adptv==1) {
+			m_trial_f[i] =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
+			m_trial_cr[i] = (r_dist() < 0.9) ? m_cr[i] : r_dist();
+		} else {
+			m_trial_f[i] = de_kernels::adapt_parameter(m_variant,m_f,bestF,i,r,n_dist);
+			m_trial_cr[i] = de_kernels::adapt_parameter(m_variant,m_cr,bestCR,i,r,n_dist);
+		}
+		trial(retval[i],pop.get_individual(i).cur_x,pop.champion().x,rx,m_trial_f[i],m_trial_cr[i],Dc,de_kernels::uniform_index(m_urng,Dc),r_dist,mask);
+		de_kernels::resample_out_of_bounds(retval[i],lb,ub,Dc,r_dist);
+	}
+	return retval;
+}
+
+/// Tell the fitnesses of the jDE trial vectors.
+/**
+ * Each trial vector replaces the corresponding individual if its fitness is better, in which case
+ * the F and CR that generated it are adopted for that individual.
+ *
+ * @param[in,out] pop population the trial vectors were asked from.
+ * @param[in] x the trial vectors returned by the last ask().
+ * @param[in] f the fitnesses of the trial vectors.
+ * @throws value_error if x and f do not match the candidates of the last ask().
+ */
+void jde::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	check_told(pop,x,f,pop.size());
+	if (m_trial_f.size() != pop.size() || m_f.size() != pop.size()) {
+		pagmo_throw(value_error,"tell() must follow an ask() on a population of the same size");
+	}
+	decision_vector v;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		// Same selection rule as evolve(): the trial replaces the target only if strictly better.
+		if (pop.problem().compare_fitness(f[i],pop.get_individual(i).cur_f)) {
+			m_f[i] = m_trial_f[i];
+			m_cr[i] = m_trial_cr[i];
+			v = x[i];
+			std::transform(v.begin(), v.end(), pop.get_individual(i).cur_x.begin(), v.begin(),std::minus<double>());
+			pop.set_xf(i,x[i],f[i]);
+			pop.set_v(i,v);
+		}
+	}
+}
+
 /// Algorithm name
 std::string jde::get_name() const
 {
@@ -67,11 +67,14 @@ public:
 	jde(int = 100, int = 2, int = 1, double = 1e-6, double = 1e-6, bool = false);
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 
 protected:
 	std::string human_readable_extra() const;
 private:
+	void init_parameters(population::size_type) const;
 	friend class boost::serialization::access;
 	template <class Archive>
 	void serialize(Archive &ar, const unsigned int)
@@ -105,6 +108,10 @@ private:
 
 	// Memory option
 	const bool m_memory;
+
+	// F and CR used to build the trial vectors of the last ask(), adopted in tell() on success
+	mutable std::vector<double> m_trial_f;
+	mutable std::vector<double> m_trial_cr;
 };
 
 }}
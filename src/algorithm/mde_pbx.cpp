@@ -23,7 +23,6 @@
 *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
-#include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/cauchy_distribution.hpp>
@@ -38,6 +37,7 @@
 #include "../types.h"
 #include "base.h"
 #include "mde_pbx.h"
+#include "de_kernels.h"
 
 namespace pagmo { namespace algorithm {
 
@@ -86,7 +86,8 @@ void mde_pbx::evolve(population &pop) const
 	const problem::base::size_type D = prob.get_dimension();
 	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	const population::size_type NP = pop.size();
-	const population::size_type NP_Part = m_qperc * NP; // here we rely on an implicit cast
+	// here we rely on an implicit cast, the q% sample cannot be larger than the NP-1 other individuals
+	const population::size_type NP_Part = std::min<population::size_type>(m_qperc * NP, NP - 1);
 
 	//We perform some checks to determine wether the problem/population are suitable for DE
 	if ( D == 0 ) {
@@ -126,19 +127,15 @@ void mde_pbx::evolve(population &pop) const
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
 
-	boost::uniform_int<decision_vector::size_type> r_c_idx(0,D-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<decision_vector::size_type> > c_idx(m_urng,r_c_idx);
-	
-	boost::uniform_int<population::size_type> r_p_idx(0,NP-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<population::size_type> > p_idx(m_urng,r_p_idx);
-	
+
 	boost::normal_distribution<double> nd(0.0, 1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > gauss(m_drng,nd);
 	
 	// Declaring temporary variables used by the main-loop
 	population::size_type p;
 	population::size_type r1, r2, bestq_idx, bestp_idx, j_rand;
-	std::vector<population::size_type> a(NP-1,0);
+	std::vector<population::size_type> a(NP_Part,0);
+	de_kernels::index_sampler sampler(NP);
 	double cri, fi; //, wcr, wf;
 
 	// **** Main Loop of MDE-pBX ****
@@ -162,16 +159,8 @@ void mde_pbx::evolve(population &pop) const
 		// loop through all individuals
 		for (pagmo::population::size_type i = 0; i < NP; ++i) {
 			
-			// Get q% random indices excluding i
-			// First we build the index list (for example i=5 -> a = [1,2,3,4,6,7,8, .... ]) containing NP-1 entries
-			for (pagmo::population::size_type k = 0; k < NP-1; ++k) {
-				(k<i) ? a[k] = k : a[k] = k+1;
-			}
-			// Then we swap the first q% of the indexes
-			for (pagmo::population::size_type k = 0; k < NP_Part; ++k) {
-				r1 = boost::uniform_int<int>(k,NP-2)(m_urng);
-				std::swap(a[k], a[r1]);
-			}
+			// Get q% random indices excluding i (partial Fisher-Yates shuffle on the reusable index buffer)
+			sampler.draw(i,NP_Part,&a[0],m_urng);
 			
 			// find index of individual from q% sample with best fitness
 			bestq_idx = a[0];
@@ -184,15 +173,15 @@ void mde_pbx::evolve(population &pop) const
 			// choose two random distinct pop members
 			do {
 				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
+				r1 = de_kernels::uniform_index(m_urng,NP);
 			} while ((r1==i) || (r1==bestq_idx));
 			
 			do {
 				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
+				r2 = de_kernels::uniform_index(m_urng,NP);
 			} while ((r2==i) || (r2==r1) || (r2==bestq_idx));
 			
-			bestp_idx = pbest[boost::uniform_int<int>(0,p-1)(m_urng)];
+			bestp_idx = pbest[de_kernels::uniform_index(m_urng,p)];
 			
 			// sample scale factors
 			//do {
@@ -210,7 +199,7 @@ void mde_pbx::evolve(population &pop) const
 			} while (fi <= 0.0); // || (fi >=1.0));
 			
 			// fix a random dimension index
-			j_rand = c_idx();
+			j_rand = de_kernels::uniform_index(m_urng,D);
 
 			// Mutation + Crossover
 			for (size_t j = 0; j < D; ++j) {
@@ -232,10 +221,10 @@ void mde_pbx::evolve(population &pop) const
 			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] and records it fitness in newfitness */
 			if ( pop.problem().compare_fitness(newfitness,pop_old.get_individual(i).cur_f) ) {  /* improved objective function value ? */
 				// As a fitness improvement occured we 
-				pop.set_x(i,tmp);
+				pop.set_xf(i,tmp,newfitness);
 				// and thus can evaluate a new velocity
 				std::transform(tmp.begin(), tmp.end(), pop_old.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				// updates  v (cache avoids to recompute the objective function)
+				// updates v
 				pop.set_v(i,tmp);
 				// pop_old.set_x(i,tmp); (un-comment for a steady-state version)
 				// remember the successful scale factors
@@ -32,6 +32,9 @@
 #include "nn_tsp.h"
 
 namespace pagmo { namespace algorithm {
+
+// Number of nearest cities examined before scanning all the unvisited ones.
+static const problem::base_tsp::size_type n_candidates = 16;
     
 /// Constructor.
 /**
@@ -93,34 +96,54 @@ void nn_tsp::evolve(population &pop) const
 		Nt = m_start_city+1;
 	}
 
-	int length_best_tour, length_new_tour;
-	size_t nxt_city, min_idx;
-	std::vector<int> not_visited(Nv);
-	length_best_tour = 0;
+	// Candidate lists: most of the times the nearest unvisited city is among the nearest cities,
+	// only when they are all visited we fall back to scanning the unvisited ones.
+	const std::vector<unsigned int> &neighbours = prob->neighbour_lists(n_candidates);
+	const size_t k = (Nv > 0) ? neighbours.size() / Nv : 0;
+
+	double length_best_tour = 0, length_new_tour;
+	size_t nxt_city, cur_city;
+	// not_visited[0,n_not_visited) holds the unvisited cities, position[c] the index of c in not_visited
+	std::vector<size_t> not_visited(Nv), position(Nv);
+	size_t n_not_visited;
 
 	//main loop
 	for (size_t i = first_city; i < Nt; i++) {
 		length_new_tour = 0;
 		for (size_t j = 0; j < Nv; j++) {
 			not_visited[j] = j;
+			position[j] = j;
 		}
-		new_tour[0] = i;
-		std::swap(not_visited[new_tour[0]],not_visited[Nv-1]);
-		for (size_t j = 1; j < Nv-1; j++) {
-			min_idx = 0;
-			nxt_city = not_visited[0];
-			for (size_t l = 1; l < Nv-j; l++) {
-				if(prob->distance(new_tour[j-1], not_visited[l]) < prob->distance(new_tour[j-1], nxt_city) )
-			{
-					min_idx = l;		
-					nxt_city = not_visited[l];}
+		n_not_visited = Nv;
+		cur_city = i;
+		new_tour[0] = cur_city;
+		for (size_t j = 1; j < Nv; j++) {
+			// removes cur_city from the unvisited ones
+			--n_not_visited;
+			position[not_visited[n_not_visited]] = position[cur_city];
+			std::swap(not_visited[position[cur_city]], not_visited[n_not_visited]);
+			position[cur_city] = n_not_visited;
+
+			nxt_city = Nv;
+			for (size_t l = 0; l < k; l++) {
+				const size_t c = neighbours[cur_city * k + l];
+				if (position[c] < n_not_visited) {
+					nxt_city = c;
+					break;
+				}
+			}
+			if (nxt_city == Nv) {
+				nxt_city = not_visited[0];
+				for (size_t l = 1; l < n_not_visited; l++) {
+					if(prob->distance(cur_city, not_visited[l]) < prob->distance(cur_city, nxt_city)) {
+						nxt_city = not_visited[l];
+					}
+				}
 			}
 			new_tour[j] = nxt_city;
-			length_new_tour += prob->distance(new_tour[j-1], nxt_city);
-			std::swap(not_visited[min_idx],not_visited[Nv-j-1]);
+			length_new_tour += prob->distance(cur_city, nxt_city);
+			cur_city = nxt_city;
 		}
-		new_tour[Nv-1] = not_visited[0];
-		length_new_tour += prob->distance(new_tour[Nv-2], new_tour[Nv-1]);
 		length_new_tour += prob->distance(new_tour[Nv-1], new_tour[0]);
 		if(i == first_city || length_new_tour < length_best_tour){
 			best_tour = new_tour;
@@ -39,6 +39,8 @@ namespace pagmo { namespace algorithm {
 /**
  * The Nearest Neighbor algorithm generates a tour starting either from a single, in the input, specified vertex
  * or loops over all possible initial vertices, computes the corresponding tours and returns the shortest tour.
+ * The next city is first searched among the candidate lists of pagmo::problem::base_tsp::neighbour_lists, so that
+ * each tour costs O(n k) rather than O(n^2) in most cases.
  *
  * @author Ingmar Getzner (ingmar.getzner@gmail.com)
  */
@@ -246,7 +246,6 @@ void nsga2::evolve(population &pop) const
 {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type D = prob.get_dimension();
 	const problem::base::size_type prob_c_dimension = prob.get_c_dimension();
 	const population::size_type NP = pop.size();
 
@@ -269,9 +268,30 @@ void nsga2::evolve(population &pop) const
 		return;
 	}
 
-	std::vector<population::size_type> best_idx(NP), shuffle1(NP),shuffle2(NP);
+	// Main NSGA-II loop
+	for (int g = 0; g<m_gen; g++) {
+		// We compute the crowding distance and the pareto rank of pop
+		pop.update_pareto_information();
+		const std::vector<decision_vector> children(make_offspring(pop));
+		//At each generation we make a copy of the population into popnew
+		population popnew(pop);
+		for (population::size_type i = 0; i < NP; ++i) {
+			popnew.push_back(children[i]);
+		} // popnew now contains 2NP individuals
+		select_survivors(pop,popnew);
+	} // end of main SGA loop
+}
+
+// Creates NP offspring from pop by tournament selection, crossover and mutation. The pareto information of pop must be up to date.
+std::vector<decision_vector> nsga2::make_offspring(const population &pop) const
+{
+	const population::size_type NP = pop.size();
+	const problem::base::size_type D = pop.problem().get_dimension();
+	std::vector<population::size_type> shuffle1(NP),shuffle2(NP);
 	population::size_type parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	std::vector<decision_vector> retval;
+	retval.reserve(NP);
 
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle1[i] = i;
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle2[i] = i;
@@ -279,47 +299,90 @@ void nsga2::evolve(population &pop) const
 	boost::uniform_int<int> pop_idx(0,NP-1);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,pop_idx);
 
-	// Main NSGA-II loop
-	for (int g = 0; g<m_gen; g++) {
-		//At each generation we make a copy of the population into popnew
-		// We compute the crowding distance and the pareto rank of pop
-		pop.update_pareto_information();
-		population popnew(pop);
+	//We create some pseudo-random permutation of the poulation indexes
+	std::random_shuffle(shuffle1.begin(),shuffle1.end(),p_idx);
+	std::random_shuffle(shuffle2.begin(),shuffle2.end(),p_idx);
+
+	//We then loop thorugh all individuals with increment 4 to select two pairs of parents that will
+	//each create 2 new offspring
+	for (pagmo::population::size_type i=0; i< NP; i+=4) {
+		// We create two offsprings using the shuffled list 1
+		parent1_idx = tournament_selection(shuffle1[i], shuffle1[i+1],pop);
+		parent2_idx = tournament_selection(shuffle1[i+2], shuffle1[i+3],pop);
+		crossover(child1, child2, parent1_idx,parent2_idx,pop);
+		mutate(child1,pop);
+		mutate(child2,pop);
+		retval.push_back(child1);
+		retval.push_back(child2);
+
+		// We repeat with the shuffled list 2
+		parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],pop);
+		parent2_idx = tournament_selection(shuffle2[i+2], shuffle2[i+3],pop);
+		crossover(child1, child2, parent1_idx,parent2_idx,pop);
+		mutate(child1,pop);
+		mutate(child2,pop);
+		retval.push_back(child1);
+		retval.push_back(child2);
+	}
+	return retval;
+}
 
-		//We create some pseudo-random permutation of the poulation indexes
-		std::random_shuffle(shuffle1.begin(),shuffle1.end(),p_idx);
-		std::random_shuffle(shuffle2.begin(),shuffle2.end(),p_idx);
-
-		//We then loop thorugh all individuals with increment 4 to select two pairs of parents that will
-		//each create 2 new offspring
-		for (pagmo::population::size_type i=0; i< NP; i+=4) {
-			// We create two offsprings using the shuffled list 1
-			parent1_idx = tournament_selection(shuffle1[i], shuffle1[i+1],pop);
-			parent2_idx = tournament_selection(shuffle1[i+2], shuffle1[i+3],pop);
-			crossover(child1, child2, parent1_idx,parent2_idx,pop);
-			mutate(child1,pop);
-			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
-
-			// We repeat with the shuffled list 2
-			parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],pop);
-			parent2_idx = tournament_selection(shuffle2[i+2], shuffle2[i+3],pop);
-			crossover(child1, child2, parent1_idx,parent2_idx,pop);
-			mutate(child1,pop);
-			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
-		} // popnew now contains 2NP individuals
+// Replaces pop with the pop.size() best individuals of popnew (parents plus offspring).
+void nsga2::select_survivors(population &pop, const population &popnew) const
+{
+	const population::size_type NP = pop.size();
+	// This method returns the sorted N best individuals in the population according to the crowded comparison operator
+	// defined in population.cpp
+	const std::vector<population::size_type> best_idx = popnew.get_best_idx(NP);
+	// We completely cancel the population (NOTE: memory of all individuals and the notion of
+	// champion is thus destroyed). Fitnesses are known, no need to evaluate again.
+	pop.clear();
+	for (population::size_type i=0; i < NP; ++i) {
+		pop.push_back(popnew.get_individual(best_idx[i]).cur_x,popnew.get_individual(best_idx[i]).cur_f);
+	}
+}
 
-		// This method returns the sorted N best individuals in the population according to the crowded comparison operator
-		// defined in population.cpp
-		best_idx = popnew.get_best_idx(NP);
-		// We completely cancel the population (NOTE: memory of all individuals and the notion of
-		// champion is thus destroyed)
-		pop.clear();
-		for (population::size_type i=0; i < NP; ++i) pop.push_back(popnew.get_individual(best_idx[i]).cur_x);
-	} // end of main SGA loop
+/// Ask for one generation of NSGA-II offspring.
+/**
+ * Generates NP offspring from pop by binary tournament selection, simulated binary crossover and polynomial mutation.
+ *
+ * @param[in] pop population the offspring is generated from.
+ *
+ * @return the NP offspring decision vectors.
+ * @throws value_error if the problem/population are not suitable for NSGA-II
+ */
+std::vector<decision_vector> nsga2::ask(const population &pop) const
+{
+	if ( pop.problem().get_c_dimension() != 0 ) {
+		pagmo_throw(value_error, "The problem is not box constrained and NSGA-II is not suitable to solve it");
+	}
+	if (pop.size() < 5 || (pop.size() % 4 != 0) ) {
+		pagmo_throw(value_error, "for NSGA-II at least 5 individuals in the population are needed and the population size must be a multiple of 4");
+	}
+	if ( pop.problem().get_f_dimension() < 2 ) {
+		pagmo_throw(value_error, "The problem is not multiobjective, try some other algorithm than NSGA-II");
+	}
+	pop.update_pareto_information();
+	return make_offspring(pop);
+}
+
+/// Tell the fitnesses of the NSGA-II offspring.
+/**
+ * Parents and offspring are merged and the best NP individuals, according to the crowded comparison operator, form the new population.
+ *
+ * @param[in,out] pop population the offspring was asked from.
+ * @param[in] x the offspring returned by ask().
+ * @param[in] f the fitnesses of the offspring.
+ * @throws value_error if x and f do not contain one element per individual.
+ */
+void nsga2::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	check_told(pop,x,f,pop.size());
+	population popnew(pop);
+	for (population::size_type i = 0; i < x.size(); ++i) {
+		popnew.push_back(x[i],f[i]);
+	}
+	select_survivors(pop,popnew);
 }
 
 /// Algorithm name
@@ -52,6 +52,8 @@ public:
 	nsga2(int gen=100, double cr = 0.95, double eta_c = 10, double m = 0.01, double eta_m = 50);
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 	
 protected:
@@ -61,6 +63,8 @@ private:
 	pagmo::population::size_type tournament_selection(pagmo::population::size_type, pagmo::population::size_type, const pagmo::population&) const;
 	void crossover(decision_vector&, decision_vector&, pagmo::population::size_type, pagmo::population::size_type,const pagmo::population&) const;
 	void mutate(decision_vector&, const pagmo::population&) const;
+	std::vector<decision_vector> make_offspring(const population &) const;
+	void select_survivors(population &, const population &) const;
 	
 	friend class boost::serialization::access;
 	template <class Archive>
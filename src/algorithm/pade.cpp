@@ -265,10 +265,15 @@ void pade::evolve(population &pop) const
 	// As m_T neighbours are connected, we replace m_T individuals on the island
 	const pagmo::migration::worst_r_policy replacement_policy(m_T);
 
-	//We create all the decomposed problems (one for each individual)
+	//We create all the decomposed problems (one for each individual), sharing the cache of the original fitnesses
+	//so that individuals migrating between islands are evaluated only once on the original problem
 	std::vector<pagmo::problem::base_ptr> problems_vector;
-	for(pagmo::population::size_type i=0; i<NP;++i) {
-		problems_vector.push_back(pagmo::problem::decompose(prob, m_method,weights[i],m_z).clone());
+	const pagmo::problem::decompose first_problem(prob, m_method, weights[0], m_z);
+	problems_vector.push_back(first_problem.clone());
+	for(pagmo::population::size_type i=1; i<NP;++i) {
+		pagmo::problem::decompose decomposed_problem(prob, m_method,weights[i],m_z);
+		decomposed_problem.share_fitness_cache(first_problem);
+		problems_vector.push_back(decomposed_problem.clone());
 	}
 
 	//We create a pseudo-random permutation of the problem indexes
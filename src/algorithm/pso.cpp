@@ -351,8 +351,9 @@ void pso::evolve(population &pop) const
 	
 	// copy particles' positions & velocities back to the main population
 	for( p = 0; p < swarm_size; p++ ){
-		pop.set_x( p, lbX[p] );		// sets: cur_x, cur_f, best_x, best_f
-		pop.set_x( p, X[p] );		// sets: cur_x, cur_f
+		// (the fitness values are already known, no re-evaluation is needed)
+		pop.set_xf( p, lbX[p], lbfit[p] );	// sets: cur_x, cur_f, best_x, best_f
+		pop.set_xf( p, X[p], fit[p] );		// sets: cur_x, cur_f
 		pop.set_v( p, V[p] );		// sets: cur_v
 	}
 }
@@ -107,7 +107,6 @@ void pso_generational::evolve(population &pop) const
 	const problem::base             &prob = pop.problem();
 	const problem::base::size_type   D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
 	const problem::base::size_type   Dc = D - prob_i_dimension;
-	const decision_vector           &lb = prob.get_lb(), &ub = prob.get_ub();
 	const population::size_type      swarm_size = pop.size();
 
 
@@ -148,21 +147,11 @@ void pso_generational::evolve(population &pop) const
 	bool best_fit_improved;					// flag indicating whether the best solution's fitness improved (tracked only when using topologies 1 or 4)
 
 
-	decision_vector minv(Dc), maxv(Dc);			// Maximum and minumum velocity allowed
-
-	double vwidth;						// Temporary variable
-	double new_x;						// Temporary variable
-
 	population::size_type    p;		// for iterating over particles
-	population::size_type    n;		// for iterating over particles's neighbours
-	problem::base::size_type d;		// for iterating over problem dimensions
-
 
-	// Initialise the minimum and maximum velocity
-	for( d = 0; d < Dc; d++ ){
-		vwidth  = ( ub[d] - lb[d] ) * m_vcoeff;
-		minv[d] = -1.0 * vwidth;
-		maxv[d] = vwidth;
+	std::vector<population::size_type> swarm_idx(swarm_size);	// positions of all particles (bulk write-back into the population)
+	for( p = 0; p < swarm_size; p++ ){
+		swarm_idx[p] = p;
 	}
 
 	// Copy the particle positions, their velocities and their fitness
@@ -190,145 +179,13 @@ void pso_generational::evolve(population &pop) const
 	}
 
 
-	// auxiliary varibables specific to the Fully Informed Particle Swarm variant
-	double acceleration_coefficient = m_eta1 + m_eta2;
-	double sum_forces;
-
-	double r1 = 0.0;
-	double r2 = 0.0;
-
 	/* --- Main PSO loop ---
 	 */
 	// For each generation
 	for( int g = 0; g < m_gen; ++g ){
 
-		// Update Velocity
-		for( p = 0; p < swarm_size; p++ ){
-
-			// identify the current particle's best neighbour
-			// . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked in this function
-			// . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best one
-			if( m_neighb_type != 1 && m_variant != 6)
-				best_neighb = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
-
-
-			/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-			/*-------Original algorithm used in PaGMO paper-------------------------------------------*/
-			if( m_variant == 1 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
-				}
-			}
-
-			/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
-			/*-------and with equal random weights of social and cognitive components-----------------*/
-			/*-------Check with Rastrigin-------------------------------------------------------------*/
-			else if( m_variant == 2 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
-				}
-			}
-
-			/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-			/*-------Same random number for all components------------------------------------------*/
-			else if( m_variant == 3 ){
-				r1 = m_drng();
-				r2 = m_drng();
-				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
-				}
-			}
-
-			/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
-			/*-------Same random number for all components------------------------------------------*/
-			/*-------and with equal random weights of social and cognitive components---------------*/
-			else if( m_variant == 4 ){
-				r1 = m_drng();
-				for( d = 0; d < Dc; d++ ){
-					V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
-				}
-			}
-
-			/*-------PSO variant with constriction coefficients------------------------------------*/
-			/*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
-			 *  placement of "constriction coefficients" on the terms of the formulas; these
-			 *  coefficients controlled the convergence of the particle and allowed an elegant and
-			 *  well-explained method for preventing explosion, ensuring convergence, and
-			 *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
-			 *  out of setting the values of phi_1 and phi_2.''
-			 *  ''this is the canonical particle swarm algorithm of today.''
-			 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-			 *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
-			 *
-			 *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
-			 *-------------------------------------------------------------------------------------*/
-			else if( m_variant == 5 ){
-				for( d = 0; d < Dc; d++ ){
-					r1 = m_drng();
-					r2 = m_drng();
-					V[p][d] = m_omega * ( V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]) );
-				}
-			}
-
-			/*-------Fully Informed Particle Swarm-------------------------------------------------*/
-			/*  ''Whereas in the traditional algorithm each particle is affected by its own
-			 *  previous performance and the single best success found in its neighborhood, in
-			 *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
-			 *  neighbors, sometimes with no influence from its own previous success.''
-			 *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
-			 *  than the canonical algorithm, but it is much more dependent on the population topology.''
-			 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
-			 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
-			 *-------------------------------------------------------------------------------------*/
-			else if( m_variant == 6 ){
-				for( d = 0; d < Dc; d++ ){
-					sum_forces = 0.0;
-					for( n = 0; n < neighb[p].size(); n++ )
-						sum_forces += m_drng() * acceleration_coefficient * ( lbX[ neighb[p][n] ][d] - X[p][d] );
-
-					V[p][d] = m_omega * ( V[p][d] + sum_forces / neighb[p].size() );
-				}
-			}
-		}
-
-		// Update Position
-		for( p = 0; p < swarm_size; p++ ){
-			// We now check that the velocity does not exceed the maximum allowed per component
-			// and we perform the position update and the feasibility correction
-			for( d = 0; d < Dc; d++ ){
-
-				if( V[p][d] > maxv[d] )
-					V[p][d] = maxv[d];
-
-				else if( V[p][d] < minv[d] )
-					V[p][d] = minv[d];
-
-				// update position
-				new_x = X[p][d] + V[p][d];
-
-				// feasibility correction
-				// (velocity updated to that which would have taken the previous position
-				// to the newly corrected feasible position)
-				if( new_x < lb[d] ){
-					new_x = lb[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-//					V[p][d] = 0;
-				}
-				else if( new_x > ub[d] ){
-					new_x = ub[d];
-					V[p][d] = 0.0;
-//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
-//					V[p][d] = new_x - X[p][d];
-//					V[p][d] = 0;
-				}
-				X[p][d] = new_x;
-			}
-		}
+		// Update velocities and positions
+		move_swarm( X, V, lbX, lbfit, neighb, best_neighb, prob );
 
 		// If the problem is a stochastic optimization chage the seed and re-evaluate taking care to update also best and local bests
 		try
@@ -343,8 +200,11 @@ void pso_generational::evolve(population &pop) const
 				// We re-evaluate the fitness of the particle memory
 				prob.objfun( lbfit[p], lbX[p] );
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(lbX[p]);
-				pop.set_x(p,X[p]);
+				pop.push_back(lbX[p],lbfit[p]);
+			}
+			// Move all particles at once (fitness already known, single domination update)
+			pop.set_xf(swarm_idx,X,fit);
+			for( p = 0; p < swarm_size; p++ ){
 				pop.set_v(p,V[p]);
 			}
 			//UPDATE BEST_FIT and BEST to account for the new seed
@@ -364,7 +224,10 @@ void pso_generational::evolve(population &pop) const
 			for( p = 0; p < swarm_size; p++ ){
 				// We evaluate here the new individual fitness
 				prob.objfun( fit[p], X[p] );
-				pop.set_x(p,X[p]);
+			}
+			// Move all particles at once (fitness already known, single domination update)
+			pop.set_xf(swarm_idx,X,fit);
+			for( p = 0; p < swarm_size; p++ ){
 				pop.set_v(p,V[p]);
 			}
 		}
@@ -398,6 +261,251 @@ void pso_generational::evolve(population &pop) const
 }
 
 
+/// Ask for one generation of PSO particle moves.
+/**
+ * Moves all particles as one generation of evolve() would, and returns their new positions. The corresponding
+ * velocities are kept and assigned to the particles by tell().
+ *
+ * @param[in] pop swarm to be moved.
+ *
+ * @return the new particle positions.
+ * @throws value_error if the problem/population are not suitable for PSO
+ */
+std::vector<decision_vector> pso_generational::ask(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const population::size_type swarm_size = pop.size();
+
+	if( prob.get_dimension() == prob.get_i_dimension() ){
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for PSO to optimise");
+	}
+	if( prob.get_c_dimension() != 0 ){
+		pagmo_throw(value_error,"The problem is not box constrained and PSO is not suitable to solve it");
+	}
+	if( prob.get_f_dimension() != 1 ){
+		pagmo_throw(value_error,"The problem is not single objective and PSO is not suitable to solve it");
+	}
+
+	std::vector<decision_vector> X(swarm_size), lbX(swarm_size);
+	std::vector<fitness_vector> lbfit(swarm_size);
+	m_asked_v.resize(swarm_size);
+	for( population::size_type p = 0; p < swarm_size; p++ ){
+		X[p]         = pop.get_individual(p).cur_x;
+		m_asked_v[p]  = pop.get_individual(p).cur_v;
+		lbX[p]       = pop.get_individual(p).best_x;
+		lbfit[p]     = pop.get_individual(p).best_f;
+	}
+
+	std::vector< std::vector<int> > neighb(swarm_size);
+	decision_vector best_neighb(prob.get_dimension() - prob.get_i_dimension());
+	fitness_vector best_fit;
+	switch( m_neighb_type ){
+		case 1:  initialize_topology__gbest( pop, best_neighb, best_fit, neighb ); break;
+		case 3:  initialize_topology__von( neighb ); break;
+		case 4:  initialize_topology__adaptive_random( neighb ); break;
+		case 2:
+		default: initialize_topology__lbest( neighb );
+	}
+	move_swarm( X, m_asked_v, lbX, lbfit, neighb, best_neighb, prob );
+	return X;
+}
+
+/// Tell the fitnesses of the moved particles.
+/**
+ * Assigns to each particle its new position, fitness and velocity. Particles' memory (best_x) and the
+ * champion are updated by the population.
+ *
+ * @param[in,out] pop swarm the moves were asked for.
+ * @param[in] x the positions returned by the last ask().
+ * @param[in] f the fitnesses of the positions.
+ * @throws value_error if x and f do not match the particles of the last ask().
+ */
+void pso_generational::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	check_told(pop,x,f,pop.size());
+	if( m_asked_v.size() != pop.size() ){
+		pagmo_throw(value_error,"tell() must follow an ask() on a population of the same size");
+	}
+	std::vector<population::size_type> swarm_idx(pop.size());
+	for( population::size_type p = 0; p < pop.size(); p++ ){
+		swarm_idx[p] = p;
+	}
+	pop.set_xf( swarm_idx, x, f );
+	for( population::size_type p = 0; p < pop.size(); p++ ){
+		pop.set_v( p, m_asked_v[p] );
+	}
+}
+
+/**
+ *  @brief Performs one PSO velocity and position update of the whole swarm
+ *
+ *  @param[in,out] X particles' current positions
+ *  @param[in,out] V particles' velocities
+ *  @param[in] lbX particles' previous best positions
+ *  @param[in] lbfit particles' fitness values at their previous best positions
+ *  @param[in] neighb definition of the swarm's topology
+ *  @param[in,out] best_neighb best position in the swarm (tracked by the caller when using topology 1)
+ *  @param[in] prob problem undergoing optimization
+ */
+void pso_generational::move_swarm( std::vector<decision_vector> &X, std::vector<decision_vector> &V, const std::vector<decision_vector> &lbX, const std::vector<fitness_vector> &lbfit, std::vector< std::vector<int> > &neighb, decision_vector &best_neighb, const problem::base &prob ) const
+{
+	const problem::base::size_type   Dc = prob.get_dimension() - prob.get_i_dimension();
+	const decision_vector           &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type      swarm_size = X.size();
+
+	decision_vector minv(Dc), maxv(Dc);			// Maximum and minumum velocity allowed
+
+	double vwidth;						// Temporary variable
+	double new_x;						// Temporary variable
+
+	population::size_type    p;		// for iterating over particles
+	population::size_type    n;		// for iterating over particles's neighbours
+	problem::base::size_type d;		// for iterating over problem dimensions
+
+	// Initialise the minimum and maximum velocity
+	for( d = 0; d < Dc; d++ ){
+		vwidth  = ( ub[d] - lb[d] ) * m_vcoeff;
+		minv[d] = -1.0 * vwidth;
+		maxv[d] = vwidth;
+	}
+
+	// auxiliary varibables specific to the Fully Informed Particle Swarm variant
+	double acceleration_coefficient = m_eta1 + m_eta2;
+	double sum_forces;
+
+	double r1 = 0.0;
+	double r2 = 0.0;
+
+	// Update Velocity
+	for( p = 0; p < swarm_size; p++ ){
+
+		// identify the current particle's best neighbour
+		// . not needed if m_neighb_type == 1 (gbest): best_neighb directly tracked by the caller
+		// . not needed if m_variant == 6 (FIPS): all neighbours are considered, no need to identify the best one
+		if( m_neighb_type != 1 && m_variant != 6)
+			best_neighb = particle__get_best_neighbor( p, neighb, lbX, lbfit, prob );
+
+
+		/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+		/*-------Original algorithm used in PaGMO paper-------------------------------------------*/
+		if( m_variant == 1 ){
+			for( d = 0; d < Dc; d++ ){
+				r1 = m_drng();
+				r2 = m_drng();
+				V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+			}
+		}
+
+		/*-------PSO canonical (with inertia weight) ---------------------------------------------*/
+		/*-------and with equal random weights of social and cognitive components-----------------*/
+		/*-------Check with Rastrigin-------------------------------------------------------------*/
+		else if( m_variant == 2 ){
+			for( d = 0; d < Dc; d++ ){
+				r1 = m_drng();
+				V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
+			}
+		}
+
+		/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+		/*-------Same random number for all components------------------------------------------*/
+		else if( m_variant == 3 ){
+			r1 = m_drng();
+			r2 = m_drng();
+			for( d = 0; d < Dc; d++ ){
+				V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]);
+			}
+		}
+
+		/*-------PSO variant (commonly mistaken in literature for the canonical)----------------*/
+		/*-------Same random number for all components------------------------------------------*/
+		/*-------and with equal random weights of social and cognitive components---------------*/
+		else if( m_variant == 4 ){
+			r1 = m_drng();
+			for( d = 0; d < Dc; d++ ){
+				V[p][d] = m_omega * V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r1 * (best_neighb[d] - X[p][d]);
+			}
+		}
+
+		/*-------PSO variant with constriction coefficients------------------------------------*/
+		/*  ''Clerc's analysis of the iterative system led him to propose a strategy for the
+		 *  placement of "constriction coefficients" on the terms of the formulas; these
+		 *  coefficients controlled the convergence of the particle and allowed an elegant and
+		 *  well-explained method for preventing explosion, ensuring convergence, and
+		 *  eliminating the arbitrary Vmax parameter. The analysis also takes the guesswork
+		 *  out of setting the values of phi_1 and phi_2.''
+		 *  ''this is the canonical particle swarm algorithm of today.''
+		 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+		 *  [Clerc and Kennedy, 2002] http://dx.doi.org/10.1109/4235.985692
+		 *
+		 *  This being the canonical PSO of today, this variant is set as the default in PaGMO.
+		 *-------------------------------------------------------------------------------------*/
+		else if( m_variant == 5 ){
+			for( d = 0; d < Dc; d++ ){
+				r1 = m_drng();
+				r2 = m_drng();
+				V[p][d] = m_omega * ( V[p][d] + m_eta1 * r1 * (lbX[p][d] - X[p][d]) + m_eta2 * r2 * (best_neighb[d] - X[p][d]) );
+			}
+		}
+
+		/*-------Fully Informed Particle Swarm-------------------------------------------------*/
+		/*  ''Whereas in the traditional algorithm each particle is affected by its own
+		 *  previous performance and the single best success found in its neighborhood, in
+		 *  Mendes' fully informed particle swarm (FIPS), the particle is affected by all its
+		 *  neighbors, sometimes with no influence from its own previous success.''
+		 *  ''With good parameters, FIPS appears to find better solutions in fewer iterations
+		 *  than the canonical algorithm, but it is much more dependent on the population topology.''
+		 *  [Poli et al., 2007] http://dx.doi.org/10.1007/s11721-007-0002-0
+		 *  [Mendes et al., 2004] http://dx.doi.org/10.1109/TEVC.2004.826074
+		 *-------------------------------------------------------------------------------------*/
+		else if( m_variant == 6 ){
+			for( d = 0; d < Dc; d++ ){
+				sum_forces = 0.0;
+				for( n = 0; n < neighb[p].size(); n++ )
+					sum_forces += m_drng() * acceleration_coefficient * ( lbX[ neighb[p][n] ][d] - X[p][d] );
+
+				V[p][d] = m_omega * ( V[p][d] + sum_forces / neighb[p].size() );
+			}
+		}
+	}
+
+	// Update Position
+	for( p = 0; p < swarm_size; p++ ){
+		// We now check that the velocity does not exceed the maximum allowed per component
+		// and we perform the position update and the feasibility correction
+		for( d = 0; d < Dc; d++ ){
+
+			if( V[p][d] > maxv[d] )
+				V[p][d] = maxv[d];
+
+			else if( V[p][d] < minv[d] )
+				V[p][d] = minv[d];
+
+			// update position
+			new_x = X[p][d] + V[p][d];
+
+			// feasibility correction
+			// (velocity updated to that which would have taken the previous position
+			// to the newly corrected feasible position)
+			if( new_x < lb[d] ){
+				new_x = lb[d];
+				V[p][d] = 0.0;
+//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+//					V[p][d] = new_x - X[p][d];
+//					V[p][d] = 0;
+			}
+			else if( new_x > ub[d] ){
+				new_x = ub[d];
+				V[p][d] = 0.0;
+//					new_x = boost::uniform_real<double>(lb[d],ub[d])(m_drng);
+//					V[p][d] = new_x - X[p][d];
+//					V[p][d] = 0;
+			}
+			X[p][d] = new_x;
+		}
+	}
+}
+
+
 /**
  *  @brief Get information on the best position already visited by any of a particle's neighbours
  *  2
@@ -55,10 +55,13 @@ public:
 	pso_generational(int gen=1, double omega = 0.7298, double eta1 = 2.05, double eta2 = 2.05, double vcoeff = 0.5, int variant = 5, int neighb_type = 2, int neighb_param = 4 );
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 protected:
 	std::string human_readable_extra() const;
 private:
+	void move_swarm( std::vector<decision_vector> &X, std::vector<decision_vector> &V, const std::vector<decision_vector> &lbX, const std::vector<fitness_vector> &lbfit, std::vector< std::vector<int> > &neighb, decision_vector &best_neighb, const problem::base &prob ) const;
 	decision_vector particle__get_best_neighbor( population::size_type pidx, std::vector< std::vector<int> > &neighb, const std::vector<decision_vector> &lbX, const std::vector<fitness_vector> &lbfit, const problem::base &prob ) const;
 	void initialize_topology__gbest( const population &pop, decision_vector &gbX, fitness_vector &gbfit, std::vector< std::vector<int> > &neighb ) const;
 	void initialize_topology__lbest( std::vector< std::vector<int> > &neighb ) const;
@@ -95,6 +98,8 @@ private:
 	const int m_neighb_type;
 	// parameterization of the swarm topology
 	const int m_neighb_param;
+	// Velocities computed by the last ask(), assigned to the particles by tell()
+	mutable std::vector<decision_vector> m_asked_v;
 };
 
 }} //namespaces
@@ -316,10 +316,12 @@ void pso_generational_racing::evolve(population &pop) const
 
 	// Initialize the seed to be used to construct different race_pop instances
 	// to be used to do racing in different contexts: Within the new X, or
-	// within X + lbX, so that past evaluation data can be reused.
+	// within X + lbX. The two instances share their evaluations, so that past
+	// evaluation data is reused whenever a particle is raced again.
 	unsigned int racing_seed = m_urng();
 	util::racing::race_pop race_lbX(racing_seed);
 	util::racing::race_pop race_lbX_and_X(racing_seed);
+	race_lbX_and_X.share_memory(race_lbX);
 
 	racing__construct_race_environment(race_lbX, pop.problem(), lbX, std::vector<decision_vector>());
 
@@ -517,7 +519,6 @@ void pso_generational_racing::evolve(population &pop) const
 		// Stochastic problem being solved with the assistance of racing
 		
 		racing__construct_race_environment(race_lbX_and_X, pop.problem(), lbX, X);
-		race_lbX_and_X.inherit_memory(race_lbX);
 
 		for( p = 0; p < swarm_size && !forced_terminate; p++ ){
 			std::pair<population::size_type, unsigned int> res =
@@ -573,13 +574,10 @@ void pso_generational_racing::evolve(population &pop) const
 			// pop.set_x(p,X[p]);
 		}
 
-		// Construct the new race environment with the updated lbX. Pass on the
-		// memory to the next generation -- some new memory may come from the
-		// previous race between lbX and X. NOTE: This is only possible if the
-		// ground seed of the race doesn't change in the next iteration,
-		// otherwise the transferred cache will be cleared anyway.
+		// Construct the new race environment with the updated lbX. The memory
+		// is passed on to the next generation through the shared store -- some
+		// new memory may come from the previous race between lbX and X.
 		racing__construct_race_environment(race_lbX, pop.problem(), lbX, std::vector<decision_vector>());
-		race_lbX.inherit_memory(race_lbX_and_X);
 
 		// update the best position observed so far by any particle in the swarm
 		// (only performed if swarm topology is gbest or random varying)
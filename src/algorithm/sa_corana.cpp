@@ -188,7 +188,7 @@ void sa_corana::evolve(population &pop) const {
 		currentT *= Tcoeff;
 	}
 	if ( prob.compare_fitness(fOLD,fit0) ){
-		pop.set_x(bestidx,xOLD); //new evaluation is possible here......
+		pop.set_xf(bestidx,xOLD,fOLD); //fitness already known, no new evaluation
 		std::transform(xOLD.begin(), xOLD.end(), pop.get_individual(bestidx).cur_x.begin(), xOLD.begin(),std::minus<double>());
 		pop.set_v(bestidx,xOLD);
 	}
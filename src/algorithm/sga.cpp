@@ -57,7 +57,7 @@ namespace pagmo { namespace algorithm {
  *
  */
 sga::sga(int gen, const double &cr, const double &m, int elitism, mutation::type mut, double width, selection::type sel, crossover::type cro)
-	:base(),m_gen(gen),m_cr(cr),m_m(m),m_elitism(elitism),m_mut(mut,width),m_sel(sel),m_cro(cro)
+	:base(),m_gen(gen),m_cr(cr),m_m(m),m_elitism(elitism),m_mut(mut,width),m_sel(sel),m_cro(cro),m_told(0)
 {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
@@ -95,11 +95,8 @@ void sga::evolve(population &pop) const
 {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type D = prob.get_dimension(), Di = prob.get_i_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const problem::base::size_type D = prob.get_dimension(), prob_c_dimension = prob.get_c_dimension(), prob_f_dimension = prob.get_f_dimension();
 	const population::size_type NP = pop.size();
-	const problem::base::size_type Dc = D - Di;
-
 
 	//We perform some checks to determine wether the problem/population are suitable for SGA
 	if ( prob_c_dimension != 0 ) {
@@ -127,12 +124,6 @@ void sga::evolve(population &pop) const
 	fitness_vector bestfit;
 	decision_vector bestX(D,0);
 
-	std::vector<double> selectionfitness(NP), cumsum(NP), cumsumTemp(NP);
-	std::vector <int> selection(NP);
-
-	int tempID;
-	std::vector<int> fitnessID(NP);
-
 	// Initialise the chromosomes and their fitness to that of the initial deme
 	for (pagmo::population::size_type i = 0; i<NP; i++ ) {
 		X[i]	=	pop.get_individual(i).cur_x;
@@ -148,152 +139,8 @@ void sga::evolve(population &pop) const
 	// Main SGA loop
 	for (int j = 0; j<m_gen; j++) {
 
-		switch (m_sel) {
-		case selection::BEST20: { //selects the best 20% and puts multiple copies in Xnew
-			//Sort the individuals according to their fitness
-			for (pagmo::population::size_type i=0; i<NP; i++) fitnessID[i]=i;
-			for (pagmo::population::size_type i=0; i < (NP-1); ++i) {
-				for (pagmo::population::size_type j=i+1; j<NP; ++j) {
-					if ( prob.compare_fitness(fit[j],fit[i]) ) {
-						//swap fitness values
-						fit[i].swap(fit[j]);
-						//swap id's
-						tempID = fitnessID[i];
-						fitnessID[i] = fitnessID[j];
-						fitnessID[j] = tempID;
-					}
-				}
-			}
-			int best20 = NP/5;
-			for (pagmo::population::size_type i=0; i<NP; ++i) {
-				selection[i] = fitnessID[i % best20];
-			}
-			break;
-		}
-
-		case selection::ROULETTE: {
-			//We scale all fitness values from 0 (worst) to absolute value of the best fitness
-			fitness_vector worstfit=fit[0];
-			for (pagmo::population::size_type i = 1; i < NP;i++) {
-				if (prob.compare_fitness(worstfit,fit[i])) worstfit=fit[i];
-			}
-
-			for (pagmo::population::size_type i = 0; i < NP; i++) {
-				selectionfitness[i] = fabs(worstfit[0] - fit[i][0]);
-			}
-
-			// We build and normalise the cumulative sum
-			cumsumTemp[0] = selectionfitness[0];
-			for (pagmo::population::size_type i = 1; i< NP; i++) {
-				cumsumTemp[i] = cumsumTemp[i - 1] + selectionfitness[i];
-			}
-			for (pagmo::population::size_type i = 0; i < NP; i++) {
-				cumsum[i] = cumsumTemp[i]/cumsumTemp[NP-1];
-			}
-
-			//we throw a dice and pick up the corresponding index
-			double r2;
-			for (pagmo::population::size_type i = 0; i < NP; i++) {
-				r2 = m_drng();
-				for (pagmo::population::size_type j = 0; j < NP; j++) {
-					if (cumsum[j] > r2) {
-						selection[i]=j;
-						break;
-					}
-				}
-			}
-			break;
-			}
-		}
-
-		//Xnew stores the new selected generation of chromosomes
-		for (pagmo::population::size_type i = 0; i < NP; i++) {
-			Xnew[i]=X[selection[i]];
-		}
-
-		//2 - Crossover
-		{
-			int r1,L;
-			decision_vector  member1,member2;
-
-			for (pagmo::population::size_type i=0; i< NP; i++) {
-				//for each chromosome selected i.e. in Xnew
-				member1 = Xnew[i];
-				//we select a mating patner different from the self (i.e. no masturbation)
-				do {
-					r1 = boost::uniform_int<int>(0,NP - 1)(m_urng);
-				} while ( r1 == boost::numeric_cast<int>(i) );
-				member2 = Xnew[r1];
-				//and we operate crossover
-				switch (m_cro) {
-					//0 - binomial crossover
-				case crossover::BINOMIAL: {
-					size_t n = boost::uniform_int<int>(0,D-1)(m_urng);
-					for (size_t L = 0; L < D; ++L) { /* perform D binomial trials */
-						if ((m_drng() < m_cr) || L + 1 == D) { /* change at least one parameter */
-							member1[n] = member2[n];
-						}
-						n = (n+1)%D;
-					}
-					break; }
-					//1 - exponential crossover
-				case crossover::EXPONENTIAL: {
-					size_t n = boost::uniform_int<int>(0,D-1)(m_urng);
-					L = 0;
-					do {
-						member1[n] = member2[n];
-						n = (n+1) % D;
-						L++;
-					}  while ( (m_drng() < m_cr) && (L < boost::numeric_cast<int>(D)) );
-					break; }
-				}
-				Xnew[i] = member1;
-
-			} }
-
-		//3 - Mutation
-		switch (m_mut.m_type) {
-		case mutation::GAUSSIAN: {
-			boost::normal_distribution<double> dist;
-			boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > delta(m_drng,dist);
-			for (pagmo::problem::base::size_type k = 0; k < Dc;k++) { //for each continuous variable
-				double std = (ub[k]-lb[k]) * m_mut.m_width;
-				for (pagmo::population::size_type i = 0; i < NP;i++) { //for each individual
-					if (m_drng() < m_m) {
-						double mean = Xnew[i][k];
-						double tmp = (delta() * std + mean);
-						if ( (tmp < ub[k]) &&  (tmp > lb[k]) ) Xnew[i][k] = tmp;
-					}
-				}
-			}
-			for (pagmo::problem::base::size_type k = Dc; k < D;k++) { //for each integer variable
-				double std = (ub[k]-lb[k]) * m_mut.m_width;
-				for (pagmo::population::size_type i = 0; i < NP;i++) { //for each individual
-					if (m_drng() < m_m) {
-						double mean = Xnew[i][k];
-						double tmp = boost::math::iround(delta() * std + mean);
-						if ( (tmp < ub[k]) &&  (tmp > lb[k]) ) Xnew[i][k] = tmp;
-					}
-				}
-			}
-			break;
-			}
-		case mutation::RANDOM: {
-			for (pagmo::population::size_type i = 0; i < NP;i++) {
-				for (pagmo::problem::base::size_type j = 0; j < Dc;j++) { //for each continuous variable
-					if (m_drng() < m_m) {
-						Xnew[i][j] = boost::uniform_real<double>(lb[j],ub[j])(m_drng);
-					}
-				}
-				for (pagmo::problem::base::size_type j = Dc; j < D;j++) {//for each integer variable
-					if (m_drng() < m_m) {
-						Xnew[i][j] = boost::uniform_int<int>(lb[j],ub[j])(m_urng);
-					}
-				}
-			}
-			break;
-			}
-		}
+		//1,2,3 - Selection, crossover and mutation
+		generate_offspring(Xnew,X,fit,prob);
 
 		// If the problem is a stochastic optimization chage the seed and re-evaluate taking care to update also best and local bests
 		try
@@ -312,7 +159,7 @@ void sga::evolve(population &pop) const
 				//dummy = Xnew[i];
 				//std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(Xnew[i]);
+				pop.push_back(Xnew[i],fit[i]);
 				//pop.set_v(i,dummy);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
@@ -327,8 +174,8 @@ void sga::evolve(population &pop) const
 				prob.objfun(fit[i],Xnew[i]);
 				dummy = Xnew[i];
 				std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function and constraints)
-				pop.set_x(i,Xnew[i]);
+				//updates x and v (the fitness is already known, no re-evaluation is needed)
+				pop.set_xf(i,Xnew[i],fit[i]);
 				pop.set_v(i,dummy);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
@@ -347,14 +194,259 @@ void sga::evolve(population &pop) const
 			fit[worst] = bestfit;
 			dummy = Xnew[worst];
 			std::transform(dummy.begin(), dummy.end(), pop.get_individual(worst).cur_x.begin(), dummy.begin(),std::minus<double>());
-			//updates x and v (cache avoids to recompute the objective function)
-			pop.set_x(worst,Xnew[worst]);
+			//updates x and v (the fitness is already known, no re-evaluation is needed)
+			pop.set_xf(worst,Xnew[worst],fit[worst]);
 			pop.set_v(worst,dummy);
 		}
 		X = Xnew;
 	} // end of main SGA loop
 }
 
+// Builds in Xnew the offspring of the chromosomes X, whose fitnesses are fit, by selection, crossover and mutation.
+// NOTE: fit is reordered by the BEST20 selection.
+void sga::generate_offspring(std::vector<decision_vector> &Xnew, const std::vector<decision_vector> &X, std::vector<fitness_vector> &fit, const problem::base &prob) const
+{
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type NP = X.size();
+
+	std::vector<double> selectionfitness(NP), cumsum(NP), cumsumTemp(NP);
+	std::vector <int> selection(NP);
+
+	int tempID;
+	std::vector<int> fitnessID(NP);
+
+	switch (m_sel) {
+	case selection::BEST20: { //selects the best 20% and puts multiple copies in Xnew
+		//Sort the individuals according to their fitness
+		for (pagmo::population::size_type i=0; i<NP; i++) fitnessID[i]=i;
+		for (pagmo::population::size_type i=0; i < (NP-1); ++i) {
+			for (pagmo::population::size_type j=i+1; j<NP; ++j) {
+				if ( prob.compare_fitness(fit[j],fit[i]) ) {
+					//swap fitness values
+					fit[i].swap(fit[j]);
+					//swap id's
+					tempID = fitnessID[i];
+					fitnessID[i] = fitnessID[j];
+					fitnessID[j] = tempID;
+				}
+			}
+		}
+		int best20 = NP/5;
+		for (pagmo::population::size_type i=0; i<NP; ++i) {
+			selection[i] = fitnessID[i % best20];
+		}
+		break;
+	}
+
+	case selection::ROULETTE: {
+		//We scale all fitness values from 0 (worst) to absolute value of the best fitness
+		fitness_vector worstfit=fit[0];
+		for (pagmo::population::size_type i = 1; i < NP;i++) {
+			if (prob.compare_fitness(worstfit,fit[i])) worstfit=fit[i];
+		}
+
+		for (pagmo::population::size_type i = 0; i < NP; i++) {
+			selectionfitness[i] = fabs(worstfit[0] - fit[i][0]);
+		}
+
+		// We build and normalise the cumulative sum
+		cumsumTemp[0] = selectionfitness[0];
+		for (pagmo::population::size_type i = 1; i< NP; i++) {
+			cumsumTemp[i] = cumsumTemp[i - 1] + selectionfitness[i];
+		}
+		for (pagmo::population::size_type i = 0; i < NP; i++) {
+			cumsum[i] = cumsumTemp[i]/cumsumTemp[NP-1];
+		}
+
+		//we throw a dice and pick up the corresponding index
+		double r2;
+		for (pagmo::population::size_type i = 0; i < NP; i++) {
+			r2 = m_drng();
+			for (pagmo::population::size_type j = 0; j < NP; j++) {
+				if (cumsum[j] > r2) {
+					selection[i]=j;
+					break;
+				}
+			}
+		}
+		break;
+		}
+	}
+
+	//Xnew stores the new selected generation of chromosomes
+	for (pagmo::population::size_type i = 0; i < NP; i++) {
+		Xnew[i]=X[selection[i]];
+	}
+
+	//2 - Crossover
+	{
+		int r1,L;
+		decision_vector  member1,member2;
+
+		for (pagmo::population::size_type i=0; i< NP; i++) {
+			//for each chromosome selected i.e. in Xnew
+			member1 = Xnew[i];
+			//we select a mating patner different from the self (i.e. no masturbation)
+			do {
+				r1 = boost::uniform_int<int>(0,NP - 1)(m_urng);
+			} while ( r1 == boost::numeric_cast<int>(i) );
+			member2 = Xnew[r1];
+			//and we operate crossover
+			switch (m_cro) {
+				//0 - binomial crossover
+			case crossover::BINOMIAL: {
+				size_t n = boost::uniform_int<int>(0,D-1)(m_urng);
+				for (size_t L = 0; L < D; ++L) { /* perform D binomial trials */
+					if ((m_drng() < m_cr) || L + 1 == D) { /* change at least one parameter */
+						member1[n] = member2[n];
+					}
+					n = (n+1)%D;
+				}
+				break; }
+				//1 - exponential crossover
+			case crossover::EXPONENTIAL: {
+				size_t n = boost::uniform_int<int>(0,D-1)(m_urng);
+				L = 0;
+				do {
+					member1[n] = member2[n];
+					n = (n+1) % D;
+					L++;
+				}  while ( (m_drng() < m_cr) && (L < boost::numeric_cast<int>(D)) );
+				break; }
+			}
+			Xnew[i] = member1;
+
+		} }
+
+	//3 - Mutation
+	switch (m_mut.m_type) {
+	case mutation::GAUSSIAN: {
+		boost::normal_distribution<double> dist;
+		boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > delta(m_drng,dist);
+		for (pagmo::problem::base::size_type k = 0; k < Dc;k++) { //for each continuous variable
+			double std = (ub[k]-lb[k]) * m_mut.m_width;
+			for (pagmo::population::size_type i = 0; i < NP;i++) { //for each individual
+				if (m_drng() < m_m) {
+					double mean = Xnew[i][k];
+					double tmp = (delta() * std + mean);
+					if ( (tmp < ub[k]) &&  (tmp > lb[k]) ) Xnew[i][k] = tmp;
+				}
+			}
+		}
+		for (pagmo::problem::base::size_type k = Dc; k < D;k++) { //for each integer variable
+			double std = (ub[k]-lb[k]) * m_mut.m_width;
+			for (pagmo::population::size_type i = 0; i < NP;i++) { //for each individual
+				if (m_drng() < m_m) {
+					double mean = Xnew[i][k];
+					double tmp = boost::math::iround(delta() * std + mean);
+					if ( (tmp < ub[k]) &&  (tmp > lb[k]) ) Xnew[i][k] = tmp;
+				}
+			}
+		}
+		break;
+		}
+	case mutation::RANDOM: {
+		for (pagmo::population::size_type i = 0; i < NP;i++) {
+			for (pagmo::problem::base::size_type j = 0; j < Dc;j++) { //for each continuous variable
+				if (m_drng() < m_m) {
+					Xnew[i][j] = boost::uniform_real<double>(lb[j],ub[j])(m_drng);
+				}
+			}
+			for (pagmo::problem::base::size_type j = Dc; j < D;j++) {//for each integer variable
+				if (m_drng() < m_m) {
+					Xnew[i][j] = boost::uniform_int<int>(lb[j],ub[j])(m_urng);
+				}
+			}
+		}
+		break;
+		}
+	}
+}
+
+/// Ask for one generation of SGA offspring.
+/**
+ * Generates NP offspring by selection, crossover and mutation of the individuals of pop, as one generation of evolve() would.
+ *
+ * @param[in] pop population the offspring is generated from.
+ *
+ * @return the NP offspring chromosomes.
+ * @throws value_error if the problem/population are not suitable for SGA
+ */
+std::vector<decision_vector> sga::ask(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const population::size_type NP = pop.size();
+	if ( prob.get_c_dimension() != 0 ) {
+		pagmo_throw(value_error,"The problem is not box constrained and SGA is not suitable to solve it");
+	}
+	if ( prob.get_f_dimension() != 1 ) {
+		pagmo_throw(value_error,"The problem is not single objective and SGA is not suitable to solve it");
+	}
+	if (NP < 5) {
+		pagmo_throw(value_error,"for SGA at least 5 individuals in the population are needed");
+	}
+	std::vector<decision_vector> X(NP), Xnew(NP);
+	std::vector<fitness_vector> fit(NP);
+	for (pagmo::population::size_type i = 0; i<NP; i++ ) {
+		X[i]	=	pop.get_individual(i).cur_x;
+		fit[i]	=	pop.get_individual(i).cur_f;
+	}
+	generate_offspring(Xnew,X,fit,prob);
+	return Xnew;
+}
+
+/// Tell the fitnesses of the SGA offspring.
+/**
+ * The offspring replaces the population. Every elitism tells, the best chromosome found since the first tell
+ * (the best of the population at that time, or a better offspring) is reinserted in place of the worst offspring,
+ * as in evolve().
+ *
+ * @param[in,out] pop population the offspring was asked from.
+ * @param[in] x the offspring returned by ask().
+ * @param[in] f the fitnesses of the offspring.
+ * @throws value_error if x and f do not contain one element per individual.
+ */
+void sga::tell(population &pop, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f) const
+{
+	const problem::base &prob = pop.problem();
+	const population::size_type NP = pop.size();
+	check_told(pop,x,f,NP);
+
+	// As in evolve(), the best chromosome is the best of the population at the first tell, updated with
+	// every told offspring.
+	if (m_told == 0 || m_best_x.size() != prob.get_dimension()) {
+		const population::size_type bestidx = pop.get_best_idx();
+		m_best_x = pop.get_individual(bestidx).cur_x;
+		m_best_f = pop.get_individual(bestidx).cur_f;
+		m_told = 0;
+	}
+	decision_vector &bestX = m_best_x, dummy;
+	fitness_vector &bestfit = m_best_f;
+	for (pagmo::population::size_type i = 0; i < NP;i++) {
+		dummy = x[i];
+		std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
+		pop.set_xf(i,x[i],f[i]);
+		pop.set_v(i,dummy);
+		if (prob.compare_fitness(f[i], bestfit)) {
+			bestfit = f[i];
+			bestX = x[i];
+		}
+	}
+
+	if (m_told % m_elitism == 0) {
+		population::size_type worst=0;
+		for (pagmo::population::size_type i = 1; i < NP;i++) {
+			if ( prob.compare_fitness(f[worst],f[i]) ) worst=i;
+		}
+		dummy = bestX;
+		std::transform(dummy.begin(), dummy.end(), pop.get_individual(worst).cur_x.begin(), dummy.begin(),std::minus<double>());
+		pop.set_xf(worst,bestX,bestfit);
+		pop.set_v(worst,dummy);
+	}
+	++m_told;
+}
+
 /// Algorithm name
 std::string sga::get_name() const
 {
@@ -95,13 +95,16 @@ public:
 	    crossover::type cro = crossover::EXPONENTIAL);
 	base_ptr clone() const;
 	void evolve(population &) const;
+	std::vector<decision_vector> ask(const population &) const;
+	void tell(population &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &) const;
 	std::string get_name() const;
 protected:
 	std::string human_readable_extra() const;
 private:
+	void generate_offspring(std::vector<decision_vector> &, const std::vector<decision_vector> &, std::vector<fitness_vector> &, const problem::base &) const;
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<int &>(m_gen);
@@ -111,6 +114,12 @@ private:
 		ar & const_cast<mutation &>(m_mut);
 		ar & const_cast<selection::type &>(m_sel);
 		ar & const_cast<crossover::type &>(m_cro);
+		// The ask/tell state was added in version 1.
+		if (version >= 1) {
+			ar & m_told;
+			ar & m_best_x;
+			ar & m_best_f;
+		}
 	}  
 	//Number of generations
 	const int m_gen;
@@ -127,10 +136,16 @@ private:
 	const selection::type m_sel;
 	//Crossover_type
 	const crossover::type m_cro;
+	//Number of tell() calls so far (schedules elitism in the ask/tell interface)
+	mutable int m_told;
+	//Best chromosome and fitness found since the first tell() (reinserted by elitism in the ask/tell interface)
+	mutable decision_vector m_best_x;
+	mutable fitness_vector m_best_f;
 };
 
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::sga)
+BOOST_CLASS_VERSION(pagmo::algorithm::sga,1)
 
 #endif // PAGMO_ALGORITHM_SGA_H
@@ -177,7 +177,7 @@ void sga_gray::evolve(population &pop) const
 				//dummy = Xnew[i];
 				//std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(Xnew[i]);
+				pop.push_back(Xnew[i],fit[i]);
 				//pop.set_v(i,dummy);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
@@ -192,8 +192,8 @@ void sga_gray::evolve(population &pop) const
 				prob.objfun(fit[i],Xnew[i]);
 				dummy = Xnew[i];
 				std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function and constraints)
-				pop.set_x(i,Xnew[i]);
+				//updates x and v (the fitness is already known, no re-evaluation is needed)
+				pop.set_xf(i,Xnew[i],fit[i]);
 				pop.set_v(i,dummy);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
@@ -212,8 +212,8 @@ void sga_gray::evolve(population &pop) const
 			fit[worst] = bestfit;
 			dummy = Xnew[worst];
 			std::transform(dummy.begin(), dummy.end(), pop.get_individual(worst).cur_x.begin(), dummy.begin(),std::minus<double>());
-			//updates x and v (cache avoids to recompute the objective function)
-			pop.set_x(worst,Xnew[worst]);
+			//updates x and v (the fitness is already known, no re-evaluation is needed)
+			pop.set_xf(worst,Xnew[worst],fit[worst]);
 			pop.set_v(worst,dummy);
 		}
 		X = Xnew;
@@ -22,11 +22,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/functional/hash.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_io.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <cstddef>
@@ -40,6 +42,7 @@
 #include "archipelago.h"
 #include "algorithm/base.h"
 #include "base_island.h"
+#include "evolution_stats.h"
 #include "exceptions.h"
 #include "island.h"
 #include "population.h"
@@ -67,7 +70,7 @@ void archipelago::check_migr_attributes() const
  */
 archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),m_reeval_threads(1)
 {
 	check_migr_attributes();
 }
@@ -83,7 +86,7 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),m_reeval_threads(1)
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -106,7 +109,7 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),m_reeval_threads(1)
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -138,6 +141,7 @@ archipelago::archipelago(const archipelago &a)
 	m_drng = a.m_drng;
 	m_urng = a.m_urng;
 	m_migr_hist = a.m_migr_hist;
+	m_reeval_threads = a.m_reeval_threads;
 }
 
 /// Assignment operator.
@@ -166,6 +170,7 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_drng = a.m_drng;
 		m_urng = a.m_urng;
 		m_migr_hist = a.m_migr_hist;
+		m_reeval_threads = a.m_reeval_threads;
 	}
 	return *this;
 }
@@ -335,6 +340,33 @@ void archipelago::set_distribution_type(const archipelago::distribution_type &dt
 	m_dist_type = dt;
 }
 
+/// Get the number of threads used to re-evaluate immigrants.
+/**
+ * @return the maximum number of threads used by each island to re-evaluate its immigrants.
+ */
+unsigned int archipelago::get_reevaluation_threads() const {
+	return m_reeval_threads;
+}
+
+/// Set the number of threads used to re-evaluate immigrants.
+/**
+ * Before being inserted into an island, immigrants are re-evaluated on the problem of the destination island.
+ * With n greater than one, each island spreads these evaluations over at most n threads (see problem::base::evaluate_batch()).
+ * This is worth doing when the islands are fewer than the available cores and the objective function is expensive.
+ * The outcome of migration does not depend on n.
+ *
+ * @param[in] n maximum number of threads.
+ *
+ * @throws value_error if n is zero.
+ */
+void archipelago::set_reevaluation_threads(unsigned int n) {
+	if (n == 0) {
+		pagmo_throw(value_error,"the number of threads must be positive");
+	}
+	join();
+	m_reeval_threads = n;
+}
+
 /// Check whether an island is compatible with the archipelago.
 /**
  * Will return true if any of these conditions holds:
@@ -396,24 +428,56 @@ void archipelago::build_immigrants_vector(std::vector<std::pair<population::size
 	}
 }
 
+// Hash and equality of decision vectors accessed through pointers, used to detect repeated immigrants without copying them.
+struct decision_vector_ptr_hash
+{
+	std::size_t operator()(const decision_vector *x) const
+	{
+		return boost::hash_range(x->begin(),x->end());
+	}
+};
+
+struct decision_vector_ptr_equal
+{
+	bool operator()(const decision_vector *x1, const decision_vector *x2) const
+	{
+		return *x1 == *x2;
+	}
+};
+
 // Re-evaluate vector of immigrants before insertion into destination island.
+// The same individual often reaches an island from several neighbours (e.g., with broadcast distribution or densely connected
+// topologies): each distinct decision vector is evaluated only once, and all the evaluations are done in one batch.
 void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &immigrants, const base_island &isl) const
 {
-	individual_type tmp;
-	tmp.cur_v.resize(isl.m_pop.problem().get_dimension());
-	tmp.cur_f.resize(isl.m_pop.problem().get_f_dimension());
-	tmp.cur_c.resize(isl.m_pop.problem().get_c_dimension());
-	for (std::vector<std::pair<population::size_type, individual_type> >::iterator ind_it = immigrants.begin(); ind_it != immigrants.end(); ++ind_it) {
-		tmp.cur_x = (*ind_it).second.cur_x;
-		isl.m_pop.problem().objfun(tmp.cur_f,tmp.cur_x);
-		isl.m_pop.problem().compute_constraints(tmp.cur_c,tmp.cur_x);
+	typedef std::vector<std::pair<population::size_type, individual_type> >::size_type imm_size_type;
+	typedef boost::unordered_map<const decision_vector *,imm_size_type,decision_vector_ptr_hash,decision_vector_ptr_equal> position_map_type;
+	const problem::base &prob = isl.m_pop.problem();
+	// Distinct decision vectors, and position of each immigrant's one among them.
+	std::vector<decision_vector> x;
+	std::vector<imm_size_type> positions(immigrants.size());
+	position_map_type first_seen;
+	for (imm_size_type i = 0; i < immigrants.size(); ++i) {
+		const std::pair<position_map_type::iterator,bool> res = first_seen.insert(std::make_pair(&immigrants[i].second.cur_x,x.size()));
+		if (res.second) {
+			x.push_back(immigrants[i].second.cur_x);
+		}
+		positions[i] = res.first->second;
+	}
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	prob.evaluate_batch(f,c,x,m_reeval_threads);
+	for (imm_size_type i = 0; i < immigrants.size(); ++i) {
+		individual_type &ind = immigrants[i].second;
+		ind.cur_f = f[positions[i]];
+		ind.cur_c = c[positions[i]];
+		ind.cur_v.assign(prob.get_dimension(),0.);
 		// Set the best properties to the current ones. (TODO: maybe here one could
 		// reevaluate the old best in the new environment and keep it if still better than the
 		// reevaluated current ...... discuss!! (Anche no, grazie!!)
-		tmp.best_x = tmp.cur_x;
-		tmp.best_f = tmp.cur_f;
-		tmp.best_c = tmp.cur_c;
-		(*ind_it).second = tmp;
+		ind.best_x = ind.cur_x;
+		ind.best_f = ind.cur_f;
+		ind.best_c = ind.cur_c;
 	}
 }
 
@@ -466,23 +530,27 @@ void archipelago::pre_evolution(base_island &isl)
 		case destination:
 			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
 			// "database of best individuals" seen in the islands of the archipelago.
-			// Get neighbours connecting into isl.
-			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			// Get neighbours connecting into isl, and the corresponding migration probabilities.
+			const topology::base::csr_ptr csr = m_topology->get_csr();
+			const topology::base::csr_type::range_type inv_adj_islands(csr->get_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			const double *inv_adj_weights = csr->get_inv_adjacent_weights(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx));
+			const std::ptrdiff_t n_inv_adj = inv_adj_islands.second - inv_adj_islands.first;
 			// Do something only if there are adjacent islands.
-			if (inv_adj_islands.size()) {
+			if (n_inv_adj) {
 				switch (m_dist_type) {
 					case point_to_point:
 					{
 						lock_type lock(m_migr_mutex);
 						// Get the index of a random island connecting into isl.
-						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
+						boost::uniform_int<std::ptrdiff_t> u_int(0,n_inv_adj - 1);
+						const std::ptrdiff_t rn_pos = u_int(m_urng);
+						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands.first[rn_pos]);
 						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
 						// argument of the function.
 						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
 
 						double next_rng = m_drng();
-						double migr_prob = m_topology->get_weight(rn_isl_idx, isl_idx);
+						double migr_prob = inv_adj_weights[rn_pos];
 						if (next_rng < migr_prob) {
 							build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,m_migr_map[rn_isl_idx][rn_isl_idx]);
 						}
@@ -492,11 +560,11 @@ void archipelago::pre_evolution(base_island &isl)
 					{
 						lock_type lock(m_migr_mutex);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
-						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
-							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
+						for (std::ptrdiff_t i = 0; i < n_inv_adj; ++i) {
+							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands.first[i]);
 							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
 							double next_rng = m_drng();
-							double migr_prob = m_topology->get_weight(src_isl_idx, isl_idx);
+							double migr_prob = inv_adj_weights[i];
 							if (next_rng < migr_prob) {
 								build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
 							}
@@ -543,9 +611,12 @@ void archipelago::post_evolution(base_island &isl)
 	switch (m_migr_dir) {
 		case source:
 		{
-			// Get the islands to which isl connects.
-			const std::vector<topology::base::vertices_size_type> adj_islands(m_topology->get_v_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
-			if (adj_islands.size()) {
+			// Get the islands to which isl connects, and the corresponding migration probabilities.
+			const topology::base::csr_ptr csr = m_topology->get_csr();
+			const topology::base::csr_type::range_type adj_islands(csr->get_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			const double *adj_weights = csr->get_adjacent_weights(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx));
+			const std::ptrdiff_t n_adj = adj_islands.second - adj_islands.first;
+			if (n_adj) {
 				emigrants = isl.get_emigrants();
 				// Do something only if we have emigrants.
 				if (emigrants.size()) {
@@ -555,10 +626,11 @@ void archipelago::post_evolution(base_island &isl)
 						{
 							lock_type lock(m_migr_mutex);
 							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
-							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
+							boost::uniform_int<std::ptrdiff_t> u_int(0,n_adj - 1);
+							const std::ptrdiff_t chosen_pos = u_int(m_urng);
+							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands.first[chosen_pos]);
 							double next_rng = m_drng();
-							double migr_prob = m_topology->get_weight(isl_idx, chosen_adj);
+							double migr_prob = adj_weights[chosen_pos];
 							if (next_rng < migr_prob) {
 								m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
 							}
@@ -568,12 +640,12 @@ void archipelago::post_evolution(base_island &isl)
 						{
 							lock_type lock(m_migr_mutex);
 							// For broadcast migration put immigrants to all neighbour islands' inboxes.
-							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
+							for (std::ptrdiff_t i = 0; i < n_adj; ++i) {
 								double next_rng = m_drng();
-								double migr_prob = m_topology->get_weight(isl_idx, adj_islands[i]);
+								double migr_prob = adj_weights[i];
 								if (next_rng < migr_prob) {
-									m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-										.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
+									m_migr_map[boost::numeric_cast<size_type>(adj_islands.first[i])][isl_idx]
+										.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands.first[i])][isl_idx].end(),
 										emigrants.begin(),emigrants.end());
 								}
 							}
@@ -697,6 +769,65 @@ void archipelago::interrupt()
 	}
 }
 
+/// Return the evolution statistics of the archipelago.
+/**
+ * @return the statistics of all the islands (see base_island::get_stats()) merged together with evolution_stats::merge().
+ */
+evolution_stats archipelago::get_stats() const
+{
+	join();
+	evolution_stats retval;
+	const const_iterator it_f = m_container.end();
+	for (const_iterator it = m_container.begin(); it != it_f; ++it) {
+		retval.merge((*it)->get_stats());
+	}
+	return retval;
+}
+
+/// Return the evolution statistics of the islands.
+/**
+ * @return vector whose i-th element is the output of base_island::get_stats() for the i-th island.
+ */
+std::vector<evolution_stats> archipelago::get_island_stats() const
+{
+	join();
+	std::vector<evolution_stats> retval;
+	retval.reserve(m_container.size());
+	const const_iterator it_f = m_container.end();
+	for (const_iterator it = m_container.begin(); it != it_f; ++it) {
+		retval.push_back((*it)->get_stats());
+	}
+	return retval;
+}
+
+/// Reset the evolution statistics.
+/**
+ * Calls base_island::reset_stats() on all the islands.
+ */
+void archipelago::reset_stats()
+{
+	join();
+	const iterator it_f = m_container.end();
+	for (iterator it = m_container.begin(); it != it_f; ++it) {
+		(*it)->reset_stats();
+	}
+}
+
+/// Enable or disable objective function timing.
+/**
+ * Calls base_island::set_objfun_timing() on all the islands.
+ *
+ * @param[in] flag true to enable timing, false to disable it.
+ */
+void archipelago::set_objfun_timing(bool flag)
+{
+	join();
+	const iterator it_f = m_container.end();
+	for (iterator it = m_container.begin(); it != it_f; ++it) {
+		(*it)->set_objfun_timing(flag);
+	}
+}
+
 /// Island getter.
 /**
  * @param[in] idx index of the desired island.
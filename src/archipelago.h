@@ -40,6 +40,7 @@
 #include "algorithm/base.h"
 #include "base_island.h"
 #include "config.h"
+#include "evolution_stats.h"
 #include "population.h"
 #include "problem/base.h"
 #include "rng.h"
@@ -138,11 +139,17 @@ class __PAGMO_VISIBLE archipelago
 		void set_topology(const topology::base &);
 		distribution_type get_distribution_type() const;
 		void set_distribution_type(const distribution_type &);
+		unsigned int get_reevaluation_threads() const;
+		void set_reevaluation_threads(unsigned int);
 		void evolve(int = 1);
 		void evolve_batch(int, unsigned int, bool = true);
 		void evolve_t(int);
 		bool busy() const;
 		void interrupt();
+		evolution_stats get_stats() const;
+		std::vector<evolution_stats> get_island_stats() const;
+		void reset_stats();
+		void set_objfun_timing(bool);
 		std::string dump_migr_history() const;
 		void clear_migr_history();
 		void set_island(const size_type &, const base_island &);
@@ -175,6 +182,12 @@ class __PAGMO_VISIBLE archipelago
 			ar & m_migr_map;
 			ar & m_drng;
 			ar & m_urng;
+			// Archives written before version 1 reevaluate the immigrants serially.
+			if (version >= 1) {
+				ar & m_reeval_threads;
+			} else {
+				m_reeval_threads = 1;
+			}
 			// NOTE: this would need tuple serialization...
 			//ar & m_migr_hist;
 			boost::serialization::split_member(ar, *this, version);
@@ -213,6 +226,8 @@ class __PAGMO_VISIBLE archipelago
 		boost::mutex				m_migr_mutex;
 		// Migration history.
 		migr_hist_type				m_migr_hist;
+		// Number of threads used to re-evaluate immigrants.
+		unsigned int				m_reeval_threads;
 
 };
 
@@ -220,4 +235,6 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const archipelago
 
 }
 
+BOOST_CLASS_VERSION(pagmo::archipelago,1)
+
 #endif
@@ -22,6 +22,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/thread/thread.hpp>
@@ -40,6 +42,7 @@
 #include "algorithm/base.h"
 #include "archipelago.h"
 #include "base_island.h"
+#include "evolution_stats.h"
 #include "exceptions.h"
 #include "migration/base_r_policy.h"
 #include "migration/base_s_policy.h"
@@ -78,6 +81,7 @@ base_island::base_island(const base_island &isl):m_pop(isl.get_population())
 	m_algo = isl.m_algo->clone();
 	m_archi = isl.m_archi;
 	m_evo_time = isl.m_evo_time;
+	m_stats = isl.m_stats;
 	m_s_policy = isl.m_s_policy->clone();
 	m_r_policy = isl.m_r_policy->clone();
 	m_evo_thread.reset(0);
@@ -117,6 +121,7 @@ base_island &base_island::operator=(const base_island &isl)
 		m_pop = isl.m_pop;
 		m_archi = isl.m_archi;
 		m_evo_time = isl.m_evo_time;
+		m_stats = isl.m_stats;
 		m_s_policy = isl.m_s_policy->clone();
 		m_r_policy = isl.m_r_policy->clone();
 		m_evo_thread.reset(0);
@@ -233,6 +238,50 @@ struct base_island::raii_thread_hook
 	base_island *m_ptr;
 };
 
+// Difference between two readings of a problem's counter. The reading can decrease if the problem has been
+// replaced during the evolution, in which case nothing is counted.
+static boost::uint64_t counter_delta(const boost::uint64_t &before, const boost::uint64_t &after)
+{
+	return (after >= before) ? (after - before) : 0;
+}
+
+// Single evolution step: migration and problem hooks around one call to perform_evolution(), recording the evolution statistics.
+// NOTE: the problem is looked up again after each phase, as the evolution might replace the population.
+void base_island::evolution_step()
+{
+	const unsigned int fevals = m_pop.problem().get_fevals(), cevals = m_pop.problem().get_cevals(), cache_hits = m_pop.problem().get_cache_hits();
+	const boost::uint64_t t0 = stats_clock();
+	// Call pre-evolve hooks.
+	if (m_archi) {
+		m_archi->pre_evolution(*this);
+	}
+	const boost::uint64_t t1 = stats_clock(), o1 = m_pop.problem().get_objfun_time();
+	m_pop.problem().pre_evolution(m_pop);
+	// Call the evolution.
+	perform_evolution(*m_algo,m_pop);
+	const boost::uint64_t t2 = stats_clock(), o2 = m_pop.problem().get_objfun_time();
+	// Post-evolve hooks.
+	if (m_archi) {
+		m_archi->post_evolution(*this);
+	}
+	const boost::uint64_t t3 = stats_clock(), o3 = m_pop.problem().get_objfun_time();
+	m_pop.problem().post_evolution(m_pop);
+	const boost::uint64_t t4 = stats_clock(), o4 = m_pop.problem().get_objfun_time();
+	const boost::uint64_t evo_time = (t2 - t1) + (t4 - t3), migr_time = (t1 - t0) + (t3 - t2);
+	const boost::uint64_t objfun_time = std::min(counter_delta(o1,o2) + counter_delta(o3,o4),evo_time);
+	++m_stats.n_evolutions;
+	m_stats.fevals += counter_delta(fevals,m_pop.problem().get_fevals());
+	m_stats.cevals += counter_delta(cevals,m_pop.problem().get_cevals());
+	m_stats.cache_hits += counter_delta(cache_hits,m_pop.problem().get_cache_hits());
+	m_stats.objfun_time += objfun_time;
+	m_stats.algorithm_time += evo_time - objfun_time;
+	m_stats.evolution_latency.add(evo_time);
+	if (m_archi) {
+		m_stats.migration_time += migr_time;
+		m_stats.migration_latency.add(migr_time);
+	}
+}
+
 // Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 struct base_island::int_evolver {
 	int_evolver(base_island *i, const std::size_t &n):m_i(i),m_n(n) {}
@@ -247,22 +296,13 @@ void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
 	start = boost::posix_time::microsec_clock::local_time();
 	// Synchronise start with all other threads if we are in an archi.
 	if (m_i->m_archi) {
+		const boost::uint64_t wait_start = stats_clock();
 		m_i->m_archi->sync_island_start();
+		m_i->m_stats.barrier_time += stats_clock() - wait_start;
 	}
 	const raii_thread_hook hook(m_i);
 	for (std::size_t i = 0; i < m_n; ++i) {
-		// Call pre-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		// Call the evolution.
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		// Post-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolution_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 	}
@@ -331,19 +371,13 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 	start = boost::posix_time::microsec_clock::local_time();
 	// Synchronise start.
 	if (m_i->m_archi) {
+		const boost::uint64_t wait_start = stats_clock();
 		m_i->m_archi->sync_island_start();
+		m_i->m_stats.barrier_time += stats_clock() - wait_start;
 	}
 	const raii_thread_hook hook(m_i);
 	do {
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolution_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 		diff = boost::posix_time::microsec_clock::local_time() - start;
@@ -437,6 +471,48 @@ std::size_t base_island::get_evolution_time() const
 	return m_evo_time;
 }
 
+/// Return the evolution statistics.
+/**
+ * The counters and timers are accumulated over all the evolutions performed by the island since its construction
+ * or the last call to reset_stats(). The objective function latency histogram is the one recorded by the problem
+ * (see problem::base::set_objfun_timing()).
+ *
+ * @return a snapshot of the evolution statistics of the island.
+ */
+evolution_stats base_island::get_stats() const
+{
+	join();
+	evolution_stats retval(m_stats);
+	retval.objfun_latency = m_pop.problem().get_objfun_latency();
+	return retval;
+}
+
+/// Reset the evolution statistics.
+/**
+ * Sets all the counters, timers and histograms of the island to zero, including the objective function timing of the problem.
+ */
+void base_island::reset_stats()
+{
+	join();
+	m_stats = evolution_stats();
+	if (m_pop.problem().get_objfun_timing()) {
+		m_pop.m_prob->set_objfun_timing(true);
+	}
+}
+
+/// Enable or disable objective function timing.
+/**
+ * Calls problem::base::set_objfun_timing() on the problem of the island. When timing is disabled, the time spent in the objective
+ * function is reported as algorithm time by get_stats().
+ *
+ * @param[in] flag true to enable timing, false to disable it.
+ */
+void base_island::set_objfun_timing(bool flag)
+{
+	join();
+	m_pop.m_prob->set_objfun_timing(flag);
+}
+
 /// Return copy of the internal algorithm.
 /**
  * @return algorithm::base_ptr to the cloned algorithm.
@@ -566,12 +642,14 @@ std::vector<std::pair<population::size_type, archipelago::size_type> > base_isla
 	// We extract the immigrants from the pair
 	std::vector<population::individual_type> immigrants;
 	immigrants.reserve(immigrant_pairs.size());
+	m_stats.migrants_received += immigrant_pairs.size();
 	for (size_t i=0;i<immigrant_pairs.size();++i) {
 		immigrants.push_back(immigrant_pairs[i].second);
 	}
 	
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > rep;
 	rep = m_r_policy->select(immigrants,m_pop);
+	m_stats.migrants_accepted += rep.size();
 	for (std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> >::const_iterator
 		rep_it = rep.begin(); rep_it != rep.end(); ++rep_it)
 	{
@@ -595,7 +673,9 @@ std::vector<std::pair<population::size_type, archipelago::size_type> > base_isla
 // Get individuals migrating from here.
 std::vector<population::individual_type> base_island::get_emigrants() 
 {
-	return m_s_policy->select(m_pop);
+	std::vector<population::individual_type> retval(m_s_policy->select(m_pop));
+	m_stats.migrants_sent += retval.size();
+	return retval;
 }
 
 /// Overload stream operator for pagmo::base_island.
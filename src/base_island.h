@@ -35,6 +35,7 @@
 
 #include "config.h"
 #include "algorithm/base.h"
+#include "evolution_stats.h"
 #include "migration/base_r_policy.h"
 #include "migration/base_s_policy.h"
 #include "population.h"
@@ -122,6 +123,9 @@ class __PAGMO_VISIBLE base_island
 		void evolve_t(int);
 		void interrupt();
 		std::size_t get_evolution_time() const;
+		evolution_stats get_stats() const;
+		void reset_stats();
+		void set_objfun_timing(bool);
 	protected:
 		/// Method that implements the evolution of the population.
 		virtual void perform_evolution(const algorithm::base &, population &) const = 0;
@@ -147,6 +151,7 @@ class __PAGMO_VISIBLE base_island
 		// but this creates problems as at this point archipelago::siz_type is not defined and cannot be!!!
 		std::vector<std::pair<population::size_type, population::size_type> > accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &);
 		std::vector<population::individual_type> get_emigrants();
+		void evolution_step();
 		// Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 		struct int_evolver;
 		// Time-dependent evolver thread object. This is a callable helper object used to launch an evolution for a specified amount of time.
@@ -163,6 +168,8 @@ class __PAGMO_VISIBLE base_island
 		archipelago				*m_archi;
 		/// Total time spent by the island on evolution (in milliseconds).
 		std::size_t				m_evo_time;
+		/// Evolution statistics.
+		evolution_stats				m_stats;
 		/// Migration selection policy.
 		migration::base_s_policy_ptr		m_s_policy;
 		/// Migration replacement policy.
@@ -180,6 +187,12 @@ class __PAGMO_VISIBLE base_island
 			ar & m_algo;
 			ar & m_pop;
 			ar & m_evo_time;
+			// Archives written before version 1 have no statistics.
+			if (version >= 1) {
+				ar & m_stats;
+			} else {
+				m_stats = evolution_stats();
+			}
 			ar & m_s_policy;
 			ar & m_r_policy;
 			boost::serialization::split_member(ar, *this, version);
@@ -235,5 +248,6 @@ class island_init: public base
 }
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::base_island)
+BOOST_CLASS_VERSION(pagmo::base_island,1)
 
 #endif
@@ -0,0 +1,225 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "evolution_stats.h"
+#include "exceptions.h"
+
+namespace pagmo {
+
+/// Default constructor.
+/**
+ * Builds an empty histogram.
+ */
+latency_histogram::latency_histogram()
+{
+	clear();
+}
+
+/// Add a duration.
+/**
+ * @param[in] ns duration in nanoseconds.
+ */
+void latency_histogram::add(const boost::uint64_t &ns)
+{
+	// Bucket index is the number of significant bits of ns, saturated to the last bucket.
+	std::size_t idx = 0;
+	for (boost::uint64_t tmp = ns; tmp != 0 && idx < n_buckets - 1; tmp >>= 1) {
+		++idx;
+	}
+	++m_buckets[idx];
+	++m_count;
+	m_total += ns;
+	m_max = std::max(m_max,ns);
+}
+
+/// Merge with another histogram.
+/**
+ * @param[in] other histogram whose counts will be added to this.
+ */
+void latency_histogram::merge(const latency_histogram &other)
+{
+	for (std::size_t i = 0; i < n_buckets; ++i) {
+		m_buckets[i] += other.m_buckets[i];
+	}
+	m_count += other.m_count;
+	m_total += other.m_total;
+	m_max = std::max(m_max,other.m_max);
+}
+
+/// Reset the histogram.
+void latency_histogram::clear()
+{
+	m_buckets.assign(0);
+	m_count = 0;
+	m_total = 0;
+	m_max = 0;
+}
+
+/// Number of recorded durations.
+boost::uint64_t latency_histogram::get_count() const
+{
+	return m_count;
+}
+
+/// Sum of the recorded durations, in nanoseconds.
+boost::uint64_t latency_histogram::get_total() const
+{
+	return m_total;
+}
+
+/// Longest recorded duration, in nanoseconds.
+boost::uint64_t latency_histogram::get_max() const
+{
+	return m_max;
+}
+
+/// Bucket counts.
+/**
+ * @return vector of size latency_histogram::n_buckets, whose i-th element is the number of durations recorded in the i-th bucket.
+ */
+std::vector<boost::uint64_t> latency_histogram::get_buckets() const
+{
+	return std::vector<boost::uint64_t>(m_buckets.begin(),m_buckets.end());
+}
+
+/// Approximate quantile.
+/**
+ * @param[in] q quantile, in the [0,1] range.
+ *
+ * @return upper bound of the bucket containing the q-quantile of the recorded durations (capped at the longest recorded duration),
+ * or 0 if the histogram is empty.
+ *
+ * @throws value_error if q is not in the [0,1] range.
+ */
+boost::uint64_t latency_histogram::get_quantile(const double &q) const
+{
+	if (!(q >= 0 && q <= 1)) {
+		pagmo_throw(value_error,"quantile must be in the [0,1] range");
+	}
+	if (m_count == 0) {
+		return 0;
+	}
+	// Rank of the requested duration, 1-based.
+	const boost::uint64_t rank = std::max<boost::uint64_t>(static_cast<boost::uint64_t>(q * static_cast<double>(m_count) + .5),1);
+	boost::uint64_t cum = 0;
+	std::size_t i = 0;
+	for (; i < n_buckets - 1; ++i) {
+		cum += m_buckets[i];
+		if (cum >= rank) {
+			break;
+		}
+	}
+	if (i == n_buckets - 1) {
+		return m_max;
+	}
+	return std::min(boost::uint64_t(1) << i,m_max);
+}
+
+/// Return human readable representation of the histogram.
+std::string latency_histogram::human_readable() const
+{
+	std::ostringstream oss;
+	oss << "count: " << m_count;
+	if (m_count) {
+		oss << ", mean: " << m_total / m_count << " ns, p50: " << get_quantile(.5) << " ns, p99: " << get_quantile(.99) << " ns, max: " << m_max << " ns";
+	}
+	return oss.str();
+}
+
+/// Default constructor.
+/**
+ * All counters and timers are set to zero.
+ */
+evolution_stats::evolution_stats():n_evolutions(0),fevals(0),cevals(0),cache_hits(0),migrants_sent(0),migrants_received(0),
+	migrants_accepted(0),objfun_time(0),algorithm_time(0),migration_time(0),barrier_time(0)
+{}
+
+/// Merge with other statistics.
+/**
+ * Counters and timers are summed, histograms are merged.
+ *
+ * @param[in] other statistics to be added to this.
+ */
+void evolution_stats::merge(const evolution_stats &other)
+{
+	n_evolutions += other.n_evolutions;
+	fevals += other.fevals;
+	cevals += other.cevals;
+	cache_hits += other.cache_hits;
+	migrants_sent += other.migrants_sent;
+	migrants_received += other.migrants_received;
+	migrants_accepted += other.migrants_accepted;
+	objfun_time += other.objfun_time;
+	algorithm_time += other.algorithm_time;
+	migration_time += other.migration_time;
+	barrier_time += other.barrier_time;
+	evolution_latency.merge(other.evolution_latency);
+	migration_latency.merge(other.migration_latency);
+	objfun_latency.merge(other.objfun_latency);
+}
+
+/// Return human readable representation of the statistics.
+std::string evolution_stats::human_readable() const
+{
+	std::ostringstream oss;
+	oss << "Evolutions:\t\t" << n_evolutions << '\n';
+	oss << "Function evaluations:\t" << fevals << '\n';
+	oss << "Constraints evaluations:\t" << cevals << '\n';
+	oss << "Cache hits:\t\t" << cache_hits << '\n';
+	oss << "Migrants sent:\t\t" << migrants_sent << '\n';
+	oss << "Migrants received:\t" << migrants_received << '\n';
+	oss << "Migrants accepted:\t" << migrants_accepted << '\n';
+	oss << "Objective function time:\t" << objfun_time << " ns\n";
+	oss << "Algorithm time:\t\t" << algorithm_time << " ns\n";
+	oss << "Migration time:\t\t" << migration_time << " ns\n";
+	oss << "Barrier time:\t\t" << barrier_time << " ns\n";
+	oss << "Evolution latency:\t" << evolution_latency.human_readable() << '\n';
+	oss << "Migration latency:\t" << migration_latency.human_readable() << '\n';
+	oss << "Objective function latency:\t" << objfun_latency.human_readable() << '\n';
+	return oss.str();
+}
+
+/// Overload stream operator for pagmo::evolution_stats.
+/**
+ * Equivalent to printing evolution_stats::human_readable() to stream.
+ *
+ * @param[in] s stream to which the statistics will be sent.
+ * @param[in] stats statistics to be sent to stream.
+ *
+ * @return reference to s.
+ */
+std::ostream &operator<<(std::ostream &s, const evolution_stats &stats)
+{
+	s << stats.human_readable();
+	return s;
+}
+
+}
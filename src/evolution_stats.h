@@ -0,0 +1,164 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_EVOLUTION_STATS_H
+#define PAGMO_EVOLUTION_STATS_H
+
+#include <boost/array.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "serialization.h"
+
+namespace pagmo {
+
+/// Monotonic clock used by the evolution statistics.
+/**
+ * @return the current value of a monotonic clock, in nanoseconds from an arbitrary origin.
+ */
+inline boost::uint64_t stats_clock()
+{
+	return static_cast<boost::uint64_t>(boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+		boost::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Latency histogram.
+/**
+ * Counts durations, expressed in nanoseconds, in logarithmic buckets: bucket 0 holds durations shorter than 1 nanosecond,
+ * bucket i > 0 holds durations in the [2^(i-1),2^i) range. The last bucket also holds all the longer durations.
+ * Adding a duration costs a few integer operations and no allocation, and histograms can be merged.
+ */
+class __PAGMO_VISIBLE latency_histogram
+{
+	public:
+		/// Number of buckets.
+		static const std::size_t n_buckets = 48;
+		latency_histogram();
+		void add(const boost::uint64_t &);
+		void merge(const latency_histogram &);
+		void clear();
+		boost::uint64_t get_count() const;
+		boost::uint64_t get_total() const;
+		boost::uint64_t get_max() const;
+		std::vector<boost::uint64_t> get_buckets() const;
+		boost::uint64_t get_quantile(const double &) const;
+		std::string human_readable() const;
+	private:
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			for (std::size_t i = 0; i < n_buckets; ++i) {
+				ar & m_buckets[i];
+			}
+			ar & m_count;
+			ar & m_total;
+			ar & m_max;
+		}
+		boost::array<boost::uint64_t,n_buckets>	m_buckets;
+		boost::uint64_t				m_count;
+		boost::uint64_t				m_total;
+		boost::uint64_t				m_max;
+};
+
+/// Evolution statistics.
+/**
+ * Snapshot of the counters and timers collected by an island (see base_island::get_stats()) or by all the islands
+ * of an archipelago (see archipelago::get_stats()). All times are in nanoseconds.
+ *
+ * Each evolution step of an island is split in three phases:
+ * - the archipelago's migration hooks, before and after the step (migration time, including the re-evaluation of immigrants),
+ * - the evolution of the population by the algorithm, together with the problem's hooks, of which the time spent inside the objective function
+ *   is reported separately (objective function time and algorithm time),
+ * - the wait at the barrier synchronising the start of the islands of an archipelago (barrier time).
+ *
+ * The objective function time is measured only when timing is enabled on the problem (see problem::base::set_objfun_timing()),
+ * otherwise it is zero and the whole evolution time is reported as algorithm time.
+ */
+struct __PAGMO_VISIBLE evolution_stats
+{
+	evolution_stats();
+	void merge(const evolution_stats &);
+	std::string human_readable() const;
+	/// Number of evolution steps (calls to algorithm::base::evolve()).
+	boost::uint64_t		n_evolutions;
+	/// Objective function evaluations.
+	boost::uint64_t		fevals;
+	/// Constraints evaluations.
+	boost::uint64_t		cevals;
+	/// Objective function and constraints calls served by the problem caches.
+	boost::uint64_t		cache_hits;
+	/// Individuals selected for emigration by the selection policy.
+	boost::uint64_t		migrants_sent;
+	/// Individuals received from other islands and offered to the replacement policy.
+	boost::uint64_t		migrants_received;
+	/// Received individuals inserted into the population by the replacement policy.
+	boost::uint64_t		migrants_accepted;
+	/// Time spent in the objective function during evolution.
+	boost::uint64_t		objfun_time;
+	/// Time spent by the algorithm during evolution, excluding the objective function.
+	boost::uint64_t		algorithm_time;
+	/// Time spent in migration.
+	boost::uint64_t		migration_time;
+	/// Time spent waiting for the other islands at the start of the evolution.
+	boost::uint64_t		barrier_time;
+	/// Latency of the evolution steps (algorithm and objective function).
+	latency_histogram	evolution_latency;
+	/// Latency of the migration steps.
+	latency_histogram	migration_latency;
+	/// Latency of the objective function (only if timing is enabled on the problem).
+	latency_histogram	objfun_latency;
+	private:
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & n_evolutions;
+			ar & fevals;
+			ar & cevals;
+			ar & cache_hits;
+			ar & migrants_sent;
+			ar & migrants_received;
+			ar & migrants_accepted;
+			ar & objfun_time;
+			ar & algorithm_time;
+			ar & migration_time;
+			ar & barrier_time;
+			ar & evolution_latency;
+			ar & migration_latency;
+			ar & objfun_latency;
+		}
+};
+
+std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const evolution_stats &);
+
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "../population.h"
+#include "../problem/base.h"
 #include "base.h"
 #include "base_r_policy.h"
 #include "fair_r_policy.h"
@@ -48,87 +49,80 @@ base_r_policy_ptr fair_r_policy::clone() const
 	return base_r_policy_ptr(new fair_r_policy(*this));
 }
 
-// Helper object used to sort arrays of indices of object placed in another container.
-template <class Container>
-struct indirect_individual_sorter
+// Orders immigrants from best to worst according to problem::base::compare_fc().
+struct immigrants_comparison
 {
-	indirect_individual_sorter(const Container &container, const population &pop):
-		m_container(container),m_pop(pop) {}
-	template <class Idx>
-	bool operator()(const Idx &idx1, const Idx &idx2) const
+	immigrants_comparison(const std::vector<population::individual_type> &immigrants, const problem::base &prob):
+		m_immigrants(immigrants),m_prob(prob) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
 	{
-		typedef typename Container::const_iterator::difference_type diff_type;
-		return m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx1))) >
-			m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx2)));
+		return m_prob.compare_fc(m_immigrants[idx1].cur_f,m_immigrants[idx1].cur_c,m_immigrants[idx2].cur_f,m_immigrants[idx2].cur_c);
 	}
-	// The original container.
-	const Container		&m_container;
-	const population	&m_pop;
+	const std::vector<population::individual_type>	&m_immigrants;
+	const problem::base				&m_prob;
 };
 
 // Selection implementation.
+/*
+ * Ranking natives and immigrants together, the i-th best immigrant replaces the i-th worst native if it is ranked before it.
+ * As the immigrants get worse and the natives get better along the two rankings, only the best rate_limit immigrants and the
+ * worst rate_limit natives need to be ordered.
+ */
 std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> >
 	fair_r_policy::select(const std::vector<population::individual_type> &immigrants, const population &dest) const
 {
 	// Computes the number of immigrants to be selected (accounting for the destination pop size)
 	const population::size_type rate_limit = std::min<population::size_type>(get_n_individuals(dest),boost::numeric_cast<population::size_type>(immigrants.size()));
-	
+
 	// Defines the retvalue
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result;
+	if (!rate_limit) {
+		return result;
+	}
 
-	// Makes a copy of the destination population
+	if (dest.problem().get_f_dimension() == 1) {
+		// Single objective: the comparison with the natives does not depend on the other individuals, so
+		// the first rate_limit immigrants are sorted on their own and the natives are ranked in place.
+		std::vector<population::size_type> immigrants_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(rate_limit));
+		iota(immigrants_idx.begin(),immigrants_idx.end(),population::size_type(0));
+		std::sort(immigrants_idx.begin(),immigrants_idx.end(),immigrants_comparison(immigrants,dest.problem()));
+		const std::vector<population::size_type> dest_idx(dest.get_worst_idx(rate_limit));
+		for (population::size_type i = 0; i < rate_limit; ++i) {
+			const population::individual_type &imm = immigrants[immigrants_idx[i]], &native = dest.get_individual(dest_idx[i]);
+			if (!dest.problem().compare_fc(imm.cur_f,imm.cur_c,native.cur_f,native.cur_c)) {
+				break;
+			}
+			result.push_back(std::make_pair(dest_idx[i],immigrants_idx[i]));
+		}
+		return result;
+	}
+
+	// Multi objective: Pareto ranks and crowding distances depend on the whole set, so they are computed on a population
+	// combining all (immigrants come with their fitness, no function evaluation is performed here).
 	population pop_copy(dest);
-	
-	// Creates a population combining all (INEFFICIENT: not-needed function evaluations are performed here)
 	for (population::size_type i  = 0; i < rate_limit; ++i) {
-		pop_copy.push_back(immigrants[i].cur_x);
+		pop_copy.push_back(immigrants[i].cur_x,immigrants[i].cur_f);
 	}
-	
-	// Extracts the best of the combined population
-	std::vector<population::size_type> best_idx(pop_copy.get_best_idx(pop_copy.size()));
-	
-	std::vector<population::size_type>::iterator left = best_idx.begin();
-	std::vector<population::size_type>::iterator right = best_idx.end() - 1;
-	
-	// Best idx now contains, sorted, all indexes of the augmented pop. Indexes from 0 to pop.size()
-	// belong to the original population, the others are immigrants
-	while (left < right) {
-		// If the index belongs to one of the immigrants
-		if (*left >= dest.size()) {
-			// Move the right iterator up to when it points to the worst of the natives
-			while (*right >= dest.size()) {
-				--right;
-			};
-			if (right>left) {
-				result.push_back(std::make_pair(*right,*left-dest.size()));
-			--right;
-			}
+	pop_copy.update_pareto_information();
+	// Gather the keys once: natives first, then immigrants.
+	std::vector<population::crowded_key> keys(pop_copy.size());
+	for (population::size_type i = 0; i < pop_copy.size(); ++i) {
+		keys[i].rank = pop_copy.get_pareto_rank(i);
+		keys[i].crowding_d = pop_copy.get_crowding_d(i);
+		keys[i].idx = i;
+	}
+	const std::vector<population::crowded_key>::iterator immigrants_begin = keys.begin() + boost::numeric_cast<std::vector<population::crowded_key>::difference_type>(dest.size());
+	// Immigrants from best to worst.
+	std::sort(immigrants_begin,keys.end(),population::crowded_key_comparison(false));
+	// Natives from worst to best.
+	population::partial_rank(keys.begin(),immigrants_begin,rate_limit,population::crowded_key_comparison(true));
+	for (population::size_type i = 0; i < rate_limit; ++i) {
+		const population::crowded_key &imm = *(immigrants_begin + boost::numeric_cast<std::vector<population::crowded_key>::difference_type>(i)), &native = keys[i];
+		if (!imm.is_better(native)) {
+			break;
 		}
-		++left;
+		result.push_back(std::make_pair(native.idx,imm.idx - dest.size()));
 	}
-	
-	
-	// Temporary vectors to store sorted indices of the populations.
-//	std::vector<population::size_type> immigrants_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(immigrants.size()));
-//	std::vector<population::size_type> dest_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(dest.size()));
-	// Fill in the arrays of indices.
-//	iota(immigrants_idx.begin(),immigrants_idx.end(),population::size_type(0));
-//	iota(dest_idx.begin(),dest_idx.end(),population::size_type(0));
-	// Sort the arrays of indices.
-	// From best to worst.
-//	std::sort(immigrants_idx.begin(),immigrants_idx.end(),indirect_individual_sorter<std::vector<population::individual_type> >(immigrants,dest));
-	// From worst to best.
-//	std::sort(dest_idx.begin(),dest_idx.end(),indirect_individual_sorter<population>(dest,dest));
-//	std::reverse(dest_idx.begin(),dest_idx.end());
-	// Create the result.
-//	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result;
-//	for (population::size_type i = 0; i < rate_limit; ++i) {
-//		if (dest.n_dominated(immigrants[immigrants_idx[boost::numeric_cast<std::vector<population::size_type>::size_type>(i)]]) >
-//		dest.n_dominated(*(dest.begin() + dest_idx[boost::numeric_cast<std::vector<population::size_type>::size_type>(i)])))
-//		{
-//			result.push_back(std::make_pair(dest_idx[i],immigrants_idx[i]));
-//		}
-//	}
 	return result;
 }
 
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -34,6 +35,7 @@
 #include "hv_greedy_r_policy.h"
 #include "fair_r_policy.h"
 
+#include "../util/hv_contributions.h"
 #include "../util/hypervolume.h"
 
 using namespace pagmo::util;
@@ -112,9 +114,9 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Makes a copy of the destination population
 	population pop_copy(dest);
 
-	// Merge the immigrants to the copy of the destination population
+	// Merge the immigrants to the copy of the destination population (immigrants come with their fitness, no re-evaluation)
 	for (population::size_type i  = 0; i < rate_limit; ++i) {
-		pop_copy.push_back(filtered_immigrants[i].cur_x);
+		pop_copy.push_back(filtered_immigrants[i].cur_x,filtered_immigrants[i].cur_f);
 	}
 
 	// Population fronts stored as indices of individuals.
@@ -148,9 +150,8 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	unsigned int front_idx = fronts_i.size() - 1;
 	unsigned int processed_individuals = 0;
 
-	// Vector for maintaining the original indices of points for given front
-	std::vector<unsigned int> orig_indices(fronts_i[front_idx].size());
-	iota(orig_indices.begin(), orig_indices.end(), 0);
+	// Contributions of the points of the current front, updated incrementally as the points are discarded
+	boost::scoped_ptr<hv_contributions> contributions(new hv_contributions(fronts_f[front_idx], refpoint));
 
 	// Vector for maintaining the original indices of points for augmented population as 0 and 1
 	std::vector<unsigned int> g_orig_indices(pop_copy.size(), 1);
@@ -164,20 +165,13 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Stops when we reduce the augmented population to the size of the original population or when the number of discarded islanders reaches the limit
 	while (processed_individuals < filtered_immigrants.size() && discarded_islanders.size() < rate_limit) {
 		// If current front is depleted, load next front.
-		if (fronts_f[front_idx].size() == 0) {
-			// Decrease front and reset the orig_indices
+		if (contributions->size() == 0) {
 			--front_idx;
-			orig_indices.resize(fronts_i[front_idx].size());
-			iota(orig_indices.begin(), orig_indices.end(), 0);
+			contributions.reset(new hv_contributions(fronts_f[front_idx], refpoint));
 		}
 
-		// Initiate the hypervolume object and compute the least contributor
-		hypervolume hv(fronts_f[front_idx], false);
-		hv.set_copy_points(false);
-		unsigned int lc_idx = hv.least_contributor(refpoint);
-
-		// Fix the index shift
-		unsigned int orig_lc_idx = fronts_i[front_idx][orig_indices[lc_idx]];
+		// Remove the least contributor from the front
+		unsigned int orig_lc_idx = fronts_i[front_idx][contributions->pop_least()];
 
 		if (orig_lc_idx < dest.size()) {
 			discarded_islanders.push_back(std::make_pair(orig_lc_idx, 0.0));
@@ -187,10 +181,6 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 
 		// Flag given individual as discarded
 		g_orig_indices[orig_lc_idx] = 0;
-
-		// Drop the local index, and the point from the front
-		orig_indices.erase(orig_indices.begin() + lc_idx);
-		fronts_f[front_idx].erase(fronts_f[front_idx].begin() + lc_idx);
 		++processed_individuals;
 	}
 
@@ -216,15 +206,17 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		merged_fronts.push_back(pop_copy.get_individual(idx).cur_f);
 	}
 
+	// A single contributions pass is cheaper than one exclusive computation per point
 	hypervolume hv(merged_fronts, false);
+	const std::vector<double> c = hv.contributions(refpoint);
 	std::vector<std::pair<unsigned int, double> >::iterator it;
 
 	for(it = available_immigrants.begin() ; it != available_immigrants.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = c[(*it).first];
 	}
 
 	for(it = discarded_islanders.begin() ; it != discarded_islanders.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = c[(*it).first];
 	}
 
 	// Sort islanders and immigrants according to exclusive hypervolume
@@ -32,7 +32,7 @@
 #include "hv_greedy_s_policy.h"
 #include "best_s_policy.h"
 #include "../exceptions.h"
-#include "../util/hypervolume.h"
+#include "../util/hv_contributions.h"
 
 using namespace pagmo::util;
 
@@ -96,9 +96,6 @@ std::vector<population::individual_type> hv_greedy_s_policy::select(population &
 	unsigned int front_idx = 0;
 	unsigned int processed_individuals = 0;
 
-	// Vector for maintaining the original indices of points
-	std::vector<unsigned int> orig_indices;
-
 	while (processed_individuals < migration_rate) {
 		// If we need to pull every point from given front anyway, just push back the individuals right away
 		if (fronts_f[front_idx].size() <= (migration_rate - processed_individuals)) {
@@ -109,22 +106,13 @@ std::vector<population::individual_type> hv_greedy_s_policy::select(population &
 			processed_individuals += fronts_f[front_idx].size();
 			++front_idx;
 		} else {
-			// Prepare the vector for the original indices
-			if (orig_indices.size() == 0) {
-				orig_indices.resize(fronts_i[front_idx].size());
-				iota(orig_indices.begin(), orig_indices.end(), 0);
+			// Only part of the front is needed: extract the greatest contributors one at a time,
+			// updating the contributions of the remaining points incrementally.
+			hv_contributions contributions(fronts_f[front_idx], refpoint);
+			while (processed_individuals < migration_rate) {
+				result.push_back(pop.get_individual(fronts_i[front_idx][contributions.pop_greatest()]));
+				++processed_individuals;
 			}
-
-			// Compute the greatest contributor
-			hypervolume hv(fronts_f[front_idx], false);
-			hv.set_copy_points(false);
-			unsigned int gc_idx = hv.greatest_contributor(refpoint);
-			result.push_back(pop.get_individual(fronts_i[front_idx][orig_indices[gc_idx]]));
-			
-			// Remove it from the front along with its index
-			orig_indices.erase(orig_indices.begin() + gc_idx);
-			fronts_f[front_idx].erase(fronts_f[front_idx].begin() + gc_idx);
-			++processed_individuals;
 		}
 	}
 
@@ -48,22 +48,22 @@ base_r_policy_ptr worst_r_policy::clone() const
 	return base_r_policy_ptr(new worst_r_policy(*this));
 }
 
-// Helper object used to sort arrays of indices of object placed in another container.
-template <class Container>
-struct indirect_individual_sorter
+// Flat ranking key of an individual: number of individuals of the destination population it dominates, and its position.
+typedef std::pair<population::size_type,population::size_type> domination_key;
+
+// Orders domination keys from the most to the least dominating individual (or the opposite if worst_first is true).
+// Ties are broken by position, so that the outcome does not depend on the sorting algorithm.
+struct domination_key_comparison
 {
-	indirect_individual_sorter(const Container &container, const population &pop):
-		m_container(container),m_pop(pop) {}
-	template <class Idx>
-	bool operator()(const Idx &idx1, const Idx &idx2) const
+	domination_key_comparison(bool worst_first):m_worst_first(worst_first) {}
+	bool operator()(const domination_key &k1, const domination_key &k2) const
 	{
-		typedef typename Container::const_iterator::difference_type diff_type;
-		return m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx1))) >
-			m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx2)));
+		if (k1.first != k2.first) {
+			return m_worst_first ? (k1.first < k2.first) : (k1.first > k2.first);
+		}
+		return k1.second < k2.second;
 	}
-	// The original container.
-	const Container		&m_container;
-	const population	&m_pop;
+	bool m_worst_first;
 };
 
 // Selection implementation.
@@ -71,23 +71,27 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	worst_r_policy::select(const std::vector<population::individual_type> &immigrants, const population &dest) const
 {
 	const population::size_type rate_limit = std::min<population::size_type>(get_n_individuals(dest),boost::numeric_cast<population::size_type>(immigrants.size()));
-	// Temporary vectors to store sorted indices of the populations.
-	std::vector<population::size_type> immigrants_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(immigrants.size()));
-	std::vector<population::size_type> dest_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(dest.size()));
-	// Fill in the arrays of indices.
-	iota(immigrants_idx.begin(),immigrants_idx.end(),population::size_type(0));
-	iota(dest_idx.begin(),dest_idx.end(),population::size_type(0));
-	// Sort the arrays of indices.
-	// From best to worst.
-	std::sort(immigrants_idx.begin(),immigrants_idx.end(),indirect_individual_sorter<std::vector<population::individual_type> >(immigrants,dest));
-	// From worst to best.
-	std::sort(dest_idx.begin(),dest_idx.end(),indirect_individual_sorter<population>(dest,dest));
-	std::reverse(dest_idx.begin(),dest_idx.end());
+	// Compute once the domination counts of immigrants and destination individuals, instead of at each comparison.
+	std::vector<domination_key> immigrants_keys, dest_keys;
+	immigrants_keys.reserve(immigrants.size());
+	dest_keys.reserve(dest.size());
+	for (std::vector<population::individual_type>::size_type i = 0; i < immigrants.size(); ++i) {
+		immigrants_keys.push_back(std::make_pair(dest.n_dominated(immigrants[i]),boost::numeric_cast<population::size_type>(i)));
+	}
+	for (population::size_type i = 0; i < dest.size(); ++i) {
+		dest_keys.push_back(std::make_pair(dest.n_dominated(dest.get_individual(i)),i));
+	}
+	// Rank only the first rate_limit elements.
+	// Immigrants from best to worst.
+	population::partial_rank(immigrants_keys.begin(),immigrants_keys.end(),rate_limit,domination_key_comparison(false));
+	// Destination individuals from worst to best.
+	population::partial_rank(dest_keys.begin(),dest_keys.end(),rate_limit,domination_key_comparison(true));
 	// Create the result.
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result;
+	result.reserve(rate_limit);
 	for (population::size_type i = 0; i < rate_limit; ++i) {
 		// Similar to fair policy, but replace unconditionally, without checking if the incoming individuals are better.
-		result.push_back(std::make_pair(dest_idx[i],immigrants_idx[i]));
+		result.push_back(std::make_pair(dest_keys[i].second,immigrants_keys[i].second));
 	}
 	return result;
 }
@@ -90,13 +90,19 @@ base_island_ptr mpi_island::clone() const
 	return base_island_ptr(new mpi_island(*this));
 }
 
+// Deleter for shared pointers that do not own the pointed object.
+struct mpi_island_null_deleter {
+	void operator()(const void *) const {}
+};
+
 // Method that perform the actual evolution for the island population, and is used to distribute the computation load over multiple processors
 void mpi_island::perform_evolution(const algorithm::base &algo, population &pop) const
 {
-	// Create copy of data to be transmitted - will use a std::pair for packing everything in a single object.
-	const boost::shared_ptr<population> pop_copy(new population(pop));
+	// Pack the data to be transmitted in a single object - will use a std::pair. The population is only read
+	// while being serialized, and nobody else touches it during the evolution, so it is referenced rather than copied.
+	const boost::shared_ptr<population> pop_ref(&pop,mpi_island_null_deleter());
 	const algorithm::base_ptr algo_copy = algo.clone();
-	const std::pair<boost::shared_ptr<population>,algorithm::base_ptr> out(pop_copy,algo_copy);
+	const std::pair<boost::shared_ptr<population>,algorithm::base_ptr> out(pop_ref,algo_copy);
 	const int processor = acquire_processor();
 	if (mpi_environment::is_multithread()) {
 		mpi_environment::send(out,processor);
@@ -130,9 +136,8 @@ void mpi_island::perform_evolution(const algorithm::base &algo, population &pop)
 	}
 	release_processor(processor);
 	if (successful) {
-		// NOTE: implement via population::swap (to be written) in order to avoid
-		// extra copying?
-		pop = *in;
+		// The received population is not used anymore, take its content without copying.
+		pop.swap(*in);
 	}
 }
 
@@ -30,6 +30,7 @@
 #include "algorithms.h"
 #include "archipelago.h"
 #include "base_island.h"
+#include "evolution_stats.h"
 #include "exceptions.h"
 #include "island.h"
 #include "migration.h"
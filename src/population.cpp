@@ -33,6 +33,7 @@
 #include <string>
 #include <vector>
 #include <limits>
+#include <utility>
 
 #include "problem/base.h"
 #include "problem/base_stochastic.h"
@@ -130,6 +131,76 @@ population &population::operator=(const population &p)
 	return *this;
 }
 
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+/// Move constructor.
+/**
+ * Steals the individuals, the domination structures and the problem of p. p is left as an empty population
+ * on a clone of the problem, so that its problem (caches, evaluation counters, timing state) is not shared with this.
+ * Only the problem is cloned, the individuals are never copied.
+ *
+ * @param[in] p population to be moved into this.
+ */
+population::population(population &&p):m_prob(p.m_prob),m_container(std::move(p.m_container)),m_dom_list(std::move(p.m_dom_list)),
+	m_dom_count(std::move(p.m_dom_count)),m_champion(std::move(p.m_champion)),m_pareto_rank(std::move(p.m_pareto_rank)),
+	m_crowding_d(std::move(p.m_crowding_d)),m_drng(p.m_drng),m_urng(p.m_urng)
+{
+	p.m_prob = m_prob->clone();
+	p.m_container.clear();
+	p.m_dom_list.clear();
+	p.m_dom_count.clear();
+	p.m_pareto_rank.clear();
+	p.m_crowding_d.clear();
+}
+
+/// Move assignment operator.
+/**
+ * Swaps the content of this and p (see population::swap()), the problem is not cloned.
+ *
+ * @param[in] p population to be moved into this.
+ *
+ * @return reference to this.
+ */
+population &population::operator=(population &&p)
+{
+	swap(p);
+	return *this;
+}
+#endif
+
+/// Swap content with another population.
+/**
+ * Exchanges all the elements of this and p (problem, individuals, domination structures, champion and random
+ * number generators) in constant time: no individual is copied and no problem is cloned.
+ *
+ * @param[in,out] p population whose content will be exchanged with this.
+ */
+void population::swap(population &p)
+{
+	m_prob.swap(p.m_prob);
+	m_container.swap(p.m_container);
+	m_dom_list.swap(p.m_dom_list);
+	m_dom_count.swap(p.m_dom_count);
+	m_champion.x.swap(p.m_champion.x);
+	m_champion.c.swap(p.m_champion.c);
+	m_champion.f.swap(p.m_champion.f);
+	m_pareto_rank.swap(p.m_pareto_rank);
+	m_crowding_d.swap(p.m_crowding_d);
+	std::swap(m_drng,p.m_drng);
+	std::swap(m_urng,p.m_urng);
+}
+
+/// Swap two populations.
+/**
+ * Equivalent to p1.swap(p2).
+ *
+ * @param[in,out] p1 first population.
+ * @param[in,out] p2 second population.
+ */
+void swap(population &p1, population &p2)
+{
+	p1.swap(p2);
+}
+
 // Update the domination list and the domination count when the individual at position n has changed
 void population::update_dom(const size_type &n)
 {
@@ -179,6 +250,25 @@ void population::update_dom(const size_type &n)
 	}
 }
 
+// Recompute from scratch the domination lists and counts of the whole population.
+void population::rebuild_dom()
+{
+	const size_type size = m_container.size();
+	pagmo_assert(m_dom_list.size() == size && m_dom_count.size() == size);
+	for (size_type i = 0; i < size; ++i) {
+		m_dom_list[i].clear();
+		m_dom_count[i] = 0;
+	}
+	for (size_type i = 0; i < size; ++i) {
+		for (size_type j = 0; j < size; ++j) {
+			if (i != j && m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[j].best_f,m_container[j].best_c)) {
+				m_dom_list[i].push_back(j);
+				m_dom_count[j]++;
+			}
+		}
+	}
+}
+
 // Init randomly the velocity of the individual in position idx.
 void population::init_velocity(const size_type &idx)
 {
@@ -752,6 +842,8 @@ population::size_type population::get_best_idx() const
  * reimplements such a virtual method at the problem level, he needs to make sure this condition
  * is met (or pay the consequences :)
  *
+ * Only the N selected individuals are fully sorted, so that the cost is linear in the population size plus N log N.
+ *
  * @return a std::vector of positional indexes of the best N individuals.
  * @throws value_error if N is larger than the population size or the population is empty
  */
@@ -763,19 +855,75 @@ std::vector<population::size_type> population::get_best_idx(const population::si
 	if (N > size()) {
 		pagmo_throw(value_error,"Best N individuals requested, but population has size smaller than N");
 	}
-	std::vector<population::size_type> retval;
-	retval.reserve(size());
-	for (population::size_type i=0; i<size(); ++i){
-		retval.push_back(i);
+	return get_ranked_idx(N,true);
+}
+
+/// Get positions of N worst individuals.
+/**
+ * Mirror of population::get_best_idx(const size_type &): the same ordering is used, but the N
+ * worst individuals are returned, starting from the worst one.
+ *
+ * @return a std::vector of positional indexes of the worst N individuals.
+ * @throws value_error if N is larger than the population size or the population is empty
+ */
+std::vector<population::size_type> population::get_worst_idx(const population::size_type& N) const
+{
+	if (!size()) {
+		pagmo_throw(value_error,"empty population, cannot compute position of worst individual");
+	}
+	if (N > size()) {
+		pagmo_throw(value_error,"Worst N individuals requested, but population has size smaller than N");
 	}
-	if (m_prob->get_f_dimension() == 1) {
-		std::sort(retval.begin(),retval.end(),trivial_comparison_operator(*this));
+	return get_ranked_idx(N,false);
+}
+
+// Swaps the arguments of a comparison functor, so that the worst elements come first.
+template <class Comp>
+struct reversed_comparison {
+	reversed_comparison(const Comp &comp):m_comp(comp) {}
+	template <class T>
+	bool operator()(const T &a, const T &b) const
+	{
+		return m_comp(b,a);
 	}
-	else {
+	Comp m_comp;
+};
+
+// Ranking used by get_best_idx(N) and get_worst_idx(N). In the single-objective case the order is defined
+// by problem::base::compare_fc(), which can be reimplemented by the user, so the comparisons cannot be
+// replaced by a precomputed key. In the multi-objective case rank and crowding distance are gathered once
+// in a flat array, instead of being fetched by the crowded comparison operator at each comparison.
+std::vector<population::size_type> population::get_ranked_idx(const size_type &N, bool best) const
+{
+	std::vector<size_type> retval;
+	if (m_prob->get_f_dimension() == 1) {
+		retval.reserve(size());
+		for (size_type i = 0; i < size(); ++i) {
+			retval.push_back(i);
+		}
+		const trivial_comparison_operator comp(*this);
+		if (best) {
+			partial_rank(retval.begin(),retval.end(),N,comp);
+		} else {
+			partial_rank(retval.begin(),retval.end(),N,reversed_comparison<trivial_comparison_operator>(comp));
+		}
+		retval.resize(N);
+	} else {
 		update_pareto_information();
-		std::sort(retval.begin(),retval.end(),crowded_comparison_operator(*this));
+		std::vector<crowded_key> keys(size());
+		for (size_type i = 0; i < size(); ++i) {
+			keys[i].rank = m_pareto_rank[i];
+			keys[i].crowding_d = m_crowding_d[i];
+			keys[i].idx = i;
+		}
+		// Ties are broken by position in both directions, as done by std::min_element() and std::max_element()
+		// in get_best_idx() and get_worst_idx().
+		partial_rank(keys.begin(),keys.end(),N,crowded_key_comparison(!best));
+		retval.reserve(N);
+		for (size_type i = 0; i < N; ++i) {
+			retval.push_back(keys[i].idx);
+		}
 	}
-	retval.resize(N);
 	return retval;
 }
 
@@ -900,6 +1048,130 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	m_prob->objfun(m_container[idx].cur_f,x);
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_bests(idx);
+	update_dom(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, with a known fitness f.
+/**
+ * Same as population::set_x(), but the objective function is not called: f is taken to be the fitness of x, as computed
+ * elsewhere (e.g. by an external evaluator in an ask/tell loop). Constraints are still computed by the problem.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ *
+ * @throws index_error if idx is not smaller than size().
+ * @throws value_error if x is not compatible with the problem or f has not the problem fitness dimension.
+ */
+void population::set_xf(const size_type &idx, const decision_vector &x, const fitness_vector &f)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_bests(idx);
+	update_dom(idx);
+}
+
+/// Set the decision vectors of many individuals at once, with known fitnesses.
+/**
+ * Bulk version of population::set_xf(): the individual at position idx[i] gets decision vector x[i] and fitness f[i].
+ * The constraints are computed by the problem, the objective function is not called.
+ *
+ * @see population::set_xfc() for the details on the validation and on the update of the domination lists.
+ *
+ * @param[in] idx positional indices of the individuals to be set.
+ * @param[in] x decision vectors to be set.
+ * @param[in] f fitness vectors of the decision vectors in x.
+ *
+ * @throws index_error if any index is not smaller than size().
+ * @throws value_error if the sizes of the inputs do not match, if an index is repeated or if any x or f is not compatible with the problem.
+ */
+void population::set_xf(const std::vector<size_type> &idx, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f)
+{
+	if (x.size() != idx.size()) {
+		pagmo_throw(value_error,"the number of decision vectors does not match the number of indices");
+	}
+	std::vector<constraint_vector> c(x.size());
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (!m_prob->verify_x(x[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+		c[i].resize(m_prob->get_c_dimension());
+		m_prob->compute_constraints(c[i],x[i]);
+	}
+	set_xfc(idx,x,f,c);
+}
+
+/// Set decision, fitness and constraint vectors of many individuals at once.
+/**
+ * The individual at position idx[i] gets decision vector x[i], fitness f[i] and constraints c[i], neither the objective
+ * function nor the constraints are evaluated. Best values of the individuals and champion are updated as in population::set_x().
+ *
+ * All the inputs are validated before the population is modified, so that on error the population is left untouched.
+ * The domination lists are updated once at the end: when at least half of the population is assigned they are rebuilt
+ * from scratch (one pass over all pairs), which is cheaper than updating them individual by individual.
+ *
+ * @param[in] idx positional indices of the individuals to be set.
+ * @param[in] x decision vectors to be set.
+ * @param[in] f fitness vectors of the decision vectors in x.
+ * @param[in] c constraint vectors of the decision vectors in x.
+ *
+ * @throws index_error if any index is not smaller than size().
+ * @throws value_error if the sizes of the inputs do not match, if an index is repeated or if any x, f or c is not compatible with the problem.
+ */
+void population::set_xfc(const std::vector<size_type> &idx, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f,
+	const std::vector<constraint_vector> &c)
+{
+	if (x.size() != idx.size() || f.size() != idx.size() || c.size() != idx.size()) {
+		pagmo_throw(value_error,"the number of decision, fitness and constraint vectors does not match the number of indices");
+	}
+	std::vector<bool> assigned(size(),false);
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		if (idx[i] >= size()) {
+			pagmo_throw(index_error,"invalid individual position");
+		}
+		if (assigned[idx[i]]) {
+			pagmo_throw(value_error,"the same individual position appears more than once");
+		}
+		assigned[idx[i]] = true;
+		if (!m_prob->verify_x(x[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+		if (f[i].size() != m_prob->get_f_dimension()) {
+			pagmo_throw(value_error,"fitness vector is not compatible with problem");
+		}
+		if (c[i].size() != m_prob->get_c_dimension()) {
+			pagmo_throw(value_error,"constraint vector is not compatible with problem");
+		}
+	}
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		m_container[idx[i]].cur_x = x[i];
+		m_container[idx[i]].cur_f = f[i];
+		m_container[idx[i]].cur_c = c[i];
+		update_bests(idx[i]);
+	}
+	if (2 * idx.size() >= size()) {
+		rebuild_dom();
+	} else {
+		for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+			update_dom(idx[i]);
+		}
+	}
+}
+
+// Update best values and champion after the current vectors of individual idx have changed (domination lists are left to the caller).
+void population::update_bests(const size_type &idx)
+{
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
 	// NOTE: we update the bests in two cases:
 	// - the bests are empty, meaning they are not defined and we are being called by push_back()
@@ -915,8 +1187,6 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	}
 	// Update the champion.
 	update_champion(idx);
-	// Updated domination lists.
-	update_dom(idx);
 }
 
 /// Erase individual idx
@@ -971,6 +1241,38 @@ void population::push_back(const decision_vector &x)
 		pagmo_throw(value_error,"decision vector is not compatible with problem");
 
 	}
+	push_back_empty();
+	// Set the individual.
+	set_x(m_container.size() - 1,x);
+	// Initialise randomly the velocity vector.
+	init_velocity(m_container.size() - 1);
+}
+
+/// Append individual with given decision vector and known fitness.
+/**
+ * As push_back(const decision_vector &), but the fitness of x is given and the objective function is not called.
+ *
+ * @param[in] x decision vector of the individual to be appended.
+ * @param[in] f fitness vector of x.
+ *
+ * @throws value_error if x is not compatible with the problem or f has not the problem fitness dimension.
+ */
+void population::push_back(const decision_vector &x, const fitness_vector &f)
+{
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	push_back_empty();
+	set_xf(m_container.size() - 1,x,f);
+	init_velocity(m_container.size() - 1);
+}
+
+// Append an individual with undefined bests, ready to be set by set_x() or set_xf().
+void population::push_back_empty()
+{
 	// Store sizes temporarily.
 	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
 	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
@@ -986,10 +1288,6 @@ void population::push_back(const decision_vector &x)
 	m_container.back().cur_f.resize(f_size);
 	// NOTE: do not allocate space for bests, as they are not defined yet. set_x will take
 	// care of it.
-	// Set the individual.
-	set_x(m_container.size() - 1,x);
-	// Initialise randomly the velocity vector.
-	init_velocity(m_container.size() - 1);
 }
 
 /// Set the velocity vector of individual at position idx.
@@ -25,11 +25,15 @@
 #ifndef PAGMO_POPULATION_H
 #define PAGMO_POPULATION_H
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <vector>
+#include <boost/config.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 
 #include "config.h"
 #include "problem/base.h"
@@ -199,6 +203,11 @@ class __PAGMO_VISIBLE population
 		}
 		population(const population &);
 		population &operator=(const population &);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+		population(population &&);
+		population &operator=(population &&);
+#endif
+		void swap(population &);
 		const individual_type &get_individual(const size_type &) const;
 
 		// Multi-Objective stuff
@@ -219,9 +228,15 @@ class __PAGMO_VISIBLE population
 		size_type get_best_idx() const;
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
+		std::vector<size_type> get_worst_idx(const size_type & N) const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_xf(const size_type &, const decision_vector &, const fitness_vector &);
+		void set_xf(const std::vector<size_type> &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &);
+		void set_xfc(const std::vector<size_type> &, const std::vector<decision_vector> &, const std::vector<fitness_vector> &,
+			const std::vector<constraint_vector> &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
+		void push_back(const decision_vector &, const fitness_vector &);
 		void erase(const size_type &);
 		size_type size() const;
 		const_iterator begin() const;
@@ -258,12 +273,71 @@ class __PAGMO_VISIBLE population
 			const population &m_pop;
 		};
 
+		/// Flat ranking key of an individual in the multi-objective case.
+		/**
+		 * Pareto rank, crowding distance and position of an individual, gathered once so that sorting does not
+		 * fetch them from the population at each comparison.
+		 */
+		struct crowded_key {
+			/// Pareto rank.
+			size_type	rank;
+			/// Crowding distance, larger is better.
+			double		crowding_d;
+			/// Position of the individual.
+			size_type	idx;
+			/// Strict crowded comparison, ignoring the position.
+			bool is_better(const crowded_key &other) const
+			{
+				return rank < other.rank || (rank == other.rank && crowding_d > other.crowding_d);
+			}
+		};
+
+		/// Orders crowded keys from best to worst (or the opposite if worst_first is true), breaking ties by position.
+		struct crowded_key_comparison {
+			crowded_key_comparison(bool worst_first = false):m_worst_first(worst_first) {}
+			bool operator()(const crowded_key &k1, const crowded_key &k2) const
+			{
+				if (k1.is_better(k2)) {
+					return !m_worst_first;
+				}
+				if (k2.is_better(k1)) {
+					return m_worst_first;
+				}
+				return k1.idx < k2.idx;
+			}
+			bool m_worst_first;
+		};
+
+		/// Partial ranking of an iterator range.
+		/**
+		 * This function will move the n best elements of the range [first,last) (according to comp) to the front of the range, sorted.
+		 * The order of the remaining elements is unspecified. The cost is linear in the size of the range plus n log n comparisons.
+		 *
+		 * @param[in] first start of the iterator range.
+		 * @param[in] last end of the iterator range.
+		 * @param[in] n number of elements to rank, must not exceed the size of the range.
+		 * @param[in] comp strict weak ordering, returning true if the first argument is better than the second one.
+		 */
+		template <class RandomAccessIterator, class Size, class Compare>
+		static void partial_rank(RandomAccessIterator first, RandomAccessIterator last, Size n, Compare comp)
+		{
+			const RandomAccessIterator nth = first + boost::numeric_cast<typename std::iterator_traits<RandomAccessIterator>::difference_type>(n);
+			if (nth != last) {
+				std::nth_element(first,nth,last,comp);
+			}
+			std::sort(first,nth,comp);
+		}
+
 	private:
 		void init_velocity(const size_type &);
 		void update_champion(const size_type &);
+		void update_bests(const size_type &);
+		void push_back_empty();
+		void rebuild_dom();
 
 		// Multi-objective stuff
 		void update_crowding_d(std::vector<size_type>) const;
+		std::vector<size_type> get_ranked_idx(const size_type &, bool) const;
 
 	protected:
 		void update_dom(const size_type &);
@@ -307,6 +381,8 @@ class __PAGMO_VISIBLE population
 		mutable	rng_uint32				m_urng;
 };
 
+// Swap two populations
+__PAGMO_VISIBLE_FUNC void swap(population &, population &);
 // Streaming operator for the population
 __PAGMO_VISIBLE_FUNC std::ostream &operator<<(std::ostream &, const population &);
 // Streaming operator for the individual
@@ -25,11 +25,13 @@
 // 30/01/10 Created by Francesco Biscani.
 
 #include <algorithm>
+#include <boost/bind.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/numeric/conversion/bounds.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
 #include <cmath>
 #include <climits>
 #include <cstddef>
@@ -74,7 +76,10 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_cache_hits(0),
+	m_objfun_timing(false),
+	m_objfun_time(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -120,7 +125,10 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_cache_hits(0),
+	m_objfun_timing(false),
+	m_objfun_time(0)
 {
 	if (c_tol.size() != static_cast<constraint_vector::size_type>(nc) ) {
 		pagmo_throw(value_error,"invalid constraints vector dimension");
@@ -173,7 +181,10 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_cache_hits(0),
+	m_objfun_timing(false),
+	m_objfun_time(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -224,7 +235,10 @@ base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf,
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_cache_hits(0),
+	m_objfun_timing(false),
+	m_objfun_time(0)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -457,6 +471,42 @@ unsigned int base::get_cevals() const
 	return m_cevals;
 }
 
+/// Return number of cache hits.
+/**
+ * @return number of calls to objfun() and compute_constraints() served by the caches, without calling the implementation.
+ */
+unsigned int base::get_cache_hits() const
+{
+	return m_cache_hits;
+}
+
+/// Return objective function timing flag.
+/**
+ * @return true if the calls to objfun_impl() are being timed, false otherwise.
+ */
+bool base::get_objfun_timing() const
+{
+	return m_objfun_timing;
+}
+
+/// Return objective function time.
+/**
+ * @return total time, in nanoseconds, spent in objfun_impl() since timing was enabled with set_objfun_timing().
+ */
+boost::uint64_t base::get_objfun_time() const
+{
+	return m_objfun_time;
+}
+
+/// Return objective function latency histogram.
+/**
+ * @return const reference to the histogram of the durations of the calls to objfun_impl() since timing was enabled with set_objfun_timing().
+ */
+const latency_histogram &base::get_objfun_latency() const
+{
+	return m_objfun_latency;
+}
+
 
 /// Return global dimension.
 /**
@@ -576,7 +626,15 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 	const x_iterator x_it = std::find(m_decision_vector_cache_f.begin(),m_decision_vector_cache_f.end(),x);
 	if (x_it == m_decision_vector_cache_f.end()) {
 		// Fitness is not into memory. Calculate it.
-		objfun_impl(f,x);
+		if (m_objfun_timing) {
+			const boost::uint64_t start = stats_clock();
+			objfun_impl(f,x);
+			const boost::uint64_t elapsed = stats_clock() - start;
+			m_objfun_time += elapsed;
+			m_objfun_latency.add(elapsed);
+		} else {
+			objfun_impl(f,x);
+		}
 		// Increase function evaluation counter.
 		m_fevals++;
 		// Make sure that the implementation of objfun_impl() in the derived class did not fuck up the dimension of the fitness vector.
@@ -587,6 +645,7 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 		m_decision_vector_cache_f.push_front(x);
 		m_fitness_vector_cache.push_front(f);
 	} else {
+		++m_cache_hits;
 		// Compute the corresponding iterator in the fitness vector cache.
 		f_iterator f_it = m_fitness_vector_cache.begin();
 		std::advance(f_it,std::distance(m_decision_vector_cache_f.begin(),x_it));
@@ -607,6 +666,91 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 	}
 }
 
+/// Evaluate a batch of decision vectors.
+/**
+ * Computes fitness and constraint vectors of all the decision vectors in x, as objfun() and compute_constraints() would do
+ * one by one. f and c are resized to the size of x and their elements are reused when they have the correct size.
+ *
+ * If n_threads is greater than one, x is spread over (at most) n_threads threads, each one (but the calling one) working on a clone
+ * of this problem. Results do not depend on the number of threads, and the evaluations performed by the clones are added to the
+ * function and constraint evaluation counters, to the cache hits and to the objective function timing of this problem. Problems whose objective function modifies their state in other
+ * ways than through the caches should be evaluated with a single thread.
+ *
+ * @param[out] f fitness vectors of the elements of x.
+ * @param[out] c constraint vectors of the elements of x.
+ * @param[in] x decision vectors to be evaluated.
+ * @param[in] n_threads maximum number of threads to be used.
+ *
+ * @throws value_error if n_threads is zero or the size of any decision vector is different from the problem dimension.
+ */
+void base::evaluate_batch(std::vector<fitness_vector> &f, std::vector<constraint_vector> &c, const std::vector<decision_vector> &x, unsigned int n_threads) const
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be positive");
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"wrong decision vector size when calling objective function");
+		}
+	}
+	f.resize(x.size());
+	c.resize(x.size());
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		f[i].resize(m_f_dimension);
+		c[i].resize(m_c_dimension);
+	}
+	const std::vector<decision_vector>::size_type n = std::min<std::vector<decision_vector>::size_type>(n_threads,x.size());
+	if (n <= 1) {
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			objfun(f[i],x[i]);
+			compute_constraints(c[i],x[i]);
+		}
+		return;
+	}
+	std::vector<base_ptr> workers(n - 1);
+	std::vector<char> failed(n, 0);
+	boost::thread_group threads;
+	for (std::vector<decision_vector>::size_type t = 1; t < n; ++t) {
+		workers[t - 1] = clone();
+		workers[t - 1]->m_fevals = 0;
+		workers[t - 1]->m_cevals = 0;
+		workers[t - 1]->m_cache_hits = 0;
+		workers[t - 1]->m_objfun_time = 0;
+		workers[t - 1]->m_objfun_latency.clear();
+		threads.create_thread(boost::bind(&base::run_batch,boost::cref(*workers[t - 1]),boost::ref(f),boost::ref(c),boost::cref(x),t,n,boost::ref(failed[t])));
+	}
+	run_batch(*this,f,c,x,0,n,failed[0]);
+	threads.join_all();
+	for (std::vector<decision_vector>::size_type t = 1; t < n; ++t) {
+		m_fevals += workers[t - 1]->m_fevals;
+		m_cevals += workers[t - 1]->m_cevals;
+		m_cache_hits += workers[t - 1]->m_cache_hits;
+		m_objfun_time += workers[t - 1]->m_objfun_time;
+		m_objfun_latency.merge(workers[t - 1]->m_objfun_latency);
+	}
+	// Failed evaluations are repeated here, so that the original exception reaches the caller.
+	for (std::vector<decision_vector>::size_type t = 0; t < n; ++t) {
+		for (std::vector<decision_vector>::size_type i = t; failed[t] && i < x.size(); i += n) {
+			objfun(f[i],x[i]);
+			compute_constraints(c[i],x[i]);
+		}
+	}
+}
+
+// Evaluates the elements offset, offset + stride, offset + 2 * stride, ... of x on prob, flagging any failure.
+void base::run_batch(const base &prob, std::vector<fitness_vector> &f, std::vector<constraint_vector> &c, const std::vector<decision_vector> &x,
+	std::vector<decision_vector>::size_type offset, std::vector<decision_vector>::size_type stride, char &failed)
+{
+	try {
+		for (std::vector<decision_vector>::size_type i = offset; i < x.size(); i += stride) {
+			prob.objfun(f[i],x[i]);
+			prob.compute_constraints(c[i],x[i]);
+		}
+	} catch (...) {
+		failed = 1;
+	}
+}
+
 /// Compare fitness vectors.
 /**
  * Will perform sanity checks on v_f1 and v_f2 and then will call base::compare_fitness_impl().
@@ -896,6 +1040,7 @@ void base::compute_constraints(constraint_vector &c, const decision_vector &x) c
 		m_decision_vector_cache_c.push_front(x);
 		m_constraint_vector_cache.push_front(c);
 	} else {
+		++m_cache_hits;
 		// Compute the corresponding iterator in the constraint vector cache.
 		c_iterator c_it = m_constraint_vector_cache.begin();
 		std::advance(c_it,std::distance(m_decision_vector_cache_c.begin(),x_it));
@@ -1418,4 +1563,21 @@ void base::reset_caches() const
 	m_constraint_vector_cache = constraint_vector_cache_type(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity));
 }
 
+/// Enable or disable objective function timing.
+/**
+ * When timing is enabled, each call to objfun_impl() is timed and its duration is accumulated into get_objfun_time()
+ * and get_objfun_latency(). Timing is disabled by default, as reading the clock has a cost comparable to the evaluation
+ * of very cheap objective functions. Enabling timing (even if already enabled) resets the accumulated time and histogram.
+ *
+ * @param[in] flag true to enable timing, false to disable it.
+ */
+void base::set_objfun_timing(bool flag)
+{
+	if (flag) {
+		m_objfun_time = 0;
+		m_objfun_latency.clear();
+	}
+	m_objfun_timing = flag;
+}
+
 }} //namespaces
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <boost/circular_buffer.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <cstddef>
@@ -41,6 +42,7 @@
 #include <string>
 
 #include "../config.h"
+#include "../evolution_stats.h"
 #include "../exceptions.h"
 #include "../serialization.h"
 #include "../types.h"
@@ -190,7 +192,8 @@ class __PAGMO_VISIBLE base
 			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+			m_fevals(0),m_cevals(0),m_cache_hits(0),m_objfun_timing(false),m_objfun_time(0)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -239,7 +242,8 @@ class __PAGMO_VISIBLE base
 			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
 			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
 			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+			m_fevals(0),m_cevals(0),m_cache_hits(0),m_objfun_timing(false),m_objfun_time(0)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -403,6 +407,10 @@ class __PAGMO_VISIBLE base
 		//@{
 		unsigned int get_fevals() const;
 		unsigned int get_cevals() const;
+		unsigned int get_cache_hits() const;
+		bool get_objfun_timing() const;
+		boost::uint64_t get_objfun_time() const;
+		const latency_histogram &get_objfun_latency() const;
 		size_type get_dimension() const;
 		size_type get_i_dimension() const;
 		f_size_type get_f_dimension() const;
@@ -456,6 +464,8 @@ return base_ptr(new derived_problem(*this));
 		void objfun(fitness_vector &, const decision_vector &) const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
 		void reset_caches() const;
+		void evaluate_batch(std::vector<fitness_vector> &, std::vector<constraint_vector> &, const std::vector<decision_vector> &, unsigned int = 1) const;
+		void set_objfun_timing(bool);
 	public:
 		const std::vector<constraint_vector>& get_best_c(void) const;
 		const std::vector<decision_vector>& get_best_x(void) const;
@@ -498,9 +508,11 @@ return base_ptr(new derived_problem(*this));
 			}
 		}
 	private:
+		static void run_batch(const base &, std::vector<fitness_vector> &, std::vector<constraint_vector> &, const std::vector<decision_vector> &,
+			std::vector<decision_vector>::size_type, std::vector<decision_vector>::size_type, char &);
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & const_cast<size_type &>(m_i_dimension);
 			ar & const_cast<f_size_type &>(m_f_dimension);
@@ -522,6 +534,12 @@ return base_ptr(new derived_problem(*this));
 			ar & m_best_c;
 			ar & m_fevals;
 			ar & m_cevals;
+			// Archives written before version 1 do not count the cache hits.
+			if (version >= 1) {
+				ar & m_cache_hits;
+			} else {
+				m_cache_hits = 0;
+			}
 		}
 
 		// Data members.
@@ -562,6 +580,12 @@ return base_ptr(new derived_problem(*this));
 		// Number of function and constraints evaluations
 		mutable unsigned int                    m_fevals;
 		mutable unsigned int                    m_cevals;
+		// Number of function and constraints calls served by the caches.
+		mutable unsigned int			m_cache_hits;
+		// Objective function timing (not serialized).
+		bool					m_objfun_timing;
+		mutable boost::uint64_t			m_objfun_time;
+		mutable latency_histogram		m_objfun_latency;
 };
 
 std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
@@ -570,5 +594,6 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
 }
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::problem::base)
+BOOST_CLASS_VERSION(pagmo::problem::base,1)
 
 #endif
@@ -31,6 +31,7 @@
 #include "ackley.h"
 #include "../types.h"
 #include "base.h"
+#include "base_stochastic.h"
 
 namespace pagmo{ namespace problem {
 
@@ -58,6 +59,24 @@ class __PAGMO_VISIBLE base_meta : public base
 			 }
 		/// Copy constructor
 		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()) {}
+		/// Check whether a problem is stochastic.
+		/**
+		 * @param[in] p problem to be checked.
+		 *
+		 * @return true if p, or the problem it wraps through (possibly nested) meta-problems, derives from base_stochastic.
+		 */
+		static bool is_stochastic(const base &p)
+		{
+			const base *cur = &p;
+			while (!dynamic_cast<const base_stochastic *>(cur)) {
+				const base_meta *meta = dynamic_cast<const base_meta *>(cur);
+				if (!meta) {
+					return false;
+				}
+				cur = meta->m_original_problem.get();
+			}
+			return true;
+		}
 	protected:
 		bool compare_fitness_impl(const fitness_vector &f1, const fitness_vector &f2) const 
 			{return m_original_problem->compare_fitness_impl(f1,f2);}
@@ -22,6 +22,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../exceptions.h"
 #include "base_stochastic.h"
 #include "../serialization.h"
 
@@ -36,7 +43,7 @@ namespace pagmo { namespace problem {
  * @param[in] dim global dimension of the problem.
  * @param[in] seed random number generator seed
  */
-base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng(seed), m_urng(seed), m_seed(seed), m_trial_threads(1)
 {
 }
 
@@ -50,7 +57,7 @@ base_stochastic::base_stochastic(int dim, unsigned int seed) : base(dim), m_drng
  * @param[in] c_tol constraints tolerance (equal for all constraints)
  * @param[in] seed random number generator seed
 */
-base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const double &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const double &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed), m_trial_threads(1)
 {
 }
 
@@ -64,7 +71,7 @@ base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const d
  * @param[in] c_tol constraints tolerance std::vector
  * @param[in] seed random number generator seed
 */
-base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed)
+base_stochastic::base_stochastic(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_tol, unsigned int seed): base((int)n, ni, nf, nc, nic, c_tol), m_drng(seed), m_urng(seed), m_seed(seed), m_trial_threads(1)
 {
 }
 
@@ -90,6 +97,135 @@ unsigned int base_stochastic::get_seed() const {
 	return m_seed;
 }
 
+/// Gets the number of threads used for the trials
+/**
+ * @return the number of threads used by average_trials()
+ */
+unsigned int base_stochastic::get_trial_threads() const {
+	return m_trial_threads;
+}
+
+/// Sets the number of threads used for the trials
+/**
+ * The results of the trials do not depend on the number of threads.
+ *
+ * @param[in] n number of threads used by average_trials()
+ *
+ * @throws value_error if n is zero
+ */
+void base_stochastic::set_trial_threads(unsigned int n) {
+	if (n == 0) {
+		pagmo_throw(value_error,"the number of threads must be positive");
+	}
+	m_trial_threads = n;
+}
+
+// Finaliser of MurmurHash3, a cheap mixing of the bits of a 32 bits integer.
+static boost::uint32_t mix32(boost::uint32_t h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+	return h;
+}
+
+/// Seed of a trial
+/**
+ * Derives the seed of a single trial from the seed of an evaluation and the trial index, so that
+ * different trials (and trials of evaluations with different seeds) use uncorrelated random sequences.
+ *
+ * @param[in] seed seed of the evaluation
+ * @param[in] trial index of the trial
+ *
+ * @return the seed to be used by the trial
+ */
+unsigned int base_stochastic::trial_seed(unsigned int seed, unsigned int trial) {
+	return mix32(static_cast<boost::uint32_t>(seed) + mix32(static_cast<boost::uint32_t>(trial) + 0x9e3779b9u));
+}
+
+/// Averages the results of independent trials
+/**
+ * Runs n_trials calls to trial_impl, with seeds trial_seed(seed,0), ..., trial_seed(seed,n_trials-1), and stores
+ * the average of their results in retval. If more than one thread is set (see set_trial_threads()), the trials are spread
+ * over the threads, each one (but the calling one) working on a clone of this problem. Results are averaged in trial order, and
+ * are thus the same for any number of threads.
+ *
+ * @param[in,out] retval vector of the size of the trial results, will contain their average
+ * @param[in] x decision vector
+ * @param[in] n_trials number of trials
+ * @param[in] seed seed of the evaluation
+ * @param[in] type quantity computed by the trials
+ */
+void base_stochastic::average_trials(std::vector<double> &retval, const decision_vector &x, unsigned int n_trials, unsigned int seed, trial_type type) const
+{
+	std::fill(retval.begin(),retval.end(),0.);
+	std::vector<std::vector<double> > results(n_trials,retval);
+	const unsigned int n_threads = std::min(m_trial_threads,n_trials);
+	if (n_threads <= 1) {
+		for (unsigned int i = 0; i < n_trials; ++i) {
+			trial_impl(results[i],x,trial_seed(seed,i),type);
+		}
+	} else {
+		std::vector<base_ptr> workers(n_threads - 1);
+		std::vector<char> failed(n_threads, 0);
+		boost::thread_group threads;
+		for (unsigned int t = 1; t < n_threads; ++t) {
+			workers[t - 1] = clone();
+			threads.create_thread(boost::bind(&base_stochastic::run_trials,boost::cref(dynamic_cast<const base_stochastic &>(*workers[t - 1])),
+				boost::ref(results),boost::cref(x),seed,type,t,n_threads,boost::ref(failed[t])));
+		}
+		run_trials(*this,results,x,seed,type,0,n_threads,failed[0]);
+		threads.join_all();
+		// Failed trials are repeated here, so that the original exception reaches the caller.
+		for (unsigned int t = 0; t < n_threads; ++t) {
+			for (unsigned int i = t; failed[t] && i < n_trials; i += n_threads) {
+				trial_impl(results[i],x,trial_seed(seed,i),type);
+			}
+		}
+	}
+	for (unsigned int i = 0; i < n_trials; ++i) {
+		for (std::vector<double>::size_type j = 0; j < retval.size(); ++j) {
+			retval[j] += results[i][j] / (double)n_trials;
+		}
+	}
+}
+
+// Runs the trials offset, offset + stride, offset + 2 * stride, ... on prob, flagging any failure.
+void base_stochastic::run_trials(const base_stochastic &prob, std::vector<std::vector<double> > &results, const decision_vector &x, unsigned int seed,
+	trial_type type, unsigned int offset, unsigned int stride, char &failed)
+{
+	try {
+		for (std::vector<std::vector<double> >::size_type i = offset; i < results.size(); i += stride) {
+			prob.trial_impl(results[i],x,trial_seed(seed,i),type);
+		}
+	} catch (...) {
+		failed = 1;
+	}
+}
+
+/// Single trial
+/**
+ * Computes the fitness or constraint vector of x for a single realisation of the random variables, generated from
+ * the given seed, typically through a pagmo::rng_philox seeded with it, which is much cheaper to set up than
+ * the lagged Fibonacci generator of the problem. The implementation must not use the rngs of the problem, nor modify its state other than through
+ * its own mutable members, as it may run concurrently on copies of the problem.
+ *
+ * The default implementation throws.
+ *
+ * @param[out] retval fitness or constraint vector, of the correct size
+ * @param[in] x decision vector
+ * @param[in] seed seed of the trial
+ * @param[in] type quantity to be computed
+ *
+ * @throws not_implemented_error unless reimplemented in the derived class
+ */
+void base_stochastic::trial_impl(std::vector<double> &, const decision_vector &, unsigned int, trial_type) const
+{
+	pagmo_throw(not_implemented_error,"trials are not implemented for this problem");
+}
+
 }} //namespaces
 
 //BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::base_stochastic);
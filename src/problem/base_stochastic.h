@@ -25,6 +25,8 @@
 #ifndef PAGMO_PROBLEM_BASE_STOCHASTIC_H
 #define PAGMO_PROBLEM_BASE_STOCHASTIC_H
 
+#include <vector>
+
 #include "base.h"
 #include "../serialization.h"
 #include "../rng.h"
@@ -50,6 +52,12 @@ namespace pagmo{ namespace problem {
  *
  * See pagmo::algorithm::pso_stochastic for a good example of such techniques.
  *
+ * Problems averaging over many independent trials (e.g. pagmo::problem::noisy, pagmo::problem::robust) can
+ * reimplement trial_impl() and call average_trials() from objfun_impl. Each trial is then run with its own seed,
+ * derived deterministically from the evaluation seed and the trial index by trial_seed(), and trials are spread over
+ * get_trial_threads() threads, each working on its own copy of the problem. Results are averaged in trial order,
+ * so that they do not depend on the number of threads.
+ *
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
 
@@ -62,15 +70,34 @@ class __PAGMO_VISIBLE base_stochastic : public base
 
 		unsigned int get_seed() const;
 		void set_seed(unsigned int) const; //This is marked const as m_seed is mutable (needs to be)
+		unsigned int get_trial_threads() const;
+		void set_trial_threads(unsigned int);
+		static unsigned int trial_seed(unsigned int, unsigned int);
+	protected:
+		/// Quantity computed by a trial.
+		enum trial_type {
+			FITNESS_TRIAL = 0,	///< The fitness vector.
+			CONSTRAINTS_TRIAL = 1	///< The constraint vector.
+		};
+		void average_trials(std::vector<double> &, const decision_vector &, unsigned int, unsigned int, trial_type) const;
+		virtual void trial_impl(std::vector<double> &, const decision_vector &, unsigned int, trial_type) const;
 	private:
+		static void run_trials(const base_stochastic &, std::vector<std::vector<double> > &, const decision_vector &, unsigned int,
+			trial_type, unsigned int, unsigned int, char &);
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_drng;
 			ar & m_urng; 
 			ar & m_seed;
+			// Archives written before version 1 run the trials serially.
+			if (version >= 1) {
+				ar & m_trial_threads;
+			} else {
+				m_trial_threads = 1;
+			}
 		}
 		
 	protected:
@@ -80,11 +107,15 @@ class __PAGMO_VISIBLE base_stochastic : public base
 		mutable rng_uint32	m_urng;
 		/// Seed of the random number generator
 		mutable unsigned int			m_seed;
+	private:
+		// Number of threads used by average_trials().
+		unsigned int				m_trial_threads;
 
 };
 
 }} //namespaces
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::problem::base_stochastic)
+BOOST_CLASS_VERSION(pagmo::problem::base_stochastic,1)
 
 #endif // PAGMO_PROBLEM_BASE_STOCHASTIC_H
@@ -23,6 +23,9 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
 
 #include "base_tsp.h"
 #include "../population.h"
@@ -43,7 +46,9 @@ namespace pagmo { namespace problem {
             1, nc, nic, 0.0
         ), 
         m_encoding(encoding), 
-        m_n_cities(n_cities)
+        m_n_cities(n_cities),
+        m_neighbours(),
+        m_n_neighbours(0)
     {
         switch( m_encoding ) {
             case FULL:
@@ -177,6 +182,347 @@ namespace pagmo { namespace problem {
         return retval;
     }
 
+    /// Symmetry of the distances
+    /**
+     * Tells the incremental evaluation methods whether distance(i,j) == distance(j,i) for all cities,
+     * in which case reversing a part of a tour does not change its internal length. The default
+     * implementation conservatively returns false; derived classes should override it whenever they know better.
+     *
+     * @return true if the distances are symmetric
+     */
+    bool base_tsp::is_symmetric() const
+    {
+        return false;
+    }
+
+    /// Length of a closed tour
+    /**
+     * @param[in] tour a tour in the CITIES encoding
+     * @return the sum of the distances along the tour, closing edge included
+     * @throws value_error if the tour length is not equal to the city number
+     */
+    double base_tsp::tour_length(const decision_vector &tour) const
+    {
+        if (tour.size() != m_n_cities)
+        {
+            pagmo_throw(value_error, "tour dimension must be equal to the city number");
+        }
+        double retval = 0;
+        for (decision_vector::size_type i = 0; i < m_n_cities - 1; ++i) {
+            retval += distance(tour[i], tour[i+1]);
+        }
+        return retval + distance(tour[m_n_cities-1], tour[0]);
+    }
+
+    /// Length change caused by an inversion
+    /**
+     * Computes the change in base_tsp::tour_length caused by reversing the cities tour[first], ..., tour[last]
+     * (the move performed by pagmo::algorithm::inverover). Only the two edges at the boundaries
+     * of the segment change, so the cost is O(1) when base_tsp::is_symmetric returns true, and O(last - first) otherwise.
+     *
+     * @param[in] tour a tour in the CITIES encoding
+     * @param[in] first position of the first city of the segment
+     * @param[in] last position of the last city of the segment
+     * @return the length of the modified tour minus the length of tour
+     * @throws value_error if the tour length is not equal to the city number
+     * @throws index_error if first > last or last is out of range
+     */
+    double base_tsp::inversion_delta(const decision_vector &tour, decision_vector::size_type first, decision_vector::size_type last) const
+    {
+        const decision_vector::size_type n = m_n_cities;
+        if (tour.size() != n)
+        {
+            pagmo_throw(value_error, "tour dimension must be equal to the city number");
+        }
+        if (first > last || last >= n)
+        {
+            pagmo_throw(index_error, "invalid segment positions");
+        }
+        const bool symmetric = is_symmetric();
+        if (last - first + 1 == n) {
+            // The whole tour is traversed backwards.
+            return symmetric ? 0. : tour_length(decision_vector(tour.rbegin(), tour.rend())) - tour_length(tour);
+        }
+        const decision_vector::size_type a = tour[first], b = tour[last], p = tour[(first + n - 1) % n], q = tour[(last + 1) % n];
+        double retval = distance(p, b) + distance(a, q) - distance(p, a) - distance(b, q);
+        if (!symmetric) {
+            for (decision_vector::size_type k = first; k < last; ++k) {
+                retval += distance(tour[k+1], tour[k]) - distance(tour[k], tour[k+1]);
+            }
+        }
+        return retval;
+    }
+
+    /// Length change caused by a 2-opt move
+    /**
+     * Computes the change in base_tsp::tour_length caused by removing the edges (tour[i],tour[i+1]) and
+     * (tour[j],tour[j+1]) and reconnecting the tour, i.e. by reversing tour[i+1], ..., tour[j].
+     * See base_tsp::inversion_delta for the complexity.
+     *
+     * @param[in] tour a tour in the CITIES encoding
+     * @param[in] i position of the start of the first edge
+     * @param[in] j position of the start of the second edge
+     * @return the length of the modified tour minus the length of tour
+     * @throws value_error if the tour length is not equal to the city number
+     * @throws index_error if i >= j or j is out of range
+     */
+    double base_tsp::two_opt_delta(const decision_vector &tour, decision_vector::size_type i, decision_vector::size_type j) const
+    {
+        if (i >= j)
+        {
+            pagmo_throw(index_error, "invalid edge positions");
+        }
+        return inversion_delta(tour, i + 1, j);
+    }
+
+    /// Length change caused by an or-opt move
+    /**
+     * Computes in O(1) the change in base_tsp::tour_length caused by moving the cities tour[first], ..., tour[last]
+     * (keeping their order) between tour[pos] and tour[pos+1] (or tour[0] if pos is the last position).
+     *
+     * @param[in] tour a tour in the CITIES encoding
+     * @param[in] first position of the first city of the segment
+     * @param[in] last position of the last city of the segment
+     * @param[in] pos position of the city after which the segment is inserted
+     * @return the length of the modified tour minus the length of tour
+     * @throws value_error if the tour length is not equal to the city number
+     * @throws index_error if the segment is invalid or if pos is inside the segment or just before it
+     */
+    double base_tsp::or_opt_delta(const decision_vector &tour, decision_vector::size_type first, decision_vector::size_type last, decision_vector::size_type pos) const
+    {
+        const decision_vector::size_type n = m_n_cities;
+        if (tour.size() != n)
+        {
+            pagmo_throw(value_error, "tour dimension must be equal to the city number");
+        }
+        const decision_vector::size_type prev = (first + n - 1) % n;
+        if (first > last || last >= n || pos >= n || (pos >= first && pos <= last) || pos == prev)
+        {
+            pagmo_throw(index_error, "invalid segment or insertion positions");
+        }
+        const decision_vector::size_type a = tour[first], b = tour[last], p = tour[prev], q = tour[(last + 1) % n];
+        const decision_vector::size_type c = tour[pos], d = tour[(pos + 1) % n];
+        return distance(p, q) + distance(c, a) + distance(b, d) - distance(p, a) - distance(b, q) - distance(c, d);
+    }
+
+    /// Candidate lists of the nearest cities
+    /**
+     * Computes (once, the result being cached and shared by the copies of the problem) the k nearest cities to
+     * each city, according to base_tsp::distance. Lists are stored contiguously: the neighbours of city i
+     * are the elements in [i * k', (i + 1) * k'), sorted by increasing distance (ties broken by city index),
+     * where k' = min(k, n_cities - 1). Building the lists requires O(n^2 log k) operations.
+     *
+     * @param[in] k number of neighbours per city
+     * @return a const reference to the flattened lists
+     */
+    const std::vector<unsigned int> &base_tsp::neighbour_lists(decision_vector::size_type k) const
+    {
+        const decision_vector::size_type n = m_n_cities;
+        k = (n < 2) ? 0 : std::min<decision_vector::size_type>(k, n - 1);
+        if (m_neighbours && m_n_neighbours == k) {
+            return *m_neighbours;
+        }
+        boost::shared_ptr<std::vector<unsigned int> > lists(new std::vector<unsigned int>(n * k));
+        std::vector<std::pair<double, unsigned int> > candidates(n - 1);
+        for (decision_vector::size_type i = 0; i < n && k > 0; ++i) {
+            for (decision_vector::size_type j = 0, l = 0; j < n; ++j) {
+                if (j != i) {
+                    candidates[l++] = std::make_pair(distance(i, j), static_cast<unsigned int>(j));
+                }
+            }
+            std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+            for (decision_vector::size_type l = 0; l < k; ++l) {
+                (*lists)[i * k + l] = candidates[l].second;
+            }
+        }
+        m_neighbours = lists;
+        m_n_neighbours = k;
+        return *m_neighbours;
+    }
+
+    /// 2-opt and or-opt local search
+    /**
+     * Improves a tour (CITIES encoding) with 2-opt moves and or-opt moves of segments of up to three
+     * cities, until no improving move is found. Only moves creating an edge between a city and one of its k nearest
+     * cities (see base_tsp::neighbour_lists) are considered, and don't-look bits restrict the search to the
+     * surroundings of the last modifications, so that a pass costs about O(n k) instead of O(n^2).
+     *
+     * The search minimises base_tsp::tour_length, which is the objective of pagmo::problem::tsp, and a
+     * good heuristic for its variants.
+     *
+     * @param[in,out] tour the tour to be improved
+     * @param[in] k number of candidate neighbours per city
+     * @return the change in tour length (non positive)
+     * @throws value_error if the tour length is not equal to the city number
+     */
+    double base_tsp::local_search(decision_vector &tour, decision_vector::size_type k) const
+    {
+        const decision_vector::size_type n = m_n_cities;
+        if (tour.size() != n)
+        {
+            pagmo_throw(value_error, "tour dimension must be equal to the city number");
+        }
+        // Below five cities every tour is 2-optimal.
+        if (n < 5 || k == 0) {
+            return 0.;
+        }
+        const std::vector<unsigned int> &nl = neighbour_lists(k);
+        const decision_vector::size_type kk = nl.size() / n;
+        // Relative tolerance on improvements, preventing cycling on round-off errors.
+        const double eps = 1e-10;
+        std::vector<decision_vector::size_type> pos(n);
+        std::deque<decision_vector::size_type> queue;
+        for (decision_vector::size_type i = 0; i < n; ++i) {
+            pos[tour[i]] = i;
+            queue.push_back(tour[i]);
+        }
+        // Don't-look bits: a city is in the queue if and only if its bit is off.
+        std::vector<char> active(n, 1);
+        std::vector<decision_vector::size_type> touched;
+        double retval = 0.;
+
+        while (!queue.empty()) {
+            const decision_vector::size_type a = queue.front();
+            queue.pop_front();
+            active[a] = 0;
+            touched.clear();
+            // 2-opt: replace (a,succ(a)),(c,succ(c)) with (a,c),(succ(a),succ(c)) or
+            // (pred(a),a),(pred(c),c) with (c,a),(pred(c),pred(a)).
+            for (int dir = 0; dir < 2 && touched.empty(); ++dir) {
+                const decision_vector::size_type pa = pos[a];
+                const double d_a = (dir == 0) ? distance(a, tour[(pa + 1) % n]) : distance(tour[(pa + n - 1) % n], a);
+                for (decision_vector::size_type l = 0; l < kk; ++l) {
+                    const decision_vector::size_type c = nl[a * kk + l];
+                    if (distance(a, c) >= d_a) {
+                        break;
+                    }
+                    decision_vector::size_type i = (dir == 0) ? pa : (pa + n - 1) % n, j = (dir == 0) ? pos[c] : (pos[c] + n - 1) % n;
+                    if (i > j) {
+                        std::swap(i, j);
+                    }
+                    if (j - i < 2 || j - i >= n - 1) {
+                        continue;
+                    }
+                    const double delta = two_opt_delta(tour, i, j);
+                    if (delta < -eps * d_a) {
+                        touched.push_back(tour[i]);
+                        touched.push_back(tour[i + 1]);
+                        touched.push_back(tour[j]);
+                        touched.push_back(tour[(j + 1) % n]);
+                        apply_inversion(tour, pos, i + 1, j);
+                        retval += delta;
+                        break;
+                    }
+                }
+            }
+            // Or-opt: move a segment of up to three cities starting (ending) at a right after (before) c.
+            for (decision_vector::size_type len = 1; len <= 3 && touched.empty(); ++len) {
+                for (int dir = 0; dir < 2 && touched.empty(); ++dir) {
+                    const decision_vector::size_type pa = pos[a];
+                    if ((dir == 0 && pa + len > n) || (dir == 1 && pa + 1 < len)) {
+                        continue;
+                    }
+                    const decision_vector::size_type first = (dir == 0) ? pa : pa + 1 - len, last = first + len - 1;
+                    const double d_a = (dir == 0) ? distance(tour[(first + n - 1) % n], a) : distance(a, tour[(last + 1) % n]);
+                    for (decision_vector::size_type l = 0; l < kk; ++l) {
+                        const decision_vector::size_type c = nl[a * kk + l];
+                        if (distance(a, c) >= d_a) {
+                            break;
+                        }
+                        const decision_vector::size_type p = (dir == 0) ? pos[c] : (pos[c] + n - 1) % n;
+                        if ((p >= first && p <= last) || p == (first + n - 1) % n) {
+                            continue;
+                        }
+                        const double delta = or_opt_delta(tour, first, last, p);
+                        if (delta < -eps * d_a) {
+                            touched.push_back(tour[(first + n - 1) % n]);
+                            touched.push_back(tour[first]);
+                            touched.push_back(tour[last]);
+                            touched.push_back(tour[(last + 1) % n]);
+                            touched.push_back(tour[p]);
+                            touched.push_back(tour[(p + 1) % n]);
+                            apply_or_opt(tour, pos, first, last, p);
+                            retval += delta;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (decision_vector::size_type i = 0; i < touched.size(); ++i) {
+                if (!active[touched[i]]) {
+                    active[touched[i]] = 1;
+                    queue.push_back(touched[i]);
+                }
+            }
+        }
+        return retval;
+    }
+
+    // Reverses tour[first], ..., tour[last] updating the positions of the cities. For symmetric problems the
+    // complementary part of the tour is reversed instead when shorter, which gives the same cycle.
+    void base_tsp::apply_inversion(decision_vector &tour, std::vector<decision_vector::size_type> &pos, decision_vector::size_type first, decision_vector::size_type last) const
+    {
+        const decision_vector::size_type n = m_n_cities;
+        decision_vector::size_type len = last - first + 1;
+        if (2 * len > n && is_symmetric()) {
+            len = n - len;
+            first = (last + 1) % n;
+            last = (first + len + n - 1) % n;
+        }
+        for (decision_vector::size_type s = 0; s < len / 2; ++s) {
+            const decision_vector::size_type x = (first + s) % n, y = (last + n - s) % n;
+            std::swap(tour[x], tour[y]);
+            pos[tour[x]] = x;
+            pos[tour[y]] = y;
+        }
+    }
+
+    // Moves tour[first], ..., tour[last] right after tour[p] updating the positions of the cities.
+    void base_tsp::apply_or_opt(decision_vector &tour, std::vector<decision_vector::size_type> &pos, decision_vector::size_type first, decision_vector::size_type last, decision_vector::size_type p) const
+    {
+        decision_vector::size_type begin, end;
+        if (p > last) {
+            std::rotate(tour.begin() + first, tour.begin() + last + 1, tour.begin() + p + 1);
+            begin = first;
+            end = p + 1;
+        } else {
+            std::rotate(tour.begin() + p + 1, tour.begin() + first, tour.begin() + last + 1);
+            begin = p + 1;
+            end = last + 1;
+        }
+        for (decision_vector::size_type i = begin; i < end; ++i) {
+            pos[tour[i]] = i;
+        }
+    }
+
+    /// Checks if a distance matrix can define a TSP
+    /**
+     * Checks that the main diagonal is zero and that all the other distances are non-zero and not NaN
+     * (i.e. the graph is fully connected). The check is O(n^2) and it is thus skipped for
+     * util::distance_matrix::EUCLIDEAN storage, which is meant for instances too large to hold all the distances.
+     *
+     * @param[in] weights the distance matrix
+     * @throws value_error if the matrix does not define a valid TSP
+     */
+    void base_tsp::check_weights(const util::distance_matrix &weights)
+    {
+        if (weights.get_storage() == util::distance_matrix::EUCLIDEAN) {
+            return;
+        }
+        const util::distance_matrix::size_type n = weights.size();
+        for (util::distance_matrix::size_type i = 0; i < n; ++i) {
+            for (util::distance_matrix::size_type j = 0; j < n; ++j) {
+                const double w = weights(i,j);
+                if (i == j && w != 0)
+                    pagmo_throw(value_error, "main diagonal elements must all be zeros.");
+                if (i != j && !w) // fully connected
+                    pagmo_throw(value_error, "adjacency matrix contains zero values.");
+                if (i != j && w != w)
+                    pagmo_throw(value_error, "adjacency matrix contains NaN values.");
+            }
+        }
+    }
+
     /// Getter for m_encoding
     /**
      * @return reference to the encoding_type
@@ -26,10 +26,12 @@
 #define PAGMO_PROBLEM_BASE_TSP_H
 
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "./base.h"
 #include "../serialization.h"
 #include "../population.h"
+#include "../util/distance_matrix.h"
 
 namespace pagmo { namespace problem {
 
@@ -89,6 +91,24 @@ class __PAGMO_VISIBLE base_tsp: public base
 
         // Pure virtual method returning the distance between cities
         virtual double distance(decision_vector::size_type, decision_vector::size_type) const = 0;
+        virtual bool is_symmetric() const;
+
+        /** @name Incremental tour evaluation (CITIES encoding).*/
+        //@{
+        double tour_length(const decision_vector &) const;
+        double inversion_delta(const decision_vector &, decision_vector::size_type, decision_vector::size_type) const;
+        double two_opt_delta(const decision_vector &, decision_vector::size_type, decision_vector::size_type) const;
+        double or_opt_delta(const decision_vector &, decision_vector::size_type, decision_vector::size_type, decision_vector::size_type) const;
+        //@}
+
+        /** @name Neighbourhood based local search (CITIES encoding).*/
+        //@{
+        const std::vector<unsigned int> &neighbour_lists(decision_vector::size_type) const;
+        double local_search(decision_vector &, decision_vector::size_type = 10) const;
+        //@}
+
+    protected:
+        static void check_weights(const util::distance_matrix &);
 
     private:
         friend class boost::serialization::access;
@@ -100,9 +120,16 @@ class __PAGMO_VISIBLE base_tsp: public base
             ar & const_cast<pagmo::decision_vector::size_type &>(m_n_cities);
         }
 
+    private:
+        void apply_inversion(decision_vector &, std::vector<decision_vector::size_type> &, decision_vector::size_type, decision_vector::size_type) const;
+        void apply_or_opt(decision_vector &, std::vector<decision_vector::size_type> &, decision_vector::size_type, decision_vector::size_type, decision_vector::size_type) const;
+
     private:
         const encoding_type m_encoding;
         const pagmo::decision_vector::size_type m_n_cities;
+        // Cache of the candidate lists, shared by copies and not serialized.
+        mutable boost::shared_ptr<const std::vector<unsigned int> > m_neighbours;
+        mutable pagmo::decision_vector::size_type m_n_neighbours;
 };
 
 }}  //namespaces
@@ -23,17 +23,29 @@
  *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <vector>
 #include <iterator>
 
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/affine.h"
 #include "cec2013.h"
 
 #define INF 1.0e99
@@ -42,6 +54,159 @@
 
 namespace pagmo { namespace problem {
 
+// Header of the binary data files written by write_binary_data(), followed by count doubles in native byte order.
+struct cec2013_bin_header
+{
+	boost::uint64_t	magic;
+	boost::uint64_t	version;
+	// cec2013_bin_byte_order as written by the host, read back differently on a host with another byte order.
+	boost::uint64_t	byte_order;
+	boost::uint64_t	count;
+	// Size in bytes of the text file the data was parsed from, to detect stale binary files.
+	boost::uint64_t	txt_size;
+};
+
+// "CEC2013K" in ASCII.
+static const boost::uint64_t cec2013_bin_magic = 0x434543323031334bULL;
+static const boost::uint64_t cec2013_bin_version = 1;
+static const boost::uint64_t cec2013_bin_byte_order = 0x0102030405060708ULL;
+
+// Immutable content of a CEC2013 data file: either the values parsed from a text file
+// or a read-only memory mapping of a binary file of doubles.
+class cec2013::data_buffer
+{
+	public:
+		// Takes the content of v (v is left empty).
+		explicit data_buffer(std::vector<double> &v):m_data(0),m_size(0)
+		{
+			m_vector.swap(v);
+			if (m_vector.size()) {
+				m_data = &m_vector[0];
+				m_size = m_vector.size();
+			}
+		}
+		// Maps the binary file file_name, checking its header. If has_txt is true, the text file it was written
+		// from must still have size txt_size.
+		data_buffer(const std::string &file_name, bool has_txt, boost::uint64_t txt_size):m_data(0),m_size(0)
+		{
+			try {
+				m_file.reset(new boost::interprocess::file_mapping(file_name.c_str(),boost::interprocess::read_only));
+				m_region.reset(new boost::interprocess::mapped_region(*m_file,boost::interprocess::read_only));
+			} catch (const boost::interprocess::interprocess_exception &e) {
+				pagmo_throw(io_error, std::string("Error: could not map the file ") + file_name + ": " + e.what());
+			}
+			cec2013_bin_header header;
+			if (m_region->get_size() < sizeof(header)) {
+				pagmo_throw(io_error, std::string("Error: ") + file_name + " is too short to be a binary data file");
+			}
+			std::memcpy(&header,m_region->get_address(),sizeof(header));
+			if (header.magic != cec2013_bin_magic || header.version != cec2013_bin_version) {
+				pagmo_throw(io_error, std::string("Error: ") + file_name + " is not a binary data file written by cec2013::write_binary_data()");
+			}
+			if (header.byte_order != cec2013_bin_byte_order) {
+				pagmo_throw(io_error, std::string("Error: ") + file_name + " was written on a host with a different byte order");
+			}
+			if ((m_region->get_size() - sizeof(header)) / sizeof(double) != header.count || (m_region->get_size() - sizeof(header)) % sizeof(double)) {
+				pagmo_throw(io_error, std::string("Error: the size of ") + file_name + " does not match its header");
+			}
+			if (has_txt && header.txt_size != txt_size) {
+				pagmo_throw(io_error, std::string("Error: ") + file_name + " is older than the text file it was written from");
+			}
+			m_data = reinterpret_cast<const double *>(static_cast<const char *>(m_region->get_address()) + sizeof(header));
+			m_size = static_cast<std::size_t>(header.count);
+		}
+		const double *data() const
+		{
+			return m_data;
+		}
+		std::size_t size() const
+		{
+			return m_size;
+		}
+	private:
+		// Not copyable.
+		data_buffer(const data_buffer &);
+		data_buffer &operator=(const data_buffer &);
+
+		std::vector<double>						m_vector;
+		boost::scoped_ptr<boost::interprocess::file_mapping>	m_file;
+		boost::scoped_ptr<boost::interprocess::mapped_region>	m_region;
+		const double							*m_data;
+		std::size_t							m_size;
+};
+
+// Returns true if a file exists and can be opened for reading.
+static bool cec2013_file_exists(const std::string &file_name)
+{
+	std::ifstream f(file_name.c_str());
+	return f.is_open();
+}
+
+// Size in bytes of an existing file.
+static boost::uint64_t cec2013_file_size(const std::string &file_name)
+{
+	std::ifstream f(file_name.c_str(), std::ios::binary | std::ios::ate);
+	return static_cast<boost::uint64_t>(f.tellg());
+}
+
+// Returns the content of the data file base_name.bin (memory-mapped) or, if it does not exist or it is not valid
+// (wrong header, byte order or size, or stale with respect to the text file), base_name.txt (parsed).
+// Files are loaded once per process: the content is shared by all the problems using it and released with the last one.
+cec2013::data_ptr cec2013::load_data(const std::string &base_name)
+{
+	// Process-wide cache, holding weak references so that it does not keep the data alive.
+	static boost::mutex cache_mutex;
+	static std::map<std::string,boost::weak_ptr<const data_buffer> > cache;
+
+	boost::lock_guard<boost::mutex> lock(cache_mutex);
+	// Drop the entries of the files no longer in use.
+	for (std::map<std::string,boost::weak_ptr<const data_buffer> >::iterator it = cache.begin(); it != cache.end();) {
+		if (it->second.expired()) {
+			cache.erase(it++);
+		} else {
+			++it;
+		}
+	}
+	data_ptr retval = cache[base_name].lock();
+	if (retval) {
+		return retval;
+	}
+	const std::string bin_file_name(base_name + ".bin"), txt_file_name(base_name + ".txt");
+	const bool has_txt = cec2013_file_exists(txt_file_name);
+	if (cec2013_file_exists(bin_file_name)) {
+		try {
+			retval.reset(new data_buffer(bin_file_name,has_txt,has_txt ? cec2013_file_size(txt_file_name) : 0));
+		} catch (const io_error &) {
+			if (!has_txt) {
+				throw;
+			}
+		}
+	}
+	if (!retval) {
+		std::ifstream data_file(txt_file_name.c_str());
+		if (!data_file.is_open()) {
+			pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + txt_file_name + ")");
+		}
+		std::istream_iterator<double> start(data_file), end;
+		std::vector<double> values(start,end);
+		retval = make_data(values);
+	}
+	cache[base_name] = retval;
+	return retval;
+}
+
+// Wraps values (left empty) into a data buffer not registered in the cache.
+cec2013::data_ptr cec2013::make_data(std::vector<double> &values)
+{
+	return data_ptr(new data_buffer(values));
+}
+
+// Copies the content of a data buffer.
+std::vector<double> cec2013::data_to_vector(const data_ptr &d)
+{
+	return std::vector<double>(d->data(),d->data() + d->size());
+}
+
 /// Constructor
 /**
  * Will construct one of the 28 CEC2013 problems
@@ -50,10 +215,11 @@ namespace pagmo { namespace problem {
  * @param[in] d problem dimension. One of [2,5,10,20,30,...,100]
  * @param[in] dir The path where the CEC2013 input files are located.
  *                Two files are expected: "M_Dx.txt" and "shift_data.txt", where "x" is the problem dimension
+ *                (or their binary versions "M_Dx.bin" and "shift_data.bin", see write_binary_data())
  *
  * @see http://web.mysites.ntu.edu.sg/epnsugan/PublicSite/Shared%20Documents/CEC2013/cec13-c-code.zip to find
  * the files
- * @throws io_error if the files are not found
+ * @throws io_error if the files are not found or do not contain enough data for dimension d
  */
 cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id), m_y(d), m_z(d)
 {
@@ -62,161 +228,203 @@ cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::str
 		pagmo_throw(value_error, "Error: CEC2013 Test functions are only defined for dimensions 2,5,10,20,30,40,50,60,70,80,90,100.");
 	}
 
-	// We create the full file name for the rotation matrix
-	std::string data_file_name(dir);
-	data_file_name.append("M_D");
-	data_file_name.append(boost::lexical_cast<std::string>(d));
-	data_file_name.append(".txt");
-	// And we read all datas into m_rotation_matrix
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + data_file_name.c_str() + ")");
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_rotation_matrix = std::vector<double>(start,end);
-	data_file.close();
-	}
-
-	// We create the full file name for the shift vector
-	data_file_name = dir;
-	data_file_name.append("shift_data.txt");
-	// And we read all data into m_origin_shift
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for ").append(data_file_name.c_str()));
+	// We load (or get from the cache) the rotation matrices and the shift vectors
+	m_rotation_matrix = load_data(dir + "M_D" + boost::lexical_cast<std::string>(d));
+	m_origin_shift = load_data(dir + "shift_data");
+	// The composition functions use up to 5 rotation matrices and shift vectors: make sure
+	// that the files are complete, as the data is accessed without bounds checking.
+	if (m_rotation_matrix->size() < 5 * d * d) {
+		pagmo_throw(io_error, std::string("Error: the rotation matrices file for dimension ") + boost::lexical_cast<std::string>(d) + " in " + dir
+			+ " contains " + boost::lexical_cast<std::string>(m_rotation_matrix->size()) + " values, at least "
+			+ boost::lexical_cast<std::string>(5 * d * d) + " are needed");
 	}
-	std::istream_iterator<double> start(data_file), end;
-	m_origin_shift = std::vector<double>(start,end);
-	data_file.close();
+	if (m_origin_shift->size() < 5 * d) {
+		pagmo_throw(io_error, std::string("Error: the shift data file in ") + dir + " contains " + boost::lexical_cast<std::string>(m_origin_shift->size())
+			+ " values, at least " + boost::lexical_cast<std::string>(5 * d) + " are needed");
 	}
 	// Set bounds. All CEC2013 problems have the same bounds
 	set_bounds(-100,100);
 }
 
 /// Clone method.
+/**
+ * The clone shares the (immutable) rotation matrices and shift vectors of this.
+ */
 base_ptr cec2013::clone() const
 {
 	return base_ptr(new cec2013(*this));
 }
 
+/// Returns the origin shift used by the problem
+/**
+ * @returns the origin shift
+ */
+std::vector<double> cec2013::origin_shift() const
+{
+	return data_to_vector(m_origin_shift);
+}
+
+/// Writes the binary versions of the data files.
+/**
+ * Parses "M_Dx.txt" and "shift_data.txt" in dir and writes their content as doubles (native byte order)
+ * into "M_Dx.bin" and "shift_data.bin" in the same folder, after a header holding a magic number, the format version,
+ * the byte order, the number of values and the size of the text file. Problems constructed afterwards memory-map the binary
+ * files instead of parsing the text ones. A binary file whose header does not match (e.g., written on a host with a
+ * different byte order, truncated, or older than a text file which has been modified since) is not used: the text file
+ * is parsed instead, or an io_error is thrown if there is none.
+ *
+ * @param[in] d problem dimension. One of [2,5,10,20,30,...,100]
+ * @param[in] dir The path where the CEC2013 input files are located.
+ *
+ * @throws io_error if the text files are not found or the binary files cannot be written
+ */
+void cec2013::write_binary_data(problem::base::size_type d, const std::string &dir)
+{
+	const std::string base_names[2] = {dir + "M_D" + boost::lexical_cast<std::string>(d), dir + "shift_data"};
+	for (int i = 0; i < 2; ++i) {
+		std::ifstream txt_file((base_names[i] + ".txt").c_str());
+		if (!txt_file.is_open()) {
+			pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + base_names[i] + ".txt)");
+		}
+		std::istream_iterator<double> start(txt_file), end;
+		const std::vector<double> values(start,end);
+		std::ofstream bin_file((base_names[i] + ".bin").c_str(), std::ios::binary);
+		if (!bin_file.is_open()) {
+			pagmo_throw(io_error, std::string("Error: could not write the file ") + base_names[i] + ".bin");
+		}
+		cec2013_bin_header header;
+		header.magic = cec2013_bin_magic;
+		header.version = cec2013_bin_version;
+		header.byte_order = cec2013_bin_byte_order;
+		header.count = values.size();
+		header.txt_size = cec2013_file_exists(base_names[i] + ".txt") ? cec2013_file_size(base_names[i] + ".txt") : 0;
+		bin_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		if (values.size()) {
+			bin_file.write(reinterpret_cast<const char *>(&values[0]), values.size() * sizeof(double));
+		}
+		if (!bin_file) {
+			pagmo_throw(io_error, std::string("Error: could not write the file ") + base_names[i] + ".bin");
+		}
+	}
+}
+
 /// Implementation of the objective function.
 void cec2013::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	size_type nx = get_dimension();
+	const double *os = m_origin_shift->data(), *mr = m_rotation_matrix->data();
 	switch(m_problem_number)
 	{
 	case 1:
-		sphere_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		sphere_func(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=-1400.0;
 		break;
 	case 2:
-		ellips_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ellips_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-1300.0;
 		break;
 	case 3:
-		bent_cigar_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bent_cigar_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-1200.0;
 		break;
 	case 4:
-		discus_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		discus_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-1100.0;
 		break;
 	case 5:
-		dif_powers_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		dif_powers_func(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=-1000.0;
 		break;
 	case 6:
-		rosenbrock_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rosenbrock_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-900.0;
 		break;
 	case 7:
-		schaffer_F7_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schaffer_F7_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-800.0;
 		break;
 	case 8:
-		ackley_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ackley_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-700.0;
 		break;
 	case 9:
-		weierstrass_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		weierstrass_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-600.0;
 		break;
 	case 10:
-		griewank_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		griewank_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-500.0;
 		break;
 	case 11:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		rastrigin_func(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=-400.0;
 		break;
 	case 12:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rastrigin_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-300.0;
 		break;
 	case 13:
-		step_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		step_rastrigin_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=-200.0;
 		break;
 	case 14:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		schwefel_func(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=-100.0;
 		break;
 	case 15:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schwefel_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=100.0;
 		break;
 	case 16:
-		katsuura_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		katsuura_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=200.0;
 		break;
 	case 17:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		bi_rastrigin_func(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=300.0;
 		break;
 	case 18:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bi_rastrigin_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=400.0;
 		break;
 	case 19:
-		grie_rosen_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		grie_rosen_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=500.0;
 		break;
 	case 20:
-		escaffer6_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		escaffer6_func(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=600.0;
 		break;
 	case 21:
-		cf01(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf01(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=700.0;
 		break;
 	case 22:
-		cf02(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		cf02(&x[0],&f[0],nx,os,mr,0);
 		f[0]+=800.0;
 		break;
 	case 23:
-		cf03(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf03(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=900.0;
 		break;
 	case 24:
-		cf04(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf04(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=1000.0;
 		break;
 	case 25:
-		cf05(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf05(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=1100.0;
 		break;
 	case 26:
-		cf06(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf06(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=1200.0;
 		break;
 	case 27:
-		cf07(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf07(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=1300.0;
 		break;
 	case 28:
-		cf08(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf08(&x[0],&f[0],nx,os,mr,1);
 		f[0]+=1400.0;
 		break;
 	default:
@@ -1048,24 +1256,12 @@ void cec2013::cf08 (const double *x, double *f, int nx, const double *Os,const d
 }
 
 void cec2013::shiftfunc (const double *x, double *xshift, int nx, const double *Os) const {
-	int i;
-	for (i=0; i<nx; i++)
-	{
-		xshift[i]=x[i]-Os[i];
-	}
+	util::affine::shift(x,Os,xshift,nx);
 }
 
 void cec2013::rotatefunc (const double *x, double *xrot, int nx,const double *Mr) const
 {
-	int i,j;
-	for (i=0; i<nx; i++)
-	{
-		xrot[i]=0;
-			for (j=0; j<nx; j++)
-			{
-				xrot[i]=xrot[i]+x[j]*Mr[i*nx+j];
-			}
-	}
+	util::affine::rotate(Mr,x,xrot,nx);
 }
 
 void cec2013::asyfunc (const double *x, double *xasy, int nx, double beta) const
@@ -26,6 +26,8 @@
 #define PAGMO_PROBLEM_CEC2013_H
 
 #include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -46,6 +48,11 @@ namespace pagmo{ namespace problem {
  *
  * NOTE 2: all problems are unconstrained continuous single objective problems.
  *
+ * NOTE 3: the data files are parsed once per process. All the instances (and their clones) using the same
+ * file share one immutable copy of its content, released when the last of them is destroyed. If a binary file
+ * with the same name and extension .bin (e.g. M_D10.bin, see cec2013::write_binary_data()) is found in the folder,
+ * it is memory-mapped instead of parsing the text file, provided that its header matches the host and the text file.
+ *
  * @see http://www.ntu.edu.sg/home/EPNSugan/index_files/CEC2013/CEC2013.htm
  *
  * @author Dario Izzo (dario.izzo@gmail.com)
@@ -65,8 +72,9 @@ class __PAGMO_VISIBLE cec2013 : public base
 		 * @returns the origin shift
 		 *
 		 */
-		std::vector<double> origin_shift() const {return m_origin_shift;}
+		std::vector<double> origin_shift() const;
 		//@}
+		static void write_binary_data(problem::base::size_type, const std::string & = "input_data/");
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
@@ -101,18 +109,41 @@ class __PAGMO_VISIBLE cec2013 : public base
 		void oszfunc (const double *, double *, int) const;
 		void cf_cal(const double *, double *, int, const double *,double *,double *,double *,int) const;
 
+		// Immutable content of a data file, shared by all the instances reading the same file.
+		class data_buffer;
+		typedef boost::shared_ptr<const data_buffer> data_ptr;
+		static data_ptr load_data(const std::string &);
+		static data_ptr make_data(std::vector<double> &);
+		static std::vector<double> data_to_vector(const data_ptr &);
+
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & const_cast<unsigned int&>(m_problem_number);
-			ar & m_rotation_matrix;
-			ar & m_origin_shift;
+			boost::serialization::split_member(ar, *this, version);
+		}
+		// The shared data are serialized by value.
+		template <class Archive>
+		void save(Archive &ar, const unsigned int) const
+		{
+			const std::vector<double> rotation_matrix(data_to_vector(m_rotation_matrix)), origin_shift(data_to_vector(m_origin_shift));
+			ar << rotation_matrix;
+			ar << origin_shift;
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int)
+		{
+			std::vector<double> rotation_matrix, origin_shift;
+			ar >> rotation_matrix;
+			ar >> origin_shift;
+			m_rotation_matrix = make_data(rotation_matrix);
+			m_origin_shift = make_data(origin_shift);
 		}
 	const unsigned int m_problem_number;
-	std::vector<double> m_rotation_matrix;
-	std::vector<double> m_origin_shift;
+	data_ptr m_rotation_matrix;
+	data_ptr m_origin_shift;
 
 	// These are pre-allocated for speed, need not to be serialized
 	mutable std::vector<double> m_y;
@@ -23,7 +23,13 @@
  *****************************************************************************/
 
 #include <cmath>
+#include <cstddef>
+#include <deque>
+#include <boost/functional/hash.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -33,6 +39,43 @@
 
 namespace pagmo { namespace problem {
 
+// Thread-safe cache of original fitnesses, keyed by chromosome. When full, the oldest entries are evicted.
+class decompose::fitness_cache
+{
+		typedef boost::unordered_map<decision_vector, fitness_vector, boost::hash<decision_vector> > map_type;
+		typedef boost::lock_guard<boost::mutex> lock_type;
+	public:
+		// Maximum number of stored fitnesses.
+		static const std::size_t capacity = 10000;
+		// Copies the fitness of x into f, if cached.
+		bool get(fitness_vector &f, const decision_vector &x)
+		{
+			lock_type lock(m_mutex);
+			const map_type::const_iterator it = m_map.find(x);
+			if (it == m_map.end()) {
+				return false;
+			}
+			f = it->second;
+			return true;
+		}
+		void insert(const decision_vector &x, const fitness_vector &f)
+		{
+			lock_type lock(m_mutex);
+			if (!m_map.insert(map_type::value_type(x,f)).second) {
+				return;
+			}
+			m_order.push_back(x);
+			if (m_order.size() > capacity) {
+				m_map.erase(m_order.front());
+				m_order.pop_front();
+			}
+		}
+	private:
+		boost::mutex			m_mutex;
+		map_type			m_map;
+		std::deque<decision_vector>	m_order;
+};
+
 
 /**
  * Constructor
@@ -59,7 +102,9 @@ decompose::decompose(const base & p, method_type method, const std::vector<doubl
 		 m_method(method),
 		 m_weights(weights),
 		 m_z(z),
-		 m_adapt_ideal(adapt_ideal)
+		 m_adapt_ideal(adapt_ideal),
+		 m_cache(new fitness_cache()),
+		 m_original_fit(p.get_f_dimension())
 {
 
 	//0 - Check whether method is implemented
@@ -125,9 +170,9 @@ base_ptr decompose::clone() const
 ///Implementation of the objective function
 void decompose::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	fitness_vector fit(m_original_problem->get_f_dimension());
-	compute_original_fitness(fit, x);
-	compute_decomposed_fitness(f, fit,m_weights);
+	m_original_fit.resize(m_original_problem->get_f_dimension());
+	compute_original_fitness(m_original_fit, x);
+	compute_decomposed_fitness(f, m_original_fit, m_weights);
 }
 
 /// Gets the ideal point
@@ -140,16 +185,42 @@ void decompose::set_ideal_point(const fitness_vector &f) {
 	m_z = f;
 }
 
+/// Shares the original fitness cache with another instance
+/**
+ * After this call, this instance and other (and all the copies of both made afterwards) look up and store
+ * the original fitnesses in the same cache.
+ *
+ * @param[in] other a decompose instance
+ *
+ * @throws value_error if other does not decompose the same problem
+ */
+void decompose::share_fitness_cache(const decompose &other)
+{
+	const base &p = *m_original_problem, &q = *other.m_original_problem;
+	if (!(p == q) || p.get_name() != q.get_name() || p.get_f_dimension() != q.get_f_dimension() ||
+		p.get_lb() != q.get_lb() || p.get_ub() != q.get_ub())
+	{
+		pagmo_throw(value_error,"the fitness cache can be shared only between decompositions of the same problem");
+	}
+	m_cache = other.m_cache;
+}
+
 /// Computes the original fitness
 /**
  * Computes the original fitness of the multi-objective problem. It also updates the ideal point in case
- * m_adapt_ideal is true
+ * m_adapt_ideal is true. The original problem is evaluated only if x is not found in the fitness cache.
  *
  * @param[out] f non-decomposed fitness vector
  * @param[in] x chromosome
  */
 void decompose::compute_original_fitness(fitness_vector &f, const decision_vector &x) const {
-	m_original_problem->objfun(f,x);
+	const bool cacheable = !is_stochastic(*m_original_problem);
+	if (!cacheable || !m_cache->get(f,x)) {
+		m_original_problem->objfun(f,x);
+		if (cacheable) {
+			m_cache->insert(x,f);
+		}
+	}
 	if (m_adapt_ideal) {
 		for (fitness_vector::size_type i=0; i<f.size(); ++i) {
 			if (f[i] < m_z[i]) m_z[i] = f[i];
@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_DECOMPOSE_H
 
 #include <string>
+#include <boost/shared_ptr.hpp>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -55,6 +56,12 @@ namespace pagmo{ namespace problem {
  *
  * TCHEBYCHEFF \f$ F_d(X) = max_{1 \leq i \leq m} w_i \vert F_i(X) - z_i \vert   \f$
  *
+ * The original fitnesses are stored in a cache shared by the copies of a decompose instance and,
+ * through decompose::share_fitness_cache, by instances decomposing the same problem with different
+ * weights (as in pagmo::algorithm::pade). A chromosome evaluated by any of them is thus
+ * evaluated only once on the original problem, and only the decomposition is recomputed.
+ * Stochastic problems are not cached.
+ *
  * @author Andrea Mambrini (andrea.mambrini@gmail.com)
  * @see "Q. Zhang -- MOEA/D: A Multiobjective Evolutionary Algorithm Based on Decomposition"
  */
@@ -82,6 +89,7 @@ class __PAGMO_VISIBLE decompose : public base_meta
 		void compute_original_fitness(fitness_vector &, const decision_vector &) const;
 		fitness_vector get_ideal_point() const;
 		void set_ideal_point(const fitness_vector &f);
+		void share_fitness_cache(const decompose &);
 
 
 	protected:
@@ -102,6 +110,12 @@ class __PAGMO_VISIBLE decompose : public base_meta
 		fitness_vector m_weights;
 		mutable fitness_vector m_z;
 		const bool m_adapt_ideal;
+		// Cache of the original fitnesses (not serialized, always allocated, but bypassed if the original problem
+		// is stochastic, also when wrapped in other meta-problems).
+		class fitness_cache;
+		boost::shared_ptr<fitness_cache> m_cache;
+		// Buffer for the original fitness.
+		mutable fitness_vector m_original_fit;
 };
 
 }} //namespaces
@@ -44,19 +44,22 @@ base_ptr inventory::clone() const
 
 void inventory::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	m_drng.seed(m_seed);
+	average_trials(f,x,(unsigned int)m_sample_size,m_seed,FITNESS_TRIAL);
+}
+
+/// Cost of a single sample path of the demand.
+void inventory::trial_impl(std::vector<double> &f, const decision_vector &x, unsigned int seed, trial_type) const
+{
+	rng_philox drng(seed);
 	const double c=1.0,b=1.5,h=0.1;
 	double retval=0;
-
-	for (size_t i = 0; i<m_sample_size; ++i) {
-		double I=0;
-		for (decision_vector::size_type j = 0; j<x.size(); ++j) {
-			double d = m_drng() * 100;
-			retval += c * x[j] + b * std::max<double>(d-I-x[j],0) + h * std::max<double>(I+x[j]-d,0);
-			I = std::max<double>(0, I + x[j] - d);
-		}
+	double I=0;
+	for (decision_vector::size_type j = 0; j<x.size(); ++j) {
+		double d = drng.uniform01() * 100;
+		retval += c * x[j] + b * std::max<double>(d-I-x[j],0) + h * std::max<double>(I+x[j]-d,0);
+		I = std::max<double>(0, I + x[j] - d);
 	}
-	f[0] = retval / m_sample_size;
+	f[0] = retval;
 }
 
 /// Extra human readable info for the problem.
@@ -84,6 +84,7 @@ class __PAGMO_VISIBLE inventory: public base_stochastic
 	protected:
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void trial_impl(std::vector<double> &, const decision_vector &, unsigned int, trial_type) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -48,6 +48,7 @@ namespace pagmo{ namespace problem {
  *
  * NOTE: for m_trials->infinity one recovers a deterministic problem, but the objective function computation
  * soon becomes very expensive. The trade-off is to keep m_trials small, while being able to get good convergence. 
+ * Trials are independent and can be spread over several threads (see base_stochastic::set_trial_threads()).
  *
  * @author Yung-Siang Liau (liauys@gmail.com)
  * @author Dario Izzo (dario.izzo@gmail.com)
@@ -82,20 +83,25 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void trial_impl(std::vector<double> &, const decision_vector &, unsigned int, trial_type) const;
 
 	private:
-		void inject_noise_f(fitness_vector&) const;
-		void inject_noise_c(constraint_vector&) const;
+		void inject_noise(std::vector<double> &, rng_philox &) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
 			ar & const_cast<unsigned int &>(m_trials);
-			ar & m_normal_dist;
-			ar & m_uniform_dist;
+			if (version == 0) {
+				// Version 0 archives store the noise distributions, now drawn from per-evaluation streams.
+				boost::normal_distribution<double> normal_dist;
+				boost::random::uniform_real_distribution<double> uniform_dist;
+				ar & normal_dist;
+				ar & uniform_dist;
+			}
 			ar & m_param_first;
 			ar & m_param_second;
 			ar & m_noise_type;
@@ -103,8 +109,6 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 
 		base_ptr m_original_problem;
 		const unsigned int m_trials;
-		mutable boost::normal_distribution<double> m_normal_dist;
-		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
 		mutable boost::hash<std::vector<double> > m_decision_vector_hash;
 		double m_param_first;
 		double m_param_second;
@@ -114,5 +118,6 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::noisy)
+BOOST_CLASS_VERSION(pagmo::problem::noisy,1)
 
 #endif // PAGMO_PROBLEM_NOISY_H
@@ -25,6 +25,8 @@
 #include <cmath>
 #include <iostream>
 #include <boost/functional/hash.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
@@ -54,8 +56,6 @@ robust::robust(const base & p, unsigned int trials, const double param_rho, unsi
 		 p.get_ic_dimension(),
 		 p.get_c_tol(), seed),
 	m_original_problem(p.clone()),
-	m_normal_dist(0, 1),
-	m_uniform_dist(0, 1),
 	m_trials(trials),
 	m_rho(param_rho)
 {
@@ -69,7 +69,6 @@ robust::robust(const base & p, unsigned int trials, const double param_rho, unsi
 robust::robust(const robust &prob):
 	 base_stochastic(prob),
 	 m_original_problem(prob.m_original_problem->clone()),
-	 m_uniform_dist(0, prob.m_rho),
 	 m_trials(prob.m_trials),
 	 m_rho(prob.m_rho) {}
 
@@ -102,60 +101,46 @@ double robust::get_rho() const
 /// Add noises to the decision vector before calling the actual objective function.
 void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	// Temporary storage used for averaging
-	fitness_vector tmp(f.size(),0.0);
-	f = tmp;
-
-	// Set the seed
-	m_drng.seed(m_seed);
-
-	// Perturb decision vector and evaluate
-	decision_vector x_perturbed(x);
-	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->objfun(tmp, x_perturbed);
-		for(fitness_vector::size_type j = 0; j < f.size(); ++j){
-			f[j] += tmp[j] / (double)m_trials;
-		}
-	}
+	average_trials(f,x,m_trials,m_seed,FITNESS_TRIAL);
 }
 
 /// Implementation of the constraints computation.
 /// Add noises to the decision vector before calling the actual constraint function.
 void robust::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	// Temporary storage used for averaging
-	constraint_vector tmp(c.size(), 0.0);
-	c = tmp;
-
-	// Set the seed
-	m_drng.seed(m_seed);
+	average_trials(c,x,m_trials,m_seed,CONSTRAINTS_TRIAL);
+}
 
-	// Perturb decision vector and evaluate
+/// Evaluation of the original problem at a single perturbation of the decision vector.
+void robust::trial_impl(std::vector<double> &retval, const decision_vector &x, unsigned int seed, trial_type type) const
+{
+	rng_philox drng(seed);
 	decision_vector x_perturbed(x);
-	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->compute_constraints(tmp, x_perturbed);
-		for(constraint_vector::size_type j = 0; j < c.size(); ++j){
-			c[j] = tmp[j] / (double)m_trials;
-		}
+	inject_noise_x(x_perturbed, drng);
+	if (type == FITNESS_TRIAL) {
+		m_original_problem->objfun(retval, x_perturbed);
+	} else {
+		m_original_problem->compute_constraints(retval, x_perturbed);
 	}
 }
 
 /// Apply noise on the decision vector based on rho
-void robust::inject_noise_x(decision_vector &x) const
+void robust::inject_noise_x(decision_vector &x, rng_philox &drng) const
 {
 	// We follow the algorithm at
 	// http://math.stackexchange.com/questions/87230/picking-random-points-in-the-volume-of-sphere-with-uniform-probability
 
+	boost::normal_distribution<double> normal_dist(0.0,1.0);
+	boost::random::uniform_real_distribution<double> uniform_dist(0.0,1.0);
+
 	// 0. Define the radius
-	double radius = m_rho * pow(m_uniform_dist(m_drng),1.0/x.size());
+	double radius = m_rho * pow(uniform_dist(drng),1.0/x.size());
 
 	// 1. Sampling N(0,1) on each dimension
 	std::vector<double> perturbation(x.size(), 0.0);
 	double c2=0;
 	for(size_type i = 0; i < perturbation.size(); i++){
-		perturbation[i] = m_normal_dist(m_drng);
+		perturbation[i] = normal_dist(drng);
 		c2 += perturbation[i]*perturbation[i];
 	}
 
@@ -70,25 +70,29 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void trial_impl(std::vector<double> &, const decision_vector &, unsigned int, trial_type) const;
 
 	private:
-		void inject_noise_x(decision_vector &) const;
+		void inject_noise_x(decision_vector &, rng_philox &) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
-			ar & m_normal_dist;
-			ar & m_uniform_dist;
+			if (version == 0) {
+				// Version 0 archives store the noise distributions, now drawn from per-evaluation streams.
+				boost::normal_distribution<double> normal_dist;
+				boost::random::uniform_real_distribution<double> uniform_dist;
+				ar & normal_dist;
+				ar & uniform_dist;
+			}
 			ar & m_trials;
 			ar & m_rho;
 		}
 
 		base_ptr m_original_problem;
-		mutable boost::normal_distribution<double> m_normal_dist;
-		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
 		unsigned int m_trials;
 		double m_rho;
 };
@@ -96,5 +100,6 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 }} //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::robust)
+BOOST_CLASS_VERSION(pagmo::problem::robust,1)
 
 #endif // PAGMO_PROBLEM_ROBUST_H
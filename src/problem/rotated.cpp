@@ -28,6 +28,7 @@
 #include "../exceptions.h"
 #include "../types.h"
 #include "../population.h"
+#include "../util/affine.h"
 #include "base.h"
 #include "rotated.h"
 
@@ -212,43 +213,48 @@ decision_vector rotated::projection_via_clipping(const decision_vector& x) const
 /// Returns the original version of the decision variables ready to be fed
 /// to the original problem
 decision_vector rotated::derotate(const decision_vector& x_normed) const
+{
+	decision_vector x(x_normed.size());
+	derotate(x_normed, x);
+	return x;
+}
+
+// Allocation-free version of derotate(), x must have the problem dimension.
+void rotated::derotate(const decision_vector& x_normed, decision_vector& x) const
 {
 	// This may be outside of the original domain, due to the 
 	// relaxed variable bounds after rotation -- project it back if so.
+	const base::size_type n = x_normed.size();
+	pagmo_assert(x.size() == n && (base::size_type)m_Rotate.rows() == n);
 
-	// 1. De-rotate the vector in the normalized space
-	Eigen::VectorXd x_normed_vec = Eigen::VectorXd::Zero(x_normed.size());
-	Eigen::VectorXd x_derotated_vec;
-	for(base::size_type i = 0; i < x_normed.size(); i++){
-		x_normed_vec(i) = x_normed[i];	
-	}
-	x_derotated_vec = m_InvRotate * x_normed_vec;
+	// 1. De-rotate the vector in the normalized space. m_Rotate is column-major, hence
+	// it is read by the kernel as its transpose, i.e. m_InvRotate.
+	util::affine::rotate(m_Rotate.data(), &x_normed[0], &x[0], n);
 
-	// 2. De-normalize the de-rotated vector to the original bounds
-	decision_vector x_derotated(x_normed.size(), 0);
-	for(base::size_type i = 0; i < x_normed.size(); i++){
-		x_derotated[i] = x_derotated_vec(i);
+	// 2. De-normalize the de-rotated vector to the original bounds and
+	// 3. if out of bounds, project back in
+	const decision_vector &lb = m_original_problem->get_lb(), &ub = m_original_problem->get_ub();
+	for(base::size_type i = 0; i < n; i++){
+		x[i] = std::min(std::max(x[i] * m_normalize_scale[i] + m_normalize_translation[i], lb[i]), ub[i]);
 	}
-	decision_vector x_wild = denormalize_to_original(x_derotated);
-
-	// 3. The de-normalized vector may be out of bounds, if so project back in
-	decision_vector x = projection_via_clipping(x_wild);
-
-	return x;
 }
 
 /// Implementation of the objective function.
 /// (Wraps over the original implementation with de-rotated input)
 void rotated::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	m_original_problem->objfun(f, derotate(x));
+	m_x_derotated.resize(x.size());
+	derotate(x, m_x_derotated);
+	m_original_problem->objfun(f, m_x_derotated);
 }
 
 /// Implementation of the constraints computation.
 /// (Wraps over the original implementation with de-rotated input)
 void rotated::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	m_original_problem->compute_constraints(c, derotate(x));
+	m_x_derotated.resize(x.size());
+	derotate(x, m_x_derotated);
+	m_original_problem->compute_constraints(c, m_x_derotated);
 }
 
 /// Extra human readable info for the problem.
@@ -68,6 +68,7 @@ class __PAGMO_VISIBLE rotated : public base_meta
 		decision_vector normalize_to_center(const decision_vector& x) const;
 		decision_vector denormalize_to_original(const decision_vector& x) const;
 		decision_vector projection_via_clipping(const decision_vector& x) const;
+		void derotate(const decision_vector &, decision_vector &) const;
 	
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -84,6 +85,8 @@ class __PAGMO_VISIBLE rotated : public base_meta
 		decision_vector m_normalize_translation;
 		decision_vector m_normalize_scale;
 
+		// Pre-allocated for speed, need not to be serialized
+		mutable decision_vector m_x_derotated;
 
 };
 
@@ -27,6 +27,7 @@
 #include "../exceptions.h"
 #include "../types.h"
 #include "../population.h"
+#include "../util/affine.h"
 #include "base.h"
 #include "shifted.h"
 
@@ -135,11 +136,11 @@ void shifted::configure_shifted_bounds(const decision_vector & translation)
  */
 decision_vector shifted::deshift(const decision_vector& x) const
 {
-	//TODO Need some assertion here?
-	decision_vector x_translated(x.size(), 0);
-	for(problem::base::size_type i = 0; i < x.size(); ++i) {
-		x_translated[i] = x[i] - m_translation[i];
+	if (x.size() != m_translation.size()) {
+		pagmo_throw(value_error,"The size of the decision vector must be equal to the problem dimension");
 	}
+	decision_vector x_translated(x.size(), 0);
+	util::affine::shift(&x[0], &m_translation[0], &x_translated[0], x.size());
 	return x_translated;
 }
 
@@ -147,16 +148,18 @@ decision_vector shifted::deshift(const decision_vector& x) const
 /// (Wraps over the original implementation with translated input x)
 void shifted::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->objfun(f, x_translated);
+	m_x_deshifted.resize(x.size());
+	util::affine::shift(&x[0], &m_translation[0], &m_x_deshifted[0], x.size());
+	m_original_problem->objfun(f, m_x_deshifted);
 }
 
 /// Implementation of the constraints computation.
 /// (Wraps over the original implementation with translated input x)
 void shifted::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->compute_constraints(c, x_translated);
+	m_x_deshifted.resize(x.size());
+	util::affine::shift(&x[0], &m_translation[0], &m_x_deshifted[0], x.size());
+	m_original_problem->compute_constraints(c, m_x_deshifted);
 }
 
 /**
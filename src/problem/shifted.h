@@ -71,6 +71,9 @@ class __PAGMO_VISIBLE shifted : public base_meta
 			ar & m_translation;
 		}
 		decision_vector m_translation;
+
+		// Pre-allocated for speed, need not to be serialized
+		mutable decision_vector m_x_deshifted;
 };
 
 }} //namespaces
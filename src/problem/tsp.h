@@ -31,6 +31,7 @@
 
 #include "./base_tsp.h"
 #include "../serialization.h"
+#include "../util/distance_matrix.h"
 
 namespace pagmo { namespace problem {
 
@@ -52,22 +53,24 @@ class __PAGMO_VISIBLE tsp: public base_tsp
 
         tsp();
         tsp(const std::vector<std::vector<double> >&, const base_tsp::encoding_type & = CITIES);
+        tsp(const util::distance_matrix &, const base_tsp::encoding_type & = CITIES);
 
         /// Copy constructor for polymorphic objects (deep copy)
         base_ptr clone() const;
 
-        const std::vector<std::vector<double> >& get_weights() const;
+        std::vector<std::vector<double> > get_weights() const;
+        const util::distance_matrix &get_distance_matrix() const;
 
         /** @name Implementation of virtual methods*/
         //@{
         std::string get_name() const;
         std::string human_readable_extra() const;
         double distance(decision_vector::size_type, decision_vector::size_type) const;
+        bool is_symmetric() const;
         //@}
 
     private:
         static boost::array<int, 2> compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type);
-        void check_weights(const std::vector<std::vector<double> >&) const;
         size_t compute_idx(const size_t i, const size_t j, const size_t n) const;
 
         void objfun_impl(fitness_vector&, const decision_vector&) const;
@@ -75,18 +78,26 @@ class __PAGMO_VISIBLE tsp: public base_tsp
 
         friend class boost::serialization::access;
         template <class Archive>
-        void serialize(Archive &ar, const unsigned int)
+        void serialize(Archive &ar, const unsigned int version)
         {
             ar & boost::serialization::base_object<base_tsp>(*this);
-            ar & m_weights;
+            if (version >= 1) {
+                ar & m_weights;
+            } else {
+                // Version 0 archives store the full weight matrix.
+                std::vector<std::vector<double> > weights;
+                ar & weights;
+                m_weights = util::distance_matrix(weights);
+            }
         }
 
     private:
-        std::vector<std::vector<double> > m_weights;
+        util::distance_matrix m_weights;
 };
 
 }}  //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::tsp)
+BOOST_CLASS_VERSION(pagmo::problem::tsp,1)
 
-#endif  //PAGMO_PROBLEM_TSP_H
\ No newline at end of file
+#endif  //PAGMO_PROBLEM_TSP_H
\ No newline at end of file
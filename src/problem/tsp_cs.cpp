@@ -36,13 +36,14 @@ namespace pagmo { namespace problem {
     tsp_cs::tsp_cs() : base_tsp(3, 0, 0 , base_tsp::RANDOMKEYS), m_weights(), m_values(), m_max_path_length(1.0)
     {
         std::vector<double> dumb(3,0);
-        m_weights = std::vector<std::vector<double> > (3,dumb);
-        m_weights[0][1] = 1;
-        m_weights[0][2] = 1;
-        m_weights[2][1] = 1;
-        m_weights[1][0] = 1;
-        m_weights[2][0] = 1;
-        m_weights[1][2] = 1;
+        std::vector<std::vector<double> > weights(3,dumb);
+        weights[0][1] = 1;
+        weights[0][2] = 1;
+        weights[2][1] = 1;
+        weights[1][0] = 1;
+        weights[2][0] = 1;
+        weights[1][2] = 1;
+        m_weights = util::distance_matrix(weights);
 
         m_values = std::vector<double>(3,1.0);
         m_max_edge_length = 1;
@@ -64,19 +65,44 @@ namespace pagmo { namespace problem {
             compute_dimensions(weights.size(), encoding)[1],
             encoding
         ),  m_weights(weights), m_values(values), m_max_path_length(max_path_length)
+    {
+        init();
+    }
+
+    /// Constructor from distance matrix
+    /**
+     * As the constructor from a weight matrix, but sharing the storage of the input util::distance_matrix.
+     *
+     * @param[in] weights         a pagmo::util::distance_matrix
+     * @param[in] values          an std::vector representing the vertices values
+     * @param[in] max_path_length the maximum path length allowed (for the travelling salesman)
+     * @param[in] encoding        a pagmo::problem::tsp::encoding representing the chosen encoding
+     */
+    tsp_cs::tsp_cs(const util::distance_matrix& weights, const std::vector<double>& values, const double max_path_length, const base_tsp::encoding_type & encoding):
+        base_tsp(weights.size(), 
+            compute_dimensions(weights.size(), encoding)[0],
+            compute_dimensions(weights.size(), encoding)[1],
+            encoding
+        ),  m_weights(weights), m_values(values), m_max_path_length(max_path_length)
+    {
+        init();
+    }
+
+    // Checks the data and computes the maximum edge length.
+    void tsp_cs::init()
     {
         check_weights(m_weights);
-        if (weights.size() != values.size()) 
+        if (m_weights.size() != m_values.size()) 
         {
             pagmo_throw(value_error,"Size of weight matrix and values vector must be equal");
         }
 
         m_max_edge_length = 0;
-        for (std::vector<std::vector<double> >::size_type  i=0; i < weights.size(); ++i)
+        for (util::distance_matrix::size_type i=0; i < m_weights.size(); ++i)
         {
-            for (std::vector<std::vector<double> >::size_type j=0; j < weights.size(); ++j)
+            for (util::distance_matrix::size_type j=0; j < m_weights.size(); ++j)
             {
-                m_max_edge_length = (weights[i][j] > m_max_edge_length) ? (weights[i][j]) : (m_max_edge_length);
+                m_max_edge_length = (m_weights(i,j) > m_max_edge_length) ? (m_weights(i,j)) : (m_max_edge_length);
             }
         }
     }
@@ -87,35 +113,6 @@ namespace pagmo { namespace problem {
         return base_ptr(new tsp_cs(*this));
     }
 
-    /// Checks if we can instantiate a TSP or ATSP problem
-    /**
-     * Checks if a matrix (std::vector<std::vector<double>>) 
-     * is square or bidirectional (e.g. no one way links between vertices).
-     * If none of the two conditions are true, we can not have a tsp problem.
-     * @param[in] matrix - the adjacency matrix (two dimensional std::vector)
-     * @throws value_error if matrix is not square and/or graph is not bidirectional
-     */
-    void tsp_cs::check_weights(const std::vector<std::vector<double> > &matrix) const 
-    {   
-        decision_vector::size_type n_cols = matrix.size();
-        
-        for (decision_vector::size_type i = 0; i < n_cols; ++i) {
-            decision_vector::size_type n_rows = matrix.at(i).size();
-            // check if the matrix is square
-            if (n_rows != n_cols)
-                pagmo_throw(value_error, "adjacency matrix is not square");
-            
-            for (size_t j = 0; j < n_rows; ++j) {
-                if (i == j && matrix.at(i).at(j) != 0)
-                    pagmo_throw(value_error, "main diagonal elements must all be zeros.");
-                if (i != j && !matrix.at(i).at(j)) // fully connected
-                    pagmo_throw(value_error, "adjacency matrix contains zero values.");
-                if (i != j && (!matrix.at(i).at(j)) == matrix.at(i).at(j)) // fully connected
-                    pagmo_throw(value_error, "adjacency matrix contains NaN values.");                    
-            }
-        }
-    }
-
     boost::array<int, 2> tsp_cs::compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type encoding)
     {
         boost::array<int,2> retval;
@@ -168,7 +165,7 @@ namespace pagmo { namespace problem {
 	    double ham_path_len = 0;
 	    for (decision_vector::size_type i=0; i<n_cities-1; ++i) 
         {
-            ham_path_len += m_weights[tour[i]][tour[i+1]];
+            ham_path_len += m_weights(tour[i],tour[i+1]);
         }
 
         f[0] = -(cum_p) - (1 - ham_path_len / (n_cities * m_max_edge_length));
@@ -223,7 +220,7 @@ namespace pagmo { namespace problem {
             while(cond_r) 
             {
                 // We increment the right "pointer" updating the value and length of the path
-                saved_length -= m_weights[tour[it_r % n_cities]][tour[(it_r + 1) % n_cities]];
+                saved_length -= m_weights(tour[it_r % n_cities],tour[(it_r + 1) % n_cities]);
                 cum_p += m_values[tour[(it_r + 1) % n_cities]];
                 it_r += 1;
 
@@ -258,7 +255,7 @@ namespace pagmo { namespace problem {
             else
             {
                 // We increment the left "pointer" updating the value and length of the path
-                saved_length += m_weights[tour[it_l % n_cities]][tour[(it_l + 1) % n_cities]];
+                saved_length += m_weights(tour[it_l % n_cities],tour[(it_l + 1) % n_cities]);
                 cum_p -= m_values[tour[it_l]];
                 it_l += 1;
                 // We update the various retvals only if the new subpath is valid
@@ -362,14 +359,35 @@ namespace pagmo { namespace problem {
     /// Definition of distance function
     double tsp_cs::distance(decision_vector::size_type i, decision_vector::size_type j) const
     {
-        return m_weights[i][j];
+        return m_weights(i,j);
+    }
+
+    /// Symmetry of the distances
+    /**
+     * @return true if the weight matrix is symmetric
+     */
+    bool tsp_cs::is_symmetric() const
+    {
+        return m_weights.is_symmetric();
+    }
+
+    /// Getter for the weight matrix
+    /**
+     * The matrix is rebuilt from the internal storage at each call, in O(n^2) time and memory
+     * for n cities: use get_distance_matrix() to access the distances without copies.
+     *
+     * @return the full weight matrix, whatever the storage used internally
+     */
+    std::vector<std::vector<double> > tsp_cs::get_weights() const
+    { 
+        return m_weights.to_matrix(); 
     }
 
     /// Getter for m_weights
     /**
-     * @return const reference to m_weights
+     * @return const reference to the distance matrix
      */
-    const std::vector<std::vector<double> >&  tsp_cs::get_weights() const
+    const util::distance_matrix &tsp_cs::get_distance_matrix() const
     { 
         return m_weights; 
     }
@@ -423,7 +441,7 @@ namespace pagmo { namespace problem {
         oss << "\tWeight Matrix: \n";
         for (decision_vector::size_type i=0; i<get_n_cities() ; ++i)
         {
-            oss << "\t\t" << m_weights.at(i) << '\n';
+            oss << "\t\t" << m_weights.row(i) << '\n';
             if (i>5)
             {
                 oss << "\t\t..." << '\n';
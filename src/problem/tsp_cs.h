@@ -31,6 +31,7 @@
 
 #include "./base_tsp.h"
 #include "../serialization.h"
+#include "../util/distance_matrix.h"
 
 namespace pagmo { namespace problem {
 
@@ -61,13 +62,15 @@ class __PAGMO_VISIBLE tsp_cs: public base_tsp
         /// Constructors
         tsp_cs();
         tsp_cs(const std::vector<std::vector<double> >&, const std::vector<double>&, const double, const base_tsp::encoding_type & = CITIES);
+        tsp_cs(const util::distance_matrix &, const std::vector<double>&, const double, const base_tsp::encoding_type & = CITIES);
 
         /// Copy constructor for polymorphic objects
         base_ptr clone() const;
 
         /** @name Getters*/
         //@{
-        const std::vector<std::vector<double> >& get_weights() const;
+        std::vector<std::vector<double> > get_weights() const;
+        const util::distance_matrix &get_distance_matrix() const;
         const std::vector<double>& get_values() const;
         double get_max_path_length() const;
         //@}
@@ -77,13 +80,14 @@ class __PAGMO_VISIBLE tsp_cs: public base_tsp
         std::string get_name() const;
         std::string human_readable_extra() const;
         double distance(decision_vector::size_type, decision_vector::size_type) const;
+        bool is_symmetric() const;
         //@}
 
         void find_subsequence(const decision_vector &, double &, double &, decision_vector::size_type &, decision_vector::size_type &) const;
 
     private:
         static boost::array<int, 2> compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type);
-        void check_weights(const std::vector<std::vector<double> >&) const;
+        void init();
         size_t compute_idx(const size_t i, const size_t j, const size_t n) const;
 
         void objfun_impl(fitness_vector&, const decision_vector&) const;
@@ -91,17 +95,24 @@ class __PAGMO_VISIBLE tsp_cs: public base_tsp
 
         friend class boost::serialization::access;
         template <class Archive>
-        void serialize(Archive &ar, const unsigned int)
+        void serialize(Archive &ar, const unsigned int version)
         {
             ar & boost::serialization::base_object<base_tsp>(*this);
-            ar & m_weights;
+            if (version >= 1) {
+                ar & m_weights;
+            } else {
+                // Version 0 archives store the full weight matrix.
+                std::vector<std::vector<double> > weights;
+                ar & weights;
+                m_weights = util::distance_matrix(weights);
+            }
             ar & m_values;
             ar & const_cast<double &>(m_max_path_length);
 	        ar & m_max_edge_length;
         }
 
     private:
-        std::vector<std::vector<double> > m_weights;
+        util::distance_matrix m_weights;
         std::vector<double> m_values ;
         const double m_max_path_length;
         double m_max_edge_length;
@@ -110,5 +121,6 @@ class __PAGMO_VISIBLE tsp_cs: public base_tsp
 }}  //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::tsp_cs)
+BOOST_CLASS_VERSION(pagmo::problem::tsp_cs,1)
 
 #endif  //PAGMO_PROBLEM_TSP_CS_H
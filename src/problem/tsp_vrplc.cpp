@@ -35,13 +35,14 @@ namespace pagmo { namespace problem {
     tsp_vrplc::tsp_vrplc() : base_tsp(3, 0, 0 , base_tsp::RANDOMKEYS), m_weights(), m_capacity(1.1)
     {
         std::vector<double> dumb(3,0);
-        m_weights = std::vector<std::vector<double> > (3,dumb);
-        m_weights[0][1] = 1;
-        m_weights[0][2] = 1;
-        m_weights[2][1] = 1;
-        m_weights[1][0] = 1;
-        m_weights[2][0] = 1;
-        m_weights[1][2] = 1;
+        std::vector<std::vector<double> > weights(3,dumb);
+        weights[0][1] = 1;
+        weights[0][2] = 1;
+        weights[2][1] = 1;
+        weights[1][0] = 1;
+        weights[2][0] = 1;
+        weights[1][2] = 1;
+        m_weights = util::distance_matrix(weights);
     }
 
     /// Constructor from weight matrix, encoding and capacity
@@ -65,40 +66,32 @@ namespace pagmo { namespace problem {
         check_weights(m_weights);
     }
 
-    /// Clone method.
-    base_ptr tsp_vrplc::clone() const
-    {
-        return base_ptr(new tsp_vrplc(*this));
-    }
-
-    /// Checks if we can instantiate a TSP or ATSP problem
+    /// Constructor from distance matrix, encoding and capacity
     /**
-     * Checks if a matrix (std::vector<std::vector<double>>) 
-     * is square or bidirectional (e.g. no one way links between vertices).
-     * If none of the two conditions are true, we can not have a tsp problem.
+     * As the constructor from a weight matrix, but sharing the storage of the input util::distance_matrix.
      *
-     * @param matrix the adjacency matrix (two dimensional std::vector)
-     * @throws pagmo_throw matrix is not square and/or graph is not bidirectional
+     * @param[in] weights a pagmo::util::distance_matrix.
+     * @param[in] encoding a pagmo::problem::tsp::encoding representing the chosen encoding
+     * @param[in] capacity maximum vehicle capacity
      */
-    void tsp_vrplc::check_weights(const std::vector<std::vector<double> > &matrix) const 
-    {   
-        decision_vector::size_type n_cols = matrix.size();
-        
-        for (decision_vector::size_type i = 0; i < n_cols; ++i) {
-            decision_vector::size_type n_rows = matrix.at(i).size();
-            // check if the matrix is square
-            if (n_rows != n_cols)
-                pagmo_throw(value_error, "adjacency matrix is not square");
-            
-            for (size_t j = 0; j < n_rows; ++j) {
-                if (i == j && matrix.at(i).at(j) != 0)
-                    pagmo_throw(value_error, "main diagonal elements must all be zeros.");
-                if (i != j && !matrix.at(i).at(j)) // fully connected
-                    pagmo_throw(value_error, "adjacency matrix contains zero values.");
-                if (i != j && (!matrix.at(i).at(j)) == matrix.at(i).at(j)) // fully connected
-                    pagmo_throw(value_error, "adjacency matrix contains NaN values.");                    
-            }
+    tsp_vrplc::tsp_vrplc(const util::distance_matrix& weights, const base_tsp::encoding_type& encoding, const double& capacity): 
+        base_tsp(weights.size(), 
+            compute_dimensions(weights.size(), encoding)[0],
+            compute_dimensions(weights.size(), encoding)[1],
+            encoding
+        ),  m_weights(weights), m_capacity(capacity)
+    {
+        if (m_capacity <= 0)
+        {
+            pagmo_throw(value_error, "Maximum vehicle capacity needs to be strictly positive");
         }
+        check_weights(m_weights);
+    }
+
+    /// Clone method.
+    base_ptr tsp_vrplc::clone() const
+    {
+        return base_ptr(new tsp_vrplc(*this));
     }
 
     boost::array<int, 2> tsp_vrplc::compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type encoding)
@@ -145,7 +138,7 @@ namespace pagmo { namespace problem {
             }
         }
         for (decision_vector::size_type i=0; i<n_cities-1; ++i) {
-            stl += m_weights[tour[i]][tour[i+1]];
+            stl += m_weights(tour[i],tour[i+1]);
             if(stl > m_capacity)
             {
                 stl = 0;
@@ -153,7 +146,7 @@ namespace pagmo { namespace problem {
             }
             else
             {
-                f[0] += (m_weights[tour[i]][tour[i+1]])/(n_cities*m_capacity);
+                f[0] += (m_weights(tour[i],tour[i+1]))/(n_cities*m_capacity);
             }
         }
         return;
@@ -175,7 +168,7 @@ namespace pagmo { namespace problem {
         for (decision_vector::size_type i=0; i<n_cities-1; ++i) 
         {
             cur_tour.push_back(x[i]);
-            stl += m_weights[x[i]][x[i+1]];
+            stl += m_weights(x[i],x[i+1]);
             if(stl > m_capacity)
             {
                     stl = 0;
@@ -268,14 +261,35 @@ namespace pagmo { namespace problem {
     /// Definition of the distance function
     double tsp_vrplc::distance(decision_vector::size_type i, decision_vector::size_type j) const
     {
-        return m_weights[i][j];
+        return m_weights(i,j);
+    }
+
+    /// Symmetry of the distances
+    /**
+     * @return true if the weight matrix is symmetric
+     */
+    bool tsp_vrplc::is_symmetric() const
+    {
+        return m_weights.is_symmetric();
+    }
+
+    /// Getter for the weight matrix
+    /**
+     * The matrix is rebuilt from the internal storage at each call, in O(n^2) time and memory
+     * for n cities: use get_distance_matrix() to access the distances without copies.
+     *
+     * @return the full weight matrix, whatever the storage used internally
+     */
+    std::vector<std::vector<double> > tsp_vrplc::get_weights() const
+    { 
+        return m_weights.to_matrix(); 
     }
 
     /// Getter for m_weights
     /**
-     * @return reference to m_weights
+     * @return const reference to the distance matrix
      */
-    const std::vector<std::vector<double> >&  tsp_vrplc::get_weights() const
+    const util::distance_matrix &tsp_vrplc::get_distance_matrix() const
     { 
         return m_weights; 
     }
@@ -319,7 +333,7 @@ namespace pagmo { namespace problem {
         oss << "\tWeight Matrix: \n";
         for (decision_vector::size_type i=0; i<get_n_cities() ; ++i)
         {
-            oss << "\t\t" << m_weights.at(i) << '\n';
+            oss << "\t\t" << m_weights.row(i) << '\n';
             if (i>5)
             {
                 oss << "\t\t..." << '\n';
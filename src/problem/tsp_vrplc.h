@@ -31,6 +31,7 @@
 
 #include "./base_tsp.h"
 #include "../serialization.h"
+#include "../util/distance_matrix.h"
 
 namespace pagmo { namespace problem {
 
@@ -50,11 +51,13 @@ class __PAGMO_VISIBLE tsp_vrplc: public base_tsp
 
         tsp_vrplc();
         tsp_vrplc(const std::vector<std::vector<double> >&, const base_tsp::encoding_type & = FULL, const double& = 1);
+        tsp_vrplc(const util::distance_matrix &, const base_tsp::encoding_type & = FULL, const double& = 1);
 
         /// Copy constructor for polymorphic objects (deep copy)
         base_ptr clone() const;
 
-        const std::vector<std::vector<double> >& get_weights() const;
+        std::vector<std::vector<double> > get_weights() const;
+        const util::distance_matrix &get_distance_matrix() const;
         const double& get_capacity() const;
 
         /** @name Implementation of virtual methods*/
@@ -62,12 +65,12 @@ class __PAGMO_VISIBLE tsp_vrplc: public base_tsp
         std::string get_name() const;
         std::string human_readable_extra() const;
         double distance(decision_vector::size_type, decision_vector::size_type) const;
+        bool is_symmetric() const;
         std::vector<std::vector<double> > return_tours(const decision_vector& x) const;
         //@}
 
     private:
         static boost::array<int, 2> compute_dimensions(decision_vector::size_type n_cities, base_tsp::encoding_type);
-        void check_weights(const std::vector<std::vector<double> >&) const;
         size_t compute_idx(const size_t i, const size_t j, const size_t n) const;
 
         void objfun_impl(fitness_vector&, const decision_vector&) const;
@@ -75,20 +78,28 @@ class __PAGMO_VISIBLE tsp_vrplc: public base_tsp
 
         friend class boost::serialization::access;
         template <class Archive>
-        void serialize(Archive &ar, const unsigned int)
+        void serialize(Archive &ar, const unsigned int version)
         {
             ar & boost::serialization::base_object<base_tsp>(*this);
-            ar & m_weights;
+            if (version >= 1) {
+                ar & m_weights;
+            } else {
+                // Version 0 archives store the full weight matrix.
+                std::vector<std::vector<double> > weights;
+                ar & weights;
+                m_weights = util::distance_matrix(weights);
+            }
             ar & const_cast<double&>(m_capacity);
         }
 
     private:
-        std::vector<std::vector<double> > m_weights;
+        util::distance_matrix m_weights;
         const double m_capacity;
 };
 
 }}  //namespaces
 
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::tsp_vrplc)
+BOOST_CLASS_VERSION(pagmo::problem::tsp_vrplc,1)
 
 #endif  //PAGMO_PROBLEM_tsp_vrplc_H
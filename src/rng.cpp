@@ -22,43 +22,206 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/atomic.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <cstddef>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 
 #include "rng.h"
 
 namespace pagmo
 {
 
-boost::mutex rng_generator::m_mutex;
+/// Skip ahead.
+/**
+ * Equivalent to n calls to operator()(), in constant time.
+ *
+ * @param[in] n number of values to be skipped.
+ */
+void rng_philox::discard(boost::uint64_t n)
+{
+	if (n == 0) {
+		return;
+	}
+	// Block and offset of the next value, the block index wrapping around at the end of the substream.
+	boost::uint64_t block = (static_cast<boost::uint64_t>(m_counter[1]) << 32) | m_counter[0];
+	unsigned int offset = 0;
+	if (m_index < 4) {
+		--block;
+		offset = m_index;
+	}
+	block += n / 4;
+	offset += static_cast<unsigned int>(n % 4);
+	if (offset >= 4) {
+		++block;
+		offset -= 4;
+	}
+	m_counter[0] = static_cast<result_type>(block);
+	m_counter[1] = static_cast<result_type>(block >> 32);
+	m_index = 4;
+	if (offset) {
+		generate_block(m_counter,m_key,m_buffer);
+		increment(m_counter);
+		m_index = offset;
+	}
+}
+
+/// Fill an array with random numbers.
+/**
+ * Equivalent to n calls to operator()(), but whole blocks are written directly to the output.
+ *
+ * @param[out] out output array.
+ * @param[in] n number of values to be drawn.
+ */
+void rng_philox::fill(result_type *out, std::size_t n)
+{
+	std::size_t i = 0;
+	for (; i < n && m_index < 4; ++i) {
+		out[i] = m_buffer[m_index++];
+	}
+	for (; i + 4 <= n; i += 4) {
+		generate_block(m_counter,m_key,out + i);
+		increment(m_counter);
+	}
+	for (; i < n; ++i) {
+		out[i] = (*this)();
+	}
+}
+
+/// Fill an array with doubles in the [0,1[ range.
+/**
+ * Equivalent to n calls to uniform01().
+ *
+ * @param[out] out output array.
+ * @param[in] n number of values to be drawn.
+ */
+void rng_philox::fill_uniform(double *out, std::size_t n)
+{
+	// The random bits are drawn in chunks on the stack, and then converted.
+	const std::size_t chunk = 256;
+	result_type bits[2 * chunk];
+	for (std::size_t i = 0; i < n; i += chunk) {
+		const std::size_t m = (n - i < chunk) ? n - i : chunk;
+		fill(bits,2 * m);
+		for (std::size_t j = 0; j < m; ++j) {
+			out[i + j] = ((bits[2 * j] >> 5) * 67108864. + (bits[2 * j + 1] >> 6)) * (1. / 9007199254740992.);
+		}
+	}
+}
+
+/// Fill an array with normally distributed doubles.
+/**
+ * The values are obtained with the Box-Muller transform from pairs of consecutive uniform01() values.
+ * An odd n consumes a whole pair for the last value.
+ *
+ * @param[out] out output array.
+ * @param[in] n number of values to be drawn.
+ * @param[in] mean mean of the distribution.
+ * @param[in] sigma standard deviation of the distribution.
+ */
+void rng_philox::fill_normal(double *out, std::size_t n, const double &mean, const double &sigma)
+{
+	const double two_pi = 2 * boost::math::constants::pi<double>();
+	fill_uniform(out,n);
+	for (std::size_t i = 0; i + 1 < n; i += 2) {
+		const double r = sigma * std::sqrt(-2 * std::log(1 - out[i])), theta = two_pi * out[i + 1];
+		out[i] = mean + r * std::cos(theta);
+		out[i + 1] = mean + r * std::sin(theta);
+	}
+	if (n % 2) {
+		const double u = uniform01();
+		out[n - 1] = mean + sigma * std::sqrt(-2 * std::log(1 - out[n - 1])) * std::cos(two_pi * u);
+	}
+}
+
+/// Equality operator.
+/**
+ * @return true if the two generators will produce the same sequence.
+ */
+bool rng_philox::operator==(const rng_philox &other) const
+{
+	if (m_key[0] != other.m_key[0] || m_key[1] != other.m_key[1] || m_index != other.m_index) {
+		return false;
+	}
+	for (int i = 0; i < 4; ++i) {
+		if (m_counter[i] != other.m_counter[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Inequality operator.
+bool rng_philox::operator!=(const rng_philox &other) const
+{
+	return !(*this == other);
+}
+
+// State of rng_generator, kept out of the header so that the atomic and thread-local
+// machinery is not pulled into every translation unit using the rngs.
+struct rng_seeder
+{
+	unsigned int	epoch;
+	rng_philox	rng;
+};
+
+static boost::mutex rng_mutex;
 
 // Use as initial seed the number of microseconds elapsed since 01/01/1970, cast to uint32_t.
-rng_uint32 rng_generator::m_seeder(boost::uint32_t((boost::posix_time::microsec_clock::local_time() -
+static boost::uint32_t rng_seed(boost::uint32_t((boost::posix_time::microsec_clock::local_time() -
 	boost::posix_time::ptime(boost::gregorian::date(1970,1,1))).total_microseconds()));
 
+static boost::uint32_t rng_next_stream(0);
+
+static boost::atomic<unsigned int> rng_epoch(0);
+
+static boost::thread_specific_ptr<rng_seeder> rng_seeders;
+
+// Seeder of the calling thread, (re)initialised on its first use after set_seed().
+static rng_philox &local_seeder()
+{
+	rng_seeder *seeder = rng_seeders.get();
+	const unsigned int epoch = rng_epoch.load(boost::memory_order_acquire);
+	if (!seeder || seeder->epoch != epoch) {
+		if (!seeder) {
+			seeder = new rng_seeder;
+			rng_seeders.reset(seeder);
+		}
+		boost::lock_guard<boost::mutex> lock(rng_mutex);
+		seeder->epoch = rng_epoch.load(boost::memory_order_relaxed);
+		seeder->rng.seed(rng_seed,rng_next_stream++);
+	}
+	return seeder->rng;
+}
+
 /// Set seed.
 /**
- * Set the seed of the internal generator to n. Thread-safe. Note that input integer n will be
- * cast to uint32_t.
+ * Set the seed of the internal generators to n. Thread-safe. Note that input integer n will be
+ * cast to uint32_t. The seeders of all the threads are reset, and streams are assigned again
+ * to the threads in the order of their next call to get().
  *
  * @param[in] n seed for the generator of pseudo-random number generators.
  */
 void rng_generator::set_seed(int n)
 {
-	boost::lock_guard<boost::mutex> lock(m_mutex);
-	m_seeder.seed(n);
+	boost::lock_guard<boost::mutex> lock(rng_mutex);
+	rng_seed = boost::uint32_t(n);
+	rng_next_stream = 0;
+	++rng_epoch;
 }
 
-
 template <class Rng> 
 Rng rng_generator::get()
 {
-	boost::lock_guard<boost::mutex> lock(m_mutex);
-	return Rng(m_seeder());
+	return Rng(local_seeder()());
 }
 
 template __PAGMO_VISIBLE rng_double rng_generator::get<rng_double>();
 template __PAGMO_VISIBLE rng_uint32 rng_generator::get<rng_uint32>();
+template __PAGMO_VISIBLE rng_philox rng_generator::get<rng_philox>();
 
 }
@@ -27,16 +27,25 @@
 #ifndef PAGMO_RNG_H
 #define PAGMO_RNG_H
 
+#include <boost/config.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/random/lagged_fibonacci.hpp>
 #include <boost/random/mersenne_twister.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 106400
+#include <boost/serialization/array_wrapper.hpp>
+#else
+#include <boost/serialization/array.hpp>
+#endif
+#include <cstddef>
+#include <cstring>
 #include <sstream>
 #include <string>
 
 #include "serialization.h"
 #include "config.h"
+#include "exceptions.h"
 
 namespace pagmo
 {
@@ -61,23 +70,55 @@ class __PAGMO_VISIBLE rng_uint32: public boost::mt19937 {
 		rng_uint32(const result_type &n):boost::mt19937(n) {}
 		// Default generated copy ctor and assignment are fine.
 	private:
-		// Serialization exploits the fact that the state of Boost RNGs
-		// can be sent/received to/from standard streams.
+		// Data members of boost::mt19937 (Boost >= 1.47): the state words and the index of the next one.
+		// Serialization copies them in and out of the engine, without going through its stream operators,
+		// and writes them as an array, so that binary archives store the state as a single block.
+		// The size of the layout is checked here, its order by the tests.
+		struct state_type
+		{
+			boost::uint32_t	x[624];
+			std::size_t	i;
+		};
+		BOOST_STATIC_ASSERT(sizeof(state_type) == sizeof(boost::mt19937));
+		void get_state(state_type &s) const
+		{
+			std::memcpy(static_cast<void *>(&s),static_cast<const void *>(static_cast<const boost::mt19937 *>(this)),sizeof(state_type));
+		}
+		void set_state(const state_type &s)
+		{
+			std::memcpy(static_cast<void *>(static_cast<boost::mt19937 *>(this)),static_cast<const void *>(&s),sizeof(state_type));
+		}
+		// Version 0 archives stored the text representation of the generator, version 1 archives the
+		// 624 words of its canonical representation, i.e., the state rewound to the last refill.
 		template <class Archive>
 		void save(Archive &ar, const unsigned int) const
 		{
-			std::stringstream ss;
-			ss << *static_cast<boost::mt19937 const *>(this);
-			std::string tmp(ss.str());
-			ar << tmp;
+			state_type s;
+			get_state(s);
+			const unsigned int i = static_cast<unsigned int>(s.i);
+			ar << i << boost::serialization::make_array(s.x,624);
 		}
 		template <class Archive>
-		void load(Archive &ar, const unsigned int)
+		void load(Archive &ar, const unsigned int version)
 		{
-			std::string tmp;
-			ar >> tmp;
-			std::stringstream ss(tmp);
-			ss >> *static_cast<boost::mt19937 *>(this);
+			if (version == 0) {
+				std::string tmp;
+				ar >> tmp;
+				std::stringstream ss(tmp);
+				ss >> *static_cast<boost::mt19937 *>(this);
+				return;
+			}
+			state_type s;
+			unsigned int i = 624;
+			if (version >= 2) {
+				ar >> i;
+			}
+			ar >> boost::serialization::make_array(s.x,624);
+			if (i > 624) {
+				pagmo_throw(value_error,"inconsistent rng state in archive");
+			}
+			s.i = i;
+			set_state(s);
 		}
 		BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
@@ -101,32 +142,193 @@ class __PAGMO_VISIBLE rng_double: public boost::lagged_fibonacci607 {
 		rng_double(const boost::uint32_t &n):boost::lagged_fibonacci607(n) {}
 		// Default generated copy ctor and assignment are fine.
 	private:
+		// Data members of boost::lagged_fibonacci607 (Boost >= 1.47), see rng_uint32. Version 1 archives
+		// hold the same values, obtained through the stream operators of the engine.
+		struct state_type
+		{
+			unsigned int	i;
+			double		x[607];
+		};
+		BOOST_STATIC_ASSERT(sizeof(state_type) == sizeof(boost::lagged_fibonacci607));
+		void get_state(state_type &s) const
+		{
+			std::memcpy(static_cast<void *>(&s),static_cast<const void *>(static_cast<const boost::lagged_fibonacci607 *>(this)),sizeof(state_type));
+		}
+		void set_state(const state_type &s)
+		{
+			std::memcpy(static_cast<void *>(static_cast<boost::lagged_fibonacci607 *>(this)),static_cast<const void *>(&s),sizeof(state_type));
+		}
 		template <class Archive>
 		void save(Archive &ar, const unsigned int) const
 		{
-			std::stringstream ss;
-			ss << *static_cast<boost::lagged_fibonacci607 const *>(this);
-			std::string tmp(ss.str());
-			ar << tmp;
+			state_type s;
+			get_state(s);
+			ar << s.i << boost::serialization::make_array(s.x,607);
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int version)
+		{
+			if (version == 0) {
+				std::string tmp;
+				ar >> tmp;
+				std::stringstream ss(tmp);
+				ss >> *static_cast<boost::lagged_fibonacci607 *>(this);
+				return;
+			}
+			state_type s;
+			ar >> s.i >> boost::serialization::make_array(s.x,607);
+			if (s.i > 607) {
+				pagmo_throw(value_error,"inconsistent rng state in archive");
+			}
+			set_state(s);
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+};
+
+/// Counter-based rng returning an unsigned integer in the [0,2**32-1] range.
+/**
+ * Implementation of the Philox4x32-10 generator of Salmon et al., "Parallel random numbers: as easy
+ * as 1, 2, 3" (SC 2011). The n-th block of four outputs is a bijective function of the counter n and of
+ * the key, so that the state is a few bytes, jumping ahead is O(1) and independent streams are obtained
+ * by changing the key or the high part of the counter, without any seeding procedure.
+ *
+ * A generator is identified by a seed and a stream (e.g., the seed of an experiment and the index of an
+ * island), and can be further split into substreams (e.g., one per thread). Generators with different
+ * (seed, stream, substream) triplets produce non-overlapping sequences.
+ *
+ * The class models a Boost uniform random number generator, and can thus be used with the Boost
+ * distributions wherever rng_uint32 is. The bulk fill methods produce the same values as the corresponding
+ * sequence of single draws.
+ */
+class __PAGMO_VISIBLE rng_philox {
+		friend class boost::serialization::access;
+	public:
+		/// Return value of the generator.
+		typedef boost::uint32_t result_type;
+		BOOST_STATIC_CONSTANT(bool, has_fixed_range = false);
+		/// Default constructor.
+		/**
+		 * Seed and stream are zero.
+		 */
+		rng_philox() {seed(0,0);}
+		/// Constructor from seed and stream.
+		/**
+		 * @param[in] s seed of the generator.
+		 * @param[in] stream index of the stream.
+		 */
+		explicit rng_philox(const result_type &s, const result_type &stream = 0) {seed(s,stream);}
+		/// Reset the generator.
+		/**
+		 * @param[in] s seed of the generator.
+		 * @param[in] stream index of the stream.
+		 */
+		void seed(const result_type &s, const result_type &stream = 0)
+		{
+			m_key[0] = s;
+			m_key[1] = stream;
+			m_counter[0] = m_counter[1] = m_counter[2] = m_counter[3] = 0;
+			m_index = 4;
+		}
+		/// Generator on a substream.
+		/**
+		 * @param[in] substream index of the substream.
+		 *
+		 * @return a generator with the same seed and stream, at the beginning of the given substream.
+		 */
+		rng_philox split(const boost::uint64_t &substream) const
+		{
+			rng_philox retval(m_key[0],m_key[1]);
+			retval.m_counter[2] = static_cast<result_type>(substream);
+			retval.m_counter[3] = static_cast<result_type>(substream >> 32);
+			return retval;
+		}
+		/// Minimum value returned by the generator.
+		static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0;}
+		/// Maximum value returned by the generator.
+		static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0xffffffffu;}
+		/// Draw a random number.
+		result_type operator()()
+		{
+			if (m_index == 4) {
+				generate_block(m_counter,m_key,m_buffer);
+				increment(m_counter);
+				m_index = 0;
+			}
+			return m_buffer[m_index++];
+		}
+		/// Draw a double in the [0,1[ range, with 53 random bits.
+		double uniform01()
+		{
+			const result_type a = (*this)() >> 5, b = (*this)() >> 6;
+			return (a * 67108864. + b) * (1. / 9007199254740992.);
+		}
+		void discard(boost::uint64_t);
+		void fill(result_type *, std::size_t);
+		void fill_uniform(double *, std::size_t);
+		void fill_normal(double *, std::size_t, const double &mean = 0, const double &sigma = 1);
+		bool operator==(const rng_philox &) const;
+		bool operator!=(const rng_philox &) const;
+	private:
+		// Philox4x32-10 bijection.
+		static void generate_block(const result_type *ctr, const result_type *key, result_type *out)
+		{
+			result_type c[4] = {ctr[0], ctr[1], ctr[2], ctr[3]}, k[2] = {key[0], key[1]};
+			for (int r = 0; r < 10; ++r) {
+				const boost::uint64_t p0 = static_cast<boost::uint64_t>(0xD2511F53u) * c[0], p1 = static_cast<boost::uint64_t>(0xCD9E8D57u) * c[2];
+				const result_type hi0 = static_cast<result_type>(p0 >> 32), lo0 = static_cast<result_type>(p0),
+					hi1 = static_cast<result_type>(p1 >> 32), lo1 = static_cast<result_type>(p1);
+				c[0] = hi1 ^ c[1] ^ k[0];
+				c[1] = lo1;
+				c[2] = hi0 ^ c[3] ^ k[1];
+				c[3] = lo0;
+				k[0] += 0x9E3779B9u;
+				k[1] += 0xBB67AE85u;
+			}
+			out[0] = c[0]; out[1] = c[1]; out[2] = c[2]; out[3] = c[3];
+		}
+		// Increment the 64-bit block counter, stored in the two low words of the counter.
+		static void increment(result_type *ctr)
+		{
+			if (!++ctr[0]) {
+				++ctr[1];
+			}
+		}
+		template <class Archive>
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << m_key[0] << m_key[1] << m_counter[0] << m_counter[1] << m_counter[2] << m_counter[3] << m_index;
 		}
 		template <class Archive>
 		void load(Archive &ar, const unsigned int)
 		{
-			std::string tmp;
-			ar >> tmp;
-			std::stringstream ss(tmp);
-			ss >> *static_cast<boost::lagged_fibonacci607 *>(this);
+			ar >> m_key[0] >> m_key[1] >> m_counter[0] >> m_counter[1] >> m_counter[2] >> m_counter[3] >> m_index;
+			// The current block, if any, is recomputed from the counter.
+			if (m_index < 4) {
+				result_type ctr[4] = {m_counter[0], m_counter[1], m_counter[2], m_counter[3]};
+				if (!ctr[0]--) {
+					--ctr[1];
+				}
+				generate_block(ctr,m_key,m_buffer);
+			}
 		}
 		BOOST_SERIALIZATION_SPLIT_MEMBER()
+		result_type	m_key[2];
+		// Counter of the next block: 64-bit block index followed by the 64-bit substream index.
+		result_type	m_counter[4];
+		result_type	m_buffer[4];
+		unsigned int	m_index;
 };
 
 /// Generic thread-safe generator of pseudo-random number generators.
 /**
  * To use, call the static member get() to get a pseudo-random number generator seeded with an initial pseudo-random value.
  *
- * Implementation internally uses a mutex, so that this generator can
- * be safely called concurrently from multiple threads. The initial seed used
- * is the number of microseconds elapsed since 01/01/1970, cast to uint32_t.
+ * Each thread draws the seeds from its own stream of a pagmo::rng_philox generator, so that
+ * this generator can be safely called concurrently from multiple threads without contention:
+ * a mutex is taken only the first time a thread calls get() after a call to set_seed(). Streams
+ * are assigned to the threads in the order of their first call, so that the seeds are reproducible
+ * in single-threaded programs. The initial seed used is the number of microseconds elapsed since
+ * 01/01/1970, cast to uint32_t.
  *
  * @see http://www.boost.org/doc/libs/release/libs/random/index.html
  *
@@ -149,12 +351,11 @@ class __PAGMO_VISIBLE rng_generator {
 		template <class Rng> 
 		static Rng get();
 		static void set_seed(int);
-
-	private:
-		static  boost::mutex  m_mutex;
-		static  rng_uint32  m_seeder;
 };
 
 }
 
+BOOST_CLASS_VERSION(pagmo::rng_uint32,2)
+BOOST_CLASS_VERSION(pagmo::rng_double,1)
+
 #endif
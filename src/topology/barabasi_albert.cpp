@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <cstddef>
@@ -29,7 +30,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
-
+#include <vector>
 
 #include "../exceptions.h"
 #include "../rng.h"
@@ -38,21 +39,78 @@
 
 namespace pagmo { namespace topology {
 
-/// Constructor from kernel size and number of edges.
+/// Constructor from kernel size, number of edges and size.
 /**
  * Build a BA network in which the initial kernel has size m0 and the elements being inserted after the construction of the kernel
  * is completed are connected randomly to m nodes. Will fail if m0 < 2, if m < 1 or if m > m0.
  *
+ * If n is positive, the network is generated with n vertices in a single pass.
+ *
  * @param[in] m0 size of the kernel
  * @param[in] m number of random connections to be established when a new node is added.
+ * @param[in] n size (i.e., number of vertices) of the topology.
  */
-barabasi_albert::barabasi_albert(int m0, int m):
+barabasi_albert::barabasi_albert(int m0, int m, int n):
 	m_m0(boost::numeric_cast<std::size_t>(m0)),m_m(boost::numeric_cast<std::size_t>(m)),
 	m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>())
 {
 	if (m0 < 2 || m < 1 || m > m0) {
 		pagmo_throw(value_error,"the value of m and m0 must be at least 1 and 2, and m must not be greater than m0");
 	}
+	const vertices_size_type size = boost::numeric_cast<vertices_size_type>(n);
+	if (size) {
+		generate(size);
+	}
+}
+
+// Generate the whole network. The kernel is built as in connect(), then the preferential attachment uses the list
+// of the endpoints of all the edges: each vertex appears in it as many times as its degree, hence picking a random
+// element of the list selects a vertex with probability proportional to its degree.
+void barabasi_albert::generate(const vertices_size_type &size)
+{
+	pagmo_assert(!get_number_of_vertices());
+	add_vertices(size);
+	std::vector<std::pair<vertices_size_type,vertices_size_type> > edges;
+	edges.reserve(boost::numeric_cast<std::vector<std::pair<vertices_size_type,vertices_size_type> >::size_type>(size * m_m));
+	std::vector<vertices_size_type> endpoints;
+	endpoints.reserve(2 * edges.capacity());
+	const double prob = 0.8;
+	const vertices_size_type kernel_size = std::min<vertices_size_type>(size,m_m0);
+	for (vertices_size_type idx = 1; idx < kernel_size; ++idx) {
+		bool connection_added = false;
+		for (vertices_size_type v = 0; v < idx; ++v) {
+			if (m_drng() < prob) {
+				connection_added = true;
+				edges.push_back(std::make_pair(v,idx));
+			}
+		}
+		if (!connection_added) {
+			boost::uniform_int<vertices_size_type> uni_int(0,idx - 1);
+			edges.push_back(std::make_pair(uni_int(m_urng),idx));
+		}
+	}
+	for (std::vector<std::pair<vertices_size_type,vertices_size_type> >::size_type i = 0; i < edges.size(); ++i) {
+		endpoints.push_back(edges[i].first);
+		endpoints.push_back(edges[i].second);
+	}
+	// The kernel has no isolated vertices, so there are always at least m0 >= m distinct candidates.
+	std::vector<vertices_size_type> targets;
+	for (vertices_size_type idx = kernel_size; idx < size; ++idx) {
+		targets.clear();
+		boost::uniform_int<std::vector<vertices_size_type>::size_type> uni_int(0,endpoints.size() - 1);
+		while (targets.size() < m_m) {
+			const vertices_size_type candidate = endpoints[uni_int(m_urng)];
+			if (std::find(targets.begin(),targets.end(),candidate) == targets.end()) {
+				targets.push_back(candidate);
+			}
+		}
+		for (std::vector<vertices_size_type>::size_type i = 0; i < targets.size(); ++i) {
+			edges.push_back(std::make_pair(targets[i],idx));
+			endpoints.push_back(targets[i]);
+			endpoints.push_back(idx);
+		}
+	}
+	add_edges(edges,true);
 }
 
 base_ptr barabasi_albert::clone() const
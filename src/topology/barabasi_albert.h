@@ -46,21 +46,26 @@ namespace pagmo { namespace topology {
  * - after the kernel is built, the next elements added to the network are connected randomly to m of the existing nodes; the probability
  *   of connection is biased linearly towards the most connected nodes.
  *
+ * If the number of vertices is passed to the constructor, the whole network is generated in one pass, in linear time, by sampling
+ * the endpoints of the existing edges as in the algorithm of Batagelj and Brandes. Otherwise each insertion costs a scan of all the vertices.
+ *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
  *
  * @see http://en.wikipedia.org/wiki/BA_model
+ * @see V. Batagelj, U. Brandes, "Efficient generation of large random networks", Physical Review E 71, 036113 (2005).
  */
 class __PAGMO_VISIBLE barabasi_albert: public base
 {
 	public:
-		barabasi_albert(int m0 = 3, int m = 2);
+		barabasi_albert(int m0 = 3, int m = 2, int n = 0);
 		base_ptr clone() const;
 		std::string get_name() const;
 	protected:
 		void connect(const vertices_size_type &);
 		std::string human_readable_extra() const;
 	private:
+		void generate(const vertices_size_type &);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -24,8 +24,11 @@
 
 #include <algorithm>
 #include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/johnson_all_pairs_shortest.hpp>
+#include <boost/bind.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
+#include <climits>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -50,7 +53,12 @@ base::base():m_graph() {}
  *
  * @param[in] t topology::base to be copied.
  */
-base::base(const base &t):m_graph(t.m_graph) {}
+base::base(const base &t):m_graph(t.m_graph)
+{
+	// The snapshot is immutable, hence it can be shared.
+	boost::lock_guard<boost::mutex> lock(t.m_csr_mutex);
+	m_csr = t.m_csr;
+}
 
 /// Assignment operator.
 /**
@@ -64,6 +72,13 @@ base &base::operator=(const base &t)
 {
 	if (this != &t) {
 		m_graph = t.m_graph;
+		csr_ptr csr;
+		{
+			boost::lock_guard<boost::mutex> lock(t.m_csr_mutex);
+			csr = t.m_csr;
+		}
+		boost::lock_guard<boost::mutex> lock(m_csr_mutex);
+		m_csr = csr;
 	}
 	return *this;
 }
@@ -162,6 +177,21 @@ std::string base::human_readable_extra() const
 void base::add_vertex()
 {
 	boost::add_vertex(m_graph);
+	invalidate_csr();
+}
+
+/// Add many vertices.
+/**
+ * Add n new, unconnected vertices to the topology. Unlike push_back(), connect() is not called.
+ *
+ * @param[in] n number of vertices to be added.
+ */
+void base::add_vertices(const vertices_size_type &n)
+{
+	for (vertices_size_type i = 0; i < n; ++i) {
+		boost::add_vertex(m_graph);
+	}
+	invalidate_csr();
 }
 
 // Check that a vertex number does not overflow the number of vertices in the graph.
@@ -303,6 +333,35 @@ void base::add_edge(const vertices_size_type &n, const vertices_size_type &m)
 	const std::pair<e_descriptor,bool> result = boost::add_edge(boost::vertex(n,m_graph),boost::vertex(m,m_graph),m_graph);
 	pagmo_assert(result.second);
 	set_weight(result.first, 1.0);
+	invalidate_csr();
+}
+
+/// Add many edges.
+/**
+ * Bulk version of add_edge(), meant for topologies generating the whole graph in one pass. The edges are
+ * written directly into the graph with unit weight, without checking that the vertices are not already connected:
+ * it is the caller's responsibility to make sure that the list contains no duplicates and no edge already present
+ * in the topology. If both_ways is true, for each pair (n,m) the edge connecting m to n is added as well.
+ *
+ * @param[in] edges list of pairs of vertex indices to be connected.
+ * @param[in] both_ways if true, add the edges in both directions.
+ */
+void base::add_edges(const std::vector<std::pair<vertices_size_type,vertices_size_type> > &edges, bool both_ways)
+{
+	typedef std::vector<std::pair<vertices_size_type,vertices_size_type> >::const_iterator const_iterator;
+	for (const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		check_vertex_index(it->first);
+		check_vertex_index(it->second);
+	}
+	for (const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		pagmo_assert(!are_adjacent(it->first,it->second));
+		m_graph[boost::add_edge(boost::vertex(it->first,m_graph),boost::vertex(it->second,m_graph),m_graph).first].migr_probability = 1.0;
+		if (both_ways) {
+			pagmo_assert(!are_adjacent(it->second,it->first));
+			m_graph[boost::add_edge(boost::vertex(it->second,m_graph),boost::vertex(it->first,m_graph),m_graph).first].migr_probability = 1.0;
+		}
+	}
+	invalidate_csr();
 }
 
 /// Sets the migration probability
@@ -317,6 +376,7 @@ void base::set_weight(const base::e_descriptor &e, double w) {
 		pagmo_throw(value_error,"invalid migration probability");
 	}
 	m_graph[e].migr_probability = w;
+	invalidate_csr();
 }
 
 /// Sets the migration probability
@@ -405,6 +465,7 @@ void base::remove_edge(const vertices_size_type &n, const vertices_size_type &m)
 		pagmo_throw(value_error,"cannot remove edge, vertices are not connected");
 	}
 	boost::remove_edge(boost::vertex(n,m_graph),boost::vertex(m,m_graph),m_graph);
+	invalidate_csr();
 }
 
 /// Remove all edges.
@@ -416,6 +477,122 @@ void base::remove_all_edges()
 	for (std::pair<v_iterator,v_iterator> vertices = get_vertices(); vertices.first != vertices.second; ++vertices.first) {
 		boost::clear_vertex(*vertices.first,m_graph);
 	}
+	invalidate_csr();
+}
+
+// Discard the CSR snapshot, to be called whenever the graph is modified.
+void base::invalidate_csr()
+{
+	boost::lock_guard<boost::mutex> lock(m_csr_mutex);
+	m_csr.reset();
+}
+
+/// Get the CSR snapshot of the topology.
+/**
+ * The snapshot is built on first use and kept until the topology is modified. Since it is immutable, it
+ * can be safely read from several threads, and it stays valid (although outdated) if the topology changes
+ * after the call.
+ *
+ * @return shared pointer to the compressed sparse row representation of the topology.
+ */
+base::csr_ptr base::get_csr() const
+{
+	boost::lock_guard<boost::mutex> lock(m_csr_mutex);
+	if (m_csr) {
+		return m_csr;
+	}
+	boost::shared_ptr<csr_type> csr(new csr_type());
+	const vertices_size_type n = get_number_of_vertices();
+	const edges_size_type n_edges = get_number_of_edges();
+	csr->m_offsets.reserve(n + 1);
+	csr->m_inv_offsets.reserve(n + 1);
+	csr->m_adjacent.reserve(n_edges);
+	csr->m_inv_adjacent.reserve(n_edges);
+	csr->m_weights.reserve(n_edges);
+	csr->m_inv_weights.reserve(n_edges);
+	for (vertices_size_type v = 0; v < n; ++v) {
+		csr->m_offsets.push_back(csr->m_adjacent.size());
+		for (std::pair<boost::graph_traits<graph_type>::out_edge_iterator,boost::graph_traits<graph_type>::out_edge_iterator> es = boost::out_edges(boost::vertex(v,m_graph),m_graph); es.first != es.second; ++es.first) {
+			csr->m_adjacent.push_back(boost::target(*es.first,m_graph));
+			csr->m_weights.push_back(m_graph[*es.first].migr_probability);
+		}
+		csr->m_inv_offsets.push_back(csr->m_inv_adjacent.size());
+		for (std::pair<graph_type::in_edge_iterator,graph_type::in_edge_iterator> es = boost::in_edges(boost::vertex(v,m_graph),m_graph); es.first != es.second; ++es.first) {
+			csr->m_inv_adjacent.push_back(boost::source(*es.first,m_graph));
+			csr->m_inv_weights.push_back(m_graph[*es.first].migr_probability);
+		}
+	}
+	csr->m_offsets.push_back(csr->m_adjacent.size());
+	csr->m_inv_offsets.push_back(csr->m_inv_adjacent.size());
+	m_csr = csr;
+	return m_csr;
+}
+
+// Check that a vertex number does not overflow the number of vertices in the snapshot.
+void base::csr_type::check_vertex_index(const vertices_size_type &idx) const
+{
+	if (idx >= get_number_of_vertices()) {
+		pagmo_throw(value_error,"invalid vertex index");
+	}
+}
+
+/// Get number of vertices.
+/**
+ * @return total number of vertices in the snapshot.
+ */
+base::vertices_size_type base::csr_type::get_number_of_vertices() const
+{
+	return m_offsets.size() - 1;
+}
+
+/// Return range of adjacent vertices.
+/**
+ * @param[in] idx index of the interested vertex.
+ *
+ * @return pointer range over the vertices connected from idx.
+ */
+base::csr_type::range_type base::csr_type::get_adjacent_vertices(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	const vertices_size_type *data = m_adjacent.empty() ? 0 : &m_adjacent[0];
+	return range_type(data + m_offsets[idx],data + m_offsets[idx + 1]);
+}
+
+/// Return migration probabilities towards adjacent vertices.
+/**
+ * @param[in] idx index of the interested vertex.
+ *
+ * @return pointer to the weights of the edges leaving idx, aligned with get_adjacent_vertices().
+ */
+const double *base::csr_type::get_adjacent_weights(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	return (m_weights.empty() ? 0 : &m_weights[0]) + m_offsets[idx];
+}
+
+/// Return range of inversely adjacent vertices.
+/**
+ * @param[in] idx index of the interested vertex.
+ *
+ * @return pointer range over the vertices connected to idx.
+ */
+base::csr_type::range_type base::csr_type::get_inv_adjacent_vertices(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	const vertices_size_type *data = m_inv_adjacent.empty() ? 0 : &m_inv_adjacent[0];
+	return range_type(data + m_inv_offsets[idx],data + m_inv_offsets[idx + 1]);
+}
+
+/// Return migration probabilities from inversely adjacent vertices.
+/**
+ * @param[in] idx index of the interested vertex.
+ *
+ * @return pointer to the weights of the edges entering idx, aligned with get_inv_adjacent_vertices().
+ */
+const double *base::csr_type::get_inv_adjacent_weights(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	return (m_inv_weights.empty() ? 0 : &m_inv_weights[0]) + m_inv_offsets[idx];
 }
 
 /// Return iterator range to vertices.
@@ -449,101 +626,201 @@ base::edges_size_type base::get_number_of_edges() const
 
 /// Calculate average path length.
 /**
- * Calculate and return the average path length of the underlying graph representation using Johnson's all pairs shortest paths
- * algorithm. All edges are given equal weight 1. If a node is unconnected, its distance from any other node will be the highest
+ * Calculate and return the average path length of the underlying graph representation using a breadth-first search
+ * from each vertex of the CSR snapshot. All edges are given equal weight 1. If a node is unconnected, its distance from any other node will be the highest
  * value representable by the C++ int type. The average path length is calculated as the mean value of the shortest paths between
  * all pairs of vertices.
  *
+ * The searches run on the calling thread (see get_graph_metrics() to spread them over several threads), and the result is cached
+ * until the topology is modified.
+ *
  * @return the average path length for the topology.
  *
- * @see http://en.wikipedia.org/wiki/Johnson's_algorithm
- * @see http://www.boost.org/doc/libs/release/libs/graph/doc/johnson_all_pairs_shortest.html
+ * @see http://en.wikipedia.org/wiki/Breadth-first_search
  */
 double base::get_average_shortest_path_length() const
 {
-	std::map<e_descriptor, int> map;
-	boost::associative_property_map<std::map<e_descriptor, int> > map2(map);
-	std::pair<e_iterator, e_iterator> es = boost::edges(m_graph);
-	for(; es.first != es.second; ++es.first) {
-		map2[(*es.first)] = 1;
-	}
-
-	// Output matrix.
-	std::vector<std::vector<int> > D(boost::numeric_cast<std::vector<std::vector<int> >::size_type>(get_number_of_vertices()),
-		std::vector<int>(boost::numeric_cast<std::vector<int>::size_type>(get_number_of_vertices())));
-	boost::johnson_all_pairs_shortest_paths(m_graph, D, weight_map(map2));
-	double retval = 0;
-	for (std::vector<std::vector<int> >::size_type i = 0; i < D.size(); ++i) {
-		for (std::vector<int>::size_type j = 0; j < D[i].size(); ++j) {
-			retval += D[i][j];
-		}
-	}
-	if (get_number_of_vertices() < 2) {
-		return 0;
-	} else {
-		return retval / (static_cast<double>(get_number_of_vertices()) * (get_number_of_vertices() - 1));
-	}
+	const csr_ptr csr = get_csr();
+	compute_metrics(*csr,true,false,1);
+	boost::lock_guard<boost::mutex> lock(csr->m_metrics_mutex);
+	return *csr->m_path_length;
 }
 
 /// Calculate clustering coefficient
+/**
+ * The clustering coefficient of a vertex with more than one adjacent vertex is the fraction of the pairs of its adjacent vertices
+ * in which the first vertex is connected to the second one. Vertices with less than two adjacent vertices have a clustering coefficient of 1.
+ * The clustering coefficient of the topology is the mean of the clustering coefficients of the vertices.
+ *
+ * The vertices are processed on the calling thread (see get_graph_metrics() to spread them over several threads), and the result is
+ * cached until the topology is modified.
+ *
+ * @return the clustering coefficient for the topology.
+ */
 double base::get_clustering_coefficient() const
 {
-        // Output value.
-        double cc = 0.0;
-        // Get the vertices.
-        std::pair<v_iterator, v_iterator> vertices;
-        std::vector<base::vertices_size_type> adj_vertices;
-        vertices  = get_vertices();
-        // Loop through vertices and calculate individual clustering coeffient.
-        for(; vertices.first != vertices.second; vertices.first++) {
-                adj_vertices = get_v_adjacent_vertices(*vertices.first);
-                if(adj_vertices.size() > 1) {
-                        // Count the number of nodes in adj_vertices that are adjacent to one another.
-                        for(unsigned int i = 0; i < adj_vertices.size()-1; i++) {
-                                for(unsigned int j = i; j < adj_vertices.size(); j++) {
-                                        if(i != j && are_adjacent(adj_vertices[i],adj_vertices[j])) {
-                                                cc += 2.0/(adj_vertices.size() * (adj_vertices.size() - 1));
-                                        }
-                                }
-                        }
-                        // Now get the clustering coefficient of the node by dividing by...
-                        //c /= adj_vertices.size() * (adj_vertices.size() - 1);
-                } else {
-                    // In the case that a node only has one neighbour
-                    // the node has a clustering coefficient of 1.
-                    cc += 1.0;
-                }
-                // Update the network clustering coefficient
-                //cc += c;
-        }
-        // Average clustering coefficient
-        cc /= get_number_of_vertices();
-        // Output
-        return cc;
+	const csr_ptr csr = get_csr();
+	compute_metrics(*csr,false,true,1);
+	boost::lock_guard<boost::mutex> lock(csr->m_metrics_mutex);
+	return *csr->m_clustering;
 }
 
 /// Constructs the Degree Distribution
+/**
+ * @return vector whose i-th element is the number of vertices with i adjacent vertices, divided by the number of edges.
+ */
 std::vector<double> base::get_degree_distribution() const
 {
-    // First, find the maximum degree of any node and define the output vector
-    std::pair<v_iterator, v_iterator> vertices;
-    int mx = 0;
-    vertices = get_vertices();
-    double ne = (get_number_of_edges());
-    ne = 1/ne;
-    for(; vertices.first != vertices.second; vertices.first++) {
-        if((int)get_num_adjacent_vertices(*vertices.first) > mx) mx = (int)get_num_adjacent_vertices(*vertices.first);
-    }
-    std::vector<double> deg_dist(mx+1);
-    for(int i = 0; i < mx; i++) deg_dist[i] = 0;
-    // Loop through each vertex and increment deg_dist accordingly
-    vertices = get_vertices();
-    for(; vertices.first != vertices.second; vertices.first++) {
-        deg_dist[get_num_adjacent_vertices(*vertices.first)]+=ne;
-
-    }
-//    // Return the degree distribution vector
-    return deg_dist;
+	const csr_ptr csr = get_csr();
+	const vertices_size_type n = csr->get_number_of_vertices();
+	const double ne = 1 / static_cast<double>(get_number_of_edges());
+	// First, find the maximum degree of any node and define the output vector
+	edges_size_type mx = 0;
+	for (vertices_size_type v = 0; v < n; ++v) {
+		mx = std::max(mx,csr->m_offsets[v + 1] - csr->m_offsets[v]);
+	}
+	std::vector<double> deg_dist(boost::numeric_cast<std::vector<double>::size_type>(mx + 1));
+	// Loop through each vertex and increment deg_dist accordingly
+	for (vertices_size_type v = 0; v < n; ++v) {
+		deg_dist[csr->m_offsets[v + 1] - csr->m_offsets[v]] += ne;
+	}
+	return deg_dist;
+}
+
+/// Calculate all the graph metrics.
+/**
+ * Compute the average shortest path length, the clustering coefficient and the degree distribution in a single sweep
+ * over the vertices, shared among n_threads threads. The results do not depend on the number of threads, and they are
+ * cached until the topology is modified, so that the individual getters will not compute them again.
+ *
+ * @param[in] n_threads number of threads to be used (default 1). If 0, the number of hardware threads will be used.
+ *
+ * @return the metrics of the topology.
+ */
+base::graph_metrics base::get_graph_metrics(unsigned int n_threads) const
+{
+	const csr_ptr csr = get_csr();
+	compute_metrics(*csr,true,true,n_threads);
+	graph_metrics retval;
+	{
+		boost::lock_guard<boost::mutex> lock(csr->m_metrics_mutex);
+		retval.average_shortest_path_length = *csr->m_path_length;
+		retval.clustering_coefficient = *csr->m_clustering;
+	}
+	retval.degree_distribution = get_degree_distribution();
+	return retval;
+}
+
+// Compute the requested metrics which are not in the cache of the snapshot yet. Each thread sweeps the vertices
+// offset, offset + stride, offset + 2 * stride, ... with its own buffers. The distances are summed as integers and
+// the clustering coefficients are stored per vertex and summed in order at the end, so that the results are
+// independent of the number of threads.
+void base::compute_metrics(const csr_type &csr, bool path_length, bool clustering, unsigned int n_threads)
+{
+	{
+		boost::lock_guard<boost::mutex> lock(csr.m_metrics_mutex);
+		path_length = path_length && !csr.m_path_length;
+		clustering = clustering && !csr.m_clustering;
+	}
+	if (!path_length && !clustering) {
+		return;
+	}
+	const vertices_size_type n = csr.get_number_of_vertices();
+	if (!n_threads) {
+		n_threads = std::max<unsigned int>(boost::thread::hardware_concurrency(),1);
+	}
+	n_threads = static_cast<unsigned int>(std::max<vertices_size_type>(std::min<vertices_size_type>(n_threads,n),1));
+	// The buffers are allocated here, so that the threads cannot fail.
+	std::vector<csr_type::sweep_state> states(n_threads);
+	for (unsigned int t = 0; t < n_threads; ++t) {
+		states[t].dist.resize(path_length ? n : 0);
+		states[t].queue.resize(path_length ? n : 0);
+		states[t].pos.resize(clustering ? n : 0);
+		states[t].distance_sum = 0;
+		states[t].unreachable = 0;
+	}
+	std::vector<double> cc(clustering ? n : 0);
+	boost::thread_group threads;
+	for (unsigned int t = 1; t < n_threads; ++t) {
+		threads.create_thread(boost::bind(&csr_type::metrics_sweep,boost::cref(csr),path_length,clustering,t,n_threads,
+			boost::ref(states[t]),boost::ref(cc)));
+	}
+	csr.metrics_sweep(path_length,clustering,0,n_threads,states[0],cc);
+	threads.join_all();
+	boost::lock_guard<boost::mutex> lock(csr.m_metrics_mutex);
+	if (path_length) {
+		boost::uint64_t total_distance = 0, total_unreachable = 0;
+		for (unsigned int t = 0; t < n_threads; ++t) {
+			total_distance += states[t].distance_sum;
+			total_unreachable += states[t].unreachable;
+		}
+		csr.m_path_length = (n < 2) ? 0. : (static_cast<double>(total_distance) + static_cast<double>(total_unreachable) * INT_MAX) /
+			(static_cast<double>(n) * (n - 1));
+	}
+	if (clustering) {
+		// Average clustering coefficient
+		double total = 0;
+		for (vertices_size_type v = 0; v < n; ++v) {
+			total += cc[v];
+		}
+		csr.m_clustering = total / n;
+	}
+}
+
+// Sweep over the vertices offset, offset + stride, ... For the path length, run a breadth-first search from each vertex,
+// accumulating the distances of the reached vertices and the number of unreached ones. For the clustering coefficient,
+// mark the adjacent vertices with their position in the adjacency list, and count the ordered pairs which are connected.
+void base::csr_type::metrics_sweep(bool path_length, bool clustering, unsigned int offset, unsigned int stride, sweep_state &state,
+	std::vector<double> &cc) const
+{
+	const vertices_size_type n = get_number_of_vertices();
+	const vertices_size_type *adjacent = m_adjacent.empty() ? 0 : &m_adjacent[0];
+	for (vertices_size_type s = offset; s < n; s += stride) {
+		if (path_length) {
+			std::fill(state.dist.begin(),state.dist.end(),-1);
+			state.dist[s] = 0;
+			state.queue[0] = s;
+			vertices_size_type head = 0, tail = 1;
+			while (head != tail) {
+				const vertices_size_type v = state.queue[head++];
+				for (edges_size_type i = m_offsets[v]; i < m_offsets[v + 1]; ++i) {
+					if (state.dist[adjacent[i]] == -1) {
+						state.dist[adjacent[i]] = state.dist[v] + 1;
+						state.queue[tail++] = adjacent[i];
+						state.distance_sum += static_cast<boost::uint64_t>(state.dist[adjacent[i]]);
+					}
+				}
+			}
+			state.unreachable += n - tail;
+		}
+		if (clustering) {
+			const edges_size_type begin = m_offsets[s], end = m_offsets[s + 1], deg = end - begin;
+			if (deg > 1) {
+				// Position + 1 of each adjacent vertex, 0 for the others.
+				for (edges_size_type i = begin; i < end; ++i) {
+					state.pos[adjacent[i]] = i - begin + 1;
+				}
+				// Count the pairs (i,j), i < j, of neighbours such that the i-th one is connected to the j-th one.
+				boost::uint64_t links = 0;
+				for (edges_size_type i = begin; i < end; ++i) {
+					const vertices_size_type a = adjacent[i];
+					for (edges_size_type j = m_offsets[a]; j < m_offsets[a + 1]; ++j) {
+						if (state.pos[adjacent[j]] > i - begin + 1) {
+							++links;
+						}
+					}
+				}
+				for (edges_size_type i = begin; i < end; ++i) {
+					state.pos[adjacent[i]] = 0;
+				}
+				cc[s] = links * (2.0 / (deg * (deg - 1)));
+			} else {
+				// In the case that a node only has one neighbour
+				// the node has a clustering coefficient of 1.
+				cc[s] = 1.0;
+			}
+		}
+	}
 }
 
 /// Push back vertex.
@@ -25,8 +25,11 @@
 #ifndef PAGMO_TOPOLOGY_BASE_H
 #define PAGMO_TOPOLOGY_BASE_H
 
+#include <boost/cstdint.hpp>
 #include <boost/graph/adjacency_list.hpp>
+#include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -117,6 +120,62 @@ class __PAGMO_VISIBLE base
 		typedef graph_type::vertices_size_type vertices_size_type;
 		/// Edges size type.
 		typedef graph_type::edges_size_type edges_size_type;
+		/// Compressed sparse row snapshot of the graph.
+		/**
+		 * Immutable copy of the adjacency lists and of the migration probabilities, stored in contiguous arrays,
+		 * to be queried in hot loops without allocations. Adjacent vertices are listed in the same order as in
+		 * get_v_adjacent_vertices() and get_v_inv_adjacent_vertices(), and the weights are aligned with them.
+		 */
+		class __PAGMO_VISIBLE csr_type
+		{
+				friend class base;
+			public:
+				/// Range of vertex indices.
+				typedef std::pair<const vertices_size_type *, const vertices_size_type *> range_type;
+				vertices_size_type get_number_of_vertices() const;
+				range_type get_adjacent_vertices(const vertices_size_type &) const;
+				const double *get_adjacent_weights(const vertices_size_type &) const;
+				range_type get_inv_adjacent_vertices(const vertices_size_type &) const;
+				const double *get_inv_adjacent_weights(const vertices_size_type &) const;
+			private:
+				// Scratch space and partial results of a thread computing the metrics.
+				struct sweep_state
+				{
+					std::vector<int>		dist;
+					std::vector<vertices_size_type>	queue;
+					std::vector<vertices_size_type>	pos;
+					boost::uint64_t			distance_sum;
+					boost::uint64_t			unreachable;
+				};
+				void check_vertex_index(const vertices_size_type &) const;
+				void metrics_sweep(bool, bool, unsigned int, unsigned int, sweep_state &, std::vector<double> &) const;
+				// Position of the adjacency list of each vertex, plus one past the end.
+				std::vector<edges_size_type>	m_offsets;
+				std::vector<edges_size_type>	m_inv_offsets;
+				std::vector<vertices_size_type>	m_adjacent;
+				std::vector<vertices_size_type>	m_inv_adjacent;
+				std::vector<double>		m_weights;
+				std::vector<double>		m_inv_weights;
+				// Metrics computed on the snapshot so far.
+				mutable boost::mutex			m_metrics_mutex;
+				mutable boost::optional<double>		m_path_length;
+				mutable boost::optional<double>		m_clustering;
+		};
+		/// Alias for shared pointer to csr_type.
+		typedef boost::shared_ptr<const csr_type> csr_ptr;
+		/// Graph metrics of the topology.
+		/**
+		 * Returned by get_graph_metrics().
+		 */
+		struct graph_metrics
+		{
+			/// Average shortest path length, as returned by get_average_shortest_path_length().
+			double			average_shortest_path_length;
+			/// Clustering coefficient, as returned by get_clustering_coefficient().
+			double			clustering_coefficient;
+			/// Degree distribution, as returned by get_degree_distribution().
+			std::vector<double>	degree_distribution;
+		};
 		base();
 		base(const base &);
 		base &operator=(const base &);
@@ -143,6 +202,7 @@ class __PAGMO_VISIBLE base
 		double get_average_shortest_path_length() const;
 		double get_clustering_coefficient() const;
 		std::vector<double> get_degree_distribution() const;
+		graph_metrics get_graph_metrics(unsigned int = 1) const;
 		bool are_adjacent(const vertices_size_type &, const vertices_size_type &) const;
 		bool are_inv_adjacent(const vertices_size_type &,const vertices_size_type &) const;
 		std::vector<vertices_size_type> get_v_adjacent_vertices(const vertices_size_type &) const;
@@ -153,14 +213,17 @@ class __PAGMO_VISIBLE base
 		void set_weight(const vertices_size_type &, double);
 		void set_weight(const vertices_size_type &, const vertices_size_type &, double);
 		double get_weight(const vertices_size_type &, const vertices_size_type &) const;
+		csr_ptr get_csr() const;
 		//@}
 	protected:
 		/** @name Low-level graph access and manipulation methods. */
 		//@{
 		void add_vertex();
+		void add_vertices(const vertices_size_type &);
 		std::pair<a_iterator,a_iterator> get_adjacent_vertices(const vertices_size_type &) const;
 		std::pair<ia_iterator,ia_iterator> get_inv_adjacent_vertices(const vertices_size_type &) const;
 		void add_edge(const vertices_size_type &, const vertices_size_type &);
+		void add_edges(const std::vector<std::pair<vertices_size_type,vertices_size_type> > &, bool);
 		void remove_edge(const vertices_size_type &, const vertices_size_type &);
 		void remove_all_edges();
 		std::pair<v_iterator,v_iterator> get_vertices() const;
@@ -178,14 +241,20 @@ class __PAGMO_VISIBLE base
 		void check_vertex_index(const vertices_size_type &) const;
 		void set_weight(const e_descriptor &, double);
 		double get_weight(const e_descriptor &) const;
+		void invalidate_csr();
+		static void compute_metrics(const csr_type &, bool, bool, unsigned int);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & m_graph;
+			invalidate_csr();
 		}
 	private:
-		graph_type m_graph;
+		graph_type		m_graph;
+		// Snapshot of the graph, built on demand and discarded when the graph changes.
+		mutable csr_ptr		m_csr;
+		mutable boost::mutex	m_csr_mutex;
 };
 
 std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
@@ -22,13 +22,16 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
+#include <boost/unordered_set.hpp>
 #include <cstddef>
 #include <iterator>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 #include "../exceptions.h"
@@ -47,9 +50,12 @@ namespace pagmo { namespace topology {
  *
  * @param[in] m0 size of the kernel
  * @param[in] m number of random connections to be established when a new node is added.
+ * If n is positive, the network is generated with n vertices in a single pass.
+ *
  * @param[in] p probability that a connection is established between two nodes that are adjacent to a new node.
+ * @param[in] n size (i.e., number of vertices) of the topology.
  */
-clustered_ba::clustered_ba(int m0, int m, double p):
+clustered_ba::clustered_ba(int m0, int m, double p, int n):
         m_m0(boost::numeric_cast<std::size_t>(m0)),m_m(boost::numeric_cast<std::size_t>(m)), m_p(double(p)),
 	m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>())
 {
@@ -59,6 +65,65 @@ clustered_ba::clustered_ba(int m0, int m, double p):
         if(p < 0 || p > 1) {
                 pagmo_throw(value_error,"the value of p must be between 0 and 1");
         }
+	const vertices_size_type size = boost::numeric_cast<vertices_size_type>(n);
+	if (size) {
+		generate(size);
+	}
+}
+
+// Generate the whole network. As in connect(), each vertex of the kernel is connected to a random previous vertex. Afterwards,
+// the preferential attachment picks random elements of the list of the endpoints of all the edges, in which each vertex
+// appears as many times as its degree. The edges already present are kept in a hash set for the clustering step.
+void clustered_ba::generate(const vertices_size_type &size)
+{
+	typedef std::pair<vertices_size_type,vertices_size_type> edge_type;
+	pagmo_assert(!get_number_of_vertices());
+	add_vertices(size);
+	std::vector<edge_type> edges;
+	std::vector<vertices_size_type> endpoints;
+	boost::unordered_set<edge_type> edge_set;
+	const vertices_size_type kernel_size = std::min<vertices_size_type>(size,m_m0);
+	for (vertices_size_type idx = 1; idx < kernel_size; ++idx) {
+		boost::uniform_int<vertices_size_type> uni_int(0,idx - 1);
+		edges.push_back(edge_type(uni_int(m_urng),idx));
+	}
+	for (std::vector<edge_type>::size_type i = 0; i < edges.size(); ++i) {
+		endpoints.push_back(edges[i].first);
+		endpoints.push_back(edges[i].second);
+		edge_set.insert(edges[i]);
+	}
+	// The kernel has no isolated vertices, so there are always at least m0 >= m distinct candidates.
+	boost::uniform_int<edges_size_type> uni_int2(1,m_m);
+	std::vector<vertices_size_type> targets;
+	for (vertices_size_type idx = kernel_size; idx < size; ++idx) {
+		targets.clear();
+		const std::size_t j = uni_int2(m_urng);
+		boost::uniform_int<std::vector<vertices_size_type>::size_type> uni_int(0,endpoints.size() - 1);
+		while (targets.size() < j) {
+			const vertices_size_type candidate = endpoints[uni_int(m_urng)];
+			if (std::find(targets.begin(),targets.end(),candidate) != targets.end()) {
+				continue;
+			}
+			// Connect to nodes that are already adjacent to idx with probability p.
+			for (std::vector<vertices_size_type>::size_type i = 0; i < targets.size(); ++i) {
+				const edge_type e(std::min(targets[i],candidate),std::max(targets[i],candidate));
+				if (m_drng() < m_p && !edge_set.count(e)) {
+					edges.push_back(e);
+					edge_set.insert(e);
+					endpoints.push_back(e.first);
+					endpoints.push_back(e.second);
+				}
+			}
+			targets.push_back(candidate);
+		}
+		for (std::vector<vertices_size_type>::size_type i = 0; i < targets.size(); ++i) {
+			edges.push_back(edge_type(targets[i],idx));
+			edge_set.insert(edges.back());
+			endpoints.push_back(targets[i]);
+			endpoints.push_back(idx);
+		}
+	}
+	add_edges(edges,true);
 }
 
 base_ptr clustered_ba::clone() const
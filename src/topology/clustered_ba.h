@@ -47,19 +47,23 @@ namespace pagmo { namespace topology {
  *   of connection is biased linearly towards the most connected nodes.
  * - Pairs of nodes that have been connected to are connected to eachother with probability, p.
  *
+ * If the number of vertices is passed to the constructor, the whole network is generated in one pass, in near-linear time,
+ * by sampling the endpoints of the existing edges as in the algorithm of Batagelj and Brandes.
+ *
  * @author Luke O'Connor (lumoconnor@gmail.com)
  *
  */
 class __PAGMO_VISIBLE clustered_ba : public base
 {
 	public:
-                clustered_ba(int m0 = 3, int m = 2, double p = 0.5);
+                clustered_ba(int m0 = 3, int m = 2, double p = 0.5, int n = 0);
 		base_ptr clone() const;
 		std::string get_name() const;
 	protected:
 		void connect(const vertices_size_type &);
 		std::string human_readable_extra() const;
 	private:
+		void generate(const vertices_size_type &);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
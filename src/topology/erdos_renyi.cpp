@@ -22,8 +22,12 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/numeric/conversion/cast.hpp>
+#include <cmath>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../rng.h"
@@ -32,19 +36,49 @@
 
 namespace pagmo { namespace topology {
 
-/// Constructor from probability.
+/// Constructor from probability and size.
 /**
  * Construct an Erdős-Rényi graph topology with given probability parameter. Allowed values for the probability are in the [0,1] range.
  * Note that if the probability is null, the topology reduces to an unconnected topology, whereas if the probability is unitary
  * the topology reduces to a fully_connected topology.
  *
+ * If n is positive, the topology is created with n vertices, and the edges are generated in one pass by skipping geometrically
+ * distributed runs of missing edges (Batagelj-Brandes), instead of drawing a random number for each pair of vertices.
+ *
  * @param[in] prob probability parameter for the Erdős-Rényi model.
+ * @param[in] n size (i.e., number of vertices) of the topology.
  */
-erdos_renyi::erdos_renyi(const double &prob):base(),m_prob(prob),m_drng(rng_generator::get<rng_double>())
+erdos_renyi::erdos_renyi(const double &prob, int n):base(),m_prob(prob),m_drng(rng_generator::get<rng_double>())
 {
 	if (prob < 0 || prob > 1) {
 		pagmo_throw(value_error,"probability must be in the [0,1] range");
 	}
+	const vertices_size_type size = boost::numeric_cast<vertices_size_type>(n);
+	if (!size) {
+		return;
+	}
+	add_vertices(size);
+	if (m_prob == 0) {
+		return;
+	}
+	// Enumerate the pairs (v,w), w < v, row by row, and jump directly to the next existing edge. The position
+	// is kept in floating point, as the jumps can be arbitrarily large for small probabilities.
+	std::vector<std::pair<vertices_size_type,vertices_size_type> > edges;
+	edges.reserve(boost::numeric_cast<std::vector<std::pair<vertices_size_type,vertices_size_type> >::size_type>(m_prob * size * (size - 1) / 2));
+	const double log_q = std::log(1 - m_prob);
+	vertices_size_type v = 1;
+	double w = -1;
+	while (v < size) {
+		w += 1 + (m_prob == 1 ? 0 : std::floor(std::log(1 - m_drng()) / log_q));
+		while (w >= v && v < size) {
+			w -= v;
+			++v;
+		}
+		if (v < size) {
+			edges.push_back(std::make_pair(v,static_cast<vertices_size_type>(w)));
+		}
+	}
+	add_edges(edges,true);
 }
 
 base_ptr erdos_renyi::clone() const
@@ -45,16 +45,18 @@ namespace pagmo { namespace topology {
  * in the graph). The expected number of edges in \f$ G(n,p) \f$ is \f$ {n \choose 2} p \f$.
  *
  * In this implementation, each time an island is added to the topology each new possible bidirectional edge to and from the new island
- * is created with probability \f$ p \f$.
+ * is created with probability \f$ p \f$. Large topologies can be built in one pass by passing the number of vertices to the constructor,
+ * in which case the edges are generated with the algorithm of Batagelj and Brandes in \f$ O(n + m) \f$ time, \f$ m \f$ being the number of edges.
  *
  * @see http://en.wikipedia.org/wiki/Erd%C5%91s%E2%80%93R%C3%A9nyi_model
+ * @see V. Batagelj, U. Brandes, "Efficient generation of large random networks", Physical Review E 71, 036113 (2005).
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
  */
 class __PAGMO_VISIBLE erdos_renyi: public base
 {
 	public:
-		erdos_renyi(const double &prob = 0.01);
+		erdos_renyi(const double &prob = 0.01, int n = 0);
 		base_ptr clone() const;
 		std::string get_name() const;
 	protected:
@@ -26,10 +26,12 @@
 #include <boost/integer_traits.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/unordered_set.hpp>
 #include <cstddef>
 #include <exception>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../rng.h"
@@ -77,61 +79,64 @@ base_ptr watts_strogatz::clone() const
 }
 
 // Connect an unconnected topology into a Watts-Strogatz model.
+// The edges are built in a flat list, with a hash set of the undirected pairs for the adjacency checks,
+// and written into the graph at the end. The cost is O(n * K) instead of O(n * K^2).
 void watts_strogatz::rewire()
 {
+	typedef std::pair<vertices_size_type,vertices_size_type> edge_type;
 	const vertices_size_type size = get_number_of_vertices();
 	pagmo_assert(size > 0);
-	// First, build the ring lattice.
-	for (std::pair<v_iterator,v_iterator> vertices = get_vertices(); vertices.first != vertices.second; ++vertices.first) {
-		// Forward connections.
-		v_iterator tmp = vertices.first;
-		for (std::size_t j = 1; j <= m_k / 2; ++j) {
-			++tmp;
-			// Wrap around if we went past the last element.
-			if (tmp == vertices.second) {
-				tmp = get_vertices().first;
+	std::vector<edge_type> edges;
+	boost::unordered_set<edge_type> edge_set;
+	if (size <= m_k + 1) {
+		// Not enough vertices for the ring lattice, do a fully connected topology as in connect().
+		for (vertices_size_type i = 0; i < size; ++i) {
+			for (vertices_size_type j = i + 1; j < size; ++j) {
+				edges.push_back(edge_type(i,j));
 			}
-			add_edge(*vertices.first,*tmp);
 		}
-		// Backward connections.
-		tmp = vertices.first;
-		for (std::size_t j = 1; j <= m_k / 2; ++j) {
-			// Go to the last-past-one element if we are at the first.
-			if (tmp == get_vertices().first) {
-				tmp = vertices.second;
-			}
-			--tmp;
-			add_edge(*vertices.first,*tmp);
+		add_edges(edges,true);
+		return;
+	}
+	// First, build the ring lattice. Edge (i,i + j) is stored at position i * K / 2 + j - 1.
+	const std::size_t half_k = m_k / 2;
+	edges.reserve(boost::numeric_cast<std::vector<edge_type>::size_type>(size * half_k));
+	for (vertices_size_type i = 0; i < size; ++i) {
+		for (std::size_t j = 1; j <= half_k; ++j) {
+			const vertices_size_type other = (i + j) % size;
+			edges.push_back(edge_type(std::min(i,other),std::max(i,other)));
+			edge_set.insert(edges.back());
 		}
 	}
+	std::vector<vertices_size_type> degree(boost::numeric_cast<std::vector<vertices_size_type>::size_type>(size),m_k);
 	// Second, do the random rewires.
 	boost::uniform_int<vertices_size_type> uint(0,size - 1);
-	for (std::pair<v_iterator,v_iterator> vertices = get_vertices(); vertices.first != vertices.second; ++vertices.first) {
-		v_iterator tmp = vertices.first;
-		++tmp;
-		const edges_size_type n_adj_vertices = get_num_adjacent_vertices(*vertices.first);
+	for (vertices_size_type i = 0; i < size; ++i) {
 		// NOTE: here things are hairy, it is possible - especially near the kernel size - that
 		// no rewire can take place because the node is fully connected. We must detect this, in order
-		// to avoid an endless loop. That's why in the for loop we check also the number of vertices adjacent to
-		// vertices.first.
+		// to avoid an endless loop. That's why in the for loop we check also the degree of i.
 		// Iterate over the next m_k / 2 vertices, without going past the end.
-		for (std::size_t j = 1; tmp != vertices.second && j <= m_k / 2 && n_adj_vertices < size - 1; ++j, ++tmp) {
+		const vertices_size_type n_adj_vertices = degree[i];
+		for (std::size_t j = 1; i + j < size && j <= half_k && n_adj_vertices < size - 1; ++j) {
 			if (m_drng() < m_beta) {
-				// Select a random vertex that is not vertices.first itself and that would
-				// not end in a duplicate edge if connected from vertices.first.
+				// Select a random vertex that is not i itself and that would
+				// not end in a duplicate edge if connected from i.
 				vertices_size_type rng;
 				do {
 					rng = uint(m_urng);
-				} while (rng == *vertices.first || are_adjacent(*vertices.first,rng));
-				pagmo_assert(!are_adjacent(rng,*vertices.first));
+				} while (rng == i || edge_set.count(edge_type(std::min(i,rng),std::max(i,rng))));
 				// Destroy edge and rewire.
-				remove_edge(*vertices.first,*tmp);
-				remove_edge(*tmp,*vertices.first);
-				add_edge(*vertices.first,rng);
-				add_edge(rng,*vertices.first);
+				edge_type &e = edges[i * half_k + j - 1];
+				pagmo_assert(e == edge_type(i,i + j));
+				edge_set.erase(e);
+				--degree[i + j];
+				e = edge_type(std::min(i,rng),std::max(i,rng));
+				edge_set.insert(e);
+				++degree[rng];
 			}
 		}
 	}
+	add_edges(edges,true);
 }
 
 void watts_strogatz::connect(const vertices_size_type &n)
@@ -49,6 +49,7 @@ namespace pagmo { namespace topology {
  * Since the addition of a single element to the topology implies the rewiring of the whole topology, for archipelago objects of large size it is advisable
  * to build the topology outside the archipelago specifying the number of islands it will contain, and use archipelago::set_topology() to apply it to an existing
  * (and possibly unconnected) archipelago.
+ * In this case the whole graph is generated in one pass, in \f$ O(n K) \f$ time.
  *
  * @see http://en.wikipedia.org/wiki/Watts_and_Strogatz_model
  *
@@ -0,0 +1,97 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <cstddef>
+
+#include "../Eigen/Dense"
+#include "affine.h"
+
+namespace pagmo{ namespace util { namespace affine {
+
+typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> row_major_matrix;
+
+/// Shift
+/**
+ * Computes y = x - s.
+ *
+ * @param[in] x input vector.
+ * @param[in] s shift vector.
+ * @param[out] y output vector.
+ * @param[in] n size of the vectors.
+ */
+void shift(const double *x, const double *s, double *y, std::size_t n)
+{
+	Eigen::Map<Eigen::VectorXd>(y,n) = Eigen::Map<const Eigen::VectorXd>(x,n) - Eigen::Map<const Eigen::VectorXd>(s,n);
+}
+
+/// Rotation
+/**
+ * Computes y = M x.
+ *
+ * NOTE: a column-major matrix (e.g. Eigen::MatrixXd) passed here is read as its transpose.
+ *
+ * @param[in] M n x n matrix, row-major.
+ * @param[in] x input vector.
+ * @param[out] y output vector.
+ * @param[in] n size of the vectors.
+ */
+void rotate(const double *M, const double *x, double *y, std::size_t n)
+{
+	Eigen::Map<Eigen::VectorXd>(y,n).noalias() = Eigen::Map<const row_major_matrix>(M,n,n) * Eigen::Map<const Eigen::VectorXd>(x,n);
+}
+
+/// Shift and rotation
+/**
+ * Computes y = M (x - s).
+ *
+ * @param[in] M n x n matrix, row-major.
+ * @param[in] s shift vector.
+ * @param[in] x input vector.
+ * @param[out] tmp work array of size n, will contain x - s.
+ * @param[out] y output vector.
+ * @param[in] n size of the vectors.
+ */
+void shift_rotate(const double *M, const double *s, const double *x, double *tmp, double *y, std::size_t n)
+{
+	shift(x,s,tmp,n);
+	rotate(M,tmp,y,n);
+}
+
+/// Batch rotation
+/**
+ * Rotates k vectors at once with a single matrix-matrix product: y_i = M x_i for i = 0 .. k-1.
+ * Vectors are stored contiguously one after the other (i.e. X and Y are k x n row-major matrices).
+ *
+ * @param[in] M n x n matrix, row-major.
+ * @param[in] X k input vectors.
+ * @param[out] Y k output vectors.
+ * @param[in] n size of the vectors.
+ * @param[in] k number of vectors.
+ */
+void rotate_batch(const double *M, const double *X, double *Y, std::size_t n, std::size_t k)
+{
+	Eigen::Map<row_major_matrix>(Y,k,n).noalias() = Eigen::Map<const row_major_matrix>(X,k,n) * Eigen::Map<const row_major_matrix>(M,n,n).transpose();
+}
+
+}}}
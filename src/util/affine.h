@@ -0,0 +1,50 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_AFFINE_H
+#define PAGMO_UTIL_AFFINE_H
+
+#include <cstddef>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Affine transformation kernels
+/**
+ * Shift and rotation kernels shared by the problems that transform their decision vector before evaluating it
+ * (problem::cec2013, problem::shifted, problem::rotated). The kernels work on raw arrays, never allocate
+ * and rely on Eigen for vectorisation. Matrices are square, stored row-major, and input and output arrays
+ * must not overlap.
+ */
+namespace affine {
+
+__PAGMO_VISIBLE_FUNC void shift(const double *, const double *, double *, std::size_t);
+__PAGMO_VISIBLE_FUNC void rotate(const double *, const double *, double *, std::size_t);
+__PAGMO_VISIBLE_FUNC void shift_rotate(const double *, const double *, const double *, double *, double *, std::size_t);
+__PAGMO_VISIBLE_FUNC void rotate_batch(const double *, const double *, double *, std::size_t, std::size_t);
+
+}}}
+
+#endif
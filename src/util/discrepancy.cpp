@@ -13,6 +13,71 @@ namespace pagmo{ namespace util {namespace discrepancy {
 
 base::~base() {}
 
+/// Block generation
+/**
+ * Writes n consecutive points of the sequence, starting from the point with index first,
+ * in the row-major n x dim matrix points. Afterwards, operator()() returns the point
+ * following the block. Index conventions are those of operator()(unsigned int). Sequences
+ * that can jump to any index in constant time can thus be generated in disjoint chunks by
+ * different threads, each owning a clone of the generator.
+ *
+ * The default implementation calls operator()(first) and then operator()().
+ *
+ * @param[out] points array of at least n * dim doubles
+ * @param[in] n number of points to be generated
+ * @param[in] first index of the first point
+ */
+void base::generate(double *points, unsigned int n, unsigned int first)
+{
+	for (unsigned int k = 0; k < n; ++k) {
+		const std::vector<double> point = (k == 0) ? (*this)(first) : (*this)();
+		std::copy(point.begin(), point.end(), points + k * m_dim);
+	}
+}
+
+/// Initialises a population from a low-discrepancy sequence
+/**
+ * Each individual of the population is set to a point of the sequence, scaled to the
+ * bounds of the problem. The points are generated in a single block, starting from the
+ * point of index first. The integer part of the decision vector is mapped onto equally
+ * sized bins of [lb,ub]. All the points are evaluated first, and then written to the population at once.
+ *
+ * @param[in,out] pop population to be initialised
+ * @param[in] seq low-discrepancy sequence, whose dimension must match the problem's
+ * @param[in] first index of the first point
+ *
+ * @throws value_error if the dimension of the sequence does not match the problem's
+ */
+void init_population(population &pop, base &seq, unsigned int first)
+{
+	const problem::base &prob = pop.problem();
+	const decision_vector::size_type dim = prob.get_dimension(), c_dim = dim - prob.get_i_dimension();
+	if (seq.get_dimension() != dim) {
+		pagmo_throw(value_error,"the dimension of the low-discrepancy sequence does not match the problem dimension");
+	}
+	std::vector<double> points(pop.size() * dim);
+	if (pop.size()) {
+		seq.generate(&points[0], pop.size(), first);
+	}
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	std::vector<population::size_type> idx(pop.size());
+	std::vector<decision_vector> x(pop.size(), decision_vector(dim));
+	std::vector<fitness_vector> f(pop.size(), fitness_vector(prob.get_f_dimension()));
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const double *point = &points[i * dim];
+		for (decision_vector::size_type j = 0; j < c_dim; ++j) {
+			x[i][j] = lb[j] + point[j] * (ub[j] - lb[j]);
+		}
+		for (decision_vector::size_type j = c_dim; j < dim; ++j) {
+			x[i][j] = std::min(ub[j], lb[j] + std::floor(point[j] * (ub[j] - lb[j] + 1)));
+		}
+		idx[i] = i;
+		prob.objfun(f[i], x[i]);
+	}
+	// A single bulk update, rather than updating the domination lists individual by individual.
+	pop.set_xf(idx, x, f);
+}
+
 /// Van Der Corput sequence
 /**
  * Returns the n-th number in the Halton sequence
@@ -283,7 +348,7 @@ std::vector<double> project_2_simplex::operator()(std::vector<double> retval) co
 
 //****************************************************************************80
 
-int *faure::binomial_table ( int qs, int m, int n )
+std::vector<int> faure::binomial_table ( int qs, int m, int n )
 
 //****************************************************************************80
 //
@@ -318,12 +383,10 @@ int *faure::binomial_table ( int qs, int m, int n )
 //    coefficients modulo QS.
 //
 {
-  int *coef;
+  std::vector<int> coef((m+1)*(n+1));
   int i;
   int j;
 
-  coef = new int[(m+1)*(n+1)];
-
   for ( j = 0; j <= n; j++ )
   {
 	for ( i = 0; i <= m; i++ )
@@ -456,21 +519,11 @@ void faure::faure_orig ( unsigned int dim_num, unsigned int *seed, double quasi[
 //
   if ( m_hisum_save != hisum )
   {
-	if ( m_coef != NULL )
-	{
-	  delete [] m_coef;
-	}
-
-	if ( m_ytemp != NULL )
-	{
-	  delete [] m_ytemp;
-	}
-
 	m_hisum_save = hisum;
 
 	m_coef = binomial_table ( m_qs, hisum, hisum );
 
-	m_ytemp = new int[hisum+1];
+	m_ytemp.resize(hisum+1);
   }
 //
 //  Find QUASI(1) using the method of Faure.
@@ -935,7 +988,6 @@ void sobol::i8_sobol ( unsigned int dim_num, long long int *seed, double quasi[
   long long int newv;
   
 
-  long long int seed_temp;
   
  if ( !m_initialized || dim_num != m_dim_num_save )
  {
@@ -14422,37 +14474,25 @@ void sobol::i8_sobol ( unsigned int dim_num, long long int *seed, double quasi[
   {
     l = i8_bit_lo0 ( *seed );
   }
-  else if ( *seed <= m_seed_save )
+  else
   {
-    m_seed_save = 0;
-    l = 1;
+//
+//  Skip ahead: the state after SEED points is the XOR of the direction
+//  numbers selected by the bits of the Gray code of SEED.
+//
+    long long int gray = *seed ^ ( *seed >> 1 );
     for ( i = 0; i < dim_num; i++ )
     {
       lastq[i] = 0;
     }
-
-    for ( seed_temp = m_seed_save; seed_temp <= (*seed)-1; seed_temp++ )
+    for ( l = 0; gray != 0; l++, gray = gray >> 1 )
     {
-
-      l = i8_bit_lo0 ( seed_temp );
-
-      for ( i = 0; i < dim_num; i++ )
+      if ( gray & 1 )
       {
-        lastq[i] = ( lastq[i] ^ v[i][l-1] );
-      }
-    }
-    l = i8_bit_lo0 ( *seed );
-  }
-  else if ( m_seed_save+1 < *seed )
-  {
-    for ( seed_temp = m_seed_save+1; seed_temp <= (*seed)-1; seed_temp++ )
-    {
-
-      l = i8_bit_lo0 ( seed_temp );
-
-      for ( i = 0; i < dim_num; i++ )
-      {
-        lastq[i] = ( lastq[i] ^ v[i][l-1] );
+        for ( i = 0; i < dim_num; i++ )
+        {
+          lastq[i] = ( lastq[i] ^ v[i][l] );
+        }
       }
     }
     l = i8_bit_lo0 ( *seed );
@@ -14678,6 +14718,24 @@ std::vector<double> halton::operator()(unsigned int n) {
 	return retval;
 }
 
+/// Block generation
+/**
+ * @see base::generate()
+ *
+ * @throws value_error if first is zero
+ */
+void halton::generate(double *points, unsigned int n, unsigned int first) {
+	if (first == 0) {
+		pagmo_throw(value_error,"Halton sequence first point id is 1");
+	}
+	for (unsigned int k = 0; k < n; ++k) {
+		for (size_t i=0; i<m_dim; ++i) {
+			points[k * m_dim + i] = van_der_corput(first + k,m_primes[i]);
+		}
+	}
+	m_count = first + n;
+}
+
 
 
 /// Constructor
@@ -14687,7 +14745,7 @@ std::vector<double> halton::operator()(unsigned int n) {
  *
  * @throws value_error if dim not in [2,23]
 */
-faure::faure(unsigned int dim, unsigned int count) : base(dim, count), m_coef(NULL), m_hisum_save(-1), m_qs(-1), m_ytemp(NULL) {
+faure::faure(unsigned int dim, unsigned int count) : base(dim, count), m_coef(), m_hisum_save(-1), m_qs(-1), m_ytemp() {
 		if (dim >23 || dim <2) {
 			pagmo_throw(value_error,"Faure sequences can have dimension [2,23]");
 		}
@@ -14722,6 +14780,17 @@ std::vector<double> faure::operator()(unsigned int n) {
 	return retval;
 }
 
+/// Block generation
+/**
+ * @see base::generate()
+ */
+void faure::generate(double *points, unsigned int n, unsigned int first) {
+	m_count = first;
+	for (unsigned int k = 0; k < n; ++k) {
+		faure_orig(m_dim, &m_count, points + k * m_dim);
+	}
+}
+
 /// Constructor
 /**
  * @param[in] dim dimension of the hypercube
@@ -14797,7 +14866,7 @@ std::vector<double> sobol::operator()() {
 	std::vector<double> retval(m_dim,0.0);
 	signed long long int seed= (signed long long int) m_count;
 	i8_sobol(m_dim, &seed, &retval[0]);
-	m_count= (unsigned short int) seed;
+	m_count= (unsigned int) seed;
 	return retval;
 }
 /// Operator (unsigned int n)
@@ -14812,10 +14881,25 @@ std::vector<double> sobol::operator()(unsigned int n) {
 	signed long long int seed= (signed long long int) m_count;
 	std::vector<double> retval(m_dim,0.0);
 	i8_sobol(m_dim, &seed, &retval[0]);
-	m_count= (unsigned short int) seed;
+	m_count= (unsigned int) seed;
 	return retval;
 }
 
+/// Block generation
+/**
+ * Jumping to the first point costs O(log(first)) (Gray code of the index), each
+ * following point is obtained with a single XOR per dimension.
+ *
+ * @see base::generate()
+ */
+void sobol::generate(double *points, unsigned int n, unsigned int first) {
+	signed long long int seed= (signed long long int) first;
+	for (unsigned int k = 0; k < n; ++k) {
+		i8_sobol(m_dim, &seed, points + k * m_dim);
+	}
+	m_count= (unsigned int) seed;
+}
+
 
 /// Constructor
 /**
@@ -14868,4 +14952,22 @@ std::vector<double> lhs::operator()(unsigned int n) {
 	m_next++;
 	return retval;
 }
+
+/// Block generation
+/**
+ * @see base::generate()
+ *
+ * @throws value_error if the block exceeds the number of points to sample
+ */
+void lhs::generate(double *points, unsigned int n, unsigned int first) {
+	if (first + n > m_count) {
+		pagmo_throw(value_error,"the latin hypercube does not contain enough points");
+	}
+	if (!m_initialised){
+		m_set=latin_random(m_dim,m_count);
+		m_initialised=true;
+	}
+	std::copy(m_set.begin() + first * m_dim, m_set.begin() + (first + n) * m_dim, points);
+	m_next = first + n;
+}
 }}} //namespaces
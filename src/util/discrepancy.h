@@ -33,6 +33,7 @@
 
 #include "../config.h"
 #include "../exceptions.h"
+#include "../population.h"
 #include "../rng.h"
 
 namespace pagmo{ namespace util {
@@ -99,6 +100,9 @@ public:
 	 * @return an std::vector<double> containing the n-th point
 	 */
 	virtual std::vector<double> operator()(unsigned int n) = 0;
+	virtual void generate(double *points, unsigned int n, unsigned int first);
+	/// Dimension of the points
+	unsigned int get_dimension() const {return m_dim;}
 	/// Clone method for dynamic polymorphism
 	virtual base_ptr clone() const = 0;
 	/// Virtual destructor. Required as the class contains pure virtual methods
@@ -129,6 +133,7 @@ class __PAGMO_VISIBLE halton : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+		void generate(double *points, unsigned int n, unsigned int first);
 	private:
 		std::vector<unsigned int> m_primes;
 };
@@ -149,18 +154,18 @@ class __PAGMO_VISIBLE faure : public base
 	base_ptr clone() const;
 	std::vector<double> operator()();
 	std::vector<double> operator()(unsigned int n);
+	void generate(double *points, unsigned int n, unsigned int first);
 	private:
-		int *binomial_table ( int qs, int m, int n );
+		std::vector<int> binomial_table ( int qs, int m, int n );
 		void faure_orig ( unsigned int dim_num, unsigned int *seed, double quasi[] );
-		double *faure_generate ( int dim_num, int n, int skip );
 		int i4_log_i4 ( int i4, int j4 );
 		int i4_min ( int i1, int i2 );
 		int i4_power ( int i, int j );
 	private:
-		int *m_coef;
+		std::vector<int> m_coef;
 		int m_hisum_save;
 		int m_qs;
-		int *m_ytemp;
+		std::vector<int> m_ytemp;
 
 };
 
@@ -202,6 +207,7 @@ class __PAGMO_VISIBLE sobol : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+		void generate(double *points, unsigned int n, unsigned int first);
 	private:
 		int i8_bit_lo0 ( long long int n );
 		void i8_sobol ( unsigned int dim_num, long long int *seed, double quasi[ ] );
@@ -234,6 +240,7 @@ class __PAGMO_VISIBLE lhs : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+		void generate(double *points, unsigned int n, unsigned int first);
 	private:
 		std::vector<double> latin_random ( unsigned int dim_num, unsigned int point_num);
 		unsigned int *perm_uniform ( unsigned int n);
@@ -243,6 +250,8 @@ class __PAGMO_VISIBLE lhs : public base
 		unsigned int m_next;
 };
 
+__PAGMO_VISIBLE_FUNC void init_population(population &, base &, unsigned int);
+
 }}} //namespace discrepancy
 
 #endif
@@ -0,0 +1,257 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "../exceptions.h"
+#include "distance_matrix.h"
+
+namespace pagmo { namespace util {
+
+// Alignment of the distance buffer (a typical cache line).
+static const std::size_t cache_line = 64;
+
+// Raw memory block aligned to a cache line. It is written only right after creation,
+// and then shared read-only between the copies of the owning distance_matrix.
+class distance_matrix::buffer
+{
+	public:
+		explicit buffer(std::size_t bytes):m_raw(bytes + cache_line)
+		{
+			const std::size_t addr = reinterpret_cast<std::size_t>(&m_raw[0]);
+			m_data = &m_raw[0] + (cache_line - addr % cache_line) % cache_line;
+		}
+		void *data()
+		{
+			return m_data;
+		}
+		const void *data() const
+		{
+			return m_data;
+		}
+	private:
+		std::vector<char>	m_raw;
+		char			*m_data;
+};
+
+/// Default constructor.
+/**
+ * Constructs an empty distance matrix.
+ */
+distance_matrix::distance_matrix():m_storage(FULL),m_n(0),m_dim(0),m_symmetric(true),m_double(0),m_float(0) {}
+
+/// Constructor from a matrix of distances.
+/**
+ * Copies the input matrix into the requested storage layout. For the float variants, distances are rounded
+ * to single precision.
+ *
+ * @param[in] weights square matrix of distances, weights[i][j] is the distance from i to j.
+ * @param[in] storage one of FULL, TRIANGULAR, FULL_FLOAT, TRIANGULAR_FLOAT.
+ *
+ * @throws value_error if weights is not square, if a triangular layout is requested for a non-symmetric matrix,
+ * or if storage is EUCLIDEAN (use euclidean() instead).
+ */
+distance_matrix::distance_matrix(const std::vector<std::vector<double> > &weights, storage_type storage):
+	m_storage(FULL),m_n(0),m_dim(0),m_symmetric(true),m_double(0),m_float(0)
+{
+	const size_type n = weights.size();
+	for (size_type i = 0; i < n; ++i) {
+		if (weights[i].size() != n) {
+			pagmo_throw(value_error,"the distance matrix must be square");
+		}
+	}
+	bool symmetric = true;
+	for (size_type i = 0; i < n && symmetric; ++i) {
+		for (size_type j = 0; j < i; ++j) {
+			if (weights[i][j] != weights[j][i]) {
+				symmetric = false;
+				break;
+			}
+		}
+	}
+	switch (storage) {
+		case FULL:
+		case FULL_FLOAT:
+			break;
+		case TRIANGULAR:
+		case TRIANGULAR_FLOAT:
+			for (size_type i = 0; i < n && !symmetric; ++i) {
+				for (size_type j = 0; j < i; ++j) {
+					if (weights[i][j] != weights[j][i]) {
+						pagmo_throw(value_error,"the distance matrix must be symmetric to use a triangular storage, weights[" +
+							boost::lexical_cast<std::string>(i) + "][" + boost::lexical_cast<std::string>(j) + "] != weights[" +
+							boost::lexical_cast<std::string>(j) + "][" + boost::lexical_cast<std::string>(i) + "]");
+					}
+				}
+			}
+			break;
+		default:
+			pagmo_throw(value_error,"invalid storage type, use distance_matrix::euclidean() for coordinate based storage");
+	}
+	allocate(storage,n,0);
+	m_symmetric = symmetric;
+	double *d = const_cast<double *>(m_double);
+	float *f = const_cast<float *>(m_float);
+	for (size_type i = 0; i < n; ++i) {
+		switch (storage) {
+			case FULL:
+				std::copy(weights[i].begin(),weights[i].end(),d + i * n);
+				break;
+			case TRIANGULAR:
+				std::copy(weights[i].begin(),weights[i].begin() + (i + 1),d + triangular_idx(i,0));
+				break;
+			case FULL_FLOAT:
+				std::copy(weights[i].begin(),weights[i].end(),f + i * n);
+				break;
+			default:
+				std::copy(weights[i].begin(),weights[i].begin() + (i + 1),f + triangular_idx(i,0));
+		}
+	}
+}
+
+/// Constructs a distance matrix from the coordinates of the points.
+/**
+ * Only the coordinates are stored (n * dim doubles), and the Euclidean distance between two
+ * points is computed each time it is requested.
+ *
+ * @param[in] coords coordinates of the points, all of the same (non-zero) dimension.
+ *
+ * @return a distance_matrix with EUCLIDEAN storage.
+ *
+ * @throws value_error if the points have inconsistent or zero dimension.
+ */
+distance_matrix distance_matrix::euclidean(const std::vector<std::vector<double> > &coords)
+{
+	distance_matrix retval;
+	if (coords.empty()) {
+		retval.m_storage = EUCLIDEAN;
+		return retval;
+	}
+	const size_type dim = coords[0].size();
+	if (dim == 0) {
+		pagmo_throw(value_error,"the coordinates of the points must have a non-zero dimension");
+	}
+	for (size_type i = 1; i < coords.size(); ++i) {
+		if (coords[i].size() != dim) {
+			pagmo_throw(value_error,"all the points must have the same dimension");
+		}
+	}
+	retval.allocate(EUCLIDEAN,coords.size(),dim);
+	double *d = const_cast<double *>(retval.m_double);
+	for (size_type i = 0; i < coords.size(); ++i) {
+		std::copy(coords[i].begin(),coords[i].end(),d + i * dim);
+	}
+	return retval;
+}
+
+/// Row of the distance matrix.
+/**
+ * @param[in] i index of the point.
+ *
+ * @return the distances from i to all the points.
+ *
+ * @throws index_error if i is out of range.
+ */
+std::vector<double> distance_matrix::row(size_type i) const
+{
+	if (i >= m_n) {
+		pagmo_throw(index_error,"point index out of range");
+	}
+	std::vector<double> retval(m_n);
+	if (m_storage == FULL) {
+		std::copy(m_double + i * m_n,m_double + (i + 1) * m_n,retval.begin());
+	} else {
+		for (size_type j = 0; j < m_n; ++j) {
+			retval[j] = (*this)(i,j);
+		}
+	}
+	return retval;
+}
+
+/// Full matrix of distances.
+/**
+ * @return the n x n matrix of distances, whatever the storage layout.
+ */
+std::vector<std::vector<double> > distance_matrix::to_matrix() const
+{
+	std::vector<std::vector<double> > retval(m_n);
+	for (size_type i = 0; i < m_n; ++i) {
+		retval[i] = row(i);
+	}
+	return retval;
+}
+
+/// Memory used by the stored data.
+/**
+ * @return the size in bytes of the (shared) buffer holding distances or coordinates.
+ */
+std::size_t distance_matrix::memory_footprint() const
+{
+	return n_stored() * ((m_storage == FULL_FLOAT || m_storage == TRIANGULAR_FLOAT) ? sizeof(float) : sizeof(double));
+}
+
+// Number of values held in the buffer.
+distance_matrix::size_type distance_matrix::n_stored() const
+{
+	switch (m_storage) {
+		case FULL:
+		case FULL_FLOAT:
+			return m_n * m_n;
+		case TRIANGULAR:
+		case TRIANGULAR_FLOAT:
+			return m_n * (m_n + 1) / 2;
+		default:
+			return m_n * m_dim;
+	}
+}
+
+// Allocates a new (uninitialised) buffer for the given layout and sets up the views on it.
+void distance_matrix::allocate(storage_type storage, size_type n, size_type dim)
+{
+	if (storage < FULL || storage > EUCLIDEAN) {
+		pagmo_throw(value_error,"invalid storage type");
+	}
+	m_storage = storage;
+	m_n = n;
+	m_dim = (storage == EUCLIDEAN) ? dim : 0;
+	m_symmetric = true;
+	m_double = 0;
+	m_float = 0;
+	const std::size_t bytes = memory_footprint();
+	boost::shared_ptr<buffer> buf(new buffer(bytes));
+	if (storage == FULL_FLOAT || storage == TRIANGULAR_FLOAT) {
+		m_float = static_cast<const float *>(buf->data());
+	} else {
+		m_double = static_cast<const double *>(buf->data());
+	}
+	m_buffer = buf;
+}
+
+}}
@@ -0,0 +1,194 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_DISTANCE_MATRIX_H
+#define PAGMO_UTIL_DISTANCE_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "../config.h"
+#include "../exceptions.h"
+#include "../serialization.h"
+
+namespace pagmo{ namespace util {
+
+/// Compact storage of the distances between n points (e.g. the cities of a TSP)
+/**
+ * Distances are stored in a single flat buffer aligned to a cache line, in one of the following layouts:
+ *
+ * - FULL: the whole n x n matrix, row-major, in double precision.
+ * - TRIANGULAR: the lower triangle (diagonal included) of a symmetric matrix, in double precision. Half the memory.
+ * - FULL_FLOAT, TRIANGULAR_FLOAT: as above, in single precision. Half the memory again.
+ * - EUCLIDEAN: only the coordinates of the points are stored, distances are computed on demand.
+ *
+ * The buffer is immutable and shared by all the copies of a distance_matrix, so that copying one
+ * (e.g. when a TSP problem is cloned) costs O(1) whatever the number of points.
+ */
+class __PAGMO_VISIBLE distance_matrix
+{
+	public:
+		/// Size type.
+		typedef std::vector<double>::size_type size_type;
+		/// Storage layout.
+		enum storage_type {
+			FULL = 0,		///< Full matrix, double precision.
+			TRIANGULAR = 1,		///< Lower triangle of a symmetric matrix, double precision.
+			FULL_FLOAT = 2,		///< Full matrix, single precision.
+			TRIANGULAR_FLOAT = 3,	///< Lower triangle of a symmetric matrix, single precision.
+			EUCLIDEAN = 4		///< Coordinates only, distances computed on demand.
+		};
+
+		distance_matrix();
+		explicit distance_matrix(const std::vector<std::vector<double> > &, storage_type = FULL);
+		static distance_matrix euclidean(const std::vector<std::vector<double> > &);
+
+		/// Number of points.
+		size_type size() const
+		{
+			return m_n;
+		}
+		/// Storage layout.
+		storage_type get_storage() const
+		{
+			return m_storage;
+		}
+		/// Symmetry of the distances.
+		/**
+		 * @return true if the distance from i to j equals the distance from j to i for all points
+		 * (always the case for triangular and EUCLIDEAN storage).
+		 */
+		bool is_symmetric() const
+		{
+			return m_symmetric;
+		}
+		/// Distance between points i and j.
+		/**
+		 * No bound checking is performed.
+		 *
+		 * @param[in] i index of the first point.
+		 * @param[in] j index of the second point.
+		 *
+		 * @return the distance from i to j.
+		 */
+		double operator()(size_type i, size_type j) const
+		{
+			switch (m_storage) {
+				case FULL:
+					return m_double[i * m_n + j];
+				case TRIANGULAR:
+					return m_double[triangular_idx(i,j)];
+				case FULL_FLOAT:
+					return m_float[i * m_n + j];
+				case TRIANGULAR_FLOAT:
+					return m_float[triangular_idx(i,j)];
+				default:
+					return euclidean_distance(i,j);
+			}
+		}
+		std::vector<double> row(size_type) const;
+		std::vector<std::vector<double> > to_matrix() const;
+		std::size_t memory_footprint() const;
+
+	private:
+		static size_type triangular_idx(size_type i, size_type j)
+		{
+			return (i >= j) ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+		}
+		double euclidean_distance(size_type i, size_type j) const
+		{
+			const double *a = m_double + i * m_dim, *b = m_double + j * m_dim;
+			double retval = 0;
+			for (size_type k = 0; k < m_dim; ++k) {
+				retval += (a[k] - b[k]) * (a[k] - b[k]);
+			}
+			return std::sqrt(retval);
+		}
+		size_type n_stored() const;
+		void allocate(storage_type, size_type, size_type);
+
+		friend class boost::serialization::access;
+		template <class Archive>
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << m_storage;
+			ar << m_n;
+			ar << m_dim;
+			ar << m_symmetric;
+			if (m_storage == FULL_FLOAT || m_storage == TRIANGULAR_FLOAT) {
+				const std::vector<float> values(m_float, m_float + n_stored());
+				ar << values;
+			} else {
+				const std::vector<double> values(m_double, m_double + n_stored());
+				ar << values;
+			}
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int)
+		{
+			storage_type storage;
+			size_type n, dim;
+			ar >> storage;
+			ar >> n;
+			ar >> dim;
+			allocate(storage, n, dim);
+			ar >> m_symmetric;
+			if (m_storage == FULL_FLOAT || m_storage == TRIANGULAR_FLOAT) {
+				std::vector<float> values;
+				ar >> values;
+				if (values.size() != n_stored()) {
+					pagmo_throw(value_error,"inconsistent distance matrix data in archive");
+				}
+				std::copy(values.begin(), values.end(), const_cast<float *>(m_float));
+			} else {
+				std::vector<double> values;
+				ar >> values;
+				if (values.size() != n_stored()) {
+					pagmo_throw(value_error,"inconsistent distance matrix data in archive");
+				}
+				std::copy(values.begin(), values.end(), const_cast<double *>(m_double));
+			}
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+		// Cache-aligned memory block holding the data, shared by the copies.
+		class buffer;
+
+		storage_type			m_storage;
+		size_type			m_n;
+		// Dimension of the points (EUCLIDEAN only).
+		size_type			m_dim;
+		bool				m_symmetric;
+		boost::shared_ptr<const buffer>	m_buffer;
+		// Views on m_buffer: m_double holds the distances (or the coordinates), m_float the single precision distances.
+		const double			*m_double;
+		const float			*m_float;
+};
+
+}}
+
+#endif
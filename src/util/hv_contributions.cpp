@@ -0,0 +1,262 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "hv_contributions.h"
+#include "hypervolume.h"
+
+namespace pagmo { namespace util {
+
+/// Constructor from points and reference point
+/**
+ * Computes the exclusive contributions of all the points.
+ *
+ * @param[in] points vector of fitness_vectors for which the contributions are tracked
+ * @param[in] r_point reference point, which must be weakly dominated by all the points
+ *
+ * @throws value_error if the points do not have the same dimension as the reference point, or if they do not dominate it
+ */
+hv_contributions::hv_contributions(const std::vector<fitness_vector> &points, const fitness_vector &r_point):
+	m_points(points),m_r_point(r_point),m_contributions(points.size(),0.),m_outdated(points.size(),0),m_present(points.size(),1),
+	m_size(static_cast<unsigned int>(points.size())),m_recomputations(0)
+{
+	for (std::vector<fitness_vector>::size_type i = 0; i < m_points.size(); ++i) {
+		if (m_points[i].size() != m_r_point.size()) {
+			pagmo_throw(value_error, "Point set dimensions and reference point dimension must be equal.");
+		}
+		for (fitness_vector::size_type k = 0; k < m_r_point.size(); ++k) {
+			if (!(m_points[i][k] <= m_r_point[k])) {
+				pagmo_throw(value_error, "Reference point must be dominated by all the points.");
+			}
+		}
+	}
+	if (m_points.size() == 1) {
+		m_contributions[0] = hv_algorithm::base::volume_between(m_points[0], m_r_point);
+	} else if (m_points.size() > 1) {
+		hypervolume hv(m_points, false);
+		m_contributions = hv.contributions(m_r_point);
+	}
+}
+
+/// Number of points
+/**
+ * @return number of points which have not been removed yet
+ */
+unsigned int hv_contributions::size() const
+{
+	return m_size;
+}
+
+/// Check the presence of a point
+/**
+ * @param[in] idx index of the point
+ *
+ * @return true if the point has not been removed yet
+ */
+bool hv_contributions::contains(const unsigned int idx) const
+{
+	return idx < m_present.size() && m_present[idx];
+}
+
+/// Exclusive contribution of a point
+/**
+ * Returns the exclusive contribution of the point with respect to the points which have not been removed yet,
+ * recomputing it if it is outdated.
+ *
+ * @param[in] idx index of the point
+ *
+ * @return exclusive contribution of the point
+ *
+ * @throws value_error if the point does not exist or it was removed
+ */
+double hv_contributions::get_contribution(const unsigned int idx)
+{
+	check_index(idx);
+	if (m_outdated[idx]) {
+		update(idx);
+	}
+	return m_contributions[idx];
+}
+
+/// Remove the least contributor
+/**
+ * The outdated contributions are recomputed only when they are the smallest, as they cannot decrease.
+ *
+ * @return index of the removed point
+ *
+ * @throws value_error if there are no points left
+ */
+unsigned int hv_contributions::pop_least()
+{
+	if (!m_size) {
+		pagmo_throw(value_error, "No points left.");
+	}
+	while (true) {
+		unsigned int idx_least = static_cast<unsigned int>(m_points.size());
+		for (unsigned int idx = 0; idx < m_points.size(); ++idx) {
+			if (m_present[idx] && (idx_least == m_points.size() || m_contributions[idx] < m_contributions[idx_least])) {
+				idx_least = idx;
+			}
+		}
+		if (!m_outdated[idx_least]) {
+			remove(idx_least);
+			return idx_least;
+		}
+		update(idx_least);
+	}
+}
+
+/// Remove the greatest contributor
+/**
+ * All the outdated contributions are recomputed before the greatest one is established.
+ *
+ * @return index of the removed point
+ *
+ * @throws value_error if there are no points left
+ */
+unsigned int hv_contributions::pop_greatest()
+{
+	if (!m_size) {
+		pagmo_throw(value_error, "No points left.");
+	}
+	unsigned int idx_greatest = static_cast<unsigned int>(m_points.size());
+	for (unsigned int idx = 0; idx < m_points.size(); ++idx) {
+		if (!m_present[idx]) {
+			continue;
+		}
+		if (m_outdated[idx]) {
+			update(idx);
+		}
+		if (idx_greatest == m_points.size() || m_contributions[idx] > m_contributions[idx_greatest]) {
+			idx_greatest = idx;
+		}
+	}
+	remove(idx_greatest);
+	return idx_greatest;
+}
+
+/// Remove a point
+/**
+ * Removes the point and flags as outdated the contributions which may have changed.
+ *
+ * @param[in] idx index of the point
+ *
+ * @throws value_error if the point does not exist or it was already removed
+ */
+void hv_contributions::remove(const unsigned int idx)
+{
+	check_index(idx);
+	m_present[idx] = 0;
+	--m_size;
+	const fitness_vector &p = m_points[idx];
+	const fitness_vector::size_type f_dim = m_r_point.size();
+	fitness_vector joint(f_dim);
+	for (unsigned int q_idx = 0; q_idx < m_points.size(); ++q_idx) {
+		if (!m_present[q_idx] || m_outdated[q_idx]) {
+			continue;
+		}
+		// Region dominated by both p and q.
+		bool empty = false;
+		for (fitness_vector::size_type k = 0; k < f_dim; ++k) {
+			joint[k] = std::max(p[k], m_points[q_idx][k]);
+			empty |= !(joint[k] < m_r_point[k]);
+		}
+		if (empty) {
+			continue;
+		}
+		// The contribution of q is unchanged if the region is dominated by a third point.
+		bool covered = false;
+		for (unsigned int r_idx = 0; r_idx < m_points.size() && !covered; ++r_idx) {
+			if (!m_present[r_idx] || r_idx == q_idx) {
+				continue;
+			}
+			covered = true;
+			for (fitness_vector::size_type k = 0; k < f_dim && covered; ++k) {
+				covered = m_points[r_idx][k] <= joint[k];
+			}
+		}
+		if (!covered) {
+			m_outdated[q_idx] = 1;
+		}
+	}
+}
+
+/// Number of recomputed contributions
+/**
+ * @return number of contributions which were recomputed after the construction
+ */
+unsigned int hv_contributions::get_recomputations() const
+{
+	return m_recomputations;
+}
+
+// Check that the point exists and that it has not been removed.
+void hv_contributions::check_index(const unsigned int idx) const
+{
+	if (!contains(idx)) {
+		pagmo_throw(value_error, "Index of the point is out of bounds or the point was removed.");
+	}
+}
+
+// Recompute the contribution of a point, as the volume of the box between the point and the reference point
+// minus the hypervolume of the remaining points limited to the box.
+void hv_contributions::update(const unsigned int idx)
+{
+	const fitness_vector &q = m_points[idx];
+	const fitness_vector::size_type f_dim = m_r_point.size();
+	std::vector<fitness_vector> limited;
+	limited.reserve(m_size);
+	fitness_vector joint(f_dim);
+	for (unsigned int r_idx = 0; r_idx < m_points.size(); ++r_idx) {
+		if (!m_present[r_idx] || r_idx == idx) {
+			continue;
+		}
+		bool empty = false;
+		for (fitness_vector::size_type k = 0; k < f_dim; ++k) {
+			joint[k] = std::max(q[k], m_points[r_idx][k]);
+			empty |= !(joint[k] < m_r_point[k]);
+		}
+		if (!empty) {
+			limited.push_back(joint);
+		}
+	}
+	double covered = 0.;
+	if (limited.size() == 1) {
+		covered = hv_algorithm::base::volume_between(limited[0], m_r_point);
+	} else if (limited.size() > 1) {
+		hypervolume hv(limited, false);
+		hv.set_copy_points(false);
+		covered = hv.compute(m_r_point);
+	}
+	m_contributions[idx] = std::max(0., hv_algorithm::base::volume_between(q, m_r_point) - covered);
+	m_outdated[idx] = 0;
+	++m_recomputations;
+}
+
+}}
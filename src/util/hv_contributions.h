@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_HV_CONTRIBUTIONS_H
+#define PAGMO_UTIL_HV_CONTRIBUTIONS_H
+
+#include <vector>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo { namespace util {
+
+/// Incremental hypervolume contributions.
+/**
+ * This class keeps track of the exclusive hypervolume contributions of a set of points while the points are removed
+ * one at a time, as done by the greedy hypervolume-based selection and replacement strategies.
+ *
+ * The contributions are computed once for the whole set at construction. When a point p is removed, the contribution
+ * of another point q can change only if the region dominated by both p and q is not dominated by any of the remaining points,
+ * i.e., if the componentwise maximum of p and q is not weakly dominated by a third point. Only such points are flagged, and
+ * their contributions are recomputed lazily, when they are needed to establish the least or the greatest contributor,
+ * by limiting the remaining points to the box dominated by the flagged point.
+ *
+ * Since removing a point can only increase the contributions of the remaining ones, the outdated contributions are
+ * lower bounds, and the least contributor can often be found without recomputing them.
+ *
+ * Ties are resolved in favour of the point with the smallest index, as in hypervolume::least_contributor() and
+ * hypervolume::greatest_contributor().
+ */
+class __PAGMO_VISIBLE hv_contributions
+{
+public:
+	hv_contributions(const std::vector<fitness_vector> &, const fitness_vector &);
+
+	unsigned int size() const;
+	bool contains(const unsigned int) const;
+	double get_contribution(const unsigned int);
+
+	unsigned int pop_least();
+	unsigned int pop_greatest();
+	void remove(const unsigned int);
+
+	unsigned int get_recomputations() const;
+
+private:
+	void check_index(const unsigned int) const;
+	void update(const unsigned int);
+
+	// Points and reference point.
+	const std::vector<fitness_vector>	m_points;
+	const fitness_vector			m_r_point;
+	// Contributions of the points, exact unless the point is flagged as outdated.
+	std::vector<double>			m_contributions;
+	std::vector<char>			m_outdated;
+	// Flags of the points which have not been removed, and their number.
+	std::vector<char>			m_present;
+	unsigned int				m_size;
+	// Number of contributions recomputed after the construction.
+	unsigned int				m_recomputations;
+};
+
+}}
+
+#endif
@@ -146,14 +146,19 @@ standard::standard(const standard &standard_copy):
 	base_stochastic(1, 1, standard_copy.get_f_dimension(),
 			standard_copy.get_c_dimension(),
 			standard_copy.get_ic_dimension(), 0, standard_copy.m_seed),
-	m_algos(standard_copy.m_algos),
-	m_probs(standard_copy.m_probs),
 	m_pop_size(standard_copy.m_pop_size),
 	m_is_first_evaluation(standard_copy.m_is_first_evaluation),
 	m_database_seed(standard_copy.m_database_seed),
 	m_database_f(standard_copy.m_database_f),
 	m_database_c(standard_copy.m_database_c)
 {
+	// Copies can be evaluated concurrently, the algorithms must not be shared
+	for(unsigned int i = 0; i < standard_copy.m_algos.size(); i++){
+		m_algos.push_back(standard_copy.m_algos[i]->clone());
+	}
+	for(unsigned int i = 0; i < standard_copy.m_probs.size(); i++){
+		m_probs.push_back(standard_copy.m_probs[i]->clone());
+	}
 	set_bounds(standard_copy.get_lb(), standard_copy.get_ub());
 }
 
@@ -266,7 +271,7 @@ void standard::evaluate_algorithm(unsigned int algo_idx) const
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed), m_race(seed)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
@@ -283,7 +288,7 @@ race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const proble
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed), m_race(seed)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
@@ -331,11 +336,11 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 	// Construct an internal population, such that the winners of the race in
 	// this population corresponds to the winning algorithm
 	metrics_algos::standard metrics(m_probs, m_algos, m_seed, m_pop_size);
-	population algos_pop(metrics);
+	racing_population algos_pop(metrics);
 	for(unsigned int i = 0; i < m_algos.size(); i++){
 		decision_vector algo_idx(1);
 		algo_idx[0] = i;
-		algos_pop.push_back(algo_idx);
+		algos_pop.push_back_noeval(algo_idx);
 	}
 
 	// Conversion to types that pop_race is familiar with
@@ -344,10 +349,12 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 		pop_race_active_set[i] = active_set[i];
 	}
 
-	// Run the actual race
+	// Run the actual race. The evaluations made in previous runs are found in
+	// the store of m_race, and are not repeated.
+	m_race.register_population(algos_pop);
 	std::pair<std::vector<population::size_type>, unsigned int> res =
-	    algos_pop.race(n_final, min_trials, max_count, delta,
-	                   pop_race_active_set, race_best, screen_output);
+	    m_race.run(n_final, min_trials, max_count, delta,
+	               pop_race_active_set, race_pop::MAX_BUDGET, race_best, screen_output);
 
 	// Convert the result to the algo's context
 	std::pair<std::vector<unsigned int>, unsigned int> res_algo_race;
@@ -360,4 +367,30 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 	return res_algo_race;
 }
 
+/// Sets the number of threads evolving the algorithms
+/**
+ * Each thread evolves its own copy of the algorithms.
+ *
+ * @param[in] n number of threads
+ *
+ * @throws value_error if n is zero
+ *
+ * @see race_pop::set_eval_threads()
+ */
+void race_algo::set_eval_threads(unsigned int n)
+{
+	m_race.set_eval_threads(n);
+}
+
+/// Sets the number of racing rounds evolved in advance
+/**
+ * @param[in] n number of rounds evolved in advance by idle threads
+ *
+ * @see race_pop::set_lookahead()
+ */
+void race_algo::set_lookahead(unsigned int n)
+{
+	m_race.set_lookahead(n);
+}
+
 }}}
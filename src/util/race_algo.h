@@ -34,6 +34,7 @@
 #include "../problem/base.h"
 #include "../problem/ackley.h"
 #include "../algorithm/base.h"
+#include "race_pop.h"
 
 namespace pagmo { namespace util { namespace racing {
 
@@ -42,6 +43,13 @@ namespace pagmo { namespace util { namespace racing {
  * This class allows the racing of a set of algorithms on a problem or a set of
  * problems. It supports the racing over single objective box-constrained and
  * equality / inequality constrained problems.
+ *
+ * The evaluations of the algorithms are kept across calls to run(), which all
+ * use the same sequence of seeds, determined by the seed of the object.
+ * The evolutions of the algorithms in a racing round can run on several
+ * threads, which can also evolve in advance the algorithms still in the race
+ * for the next rounds (see set_eval_threads() and set_lookahead()). The
+ * outcome of the race does not depend on these settings.
  */
 class __PAGMO_VISIBLE race_algo
 {
@@ -60,12 +68,16 @@ class __PAGMO_VISIBLE race_algo
 			const bool screen_output
 		);
 
+		void set_eval_threads(unsigned int);
+		void set_lookahead(unsigned int);
+
 	private:
 
 		std::vector<algorithm::base_ptr> m_algos;
 		std::vector<problem::base_ptr> m_probs;
 		unsigned int m_pop_size;
 		unsigned int m_seed;
+		race_pop m_race;
 };
 
 }}}
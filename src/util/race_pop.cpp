@@ -2,11 +2,242 @@
 #include "../problem/ackley.h"
 #include "../problem/base_stochastic.h"
 
+#include <deque>
 #include <map>
 #include <utility>
+#include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace pagmo { namespace util { namespace racing {
 
+// Bounded store of the evaluations of decision vectors under given seeds, with
+// first-in first-out eviction. Not thread safe: it is only accessed from the
+// thread running the race. Copies of race_pop get their own copy of the store,
+// which is shared only through share_memory().
+class race_pop::trial_store
+{
+	public:
+		typedef std::pair<decision_vector, unsigned int> key_type;
+
+		explicit trial_store(unsigned int capacity): m_capacity(capacity) {}
+
+		trial_store(const trial_store &other): m_problem(other.m_problem ? other.m_problem->clone() : problem::base_ptr()),
+			m_data(other.m_data), m_order(other.m_order), m_capacity(other.m_capacity) {}
+
+		const eval_data *find(const decision_vector &x, unsigned int seed) const
+		{
+			const map_type::const_iterator it = m_data.find(key_type(x, seed));
+			return it == m_data.end() ? 0 : &it->second;
+		}
+
+		void insert(const decision_vector &x, unsigned int seed, const eval_data &data)
+		{
+			if (m_capacity == 0) {
+				return;
+			}
+			const key_type key(x, seed);
+			if (m_data.insert(std::make_pair(key, data)).second) {
+				m_order.push_back(key);
+			}
+			while (m_order.size() > m_capacity) {
+				m_data.erase(m_order.front());
+				m_order.pop_front();
+			}
+		}
+
+		void clear()
+		{
+			m_data.clear();
+			m_order.clear();
+		}
+
+		void set_capacity(unsigned int capacity)
+		{
+			m_capacity = capacity;
+			while (m_order.size() > m_capacity) {
+				m_data.erase(m_order.front());
+				m_order.pop_front();
+			}
+		}
+
+		unsigned int get_capacity() const
+		{
+			return m_capacity;
+		}
+
+		// Problem the stored evaluations refer to.
+		problem::base_ptr m_problem;
+
+	private:
+		typedef boost::unordered_map<key_type, eval_data, boost::hash<key_type> > map_type;
+		map_type m_data;
+		std::deque<key_type> m_order;
+		unsigned int m_capacity;
+};
+
+// Evaluations requested during a race, processed by a set of worker threads
+// in order of priority (i.e. of data location). The racing thread steals the
+// requests it needs which have not been started yet, and evaluates them
+// itself.
+class race_pop::eval_pool
+{
+	public:
+		eval_pool(const problem::base &prob, unsigned int n_workers): m_stop(false), m_sequence(0)
+		{
+			for(unsigned int i = 0; i < n_workers; i++){
+				m_problems.push_back(prob.clone());
+				m_threads.create_thread(boost::bind(&eval_pool::worker, this, boost::cref(*m_problems.back())));
+			}
+		}
+
+		~eval_pool()
+		{
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_cond.notify_all();
+			m_threads.join_all();
+		}
+
+		// Requests the evaluation of x under seed on behalf of a racer
+		void request(const decision_vector &x, unsigned int seed, unsigned int priority, population::size_type racer)
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			const key_type key(x, seed);
+			job_map_type::iterator it = m_jobs.find(key);
+			if(it == m_jobs.end()){
+				it = m_jobs.insert(std::make_pair(key, job())).first;
+				it->second.position = m_queue.insert(std::make_pair(std::make_pair(priority, m_sequence++), &it->first)).first;
+			}
+			it->second.racers.push_back(racer);
+			m_cond.notify_one();
+		}
+
+		// Returns the evaluation of x under seed, evaluating it on prob if it has not been started yet
+		eval_data get(const problem::base &prob, const decision_vector &x, unsigned int seed)
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			const job_map_type::iterator it = m_jobs.find(key_type(x, seed));
+			if(it != m_jobs.end() && it->second.state == QUEUED){
+				m_queue.erase(it->second.position);
+				m_jobs.erase(it);
+			}
+			else if(it != m_jobs.end()){
+				while(it->second.state == RUNNING){
+					m_cond.wait(lock);
+				}
+				if(it->second.state == DONE){
+					return it->second.result;
+				}
+			}
+			lock.unlock();
+			// Failed evaluations are repeated here, so that the exception reaches the caller
+			return evaluate(prob, x, seed);
+		}
+
+		// Cancels the evaluations not started yet which were requested only by racer
+		void cancel(population::size_type racer)
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			queue_type::iterator it = m_queue.begin();
+			while(it != m_queue.end()){
+				const job_map_type::iterator job_it = m_jobs.find(*it->second);
+				std::vector<population::size_type> &racers = job_it->second.racers;
+				racers.erase(std::remove(racers.begin(), racers.end(), racer), racers.end());
+				if(racers.empty()){
+					m_queue.erase(it++);
+					m_jobs.erase(job_it);
+				}
+				else{
+					++it;
+				}
+			}
+		}
+
+	private:
+		typedef trial_store::key_type key_type;
+		enum job_state {QUEUED, RUNNING, DONE, FAILED};
+		typedef std::map<std::pair<unsigned int, unsigned long>, const key_type *> queue_type;
+		struct job
+		{
+			job(): state(QUEUED) {}
+			job_state state;
+			std::vector<population::size_type> racers;
+			queue_type::iterator position;
+			eval_data result;
+		};
+		typedef boost::unordered_map<key_type, job, boost::hash<key_type> > job_map_type;
+
+		void worker(const problem::base &prob)
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while(true){
+				while(!m_stop && m_queue.empty()){
+					m_cond.wait(lock);
+				}
+				if(m_stop){
+					return;
+				}
+				const key_type &key = *m_queue.begin()->second;
+				m_queue.erase(m_queue.begin());
+				// Running jobs are never erased, the reference stays valid
+				job &j = m_jobs.find(key)->second;
+				j.state = RUNNING;
+				lock.unlock();
+				job_state state = DONE;
+				eval_data result;
+				try{
+					result = evaluate(prob, key.first, key.second);
+				}
+				catch(...){
+					state = FAILED;
+				}
+				lock.lock();
+				j.result = result;
+				j.state = state;
+				m_cond.notify_all();
+			}
+		}
+
+		std::vector<problem::base_ptr> m_problems;
+		boost::thread_group m_threads;
+		boost::mutex m_mutex;
+		boost::condition_variable m_cond;
+		job_map_type m_jobs;
+		queue_type m_queue;
+		bool m_stop;
+		unsigned long m_sequence;
+};
+
+// Default number of evaluations kept in the store.
+static const unsigned int default_cache_capacity = 100000;
+
+// Description of the problem, including its parameters, except for the seed
+// of stochastic problems, which is set by the race at each evaluation.
+static std::string problem_signature(const problem::base &prob)
+{
+	const problem::base_ptr p = prob.clone();
+	const problem::base_stochastic *stochastic = dynamic_cast<const problem::base_stochastic *>(p.get());
+	if(stochastic){
+		stochastic->set_seed(0);
+	}
+	return p->human_readable();
+}
+
+// Whether evaluations on the two problems can be exchanged. The operator== of
+// most problems only checks dimensions and bounds, hence the descriptions
+// (e.g. the noise parameters of problem::noisy) are compared as well.
+static bool same_problem(const problem::base &p1, const problem::base &p2)
+{
+	return p1 == p2 && problem_signature(p1) == problem_signature(p2);
+}
+
 /// Constructor
 /**
  * Construct a race_pop object from an external population and a seed. The seed
@@ -15,7 +246,7 @@ namespace pagmo { namespace util { namespace racing {
  * @param[in] pop population containing the individuals to race
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_pop_wilcoxon(pop), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(pop.size()), m_cache_averaged_data(pop.size())
+race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_seeds(), m_seeder(seed), m_cache_data(pop.size()), m_cache_averaged_data(pop.size()), m_store(new trial_store(default_cache_capacity)), m_eval_threads(1), m_lookahead(0)
 {
 	register_population(pop);
 }
@@ -28,27 +259,77 @@ race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed),
  *
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_wilcoxon(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(0), m_cache_averaged_data(0)
+race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_cache_data(0), m_cache_averaged_data(0), m_store(new trial_store(default_cache_capacity)), m_eval_threads(1), m_lookahead(0)
 {
 }
 
+/// Copy constructor
+/**
+ * The copy gets its own copy of the store of the evaluations, as the store is
+ * not thread safe. Use share_memory() to share it explicitly.
+ *
+ * @param[in] other race_pop to be copied
+ */
+race_pop::race_pop(const race_pop &other): m_race_seed(other.m_race_seed), m_pop(other.m_pop), m_pop_registered(other.m_pop_registered), m_seeds(other.m_seeds), m_seeder(other.m_seeder),
+	m_cache_data(other.m_cache_data), m_cache_averaged_data(other.m_cache_averaged_data), m_cache_signatures(other.m_cache_signatures),
+	m_store(new trial_store(*other.m_store)), m_eval_threads(other.m_eval_threads), m_lookahead(other.m_lookahead)
+{
+}
+
+/// Assignment operator
+/**
+ * As for the copy constructor, the store of the evaluations is copied, not shared.
+ *
+ * @param[in] other race_pop to be assigned
+ *
+ * @return reference to this
+ */
+race_pop &race_pop::operator=(const race_pop &other)
+{
+	if(this != &other){
+		m_race_seed = other.m_race_seed;
+		m_pop = other.m_pop;
+		m_pop_registered = other.m_pop_registered;
+		m_seeds = other.m_seeds;
+		m_seeder = other.m_seeder;
+		m_cache_data = other.m_cache_data;
+		m_cache_averaged_data = other.m_cache_averaged_data;
+		m_cache_signatures = other.m_cache_signatures;
+		m_store.reset(new trial_store(*other.m_store));
+		m_eval_threads = other.m_eval_threads;
+		m_lookahead = other.m_lookahead;
+		m_pool.reset();
+	}
+	return *this;
+}
+
 /// Update the population on which the race will run
 /**
- * This also re-allocate the spaces required to the cache entries.
+ * This also re-allocate the spaces required to the cache entries, which are
+ * filled with the evaluations of the individuals found in the store. If the
+ * problem changed, the store is replaced by an empty one.
  *
  * @param[in] pop The new population
  **/
 void race_pop::register_population(const population &pop)
 {
 	m_pop = pop;
-	// This is merely to set up the problem in wilcoxon pop
-	m_pop_wilcoxon = pop;
-	reset_cache();
+	if(!m_store->m_problem){
+		m_store->m_problem = pop.problem().clone();
+	}
+	else if(!same_problem(*m_store->m_problem, pop.problem())){
+		m_store.reset(new trial_store(m_store->get_capacity()));
+		m_store->m_problem = pop.problem().clone();
+	}
+	cache_clear_local();
 	if(m_cache_data.size() != pop.size()){
 		m_cache_data.resize(pop.size());
 		m_cache_averaged_data.resize(pop.size());
 	}
 	cache_register_signatures(pop);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		cache_pull(i);
+	}
 	m_pop_registered = true;
 }
 
@@ -162,78 +443,43 @@ std::vector<population::size_type> race_pop::construct_output_list(
 // @return The number of objective function calls made
 unsigned int race_pop::prepare_population_friedman(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
 	// Perform re-evaluation on necessary individuals under current seed
+	unsigned int count_nfes = cache_fill(in_race, count_iter - 1);
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
-		// Case 1: Current racer has previous data that can be reused, no
-		// need to be evaluated with this seed
-		if(m_use_caching && cache_data_exist(*it, count_iter-1)){
-			const eval_data& cached_data = cache_get_entry(*it, count_iter-1);
-			m_pop.set_fc(*it, cached_data.f, cached_data.c);
-		}
-		// Case 2: No previous data can be reused, perform actual
-		// re-evaluation and update the cache
-		else{
-			count_nfes++;
-			const population::individual_type &ind = m_pop.get_individual(*it);
-			fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-			constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-			m_pop.set_fc(*it, f_vec, c_vec);
-			if(m_use_caching)
-				cache_insert_data(*it, f_vec, c_vec);
-		}
+		const eval_data& cached_data = cache_get_entry(*it, count_iter-1);
+		m_pop.set_fc(*it, cached_data.f, cached_data.c);
 	}
 	return count_nfes;
 }
 
-/// Update m_pop_wilcoxon to contain evaluation data required for Wilcoxon test
+/// Update the Wilcoxon statistics with the evaluation data required for Wilcoxon test
 /**
- * In the end, m_pop_wilcoxon should hold all the fc vectors evaluated so far
+ * In the end, wstats should hold all the fc vectors evaluated so far
  * for the two active individuals. This is to facilitate the rankings required
  * by Wilcoxon rank-sum test.
  **/
-unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population::size_type>& in_race, unsigned int count_iter)
+unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population::size_type>& in_race, unsigned int count_iter, wilcoxon_stats &wstats)
 {
-	unsigned int count_nfes = 0;
 	if(in_race.size() != 2){
 		pagmo_throw(value_error, "Wilcoxon rank sum test is only applicable when there are two active individuals");
 	}	
 
 	// Need to bootstrap by pulling all the previous evaluation data into
-	// wilcoxon_pop for the first time when race is left with the two
-	// individuals. Subsequent racing iterations can just re-use this
-	// wilcoxon_pop memory structure and pad in necessary fc data for each
-	// particular iteration.
+	// wstats for the first time when race is left with the two
+	// individuals. Subsequent racing iterations just add the fc data of
+	// each particular iteration.
 	unsigned int start_count_iter;
-	if(m_pop_wilcoxon.size() == 0){
+	if(wstats.size() == 0){
 		start_count_iter = 1;
 	}
 	else{
 		start_count_iter = count_iter;
 	}
-	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
-		decision_vector dummy_x;
-		for(unsigned int i = start_count_iter; i <= count_iter; i++){
-			// Case 1: Current racer has previous data that can be reused, no
-			// need to be evaluated with this seed
-			if(m_use_caching && cache_data_exist(*it, i-1)){
-				m_pop_wilcoxon.push_back_noeval(dummy_x);
-				const eval_data& cached_data = cache_get_entry(*it, i-1);
-				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, cached_data.f, cached_data.c);
-			}
-			// Case 2: No previous data can be reused, perform actual
-			// re-evaluation and update the cache
-			else{
-				count_nfes++;
-				const population::individual_type &ind = m_pop.get_individual(*it);
-				fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-				constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-				m_pop_wilcoxon.push_back_noeval(dummy_x);
-				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, f_vec, c_vec);
-				if(m_use_caching)
-					cache_insert_data(*it, f_vec, c_vec);
-			}
-		}
+	unsigned int count_nfes = cache_fill(in_race, count_iter - 1);
+	for(unsigned int i = start_count_iter; i <= count_iter; i++){
+		const eval_data &data_a = cache_get_entry(in_race[0], i-1);
+		const eval_data &data_b = cache_get_entry(in_race[1], i-1);
+		wstats.add(data_a.f, data_a.c, data_b.f, data_b.c);
 	}
 	return count_nfes;
 }
@@ -251,8 +497,8 @@ unsigned int race_pop::compute_required_fevals(const std::vector<population::siz
 {
 	unsigned int required_fevals = 0;
 	for(unsigned int i = 0; i < in_race.size(); i++){
-		if(!cache_data_exist(in_race[i], num_iter-1)){
-			required_fevals++;	
+		if(!cache_data_known(in_race[i], num_iter-1)){
+			required_fevals++;
 		}
 	}
 	return required_fevals;
@@ -355,6 +601,10 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 		}
 	}
 
+	// Make sure the seeds of the first trials are known, so that the
+	// evaluations available in the store can be accounted for
+	get_current_seed(min_trials);
+
 	if(term_cond == MAX_BUDGET){
 		// d - Check if the given budget is too small
 		_validate_budget(min_trials, max_f_evals, in_race);		
@@ -371,9 +621,15 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 		n_final_best = N_begin - n_final;
 	}
 
-	// Reset data holder for wilcoxon test
-	m_pop_wilcoxon.clear();
+	// Rank statistics, updated incrementally at each iteration
+	friedman_stats fstats(m_pop.size());
+	wilcoxon_stats wstats(m_pop.problem());
 	bool use_wilcoxon = false;
+	for(size_type i = 0; i < racers.size(); i++){
+		if(!racers[i].active){
+			fstats.drop(i);
+		}
+	}
 
 	unsigned int count_iter = 0;
 	unsigned int count_nfes = 0;
@@ -381,6 +637,20 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 	// The stochastic problem's seed will be changed using a pre-determined sequence
 	unsigned int seed_idx = 0;
 
+	// Threads evaluating the racers, stopped when leaving this function
+	struct pool_guard
+	{
+		explicit pool_guard(boost::shared_ptr<eval_pool> &pool): m_pool(pool) {}
+		~pool_guard()
+		{
+			m_pool.reset();
+		}
+		boost::shared_ptr<eval_pool> &m_pool;
+	} guard(m_pool);
+	if(m_eval_threads > 1){
+		m_pool.reset(new eval_pool(m_pop.problem(), m_eval_threads - 1));
+	}
+
 	// Start of the main loop. It will stop as soon as we have decided enough winners or
 	// discarded enough losers
 	while(decided.size() < n_final_best && decided.size() + in_race.size() > n_final_best){
@@ -402,6 +672,8 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 			print_cache_stats(in_race);
 		}
 		
+		unsigned int cur_seed = get_current_seed(seed_idx++);
+
 		if(term_cond == MAX_BUDGET){
 			// Check if there is enough budget for evaluating the individuals in the race 
 			unsigned int required_fevals = compute_required_fevals(in_race, count_iter);
@@ -417,7 +689,6 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 			}
 		}
 
-		unsigned int cur_seed = get_current_seed(seed_idx++);
 		dynamic_cast<const pagmo::problem::base_stochastic &>(m_pop.problem()).set_seed(cur_seed);
 
 		// NOTE: Here after resetting to a new seed, we do not perform
@@ -435,14 +706,20 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 		stat_test_result ss_result;
 		if(use_wilcoxon && in_race.size() == 2){
 			// Perform Wilcoxon rank-sum test
-			count_nfes += prepare_population_wilcoxon(in_race, count_iter);
-			ss_result = wilcoxon_ranksum_test(racers, in_race, m_pop_wilcoxon, delta);
+			count_nfes += prepare_population_wilcoxon(in_race, count_iter, wstats);
+			for(unsigned int i = 0; i < 2; i++){
+				racers[in_race[i]].m_mean = wstats.mean_rank(i);
+			}
+			ss_result = wstats.test(delta);
 		}
 		else{
 			// Perform Friedman test
 			count_nfes += prepare_population_friedman(in_race, count_iter);
-			ss_result = friedman_test(racers, in_race, m_pop, delta);
-
+			fstats.add_block(in_race, block_ranks(m_pop, in_race));
+			for(unsigned int i = 0; i < in_race.size(); i++){
+				racers[in_race[i]].m_mean = fstats.mean_rank(in_race[i]);
+			}
+			ss_result = fstats.test(in_race, delta);
 		}
 
 		if(count_iter < min_trials)
@@ -499,9 +776,18 @@ std::pair<std::vector<population::size_type>, unsigned int> race_pop::run(
 
 			in_race = new_in_race;
 
-			// Check if this is that important
-			if(!use_wilcoxon || in_race.size() > 2){
-				f_race_adjust_ranks(racers, out_of_race);
+			// Pending evaluations of the racers out of the race are not needed anymore
+			for(unsigned int i = 0; m_pool && i < out_of_race.size(); i++){
+				m_pool->cancel(out_of_race[i]);
+			}
+
+			// Ranks of the remaining racers, as if the racers out of the
+			// race had never taken part to it
+			for(unsigned int i = 0; i < out_of_race.size(); i++){
+				fstats.drop(out_of_race[i]);
+			}
+			for(unsigned int i = 0; (!use_wilcoxon || in_race.size() > 2) && i < in_race.size(); i++){
+				racers[in_race[i]].m_mean = fstats.mean_rank(in_race[i]);
 			}
 		}
 
@@ -556,7 +842,18 @@ std::vector<fitness_vector> race_pop::get_mean_fitness(const std::vector<populat
 }
 
 /// Clear all the cache
+/**
+ * This also clears the store of the evaluations, which is shared with other
+ * race_pop objects if share_memory() was called.
+ */
 void race_pop::reset_cache()
+{
+	cache_clear_local();
+	m_store->clear();
+}
+
+// Clear the evaluation data of the individuals of the registered population
+void race_pop::cache_clear_local()
 {
 	for(unsigned int i = 0; i < m_cache_data.size(); i++){
 		m_cache_data[i].clear();
@@ -576,7 +873,11 @@ void race_pop::cache_insert_data(unsigned int key_idx, const fitness_vector &f,
 	if(key_idx >= m_cache_data.size()){
 		pagmo_throw(index_error, "cache_insert_data: Invalid key index");
 	}
+	const unsigned int data_location = m_cache_data[key_idx].size();
 	m_cache_data[key_idx].push_back(eval_data(f,c));
+	if(data_location < m_seeds.size()){
+		m_store->insert(m_cache_signatures[key_idx], m_seeds[data_location], m_cache_data[key_idx].back());
+	}
 	// Update the averaged data to be returned upon each race call
 	if(m_cache_data[key_idx].size() == 1){
 		m_cache_averaged_data[key_idx] = m_cache_data[key_idx].back();
@@ -621,6 +922,90 @@ bool race_pop::cache_data_exist(unsigned int key_idx, unsigned int data_location
 	return false;
 }
 
+// Check if the data point is either in the cache or in the store
+bool race_pop::cache_data_known(unsigned int key_idx, unsigned int data_location) const
+{
+	if(cache_data_exist(key_idx, data_location)){
+		return true;
+	}
+	return data_location < m_seeds.size() && m_store->find(m_cache_signatures[key_idx], m_seeds[data_location]);
+}
+
+// Append to the cache of an individual the consecutive data points found in the store
+void race_pop::cache_pull(unsigned int key_idx)
+{
+	const eval_data *data;
+	while(m_cache_data[key_idx].size() < m_seeds.size() &&
+		(data = m_store->find(m_cache_signatures[key_idx], m_seeds[m_cache_data[key_idx].size()]))){
+		// Copy, as the insertion could evict the data point from the store
+		const eval_data tmp(*data);
+		cache_insert_data(key_idx, tmp.f, tmp.c);
+	}
+}
+
+/// Make sure the cache holds the first data_location + 1 data points of the racers
+/**
+ * Data points are first looked up in the store. The missing ones are then
+ * evaluated, once for each distinct decision vector and seed, either directly
+ * or through the evaluation pool.
+ *
+ * @return The number of evaluations performed
+ */
+unsigned int race_pop::cache_fill(const std::vector<population::size_type> &in_race, unsigned int data_location)
+{
+	typedef boost::unordered_map<trial_store::key_type, unsigned int, boost::hash<trial_store::key_type> > job_map_type;
+	get_current_seed(data_location + m_lookahead);
+	std::vector<const decision_vector *> job_x;
+	std::vector<unsigned int> job_seed;
+	job_map_type job_idx;
+	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it){
+		cache_pull(*it);
+		for(unsigned int k = m_cache_data[*it].size(); k <= data_location; k++){
+			const trial_store::key_type key(m_cache_signatures[*it], m_seeds[k]);
+			if(job_idx.insert(std::make_pair(key, (unsigned int)job_x.size())).second){
+				job_x.push_back(&m_cache_signatures[*it]);
+				job_seed.push_back(m_seeds[k]);
+			}
+			if(m_pool){
+				m_pool->request(m_cache_signatures[*it], m_seeds[k], k, *it);
+			}
+		}
+	}
+	// Speculative requests for the next rounds
+	for(unsigned int k = data_location + 1; m_pool && k <= data_location + m_lookahead; k++){
+		for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it){
+			if(!m_store->find(m_cache_signatures[*it], m_seeds[k])){
+				m_pool->request(m_cache_signatures[*it], m_seeds[k], k, *it);
+			}
+		}
+	}
+
+	std::vector<eval_data> results(job_x.size());
+	for(std::vector<eval_data>::size_type i = 0; i < results.size(); i++){
+		if(m_pool){
+			results[i] = m_pool->get(m_pop.problem(), *job_x[i], job_seed[i]);
+		}
+		else{
+			results[i] = evaluate(m_pop.problem(), *job_x[i], job_seed[i]);
+		}
+	}
+
+	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it){
+		for(unsigned int k = m_cache_data[*it].size(); k <= data_location; k++){
+			const eval_data &data = results[job_idx.find(trial_store::key_type(m_cache_signatures[*it], m_seeds[k]))->second];
+			cache_insert_data(*it, data.f, data.c);
+		}
+	}
+	return job_x.size();
+}
+
+// Evaluate x on the stochastic problem prob under the given seed
+race_pop::eval_data race_pop::evaluate(const problem::base &prob, const decision_vector &x, unsigned int seed)
+{
+	dynamic_cast<const problem::base_stochastic &>(prob).set_seed(seed);
+	return eval_data(prob.objfun(x), prob.compute_constraints(x));
+}
+
 /// Get a const reference to a data point
 const race_pop::eval_data &race_pop::cache_get_entry(unsigned int key_idx, unsigned int data_location) const
 {
@@ -648,7 +1033,7 @@ void race_pop::cache_register_signatures(const population& pop)
 /// Inherits the memory of another race_pop object
 /** If compatible, inherits past evaluation data from another race_pop object.
  * Useful in scenarios when racing individuals in a cross
- * generation setting.
+ * generation setting. The inherited data is also added to the store.
 */
 void race_pop::inherit_memory(const race_pop& src)
 {
@@ -656,24 +1041,110 @@ void race_pop::inherit_memory(const race_pop& src)
 	if(src.m_race_seed != m_race_seed){
 		pagmo_throw(value_error, "Incompatible seed in inherit_memory");
 	}
-	std::map<decision_vector, unsigned int> src_cache_locations;
+	boost::unordered_map<decision_vector, unsigned int, boost::hash<decision_vector> > src_cache_locations;
 	for(unsigned int i = 0; i < src.m_cache_data.size(); i++){
 		src_cache_locations.insert(std::make_pair(src.m_cache_signatures[i], i));
 	}
-	int cnt_transferred = 0;
 	for(unsigned int i = 0; i < m_cache_data.size(); i++){
-		std::map<decision_vector, unsigned int>::iterator it
+		boost::unordered_map<decision_vector, unsigned int, boost::hash<decision_vector> >::const_iterator it
 			= src_cache_locations.find(m_cache_signatures[i]);
 		if(it != src_cache_locations.end()){
 			if(src.m_cache_data[it->second].size() > m_cache_data[i].size()){
 				m_cache_data[i] = src.m_cache_data[it->second];
 				m_cache_averaged_data[i] = src.m_cache_averaged_data[it->second];
-				cnt_transferred++;
+				for(unsigned int k = 0; k < m_cache_data[i].size() && k < src.m_seeds.size(); k++){
+					m_store->insert(m_cache_signatures[i], src.m_seeds[k], m_cache_data[i][k]);
+				}
 			}
 		}
 	}
 }
 
+/// Shares the store of the evaluations with another race_pop object
+/**
+ * After this call, evaluations made by either object are available to both,
+ * whenever they race the same individuals under the same seeds, as it happens
+ * for objects constructed with the same racing seed. The current store of
+ * this object is discarded.
+ *
+ * @param[in] src race_pop whose store is to be shared
+ *
+ * @throws value_error if the two objects race on different problems
+ */
+void race_pop::share_memory(const race_pop &src)
+{
+	if(m_pop_registered && src.m_store->m_problem && !same_problem(*src.m_store->m_problem, m_pop.problem())){
+		pagmo_throw(value_error, "Cannot share the memory of races on different problems");
+	}
+	m_store = src.m_store;
+	if(!m_store->m_problem && m_pop_registered){
+		m_store->m_problem = m_pop.problem().clone();
+	}
+	for(unsigned int i = 0; i < m_cache_data.size(); i++){
+		cache_pull(i);
+	}
+}
+
+/// Sets the capacity of the store of the evaluations
+/**
+ * The store keeps at most this number of evaluations, evicting the oldest
+ * ones first. A capacity of zero disables the store, so that evaluations are
+ * only reused within the registered population.
+ *
+ * @param[in] capacity maximum number of stored evaluations
+ */
+void race_pop::set_cache_capacity(unsigned int capacity)
+{
+	m_store->set_capacity(capacity);
+}
+
+/// Gets the capacity of the store of the evaluations
+unsigned int race_pop::get_cache_capacity() const
+{
+	return m_store->get_capacity();
+}
+
+/// Sets the number of threads evaluating a racing round
+/**
+ * Each extra thread evaluates on its own copy of the problem. Results do not
+ * depend on the number of threads.
+ *
+ * @param[in] n number of threads
+ *
+ * @throws value_error if n is zero
+ */
+void race_pop::set_eval_threads(unsigned int n)
+{
+	if(n == 0){
+		pagmo_throw(value_error, "The number of threads must be positive");
+	}
+	m_eval_threads = n;
+}
+
+/// Gets the number of threads evaluating a racing round
+unsigned int race_pop::get_eval_threads() const
+{
+	return m_eval_threads;
+}
+
+/// Sets the number of rounds evaluated in advance
+/**
+ * When several threads are set, the racers still in the race are also
+ * evaluated for the next n rounds, whenever a thread is idle. Evaluations
+ * for the racers leaving the race are cancelled if not started yet.
+ *
+ * @param[in] n number of rounds evaluated in advance
+ */
+void race_pop::set_lookahead(unsigned int n)
+{
+	m_lookahead = n;
+}
+
+/// Gets the number of rounds evaluated in advance
+unsigned int race_pop::get_lookahead() const
+{
+	return m_lookahead;
+}
 
 /// Print some stats about the cache, for debugging purposes
 void race_pop::print_cache_stats(const std::vector<population::size_type> &in_race) const
@@ -697,7 +1168,7 @@ void race_pop::set_seed(unsigned int seed)
 	m_race_seed = seed;
 	m_seeder.seed(seed);
 	m_seeds.clear();
-	reset_cache();
+	cache_clear_local();
 }
 
 // Produce new seeds and append to the list of seeds
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "../config.h"
 #include "../serialization.h"
@@ -53,6 +54,21 @@ namespace racing{
  * individuals.  The caching mechanism ensures that all the data points that
  * are compared during the race correspond to the same seed.
  *
+ * Evaluations are also recorded in a hashed store indexed by decision vector
+ * and problem seed, which can be shared among several race_pop objects racing
+ * on the same problem (see share_memory()). Since all racers are evaluated
+ * with the same sequence of seeds (common random numbers), any individual
+ * appearing again in a later race, or twice in the same race, reuses its past
+ * evaluations. The size of the store is bounded (see set_cache_capacity()),
+ * and the evaluations needed by a racing round can be spread over several
+ * threads (see set_eval_threads()).
+ *
+ * When evaluating on several threads, idle threads can speculatively evaluate
+ * the racers still in the race for the next few rounds (see set_lookahead()).
+ * The pending evaluations of a racer are cancelled as soon as it leaves the
+ * race. Speculative evaluations which are not used by the race are discarded,
+ * so that the outcome of a race never depends on the number of threads.
+ *
  * Currently the racing is implemented based on F-Race, which invokes Friedman
  * test iteratively during each race.
  *
@@ -63,6 +79,8 @@ public:
 
 	race_pop(const population &, unsigned int seed = 0);
 	race_pop(unsigned int seed = 0);
+	race_pop(const race_pop &);
+	race_pop &operator=(const race_pop &);
 
 	/// Method to stop the race
 	enum termination_condition { 
@@ -88,6 +106,13 @@ public:
 	void inherit_memory(const race_pop&);
 	std::vector<fitness_vector> get_mean_fitness(const std::vector<population::size_type> &active_set = std::vector<population::size_type>()) const;
 	void set_seed(unsigned int);
+	void share_memory(const race_pop &);
+	void set_cache_capacity(unsigned int);
+	unsigned int get_cache_capacity() const;
+	void set_eval_threads(unsigned int);
+	unsigned int get_eval_threads() const;
+	void set_lookahead(unsigned int);
+	unsigned int get_lookahead() const;
 
 private:
 	// Helper methods to validate input data
@@ -97,7 +122,7 @@ private:
 	void _validate_budget(const unsigned int min_trials, const unsigned int max_f_evals, const std::vector<population::size_type>& in_race) const;
 
 	unsigned int prepare_population_friedman(const std::vector<population::size_type> &in_race, unsigned int count_iter);
-	unsigned int prepare_population_wilcoxon(const std::vector<population::size_type> &in_race, unsigned int count_iter);
+	unsigned int prepare_population_wilcoxon(const std::vector<population::size_type> &in_race, unsigned int count_iter, wilcoxon_stats &wstats);
 
 	unsigned int compute_required_fevals(const std::vector<population::size_type>& in_race, unsigned int num_iter) const;
 
@@ -117,7 +142,17 @@ private:
 			const population::size_type n_final,
 			const bool race_best);
 
+	// Shared store of the evaluations
+	class trial_store;
+	// Pool of threads evaluating the racers during a race
+	class eval_pool;
+	static eval_data evaluate(const problem::base &, const decision_vector &, unsigned int);
+
 	// Caching routines
+	unsigned int cache_fill(const std::vector<population::size_type> &, unsigned int);
+	bool cache_data_known(unsigned int, unsigned int) const;
+	void cache_clear_local();
+	void cache_pull(unsigned int);
 	void cache_insert_data(unsigned int, const fitness_vector &, const constraint_vector &);
 	void cache_delete_entry(unsigned int);
 	bool cache_data_exist(unsigned int, unsigned int) const;
@@ -132,14 +167,16 @@ private:
 
 	// Data members
 	racing_population m_pop;
-	racing_population m_pop_wilcoxon;
 	bool m_pop_registered;
 	std::vector<unsigned int> m_seeds;
 	rng_uint32 m_seeder;
-	bool m_use_caching;
 	std::vector<std::vector<eval_data> > m_cache_data;
 	std::vector<eval_data> m_cache_averaged_data;
 	std::vector<decision_vector> m_cache_signatures;
+	boost::shared_ptr<trial_store> m_store;
+	unsigned int m_eval_threads;
+	unsigned int m_lookahead;
+	boost::shared_ptr<eval_pool> m_pool;
 };
 
 }}}
@@ -5,6 +5,7 @@
 #include <boost/math/distributions/students_t.hpp>
 #include <boost/math/distributions/normal.hpp>
 
+#include <algorithm>
 #include <utility>
 
 namespace pagmo{ namespace util{
@@ -155,7 +156,7 @@ std::vector<double> racing_population::get_rankings() const
 		// Single-objective case
 		population::trivial_comparison_operator comparator(*this);
 		for(size_type i = 0; i < size() - 1; i++){	
-			if (!comparator(i, i+1) && !comparator(i+1, i)){
+			if (!comparator(raw_order[i], raw_order[i+1]) && !comparator(raw_order[i+1], raw_order[i])){
 				tied[i] = true;
 			}
 		}
@@ -164,7 +165,7 @@ std::vector<double> racing_population::get_rankings() const
 		// Multi-objective case
 		population::crowded_comparison_operator comparator(*this);
 		for(size_type i = 0; i < size() - 1; i++){	
-			if (!comparator(i, i+1) && !comparator(i+1, i)){
+			if (!comparator(raw_order[i], raw_order[i+1]) && !comparator(raw_order[i+1], raw_order[i])){
 				tied[i] = true;
 			}
 		}
@@ -185,10 +186,11 @@ std::vector<double> racing_population::get_rankings() const
 
 		double avg_rank = 0;
 		for(size_type i = begin_avg_pos; i <= cur_pos; i++){
-			avg_rank += rankings[i] / ((double)cur_pos - begin_avg_pos + 1);
+			avg_rank += rankings[raw_order[i]];
 		}
+		avg_rank /= (double)cur_pos - begin_avg_pos + 1;
 		for(size_type i = begin_avg_pos; i <= cur_pos; i++){
-			rankings[i] = avg_rank;
+			rankings[raw_order[i]] = avg_rank;
 		}
 
 		// If no tie at all for this begin pos
@@ -275,49 +277,14 @@ void f_race_adjust_ranks(std::vector<racer_type>& racers, const std::vector<popu
 	}
 }
 
-/// Perform a Friedman test
-/**
- * Friedman test has the following procedures:
- * (1) Check if the null hypothesis that all rakings of the treatments are
- *     equivalent can be rejected. This involves the use of a chi-squared
- *     distribution.
- * (2) If so, perform pair-wise comparison betwen the treatments based on
- *     rank sum. This can be achieved by using a t-distribution.
- *
- * @param[in] X Observation data, each element (vector) represents the measurements for each "treatment"
- * @param[in] delta Confidence level for the statistical test
- *
- * @return Result of the statistical test 
- *
- */
-stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X, double delta)
-{	
-	pagmo_assert(X.size() > 0);
-	
-	unsigned int N = X.size(); // # of different configurations
-	unsigned int B = X[0].size(); // # of different instances
-
-	// Compute mean rank
-	std::vector<double> X_mean(N, 0);
-	for(unsigned int i = 0; i < N; i++){
-		for(unsigned int j = 0; j < X[i].size(); j++){
-			X_mean[i] += X[i][j];
-		}
-		X_mean[i] /= (double)X[i].size();
-	}
+// Friedman test from the rank sums R of the N treatments over B blocks, and
+// the sum A1 of the squared ranks
+static stat_test_result friedman_test_from_sums(const std::vector<double> &R, double A1, unsigned int B, double delta)
+{
+	unsigned int N = R.size(); // # of different configurations
 
-	// Fill in R and T
-	std::vector<double> R(N, 0);
-	double A1 = 0;
 	double C1 = B * N * (N+1) * (N+1) / 4.0;
 
-	for(unsigned int i = 0; i < N; i++){
-		for(unsigned int j = 0; j < B; j++){
-			R[i] += X[i][j];
-			A1 += (X[i][j])*(X[i][j]);
-		}
-	}
-
 	double T1 = 0;
 	for(unsigned int i = 0; i < N; i++){
 		T1 += ((R[i] - B*(N+1)/2.0) * (R[i] - B*(N+1)/2.0));
@@ -353,11 +320,12 @@ stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X,
 			for(unsigned int j = i + 1; j < N; j++){
 				double diff_r = fabs(R[i] - R[j]);
 				// Check if a pair is statistically significantly different
+				// (mean ranks compare as the rank sums)
 				if(diff_r > t_delta2_quantile * Q){
-					if(X_mean[i] < X_mean[j]){
+					if(R[i] < R[j]){
 						is_better[i][j] = true;
 					}
-					if(X_mean[j] < X_mean[i]){
+					if(R[j] < R[i]){
 						is_better[j][i] = true;
 					}
 				}
@@ -366,7 +334,41 @@ stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X,
 	}
 
 	return res;
+}
 
+/// Perform a Friedman test
+/**
+ * Friedman test has the following procedures:
+ * (1) Check if the null hypothesis that all rakings of the treatments are
+ *     equivalent can be rejected. This involves the use of a chi-squared
+ *     distribution.
+ * (2) If so, perform pair-wise comparison betwen the treatments based on
+ *     rank sum. This can be achieved by using a t-distribution.
+ *
+ * @param[in] X Observation data, each element (vector) represents the measurements for each "treatment"
+ * @param[in] delta Confidence level for the statistical test
+ *
+ * @return Result of the statistical test 
+ *
+ */
+stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X, double delta)
+{	
+	pagmo_assert(X.size() > 0);
+	
+	unsigned int N = X.size(); // # of different configurations
+	unsigned int B = X[0].size(); // # of different instances
+
+	// Fill in R and A1
+	std::vector<double> R(N, 0);
+	double A1 = 0;
+	for(unsigned int i = 0; i < N; i++){
+		for(unsigned int j = 0; j < B; j++){
+			R[i] += X[i][j];
+			A1 += (X[i][j])*(X[i][j]);
+		}
+	}
+
+	return friedman_test_from_sums(R, A1, B, delta);
 }
 
 /// Returns the pair-wise statistical testing results based on Friedman Test
@@ -457,6 +459,8 @@ double wilcoxon_frequency( double u, int sampleSizeA, int sampleSizeB )
 	return( wilcoxon_frequency( u - sampleSizeB, sampleSizeA - 1, sampleSizeB ) + wilcoxon_frequency( u, sampleSizeA, sampleSizeB - 1 ) );
 }
 
+static stat_test_result wilcoxon_test_from_sums(const std::vector<double> &, int, int, double);
+
 // Performs Wilcoxon Rank Sum Test (a.k.a.Wilcoxon–Mann–Whitney test)
 // Intended to be used when the number of active racers is only two, as it has
 // been reported that under such circumstances this test is more data efficient
@@ -476,11 +480,16 @@ stat_test_result core_wilcoxon_ranksum_test(const std::vector<std::vector<double
 		}
 	}
 
+	return wilcoxon_test_from_sums(rank_sum, X[0].size(), X[1].size(), delta);
+}
+
+// Wilcoxon rank-sum test from the rank sums of the two samples in the pooled
+// ranking, and the sizes of the samples
+static stat_test_result wilcoxon_test_from_sums(const std::vector<double> &rank_sum, int sizeA, int sizeB, double delta)
+{
 	// Fill in pair-wise comparison results
-	stat_test_result res(N);
+	stat_test_result res(2);
 
-	int sizeA = X[0].size();
-	int sizeB = X[1].size();
 	if(sizeA < 12 && sizeB < 12){
 		// Cannot use normal approximation for the rank-sum statistic when
 		// sample size is small. Boost does not have the required Wilcoxon
@@ -505,8 +514,8 @@ stat_test_result core_wilcoxon_ranksum_test(const std::vector<std::vector<double
 	else{
 		// Use the normal approximation
 		using boost::math::normal;
-		int n1 = X[0].size();
-		int n2 = X[1].size();
+		int n1 = sizeA;
+		int n2 = sizeB;
 		normal normal_dist(n1*n2/2, sqrt(n1*n2*(n1+n2+1.0)/12.0));
 		double delta_quantile_upp = quantile(normal_dist, 1 - delta);
 		if(rank_sum[0] > rank_sum[1] && rank_sum[0] > delta_quantile_upp){
@@ -522,6 +531,290 @@ stat_test_result core_wilcoxon_ranksum_test(const std::vector<std::vector<double
 	return res;
 }
 
+// Compares the individuals in_race[i1] and in_race[i2] of a population
+struct block_ranks_comparator
+{
+	block_ranks_comparator(const racing_population &pop, const std::vector<population::size_type> &in_race): m_pop(pop), m_in_race(in_race) {}
+	bool operator()(population::size_type i1, population::size_type i2) const
+	{
+		const population::individual_type &ind1 = m_pop.get_individual(m_in_race[i1]), &ind2 = m_pop.get_individual(m_in_race[i2]);
+		return m_pop.problem().compare_fc(ind1.cur_f, ind1.cur_c, ind2.cur_f, ind2.cur_c);
+	}
+	const racing_population &m_pop;
+	const std::vector<population::size_type> &m_in_race;
+};
+
+/// Ranks of some individuals of a population
+/**
+ * Ranks as in racing_population::get_rankings(), computed only among the
+ * individuals in in_race.
+ *
+ * @param[in] pop Population storing the evaluations of the individuals
+ * @param[in] in_race Indices of the individuals to be ranked
+ *
+ * @return The ranks of the individuals, aligned with in_race
+ */
+std::vector<double> block_ranks(const racing_population &pop, const std::vector<population::size_type> &in_race)
+{
+	typedef population::size_type size_type;
+	std::vector<double> ranks(in_race.size());
+	if(in_race.empty()){
+		return ranks;
+	}
+	if(pop.problem().get_f_dimension() > 1){
+		// Ranking based on Pareto fronts and crowding, requires the whole set
+		racing_population racing_pop(pop.problem());
+		decision_vector dummy_x(pop.problem().get_dimension(), 0);
+		for(size_type i = 0; i < in_race.size(); i++){
+			racing_pop.push_back_noeval(dummy_x);
+			racing_pop.set_fc(i, pop.get_individual(in_race[i]).cur_f, pop.get_individual(in_race[i]).cur_c);
+		}
+		return racing_pop.get_rankings();
+	}
+	// Single-objective: sort and average the ranks of the tied individuals
+	std::vector<size_type> order(in_race.size());
+	for(size_type i = 0; i < order.size(); i++){
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), block_ranks_comparator(pop, in_race));
+	const block_ranks_comparator better(pop, in_race);
+	size_type begin = 0;
+	while(begin < order.size()){
+		size_type end = begin + 1;
+		while(end < order.size() && !better(order[end - 1], order[end])){
+			end++;
+		}
+		for(size_type i = begin; i < end; i++){
+			ranks[order[i]] = (begin + end + 1) / 2.0;
+		}
+		begin = end;
+	}
+	return ranks;
+}
+
+/// Constructor
+/**
+ * @param[in] n_racers Number of racers, all of them initially in the race
+ */
+friedman_stats::friedman_stats(population::size_type n_racers): m_pairwise(n_racers, std::vector<double>(n_racers, 0)),
+	m_rank_sum(n_racers, 0), m_active(n_racers, true), m_blocks(0), m_tie_correction(0)
+{
+}
+
+/// Adds a block of observations
+/**
+ * @param[in] racers Indices of the racers in the race, all of them must be observed
+ * @param[in] ranks Ranks of the racers in the block, aligned with racers
+ *
+ * @throws value_error if the racers are not those in the race
+ */
+void friedman_stats::add_block(const std::vector<population::size_type> &racers, const std::vector<double> &ranks)
+{
+	if(racers.size() != ranks.size() || racers.size() != (std::size_t)std::count(m_active.begin(), m_active.end(), true)){
+		pagmo_throw(value_error, "A block must contain the ranks of all the racers in the race");
+	}
+	for(std::vector<population::size_type>::size_type i = 0; i < racers.size(); i++){
+		if(racers[i] >= m_active.size() || !m_active[racers[i]]){
+			pagmo_throw(value_error, "A block must contain the ranks of all the racers in the race");
+		}
+		m_rank_sum[racers[i]] += ranks[i];
+		for(std::vector<population::size_type>::size_type k = 0; k < racers.size(); k++){
+			if(ranks[k] < ranks[i]){
+				m_pairwise[racers[i]][racers[k]] += 1;
+			}
+			else if(k != i && ranks[k] == ranks[i]){
+				m_pairwise[racers[i]][racers[k]] += 0.5;
+			}
+		}
+	}
+	// Record the groups of tied racers
+	std::vector<bool> grouped(racers.size(), false);
+	for(std::vector<population::size_type>::size_type i = 0; i < racers.size(); i++){
+		if(grouped[i]){
+			continue;
+		}
+		std::vector<population::size_type> group(1, racers[i]);
+		for(std::vector<population::size_type>::size_type k = i + 1; k < racers.size(); k++){
+			if(ranks[k] == ranks[i]){
+				group.push_back(racers[k]);
+				grouped[k] = true;
+			}
+		}
+		if(group.size() > 1){
+			const double t = group.size();
+			m_tie_correction += t * t * t - t;
+			m_ties.push_back(group);
+		}
+	}
+	m_blocks++;
+}
+
+/// Removes a racer from the race
+/**
+ * The ranks of the other racers in all the past blocks are updated as if
+ * the racer had never taken part to the race.
+ *
+ * @param[in] racer Index of the racer to be removed
+ */
+void friedman_stats::drop(population::size_type racer)
+{
+	if(racer >= m_active.size() || !m_active[racer]){
+		return;
+	}
+	m_active[racer] = false;
+	for(population::size_type i = 0; i < m_active.size(); i++){
+		if(m_active[i]){
+			m_rank_sum[i] -= m_pairwise[i][racer];
+		}
+	}
+	for(std::vector<std::vector<population::size_type> >::size_type g = 0; g < m_ties.size(); g++){
+		std::vector<population::size_type> &group = m_ties[g];
+		const std::vector<population::size_type>::iterator it = std::find(group.begin(), group.end(), racer);
+		if(it != group.end()){
+			const double t = group.size();
+			m_tie_correction -= 3 * t * (t - 1);
+			group.erase(it);
+		}
+	}
+}
+
+/// Mean rank of a racer
+double friedman_stats::mean_rank(population::size_type racer) const
+{
+	return m_blocks ? m_rank_sum[racer] / m_blocks : 0.;
+}
+
+/// Number of blocks of observations
+unsigned int friedman_stats::n_blocks() const
+{
+	return m_blocks;
+}
+
+/// Friedman test on the racers in the race
+/**
+ * @param[in] in_race Indices of the racers in the race
+ * @param[in] delta Confidence level for the statistical test
+ *
+ * @return Result of the statistical test, aligned with in_race
+ */
+stat_test_result friedman_stats::test(const std::vector<population::size_type> &in_race, double delta) const
+{
+	pagmo_assert(in_race.size() > 0);
+	const double N = in_race.size();
+	std::vector<double> R(in_race.size());
+	for(std::vector<population::size_type>::size_type i = 0; i < in_race.size(); i++){
+		R[i] = m_rank_sum[in_race[i]];
+	}
+	// Sum of the squared ranks: that of a permutation of 1..N in each block,
+	// corrected for the ties
+	const double A1 = m_blocks * N * (N + 1) * (2 * N + 1) / 6.0 - m_tie_correction / 12.0;
+	return friedman_test_from_sums(R, A1, m_blocks, delta);
+}
+
+/// Constructor
+/**
+ * @param[in] prob Problem used to compare the observations
+ */
+wilcoxon_stats::wilcoxon_stats(const problem::base &prob): m_prob(prob.clone()), m_u(0)
+{
+}
+
+// Number of observations in the sorted obs better than o, ties counting one half
+double wilcoxon_stats::count_better(const std::vector<observation> &obs, const observation &o) const
+{
+	const better_than better(*m_prob);
+	const std::vector<observation>::const_iterator lb = std::lower_bound(obs.begin(), obs.end(), o, better);
+	const std::vector<observation>::const_iterator ub = std::upper_bound(lb, obs.end(), o, better);
+	return (lb - obs.begin()) + (ub - lb) / 2.0;
+}
+
+// Number of observations in obs worse than o, ties counting one half
+double wilcoxon_stats::count_worse(const std::vector<observation> &obs, const observation &o) const
+{
+	return obs.size() - count_better(obs, o);
+}
+
+/// Adds an observation of each racer
+/**
+ * @param[in] f1 Fitness vector of the first racer
+ * @param[in] c1 Constraint vector of the first racer
+ * @param[in] f2 Fitness vector of the second racer
+ * @param[in] c2 Constraint vector of the second racer
+ */
+void wilcoxon_stats::add(const fitness_vector &f1, const constraint_vector &c1, const fitness_vector &f2, const constraint_vector &c2)
+{
+	const better_than better(*m_prob);
+	const observation o1(f1, c1), o2(f2, c2);
+	if(m_prob->get_f_dimension() > 1){
+		// Ranking based on Pareto fronts and crowding, which is not a pairwise
+		// relation: the pooled observations are ranked again
+		m_obs[0].push_back(o1);
+		m_obs[1].push_back(o2);
+		update_pooled();
+		return;
+	}
+	m_u += count_better(m_obs[1], o1);
+	m_obs[0].insert(std::upper_bound(m_obs[0].begin(), m_obs[0].end(), o1, better), o1);
+	m_u += count_worse(m_obs[0], o2);
+	m_obs[1].insert(std::upper_bound(m_obs[1].begin(), m_obs[1].end(), o2, better), o2);
+}
+
+// Recomputes the statistic from the pooled ranking of racing_population::get_rankings()
+void wilcoxon_stats::update_pooled()
+{
+	racing_population pool(*m_prob);
+	const decision_vector dummy_x(m_prob->get_dimension(), 0);
+	// The crowding distance of duplicated points depends on their order: the
+	// observations are pooled in the order they were made
+	for(std::vector<observation>::size_type j = 0; j < m_obs[0].size(); j++){
+		for(unsigned int i = 0; i < 2; i++){
+			pool.push_back_noeval(dummy_x);
+			pool.set_fc(pool.size() - 1, m_obs[i][j].first, m_obs[i][j].second);
+		}
+	}
+	const std::vector<double> ranks = pool.get_rankings();
+	const double n = size();
+	m_u = -n * (n + 1) / 2.0;
+	for(std::vector<double>::size_type j = 0; j < ranks.size(); j += 2){
+		m_u += ranks[j];
+	}
+}
+
+/// Mean rank of the observations of a racer in the pooled ranking
+/**
+ * @param[in] i Index of the racer (0 or 1)
+ */
+double wilcoxon_stats::mean_rank(unsigned int i) const
+{
+	const double n = size();
+	if(n == 0){
+		return 0.;
+	}
+	// Rank sum of a sample: ranks among its own observations, plus the observations of the other sample ranked before
+	return (n + 1) / 2.0 + (i == 0 ? m_u : n * n - m_u) / n;
+}
+
+/// Number of observations of each racer
+unsigned int wilcoxon_stats::size() const
+{
+	return m_obs[0].size();
+}
+
+/// Wilcoxon rank-sum test on the two racers
+/**
+ * @param[in] delta Confidence level for the statistical test
+ *
+ * @return Result of the statistical test
+ */
+stat_test_result wilcoxon_stats::test(double delta) const
+{
+	const double n = size();
+	std::vector<double> rank_sum(2);
+	rank_sum[0] = n * (n + 1) / 2.0 + m_u;
+	rank_sum[1] = n * (n + 1) / 2.0 + n * n - m_u;
+	return wilcoxon_test_from_sums(rank_sum, size(), size(), delta);
+}
+
 //! @endcond Doxygen comments the following
 
 }}}
@@ -115,6 +115,73 @@ namespace racing{
 
 	stat_test_result core_wilcoxon_ranksum_test(const std::vector<std::vector<double> > &X,
 	                                            double delta);
+
+	std::vector<double> block_ranks(const racing_population &,
+	                                const std::vector<population::size_type> &);
+
+	// Incremental Friedman statistics
+	//
+	// Keeps the rank sums of the racers and the pairwise comparison counts,
+	// updated in O(N^2) for each new block of observations of N racers and in
+	// O(N) for each racer leaving the race, so that a race costs time linear in
+	// the number of blocks. Ranks of the remaining racers are recomputed
+	// exactly (mid-ranks in case of ties) when a racer leaves.
+	class __PAGMO_VISIBLE friedman_stats
+	{
+	public:
+		explicit friedman_stats(population::size_type n_racers = 0);
+		void add_block(const std::vector<population::size_type> &, const std::vector<double> &);
+		void drop(population::size_type);
+		double mean_rank(population::size_type) const;
+		unsigned int n_blocks() const;
+		stat_test_result test(const std::vector<population::size_type> &, double) const;
+	private:
+		// m_pairwise[i][k]: number of blocks where k ranked before i, ties counting one half
+		std::vector<std::vector<double> > m_pairwise;
+		std::vector<double> m_rank_sum;
+		std::vector<bool> m_active;
+		unsigned int m_blocks;
+		// Groups of tied racers, and sum over the groups of t^3 - t
+		std::vector<std::vector<population::size_type> > m_ties;
+		double m_tie_correction;
+	};
+
+	// Incremental Wilcoxon rank-sum statistics for two racers
+	//
+	// Keeps the Mann-Whitney statistic of the observations of the two racers.
+	// Single-objective observations are kept sorted, so that each new
+	// observation is ranked by binary search. Multi-objective observations are
+	// ranked by Pareto front and crowding over the whole pool, as by
+	// racing_population::get_rankings(), which is recomputed at each addition.
+	class __PAGMO_VISIBLE wilcoxon_stats
+	{
+	public:
+		explicit wilcoxon_stats(const problem::base &);
+		void add(const fitness_vector &, const constraint_vector &, const fitness_vector &, const constraint_vector &);
+		double mean_rank(unsigned int) const;
+		unsigned int size() const;
+		stat_test_result test(double) const;
+	private:
+		typedef std::pair<fitness_vector, constraint_vector> observation;
+		struct better_than
+		{
+			explicit better_than(const problem::base &prob): m_prob(&prob) {}
+			bool operator()(const observation &o1, const observation &o2) const
+			{
+				return m_prob->compare_fc(o1.first, o1.second, o2.first, o2.second);
+			}
+			const problem::base *m_prob;
+		};
+		double count_better(const std::vector<observation> &, const observation &) const;
+		double count_worse(const std::vector<observation> &, const observation &) const;
+		void update_pooled();
+
+		problem::base_ptr m_prob;
+		std::vector<observation> m_obs[2];
+		// Number of pairs (a,b) where b is better than a, ties counting one half;
+		// for multi-objective problems, derived from the pooled ranking
+		double m_u;
+	};
 }}} //Namespaces
 
 //! @endcond
@@ -0,0 +1,103 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the affine transformation kernels
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "../src/util/affine.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Naive y = M x, M row-major
+void naive_rotate(const std::vector<double> &M, const double *x, double *y, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i) {
+		y[i] = 0;
+		for (std::size_t j = 0; j < n; ++j) {
+			y[i] += M[i * n + j] * x[j];
+		}
+	}
+}
+
+std::vector<double> random_vector(std::size_t n)
+{
+	std::vector<double> v(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		v[i] = 2. * std::rand() / RAND_MAX - 1.;
+	}
+	return v;
+}
+
+int test_kernels(std::size_t n, std::size_t k)
+{
+	const std::vector<double> M(random_vector(n * n)), s(random_vector(n)), X(random_vector(n * k));
+	std::vector<double> y(n), tmp(n), expected(n), Y(n * k), expected_Y(n * k);
+
+	util::affine::shift(&X[0], &s[0], &y[0], n);
+	for (std::size_t i = 0; i < n; ++i) {
+		expected[i] = X[i] - s[i];
+	}
+	if (!is_eq_vector(y, expected)) {
+		std::cout << "shift failed for n = " << n << std::endl;
+		return 1;
+	}
+
+	util::affine::rotate(&M[0], &X[0], &y[0], n);
+	naive_rotate(M, &X[0], &expected[0], n);
+	if (!is_eq_vector(y, expected)) {
+		std::cout << "rotate failed for n = " << n << std::endl;
+		return 1;
+	}
+
+	util::affine::shift_rotate(&M[0], &s[0], &X[0], &tmp[0], &y[0], n);
+	for (std::size_t i = 0; i < n; ++i) {
+		tmp[i] = X[i] - s[i];
+	}
+	naive_rotate(M, &tmp[0], &expected[0], n);
+	if (!is_eq_vector(y, expected)) {
+		std::cout << "shift_rotate failed for n = " << n << std::endl;
+		return 1;
+	}
+
+	util::affine::rotate_batch(&M[0], &X[0], &Y[0], n, k);
+	for (std::size_t i = 0; i < k; ++i) {
+		naive_rotate(M, &X[i * n], &expected_Y[i * n], n);
+	}
+	if (!is_eq_vector(Y, expected_Y)) {
+		std::cout << "rotate_batch failed for n = " << n << ", k = " << k << std::endl;
+		return 1;
+	}
+	std::cout << "n = " << n << ", k = " << k << " passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_kernels(1, 1) || test_kernels(2, 7) || test_kernels(10, 20) || test_kernels(37, 5) || test_kernels(100, 64);
+}
@@ -22,7 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-// Test for getters and setters
+// Test for getters and setters, and for the re-evaluation of immigrants
 
 #include <iostream>
 #include <algorithm>
@@ -50,6 +50,131 @@ int test_distribution_type() {
 	return 0;
 }
 
+// Batch evaluation must give the same results as objfun()/compute_constraints() and count every evaluation,
+// whatever the number of threads.
+int test_evaluate_batch(const problem::base &prob, unsigned int n_threads) {
+	const population pop(prob,25);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	const problem::base_ptr p = prob.clone();
+	const unsigned int fevals = p->get_fevals(), cevals = p->get_cevals();
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	p->evaluate_batch(f,c,x,n_threads);
+	if (f.size() != x.size() || c.size() != x.size()) {
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (f[i] != pop.get_individual(i).cur_f || c[i] != pop.get_individual(i).cur_c) {
+			std::cout << prob.get_name() << ": batch evaluation with " << n_threads << " threads differs from objfun" << std::endl;
+			return 1;
+		}
+	}
+	if (p->get_fevals() - fevals != x.size() || p->get_cevals() - cevals != (prob.get_c_dimension() ? x.size() : 0u)) {
+		std::cout << prob.get_name() << ": batch evaluation with " << n_threads << " threads miscounted the evaluations" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Four identical islands, fully connected, broadcasting their 6 best individuals: evolving them one after the other,
+// island i receives i copies of the same 6 individuals, which must be evaluated only once. As the islands (and the caches
+// of their problems) are identical, they must all perform the same number of evaluations.
+int test_reevaluation(unsigned int n_threads) {
+	const island isl(algorithm::null(),problem::ackley(10),10,migration::best_s_policy(6),migration::fair_r_policy(6));
+	archipelago a(topology::fully_connected(),archipelago::broadcast,archipelago::destination);
+	a.set_reevaluation_threads(n_threads);
+	for (int i = 0; i < 4; ++i) {
+		a.push_back(isl);
+	}
+	std::vector<unsigned int> fevals;
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		fevals.push_back(a.get_island(i)->get_population().problem().get_fevals());
+	}
+	a.evolve_batch(1,1,false);
+	a.join();
+	const unsigned int n1 = a.get_island(1)->get_population().problem().get_fevals() - fevals[1];
+	for (archipelago::size_type i = 2; i < a.get_size(); ++i) {
+		const unsigned int n = a.get_island(i)->get_population().problem().get_fevals() - fevals[i];
+		if (n != n1 || n > 6) {
+			std::cout << "island " << i << " re-evaluated " << n << " immigrants instead of " << n1 << " with " << n_threads << " threads" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Evolves an archipelago of de islands and checks the consistency of the evolution statistics with the problems' counters,
+// the migration history and the histograms.
+int test_stats() {
+	archipelago a(algorithm::de(5),problem::ackley(10),4,20,topology::ring(),archipelago::broadcast,archipelago::destination);
+	a.set_objfun_timing(true);
+	std::vector<unsigned int> fevals;
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		fevals.push_back(a.get_island(i)->get_population().problem().get_fevals());
+	}
+	a.evolve(3);
+	a.join();
+	const std::vector<evolution_stats> isl_stats = a.get_island_stats();
+	evolution_stats sum;
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		const evolution_stats &s = isl_stats[i];
+		const problem::base_ptr prob = a.get_island(i)->get_problem();
+		if (s.n_evolutions != 3 || s.fevals != prob->get_fevals() - fevals[i] || s.fevals == 0) {
+			std::cout << "island " << i << ": inconsistent evolution/evaluation counts\n" << s << std::endl;
+			return 1;
+		}
+		if (s.evolution_latency.get_count() != 3 || s.migration_latency.get_count() != 3 ||
+			s.evolution_latency.get_total() != s.objfun_time + s.algorithm_time || s.migration_latency.get_total() != s.migration_time)
+		{
+			std::cout << "island " << i << ": inconsistent latency histograms\n" << s << std::endl;
+			return 1;
+		}
+		if (s.objfun_latency.get_count() != prob->get_objfun_latency().get_count() || s.objfun_latency.get_count() == 0 ||
+			s.objfun_time > s.objfun_latency.get_total())
+		{
+			std::cout << "island " << i << ": inconsistent objective function timing\n" << s << std::endl;
+			return 1;
+		}
+		if (s.migrants_accepted > s.migrants_received || s.migrants_sent != 3) {
+			std::cout << "island " << i << ": inconsistent migration counts\n" << s << std::endl;
+			return 1;
+		}
+		sum.merge(s);
+	}
+	const evolution_stats total = a.get_stats();
+	if (total.n_evolutions != sum.n_evolutions || total.fevals != sum.fevals || total.migrants_accepted != sum.migrants_accepted ||
+		total.objfun_time != sum.objfun_time || total.evolution_latency.get_count() != 12 ||
+		total.evolution_latency.get_quantile(1) != total.evolution_latency.get_max())
+	{
+		std::cout << "inconsistent archipelago statistics\n" << total << std::endl;
+		return 1;
+	}
+	a.reset_stats();
+	const evolution_stats reset = a.get_stats();
+	if (reset.n_evolutions != 0 || reset.fevals != 0 || reset.evolution_latency.get_count() != 0 || reset.objfun_latency.get_count() != 0) {
+		std::cout << "statistics were not reset\n" << reset << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
 int main() {
-	return test_distribution_type();
+	int res = test_distribution_type();
+	const unsigned int threads[] = {1, 2, 4, 40};
+	for (int i = 0; i < 4; ++i) {
+		res += test_evaluate_batch(problem::zdt(1,10),threads[i]);
+		res += test_evaluate_batch(problem::cec2006(7),threads[i]);
+		res += test_reevaluation(threads[i]);
+	}
+	res += test_stats();
+	archipelago a;
+	try {
+		a.set_reevaluation_threads(0);
+		std::cout << "set_reevaluation_threads accepted 0 threads" << std::endl;
+		++res;
+	} catch (const value_error &) {}
+	return res;
 }
@@ -0,0 +1,97 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the ask/tell interface of the algorithms
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Runs gen ask/tell generations, evaluating the candidates "externally" with a copy of the problem.
+// Checks that the told fitnesses are stored in the population and that the algorithm made progress.
+int run_ask_tell(const algorithm::base &algo, const problem::base &prob, int pop_size, int gen)
+{
+	population pop(prob,pop_size);
+	const problem::base_ptr evaluator = prob.clone();
+	const fitness_vector f0 = pop.champion().f;
+	const unsigned int fevals0 = pop.problem().get_fevals();
+
+	for (int g = 0; g < gen; ++g) {
+		const std::vector<decision_vector> x = algo.ask(pop);
+		std::vector<fitness_vector> f(x.size());
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			if (!prob.verify_x(x[i])) {
+				std::cout << algo.get_name() << ": asked an invalid decision vector" << std::endl;
+				return 1;
+			}
+			f[i] = evaluator->objfun(x[i]);
+		}
+		algo.tell(pop,x,f);
+		if (pop.size() != (population::size_type)pop_size) {
+			std::cout << algo.get_name() << ": population size changed by tell()" << std::endl;
+			return 1;
+		}
+		for (population::size_type i = 0; i < pop.size(); ++i) {
+			if (!is_eq_vector(pop.get_individual(i).cur_f,evaluator->objfun(pop.get_individual(i).cur_x))) {
+				std::cout << algo.get_name() << ": inconsistent fitness after tell()" << std::endl;
+				return 1;
+			}
+		}
+	}
+	if (pop.problem().get_fevals() != fevals0) {
+		std::cout << algo.get_name() << ": tell() evaluated the objective function" << std::endl;
+		return 1;
+	}
+	if (prob.get_f_dimension() == 1 && !prob.compare_fitness(pop.champion().f,f0)) {
+		std::cout << algo.get_name() << ": no improvement after " << gen << " generations " << f0 << " -> " << pop.champion().f << std::endl;
+		return 1;
+	}
+	std::cout << algo.get_name() << ": " << f0 << " -> " << pop.champion().f << " passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	const problem::ackley ackley(10);
+	res += run_ask_tell(algorithm::de(),ackley,20,100);
+	res += run_ask_tell(algorithm::jde(),ackley,20,100);
+	res += run_ask_tell(algorithm::cmaes(),ackley,20,100);
+	res += run_ask_tell(algorithm::pso_generational(),ackley,20,100);
+	res += run_ask_tell(algorithm::sga(),ackley,20,100);
+	res += run_ask_tell(algorithm::nsga2(),problem::zdt(1,10),20,20);
+
+	// Algorithms not implementing ask/tell must say so.
+	population pop(ackley,10);
+	try {
+		algorithm::monte_carlo().ask(pop);
+		std::cout << "ask() did not throw for an algorithm without ask/tell" << std::endl;
+		++res;
+	} catch (const not_implemented_error &) {}
+	return res;
+}
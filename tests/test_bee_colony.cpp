@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the bee_colony memory and for the write-back of known fitnesses into the population
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// With memory, the trial counters survive between calls: evolving n times for one generation must
+// then be the same as evolving once for n generations, starting from the same rngs.
+int test_memory(const problem::base &prob, int limit, int gen)
+{
+	const algorithm::bee_colony one(1,limit,true), many(gen,limit,true);
+	one.reset_rngs(42);
+	many.reset_rngs(42);
+	population pop1(prob,20), pop2(pop1);
+	for (int i = 0; i < gen; ++i) {
+		one.evolve(pop1);
+	}
+	many.evolve(pop2);
+	for (population::size_type i = 0; i < pop1.size(); ++i) {
+		if (pop1.get_individual(i).cur_x != pop2.get_individual(i).cur_x) {
+			std::cout << "bee_colony with memory: " << gen << " calls differ from one call of " << gen << " generations" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// The algorithm evaluates 2 * NP candidates per generation, plus one scout at most: writing
+// the improved food sources back into the population must not evaluate them again.
+int test_write_back(const problem::base &prob)
+{
+	const population::size_type NP = 50;
+	population pop(prob,NP);
+	const unsigned int fevals0 = pop.problem().get_fevals();
+	algorithm::bee_colony(1,20).evolve(pop);
+	const unsigned int n = pop.problem().get_fevals() - fevals0;
+	if (n > 2 * NP + 1) {
+		std::cout << "bee_colony performed " << n << " evaluations in one generation of " << NP << " food sources" << std::endl;
+		return 1;
+	}
+	// Bulk write-back of known fitnesses.
+	const problem::base_ptr evaluator = prob.clone();
+	std::vector<population::size_type> idx;
+	std::vector<decision_vector> x;
+	std::vector<fitness_vector> f;
+	for (population::size_type i = 0; i < NP; i += 2) {
+		idx.push_back(i);
+		x.push_back(pop.get_individual(i + 1).cur_x);
+		f.push_back(evaluator->objfun(x.back()));
+	}
+	const unsigned int fevals1 = pop.problem().get_fevals();
+	pop.set_xf(idx,x,f);
+	if (pop.problem().get_fevals() != fevals1) {
+		std::cout << "set_xf evaluated the objective function" << std::endl;
+		return 1;
+	}
+	for (std::vector<population::size_type>::size_type i = 0; i < idx.size(); ++i) {
+		if (pop.get_individual(idx[i]).cur_x != x[i] || !is_eq_vector(pop.get_individual(idx[i]).cur_f,f[i])) {
+			std::cout << "set_xf did not write individual " << idx[i] << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	res += test_memory(problem::ackley(10),3,10);
+	res += test_memory(problem::rosenbrock(5),5,20);
+	res += test_write_back(problem::ackley(10));
+	res += test_write_back(problem::griewank(20));
+	return res;
+}
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the loading of the cec2013 data files: text files, memory-mapped binary files,
+// sharing between instances and validation of the file sizes. The data is synthetic.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Prefix of the data files written by this test in the working directory.
+static const std::string prefix("test_cec2013_");
+
+static void write_txt(const std::string &name, std::size_t n, double scale)
+{
+	std::ofstream f((prefix + name + ".txt").c_str());
+	for (std::size_t i = 0; i < n; ++i) {
+		f << scale * (static_cast<double>((i * 7919) % 201) - 100.) << '\n';
+	}
+}
+
+static void remove_files()
+{
+	const char *names[] = {"M_D2.txt","M_D2.bin","shift_data.txt","shift_data.bin"};
+	for (int i = 0; i < 4; ++i) {
+		std::remove((prefix + names[i]).c_str());
+	}
+}
+
+// Values of the first two functions at a few points.
+static std::vector<fitness_vector> sample(const std::string &dir)
+{
+	std::vector<fitness_vector> retval;
+	for (unsigned int fun_id = 1; fun_id <= 2; ++fun_id) {
+		const problem::cec2013 prob(fun_id,2,dir);
+		for (int i = 0; i < 5; ++i) {
+			decision_vector x(2);
+			x[0] = 10. * i - 20.;
+			x[1] = 3. - 7. * i;
+			retval.push_back(prob.objfun(x));
+		}
+	}
+	return retval;
+}
+
+int main()
+{
+	int res = 0;
+	remove_files();
+	write_txt("M_D2",10 * 2 * 2,.01);
+	write_txt("shift_data",10 * 100,.5);
+
+	// Text files: the sphere (function 1) is the squared distance from the first shift vector, minus 1400.
+	const std::vector<fitness_vector> f_txt = sample(prefix);
+	{
+		const problem::cec2013 prob(1,2,prefix);
+		const std::vector<double> o = prob.origin_shift();
+		decision_vector x(2,1.);
+		const double expected = (1. - o[0]) * (1. - o[0]) + (1. - o[1]) * (1. - o[1]) - 1400.;
+		if (!is_eq(prob.objfun(x)[0],expected)) {
+			std::cout << "sphere from text data: " << prob.objfun(x)[0] << " instead of " << expected << std::endl;
+			++res;
+		}
+	}
+
+	// Binary files: once written, they are used instead of the text ones, with the same results.
+	problem::cec2013::write_binary_data(2,prefix);
+	std::remove((prefix + "M_D2.txt").c_str());
+	std::remove((prefix + "shift_data.txt").c_str());
+	const std::vector<fitness_vector> f_bin = sample(prefix);
+	for (std::vector<fitness_vector>::size_type i = 0; i < f_txt.size(); ++i) {
+		if (!is_eq_vector(f_txt[i],f_bin[i],0)) {
+			std::cout << "binary data gives " << f_bin[i] << " instead of " << f_txt[i] << std::endl;
+			++res;
+		}
+	}
+
+	// Sharing: while an instance is alive, its data is reused even if the files disappear.
+	{
+		const problem::cec2013 prob(2,2,prefix);
+		remove_files();
+		try {
+			const problem::cec2013 other(2,2,prefix);
+			if (other.origin_shift() != prob.origin_shift()) {
+				std::cout << "shared data differs" << std::endl;
+				++res;
+			}
+		} catch (const io_error &) {
+			std::cout << "data was not shared between live instances" << std::endl;
+			++res;
+		}
+	}
+	// ... and released with the last instance.
+	try {
+		problem::cec2013(2,2,prefix);
+		std::cout << "data was not released with the last instance" << std::endl;
+		++res;
+	} catch (const io_error &) {}
+
+	// Truncated files are rejected, both text and binary.
+	write_txt("M_D2",3 * 2 * 2,.01);
+	write_txt("shift_data",10 * 100,.5);
+	try {
+		problem::cec2013(1,2,prefix);
+		std::cout << "truncated rotation matrices accepted" << std::endl;
+		++res;
+	} catch (const io_error &) {}
+	problem::cec2013::write_binary_data(2,prefix);
+	std::remove((prefix + "M_D2.txt").c_str());
+	try {
+		problem::cec2013(1,2,prefix);
+		std::cout << "truncated binary rotation matrices accepted" << std::endl;
+		++res;
+	} catch (const io_error &) {}
+	write_txt("M_D2",10 * 2 * 2,.01);
+	std::remove((prefix + "M_D2.bin").c_str());
+	write_txt("shift_data",7,.5);
+	std::remove((prefix + "shift_data.bin").c_str());
+	try {
+		problem::cec2013(1,2,prefix);
+		std::cout << "truncated shift data accepted" << std::endl;
+		++res;
+	} catch (const io_error &) {}
+
+	// Binary files which do not match their header or the text file are not used.
+	remove_files();
+	write_txt("M_D2",10 * 2 * 2,.01);
+	write_txt("shift_data",10 * 100,.5);
+	problem::cec2013::write_binary_data(2,prefix);
+	// Stale: the text file has been rewritten since.
+	write_txt("shift_data",10 * 100,.25);
+	{
+		const problem::cec2013 prob(1,2,prefix);
+		if (!is_eq(prob.origin_shift()[0],.25 * (static_cast<double>(0) - 100.))) {
+			std::cout << "stale binary data used instead of the text file" << std::endl;
+			++res;
+		}
+	}
+	// Corrupted: a raw array of doubles without header falls back to the text file...
+	{
+		const std::vector<double> raw(10 * 100,1.);
+		std::ofstream f((prefix + "shift_data.bin").c_str(), std::ios::binary | std::ios::trunc);
+		f.write(reinterpret_cast<const char *>(&raw[0]), raw.size() * sizeof(double));
+	}
+	{
+		const problem::cec2013 prob(1,2,prefix);
+		if (!is_eq(prob.origin_shift()[0],.25 * (static_cast<double>(0) - 100.))) {
+			std::cout << "headerless binary data used instead of the text file" << std::endl;
+			++res;
+		}
+	}
+	// ... and is rejected if there is none.
+	std::remove((prefix + "shift_data.txt").c_str());
+	try {
+		problem::cec2013(1,2,prefix);
+		std::cout << "headerless binary data accepted" << std::endl;
+		++res;
+	} catch (const io_error &) {}
+
+	remove_files();
+	return res;
+}
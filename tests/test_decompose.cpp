@@ -213,6 +213,103 @@ int test_decompose_tchebycheff(const std::vector<problem::base_ptr> &probs, std:
 
 }
 
+//Test decompose instances sharing the cache of the original fitnesses: each instance must still
+//return its own decomposition, and instances of different problems must not share the cache.
+int test_decompose_shared_cache(const std::vector<problem::base_ptr> &probs, double d_from_center)
+{
+	for(unsigned int i=0; i<probs.size(); i++)
+	{
+		decision_vector x = construct_test_point(probs[i], d_from_center);
+		int f_dimension = probs[i]->get_f_dimension();
+		fitness_vector w1(f_dimension, 0), w2(f_dimension, 0);
+		generate_weights(w1);
+		generate_weights(w2);
+
+		problem::decompose d1(*(probs[i]), problem::decompose::WEIGHTED, w1);
+		problem::decompose d2(*(probs[i]), problem::decompose::WEIGHTED, w2);
+		d2.share_fitness_cache(d1);
+		problem::base_ptr d3 = d2.clone();
+
+		fitness_vector f_original = probs[i]->objfun(x), f_expected(1);
+		fitness_vector f1 = d1.objfun(x);
+		d2.compute_decomposed_fitness(f_expected, f_original);
+		if(!is_eq(d2.objfun(x)[0], f_expected[0]) || !is_eq(d3->objfun(x)[0], f_expected[0]))
+		{
+			std::cout<<d2.get_name()<<" shared cache failed, "<<f_expected[0]<<"!="<<d2.objfun(x)[0]<<std::endl;
+			return 1;
+		}
+		d1.compute_decomposed_fitness(f_expected, f_original);
+		if(!is_eq(f1[0], f_expected[0]))
+		{
+			std::cout<<d1.get_name()<<" shared cache failed, "<<f_expected[0]<<"!="<<f1[0]<<std::endl;
+			return 1;
+		}
+		if (i > 0 && probs[i]->get_name() != probs[i-1]->get_name()) {
+			try {
+				problem::decompose other(*(probs[i-1]));
+				other.share_fitness_cache(d1);
+				std::cout<<d1.get_name()<<" cache shared with a different problem"<<std::endl;
+				return 1;
+			} catch (const value_error &) {}
+		}
+		std::cout<<d1.get_name()<<" shared cache passes, "<<std::endl;
+	}
+	return 0;
+}
+
+// zdt counting the evaluations of all its copies.
+class counted_zdt: public problem::zdt
+{
+	public:
+		counted_zdt():problem::zdt(1,10) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new counted_zdt(*this));
+		}
+		static unsigned int count;
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			++count;
+			problem::zdt::objfun_impl(f,x);
+		}
+};
+
+unsigned int counted_zdt::count = 0;
+
+//Test that decompositions sharing the cache evaluate the original problem once per distinct chromosome,
+//unless the original problem is stochastic, also when wrapped in another meta-problem.
+int test_decompose_evaluations()
+{
+	const counted_zdt prob;
+	const decision_vector x(10,0.3), y(10,0.6);
+	problem::decompose d1(prob, problem::decompose::WEIGHTED), d2(prob, problem::decompose::WEIGHTED);
+	d2.share_fitness_cache(d1);
+	const problem::base_ptr d3 = d2.clone();
+	counted_zdt::count = 0;
+	d1.objfun(x);
+	d2.objfun(x);
+	d3->objfun(x);
+	d2.objfun(y);
+	d1.objfun(y);
+	if (counted_zdt::count != 2 || d1.get_fevals() + d2.get_fevals() + d3->get_fevals() != 5) {
+		std::cout<<"shared cache: "<<counted_zdt::count<<" evaluations of the original problem for 2 chromosomes"<<std::endl;
+		return 1;
+	}
+	const problem::shifted stochastic(problem::noisy(prob,1,0,0.1),0.);
+	problem::decompose s1(stochastic, problem::decompose::WEIGHTED), s2(stochastic, problem::decompose::WEIGHTED);
+	s2.share_fitness_cache(s1);
+	counted_zdt::count = 0;
+	s1.objfun(x);
+	s2.objfun(x);
+	if (counted_zdt::count != 2) {
+		std::cout<<"shared cache used for a wrapped stochastic problem"<<std::endl;
+		return 1;
+	}
+	std::cout<<"shared cache evaluations pass"<<std::endl;
+	return 0;
+}
+
 int main()
 {
 
@@ -241,6 +338,9 @@ int main()
 		test_decompose_weighted_random(probs, -0.2) ||
 		test_decompose_tchebycheff(probs, ideal, -0.2) ||
 		test_decompose_tchebycheff(probs, ideal, 0.2) ||
-		test_decompose_tchebycheff(probs, ideal, -0.4);
+		test_decompose_tchebycheff(probs, ideal, -0.4) ||
+		test_decompose_shared_cache(probs, -0.2) ||
+		test_decompose_shared_cache(probs, 0.2) ||
+		test_decompose_evaluations();
 
 }
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the block generation of low-discrepancy sequences
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/discrepancy.h"
+#include "test.h"
+
+using namespace pagmo;
+using namespace util::discrepancy;
+
+// The block generation must return the same points as the single point interface,
+// also when the block is split in chunks generated by different clones.
+int test_generate(const base &seq, const std::string &name, unsigned int first, unsigned int n)
+{
+	const unsigned int dim = seq.get_dimension();
+	base_ptr single = seq.clone(), block = seq.clone(), chunk1 = seq.clone(), chunk2 = seq.clone();
+	std::vector<double> points(n * dim), chunks(n * dim);
+	block->generate(&points[0], n, first);
+	chunk2->generate(&chunks[(n / 2) * dim], n - n / 2, first + n / 2);
+	chunk1->generate(&chunks[0], n / 2, first);
+	for (unsigned int k = 0; k < n; ++k) {
+		const std::vector<double> point = (k == 0) ? (*single)(first) : (*single)();
+		if (!is_eq_vector(point, std::vector<double>(points.begin() + k * dim, points.begin() + (k + 1) * dim))) {
+			std::cout << name << ": block generation differs at point " << first + k << std::endl;
+			return 1;
+		}
+	}
+	if (points != chunks) {
+		std::cout << name << ": chunked generation differs" << std::endl;
+		return 1;
+	}
+	// The sequence continues after the block.
+	if ((*single)() != (*block)()) {
+		std::cout << name << ": the sequence does not continue after the block" << std::endl;
+		return 1;
+	}
+	std::cout << name << " passes" << std::endl;
+	return 0;
+}
+
+// Jumping along the Sobol sequence must give the same points as stepping.
+int test_sobol_skip()
+{
+	sobol stepping(7, 0);
+	for (unsigned int n = 0; n < 5000; ++n) {
+		const std::vector<double> point = stepping();
+		if ((n % 97 == 0 || n == 4095 || n == 4096) && point != sobol(7, 0)(n)) {
+			std::cout << "sobol: skip ahead to point " << n << " differs" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "sobol skip ahead passes" << std::endl;
+	return 0;
+}
+
+int test_init_population()
+{
+	const problem::ackley prob(5);
+	population pop(prob, 32);
+	sobol seq(5, 1);
+	init_population(pop, seq, 1);
+	std::vector<double> points(32 * 5);
+	sobol(5, 1).generate(&points[0], 32, 1);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		for (unsigned int j = 0; j < 5; ++j) {
+			const double expected = prob.get_lb()[j] + points[i * 5 + j] * (prob.get_ub()[j] - prob.get_lb()[j]);
+			if (std::abs(ind.cur_x[j] - expected) > 1e-12) {
+				std::cout << "init_population: individual " << i << " is not the scaled point" << std::endl;
+				return 1;
+			}
+		}
+		if (ind.cur_f != prob.objfun(ind.cur_x)) {
+			std::cout << "init_population: individual " << i << " not evaluated" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "init_population passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_generate(sobol(7, 0), "sobol", 0, 100) ||
+		test_generate(sobol(7, 0), "sobol (skip ahead)", 100000, 50) ||
+		test_generate(halton(4, 1), "halton", 1, 100) ||
+		test_generate(faure(5, 0), "faure", 3, 100) ||
+		test_generate(simplex(4, 1), "simplex", 1, 100) ||
+		test_generate(lhs(3, 100), "lhs", 10, 80) ||
+		test_sobol_skip() ||
+		test_init_population();
+}
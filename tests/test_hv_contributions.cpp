@@ -0,0 +1,130 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the incremental hypervolume contributions
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/hv_contributions.h"
+#include "../src/util/hypervolume.h"
+
+using namespace pagmo;
+
+// Random mutually non-dominated points, on the positive orthant of the unit sphere.
+static std::vector<fitness_vector> sphere_points(unsigned int n, unsigned int f_dim, rng_double &drng)
+{
+	std::vector<fitness_vector> points(n,fitness_vector(f_dim));
+	for (unsigned int i = 0; i < n; ++i) {
+		double norm = 0;
+		for (unsigned int k = 0; k < f_dim; ++k) {
+			points[i][k] = drng() + 1E-3;
+			norm += points[i][k] * points[i][k];
+		}
+		for (unsigned int k = 0; k < f_dim; ++k) {
+			points[i][k] /= std::sqrt(norm);
+		}
+	}
+	return points;
+}
+
+// Removes k points greedily, both incrementally and by recomputing all the contributions at each step,
+// and checks that the same points are removed and that the contributions agree.
+static int check_greedy(const std::vector<fitness_vector> &points, unsigned int k, bool least)
+{
+	const fitness_vector r_point(points[0].size(),1.1);
+	util::hv_contributions contributions(points,r_point);
+	std::vector<fitness_vector> remaining(points);
+	std::vector<unsigned int> indices;
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		indices.push_back(i);
+	}
+	for (unsigned int step = 0; step < k; ++step) {
+		util::hypervolume hv(remaining,false);
+		const std::vector<double> c = hv.contributions(r_point);
+		for (unsigned int i = 0; i < remaining.size(); ++i) {
+			if (std::abs(contributions.get_contribution(indices[i]) - c[i]) > 1E-10) {
+				std::cout << "wrong contribution of point " << indices[i] << " at step " << step << ": "
+					<< contributions.get_contribution(indices[i]) << " vs " << c[i] << std::endl;
+				return 1;
+			}
+		}
+		const unsigned int expected = least ? hv.least_contributor(r_point) : hv.greatest_contributor(r_point);
+		const unsigned int removed = least ? contributions.pop_least() : contributions.pop_greatest();
+		if (removed != indices[expected] || contributions.contains(removed) || contributions.size() != remaining.size() - 1) {
+			std::cout << "removed point " << removed << " instead of " << indices[expected] << " at step " << step << std::endl;
+			return 1;
+		}
+		remaining.erase(remaining.begin() + expected);
+		indices.erase(indices.begin() + expected);
+	}
+	return 0;
+}
+
+// Lazy evaluation: the greedy removal must not recompute all the contributions at each step.
+static int check_lazy(rng_double &drng)
+{
+	const std::vector<fitness_vector> points = sphere_points(200,2,drng);
+	util::hv_contributions contributions(points,fitness_vector(2,1.1));
+	for (unsigned int i = 0; i < 100; ++i) {
+		contributions.pop_least();
+	}
+	// In two dimensions only the two neighbours of a removed point are affected.
+	if (contributions.get_recomputations() > 2 * 100) {
+		std::cout << "too many recomputations: " << contributions.get_recomputations() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	rng_double drng(42);
+	for (unsigned int f_dim = 2; f_dim <= 5; ++f_dim) {
+		for (int trial = 0; trial < 5; ++trial) {
+			const std::vector<fitness_vector> points = sphere_points(30,f_dim,drng);
+			res += check_greedy(points,20,true);
+			res += check_greedy(points,20,false);
+		}
+		std::cout << f_dim << " objectives: " << (res ? "fails" : "passes") << std::endl;
+	}
+	res += check_lazy(drng);
+	// Removed and non-existing points are rejected.
+	util::hv_contributions contributions(sphere_points(3,2,drng),fitness_vector(2,1.1));
+	contributions.remove(1);
+	try {
+		contributions.get_contribution(1);
+		std::cout << "removed point not detected" << std::endl;
+		++res;
+	} catch (const value_error &) {}
+	try {
+		contributions.remove(3);
+		std::cout << "invalid index not detected" << std::endl;
+		++res;
+	} catch (const value_error &) {}
+	return res;
+}
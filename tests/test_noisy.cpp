@@ -198,6 +198,36 @@ int test_noisy_uniform(const std::vector<problem::base_ptr> & probs, double nois
 	return 0;
 }
 
+// Check that averaging the trials over several threads gives exactly the same result as the serial evaluation,
+// and that different seeds still give different results.
+int test_trial_threads(const problem::base_stochastic &prob)
+{
+	std::cout << std::setw(40) << prob.get_name();
+	decision_vector x(prob.get_dimension());
+	for(unsigned int xi = 0; xi < x.size(); xi++){
+		x[xi] = prob.get_lb()[xi] + (prob.get_ub()[xi] - prob.get_lb()[xi]) * (xi + 1) / (x.size() + 2.0);
+	}
+	const fitness_vector f_serial = prob.objfun(x);
+	const constraint_vector c_serial = prob.compute_constraints(x);
+	for(unsigned int n = 2; n <= 5; n++){
+		problem::base_ptr p = prob.clone();
+		problem::base_stochastic &p_threaded = dynamic_cast<problem::base_stochastic &>(*p);
+		p_threaded.set_trial_threads(n);
+		if(f_serial != p_threaded.objfun(x) || c_serial != p_threaded.compute_constraints(x)){
+			std::cout << " results depend on the number of threads (" << n << ")!" << std::endl;
+			return 1;
+		}
+	}
+	problem::base_ptr p = prob.clone();
+	dynamic_cast<problem::base_stochastic &>(*p).set_seed(prob.get_seed() + 1);
+	if(f_serial == p->objfun(x)){
+		std::cout << " results do not depend on the seed!" << std::endl;
+		return 1;
+	}
+	std::cout << " trial threads passed." << std::endl;
+	return 0;
+}
+
 int main()
 {	
 	int dimension = 10;
@@ -208,5 +238,9 @@ int main()
 	return test_noisy(probs, 0.0, 0.1, 5000, 0.01) ||
 		   test_noisy(probs, 3.14, 0.1, 5000, 0.01) ||
 		   test_noisy_uniform(probs, 0.0, 0.1, 5000, 0.01) ||
-		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01);
+		   test_noisy_uniform(probs, -0.2, 0.2, 5000, 0.01) ||
+		   test_trial_threads(problem::noisy(problem::zdt(1, dimension), 20, 0.0, 0.1, problem::noisy::NORMAL, 42)) ||
+		   test_trial_threads(problem::noisy(problem::cec2006(3), 7, -0.1, 0.1, problem::noisy::UNIFORM, 42)) ||
+		   test_trial_threads(problem::robust(problem::ackley(dimension), 20, 0.5, 42)) ||
+		   test_trial_threads(problem::inventory(dimension, 50, 42));
 }
@@ -0,0 +1,250 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the bulk write-back (set_xf / set_xfc), the swap/move and the partial ranking of the population
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+// Checks that two populations hold the same individuals and the same domination structures.
+bool same_population(const population &a, const population &b)
+{
+	if (a.size() != b.size()) return false;
+	for (population::size_type i = 0; i < a.size(); ++i) {
+		if (a.get_individual(i).cur_x != b.get_individual(i).cur_x ||
+			!is_eq_vector(a.get_individual(i).cur_f,b.get_individual(i).cur_f) ||
+			a.get_individual(i).best_x != b.get_individual(i).best_x ||
+			!is_eq_vector(a.get_individual(i).best_f,b.get_individual(i).best_f)) {
+			return false;
+		}
+		if (a.get_domination_count(i) != b.get_domination_count(i)) return false;
+		std::vector<population::size_type> la = a.get_domination_list(i), lb = b.get_domination_list(i);
+		std::sort(la.begin(),la.end());
+		std::sort(lb.begin(),lb.end());
+		if (la != lb) return false;
+	}
+	return a.champion().x == b.champion().x;
+}
+
+// Assigns new random decision vectors to the individuals in idx, once with set_x and once with the bulk set_xf.
+int test_bulk(const problem::base &prob, const std::vector<population::size_type> &idx)
+{
+	population reference(prob,20,42), bulk(reference), source(prob,20,7);
+	std::vector<decision_vector> x;
+	std::vector<fitness_vector> f;
+	for (std::vector<population::size_type>::size_type i = 0; i < idx.size(); ++i) {
+		x.push_back(source.get_individual(i).cur_x);
+		f.push_back(source.get_individual(i).cur_f);
+		reference.set_x(idx[i],x.back());
+	}
+	const unsigned int fevals = bulk.problem().get_fevals();
+	bulk.set_xf(idx,x,f);
+	if (bulk.problem().get_fevals() != fevals) {
+		std::cout << prob.get_name() << ": bulk set_xf evaluated the objective function" << std::endl;
+		return 1;
+	}
+	if (!same_population(reference,bulk)) {
+		std::cout << prob.get_name() << ": bulk set_xf of " << idx.size() << " individuals differs from set_x" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << ": bulk set_xf of " << idx.size() << " individuals passes" << std::endl;
+	return 0;
+}
+
+// Checks that swap and move exchange the content of populations without evaluations.
+int test_swap(const problem::base &prob)
+{
+	population a(prob,10,1), b(prob,5,2);
+	const population a0(a), b0(b);
+	const unsigned int fevals = a.problem().get_fevals() + b.problem().get_fevals();
+	a.swap(b);
+	if (!same_population(a,b0) || !same_population(b,a0)) {
+		std::cout << prob.get_name() << ": swap did not exchange the populations" << std::endl;
+		return 1;
+	}
+	swap(a,b);
+	if (!same_population(a,a0) || !same_population(b,b0) || a.problem().get_fevals() + b.problem().get_fevals() != fevals) {
+		std::cout << prob.get_name() << ": swapping back did not restore the populations" << std::endl;
+		return 1;
+	}
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+	population c(std::move(a));
+	b = std::move(c);
+	if (!same_population(b,a0)) {
+		std::cout << prob.get_name() << ": move did not transfer the population" << std::endl;
+		return 1;
+	}
+	// The moved-from population must not share the problem of the new one.
+	population d(std::move(b));
+	const unsigned int d_fevals = d.problem().get_fevals();
+	b.push_back(decision_vector(prob.get_dimension(),0.5));
+	if (&b.problem() == &d.problem() || d.problem().get_fevals() != d_fevals || b.size() != 1 || !same_population(d,a0)) {
+		std::cout << prob.get_name() << ": the moved-from population aliases the new one" << std::endl;
+		return 1;
+	}
+#endif
+	std::cout << prob.get_name() << ": swap passes" << std::endl;
+	return 0;
+}
+
+// Returns true if individual a comes before individual b when ranking from the best (or from the worst).
+bool ranks_before(const population &pop, population::size_type a, population::size_type b, bool best)
+{
+	if (!best) {
+		std::swap(a,b);
+	}
+	if (pop.problem().get_f_dimension() == 1) {
+		return pop.problem().compare_fc(pop.get_individual(a).cur_f,pop.get_individual(a).cur_c,
+			pop.get_individual(b).cur_f,pop.get_individual(b).cur_c);
+	}
+	return population::crowded_comparison_operator(pop)(a,b);
+}
+
+// Checks that idx holds N distinct individuals, ordered, and that none of the others ranks before the last one.
+bool is_ranked(const population &pop, const std::vector<population::size_type> &idx, const population::size_type &N, bool best)
+{
+	if (idx.size() != N) return false;
+	std::vector<bool> taken(pop.size(),false);
+	for (std::vector<population::size_type>::size_type i = 0; i < idx.size(); ++i) {
+		if (idx[i] >= pop.size() || taken[idx[i]]) return false;
+		taken[idx[i]] = true;
+		if (i && ranks_before(pop,idx[i],idx[i - 1],best)) return false;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (!taken[i] && N && ranks_before(pop,i,idx.back(),best)) return false;
+	}
+	return true;
+}
+
+int test_ranking(const problem::base &prob)
+{
+	population pop(prob,30,3);
+	// Duplicate some individuals to have ties.
+	for (population::size_type i = 0; i < 5; ++i) {
+		const decision_vector x = pop.get_individual(i).cur_x;
+		pop.push_back(x);
+	}
+	const population::size_type sizes[] = {0, 1, 7, 35};
+	for (unsigned i = 0; i < 4; ++i) {
+		if (!is_ranked(pop,pop.get_best_idx(sizes[i]),sizes[i],true) || !is_ranked(pop,pop.get_worst_idx(sizes[i]),sizes[i],false)) {
+			std::cout << prob.get_name() << ": wrong partial ranking of " << sizes[i] << " individuals" << std::endl;
+			return 1;
+		}
+	}
+	const population::size_type best = pop.get_best_idx(1)[0], worst = pop.get_worst_idx(1)[0];
+	if (ranks_before(pop,best,pop.get_best_idx(),true) || ranks_before(pop,pop.get_best_idx(),best,true) ||
+		ranks_before(pop,worst,pop.get_worst_idx(),false) || ranks_before(pop,pop.get_worst_idx(),worst,false))
+	{
+		std::cout << prob.get_name() << ": partial ranking inconsistent with get_best_idx()/get_worst_idx()" << std::endl;
+		return 1;
+	}
+	std::cout << prob.get_name() << ": partial ranking passes" << std::endl;
+	return 0;
+}
+
+// Checks the fair replacement policy against its definition: the i-th best immigrant replaces the
+// i-th worst native as long as it is strictly better.
+int test_fair_r_policy(const problem::base &prob)
+{
+	population dest(prob,20,5), source(prob,20,6);
+	const std::vector<population::individual_type> immigrants(source.begin(),source.begin() + 8);
+	const std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > r =
+		migration::fair_r_policy(8,migration::absolute).select(immigrants,dest);
+	const std::vector<population::size_type> worst = dest.get_worst_idx(8);
+	population imm_pop(prob,0);
+	for (std::vector<population::individual_type>::size_type i = 0; i < immigrants.size(); ++i) {
+		imm_pop.push_back(immigrants[i].cur_x);
+	}
+	const std::vector<population::size_type> imm_rank = imm_pop.get_best_idx(8);
+	std::vector<population::individual_type>::size_type n = 0;
+	while (n < imm_rank.size() && prob.compare_fc(immigrants[imm_rank[n]].cur_f,immigrants[imm_rank[n]].cur_c,
+		dest.get_individual(worst[n]).cur_f,dest.get_individual(worst[n]).cur_c))
+	{
+		++n;
+	}
+	if (r.size() != n) {
+		std::cout << prob.get_name() << ": fair_r_policy replaced " << r.size() << " individuals instead of " << n << std::endl;
+		return 1;
+	}
+	for (std::vector<population::individual_type>::size_type i = 0; i < n; ++i) {
+		if (r[i].first != worst[i] || !is_eq_vector(immigrants[r[i].second].cur_f,immigrants[imm_rank[i]].cur_f)) {
+			std::cout << prob.get_name() << ": fair_r_policy paired the wrong individuals" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << prob.get_name() << ": fair_r_policy replaces " << n << " individuals, passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int res = 0;
+	std::vector<population::size_type> all, some;
+	for (population::size_type i = 0; i < 20; ++i) {
+		all.push_back(19 - i);
+	}
+	some.push_back(3);
+	some.push_back(11);
+	some.push_back(0);
+
+	res += test_bulk(problem::zdt(1,10),all);
+	res += test_bulk(problem::zdt(1,10),some);
+	res += test_bulk(problem::ackley(10),all);
+	res += test_bulk(problem::ackley(10),some);
+	res += test_swap(problem::zdt(1,10));
+	res += test_ranking(problem::ackley(10));
+	res += test_ranking(problem::zdt(1,10));
+	res += test_ranking(problem::dtlz(2,10,3));
+	res += test_fair_r_policy(problem::ackley(10));
+	res += test_fair_r_policy(problem::griewank(10));
+
+	// Invalid input must be rejected without touching the population.
+	population pop(problem::ackley(10),5), copy(pop);
+	std::vector<population::size_type> dup(2,1);
+	std::vector<decision_vector> x(2,pop.get_individual(4).cur_x);
+	std::vector<fitness_vector> f(2,pop.get_individual(4).cur_f);
+	try {
+		pop.set_xf(dup,x,f);
+		std::cout << "set_xf accepted a repeated index" << std::endl;
+		++res;
+	} catch (const value_error &) {}
+	dup[1] = 5;
+	try {
+		pop.set_xf(dup,x,f);
+		std::cout << "set_xf accepted an invalid index" << std::endl;
+		++res;
+	} catch (const index_error &) {}
+	if (!same_population(pop,copy)) {
+		std::cout << "a failed set_xf modified the population" << std::endl;
+		++res;
+	}
+	return res;
+}
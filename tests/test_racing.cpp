@@ -321,7 +321,10 @@ int test_racing_get_mean_fitness(const problem::base_ptr &prob)
 	}
 	population::size_type n_final = 1;
 
-	std::pair<std::vector<population::size_type>, unsigned int> res = race_pop_dev.run(n_final, 0, 5000, 0.05, active_set, race_pop::MAX_BUDGET, true, true);
+	// Every individual is evaluated at least min_trials times, so that the mean fitness of the
+	// winner is not estimated from the handful of samples after which the race is decided.
+	const unsigned int min_trials = 100;
+	std::pair<std::vector<population::size_type>, unsigned int> res = race_pop_dev.run(n_final, min_trials, 5000, 0.05, active_set, race_pop::MAX_BUDGET, true, true);
 
 	// Check that the dimension is correct
 	unsigned int winner_idx = res.first[0];
@@ -344,9 +347,8 @@ int test_racing_get_mean_fitness(const problem::base_ptr &prob)
 		}
 	}
 
-	// Tolerance is a bit large here as race could not and should not perform
-	// too much evaluation, hence affecting the accuracy.
-	double eps = 0.2;
+	// Four standard errors of the mean of min_trials samples of the noise.
+	double eps = 4 * 0.5 / std::sqrt((double)min_trials);
 	for(unsigned int i = 0; i < mean_fitness_race.size(); i++){
 		if(fabs(mean_fitness_repeated_eval[i]-mean_fitness_race[i]) > eps){	
 			std::cout << "\tFAILED get_mean_fitness: Dimension #"  << i << " had too much deviation" << std::endl;
@@ -406,6 +408,216 @@ int test_race_pop_constructor(const problem::base_ptr& prob)
 	return 0;
 }
 
+/// Check the shared store of evaluations and the parallel evaluation of racing rounds
+int test_racing_shared_store(const problem::base_ptr &prob)
+{
+	std::cout << "Testing the shared store and the parallel evaluation of racing" << std::endl;
+
+	unsigned int seed = 123;
+	problem::noisy prob_noisy(*prob, 1, 0, 0.5, problem::noisy::NORMAL, seed);
+	population pop(prob_noisy, 8, seed);
+	population::size_type n_final = 2;
+	std::vector<population::size_type> active_set;
+
+	// Same race, evaluated serially and on several threads
+	util::racing::race_pop race_serial(pop, seed);
+	util::racing::race_pop race_threaded(pop, seed);
+	race_threaded.set_eval_threads(3);
+	race_threaded.set_lookahead(3);
+	std::pair<std::vector<population::size_type>, unsigned int> res1 = race_serial.run(n_final, 0, 500, 0.05, active_set, race_pop::MAX_BUDGET, true, false);
+	std::pair<std::vector<population::size_type>, unsigned int> res2 = race_threaded.run(n_final, 0, 500, 0.05, active_set, race_pop::MAX_BUDGET, true, false);
+	if(res1 != res2 || race_serial.get_mean_fitness() != race_threaded.get_mean_fitness()){
+		std::cout << "\tFAILED: Results depend on the number of threads!" << std::endl;
+		return 1;
+	}
+
+	// A race on a population sharing the store, where each individual appears
+	// twice, must not need any evaluation
+	population pop_twice(pop);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		pop_twice.push_back(pop.get_individual(i).cur_x);
+	}
+	util::racing::race_pop race_shared(seed);
+	race_shared.share_memory(race_serial);
+	race_shared.register_population(pop_twice);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		active_set.push_back(i);
+	}
+	std::pair<std::vector<population::size_type>, unsigned int> res3 = race_shared.run(n_final, 0, 500, 0.05, active_set, race_pop::MAX_BUDGET, true, false);
+	if(res3.second > 0){
+		std::cout << "\tFAILED: Race sharing the store consumed " << res3.second << " fevals!" << std::endl;
+		return 1;
+	}
+
+	// Without store, the duplicates are still evaluated only once
+	util::racing::race_pop race_no_store(pop_twice, seed);
+	race_no_store.set_cache_capacity(0);
+	std::pair<std::vector<population::size_type>, unsigned int> res4 = race_no_store.run(n_final, 0, 1, 0.05, std::vector<population::size_type>(), race_pop::MAX_DATA_COUNT, true, false);
+	if(res4.second != pop.size()){
+		std::cout << "\tFAILED: Duplicated individuals evaluated " << res4.second << " times in a single round!" << std::endl;
+		return 1;
+	}
+
+	// Copies do not share the store: clearing the copy keeps the evaluations
+	// of the original
+	util::racing::race_pop race_copy(race_serial);
+	race_copy.reset_cache();
+	race_serial.register_population(pop);
+	std::pair<std::vector<population::size_type>, unsigned int> res5 = race_serial.run(n_final, 0, 500, 0.05, std::vector<population::size_type>(), race_pop::MAX_BUDGET, true, false);
+	if(res5.second > 0){
+		std::cout << "\tFAILED: Clearing a copy cleared the store of the original!" << std::endl;
+		return 1;
+	}
+
+	// The same individuals on a problem with a different noise must be evaluated again
+	problem::noisy prob_other(*prob, 1, 0, 1.0, problem::noisy::NORMAL, seed);
+	population pop_other(prob_other);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		pop_other.push_back(pop.get_individual(i).cur_x);
+	}
+	race_serial.register_population(pop_other);
+	std::pair<std::vector<population::size_type>, unsigned int> res6 = race_serial.run(n_final, 0, 500, 0.05, std::vector<population::size_type>(), race_pop::MAX_BUDGET, true, false);
+	if(res6.second == 0){
+		std::cout << "\tFAILED: Evaluations reused on a problem with different parameters!" << std::endl;
+		return 1;
+	}
+
+	std::cout << "\tPASSED shared store." << std::endl;
+	return 0;
+}
+
+// Population of single-objective individuals with the given fitnesses
+racing_population make_block(const problem::base &prob, const std::vector<double> &f)
+{
+	racing_population pop(prob);
+	for(unsigned int i = 0; i < f.size(); i++){
+		pop.push_back_noeval(decision_vector(prob.get_dimension(), 0));
+		pop.set_fc(i, fitness_vector(1, f[i]), constraint_vector());
+	}
+	return pop;
+}
+
+bool same_result(const stat_test_result &r1, const stat_test_result &r2)
+{
+	return r1.trivial == r2.trivial && (r1.trivial || r1.is_better == r2.is_better);
+}
+
+/// Check the incremental rank statistics against the batch tests
+int test_rank_statistics()
+{
+	std::cout << "Testing the incremental rank statistics" << std::endl;
+
+	problem::ackley prob(1);
+	rng_uint32 rng(42);
+	const unsigned int N = 6, B = 20;
+
+	// Friedman: blocks with many ties
+	friedman_stats fstats(N);
+	std::vector<racing_population> blocks;
+	std::vector<population::size_type> in_race;
+	for(unsigned int i = 0; i < N; i++){
+		in_race.push_back(i);
+	}
+	for(unsigned int b = 0; b < B; b++){
+		std::vector<double> f(N);
+		for(unsigned int i = 0; i < N; i++){
+			// Racer 0 tends to be the best, racer N-1 the worst
+			f[i] = (rng() % 4) + (i == 0 ? 0 : (i == N - 1 ? 3 : 1));
+		}
+		blocks.push_back(make_block(prob, f));
+		const std::vector<double> ranks = block_ranks(blocks.back(), in_race);
+		if(ranks != blocks.back().get_rankings()){
+			std::cout << "\tFAILED: block ranks differ from the population rankings!" << std::endl;
+			return 1;
+		}
+		fstats.add_block(in_race, ranks);
+	}
+	for(unsigned int round = 0; round < 3; round++){
+		// Batch ranks of the racers still in the race
+		std::vector<std::vector<double> > X(in_race.size());
+		for(unsigned int b = 0; b < B; b++){
+			const std::vector<double> ranks = block_ranks(blocks[b], in_race);
+			for(unsigned int i = 0; i < in_race.size(); i++){
+				X[i].push_back(ranks[i]);
+			}
+		}
+		for(unsigned int i = 0; i < in_race.size(); i++){
+			const double mean = std::accumulate(X[i].begin(), X[i].end(), 0.) / B;
+			if(std::fabs(mean - fstats.mean_rank(in_race[i])) > EPS){
+				std::cout << "\tFAILED: mean rank " << fstats.mean_rank(in_race[i]) << " instead of " << mean << std::endl;
+				return 1;
+			}
+		}
+		if(!same_result(fstats.test(in_race, 0.05), core_friedman_test(X, 0.05))){
+			std::cout << "\tFAILED: incremental Friedman test differs from the batch one!" << std::endl;
+			return 1;
+		}
+		// A racer leaves the race
+		fstats.drop(in_race[1]);
+		in_race.erase(in_race.begin() + 1);
+	}
+
+	// Wilcoxon
+	wilcoxon_stats wstats(prob);
+	std::vector<double> f;
+	for(unsigned int n = 1; n <= 15; n++){
+		const double fa = rng() % 5, fb = rng() % 5 + 1;
+		wstats.add(fitness_vector(1, fa), constraint_vector(), fitness_vector(1, fb), constraint_vector());
+		f.push_back(fa);
+		f.push_back(fb);
+		const std::vector<double> ranks = make_block(prob, f).get_rankings();
+		std::vector<std::vector<double> > X(2);
+		for(unsigned int i = 0; i < ranks.size(); i++){
+			X[i % 2].push_back(ranks[i]);
+		}
+		for(unsigned int i = 0; i < 2; i++){
+			const double mean = std::accumulate(X[i].begin(), X[i].end(), 0.) / n;
+			if(std::fabs(mean - wstats.mean_rank(i)) > EPS){
+				std::cout << "\tFAILED: Wilcoxon mean rank " << wstats.mean_rank(i) << " instead of " << mean << std::endl;
+				return 1;
+			}
+		}
+		if(!same_result(wstats.test(0.05), core_wilcoxon_ranksum_test(X, 0.05))){
+			std::cout << "\tFAILED: incremental Wilcoxon test differs from the batch one!" << std::endl;
+			return 1;
+		}
+	}
+
+	// Wilcoxon on a multi-objective problem: ranks by Pareto front and
+	// crowding of the pooled observations
+	problem::zdt prob_mo(1, 2);
+	wilcoxon_stats wstats_mo(prob_mo);
+	racing_population pool(prob_mo);
+	for(unsigned int n = 1; n <= 15; n++){
+		for(unsigned int i = 0; i < 2; i++){
+			fitness_vector fi(2);
+			fi[0] = rng() % 4;
+			fi[1] = rng() % 4;
+			pool.push_back_noeval(decision_vector(prob_mo.get_dimension(), 0));
+			pool.set_fc(pool.size() - 1, fi, constraint_vector());
+		}
+		wstats_mo.add(pool.get_individual(2 * n - 2).cur_f, constraint_vector(), pool.get_individual(2 * n - 1).cur_f, constraint_vector());
+		const std::vector<double> ranks = pool.get_rankings();
+		std::vector<std::vector<double> > X(2);
+		for(unsigned int i = 0; i < ranks.size(); i++){
+			X[i % 2].push_back(ranks[i]);
+		}
+		for(unsigned int i = 0; i < 2; i++){
+			const double mean = std::accumulate(X[i].begin(), X[i].end(), 0.) / n;
+			if(std::fabs(mean - wstats_mo.mean_rank(i)) > EPS){
+				std::cout << "\tFAILED: multi-objective Wilcoxon mean rank " << wstats_mo.mean_rank(i) << " instead of " << mean << std::endl;
+				return 1;
+			}
+		}
+		if(!same_result(wstats_mo.test(0.05), core_wilcoxon_ranksum_test(X, 0.05))){
+			std::cout << "\tFAILED: multi-objective Wilcoxon test differs from the batch one!" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "\tPASSED rank statistics." << std::endl;
+	return 0;
+}
 
 int main()
 {
@@ -443,6 +655,8 @@ int main()
 
 		   test_racing_cache(prob_ackley) ||
 		   test_racing_cache_transfer(prob_ackley) ||
+		   test_racing_shared_store(prob_ackley) ||
+		   test_rank_statistics() ||
 
 		   test_racing_get_mean_fitness(prob_ackley) ||
 
@@ -229,6 +229,36 @@ int varied_pso_variant(const problem::base_ptr& prob)
 }
 */
 
+// Check that evolving the algorithms on several threads, possibly in advance,
+// does not change the outcome of the race, and that a second race reuses the
+// evolutions of the first one.
+int test_parallel_race(const problem::base& prob)
+{
+	std::vector<algorithm::base_ptr> algos;
+	for(unsigned int i = 1; i <= 6; i++){
+		algos.push_back(algorithm::base_ptr(new algorithm::de(i * 5)));
+	}
+	std::cout << "Testing parallel race on problem " << prob.get_name() << std::endl;
+	util::racing::race_algo race_serial(algos, prob, 20, 42);
+	util::racing::race_algo race_parallel(algos, prob, 20, 42);
+	race_parallel.set_eval_threads(4);
+	race_parallel.set_lookahead(2);
+	std::pair<std::vector<unsigned int>, unsigned int> res1 = race_serial.run(2, 1, 200, 0.05, std::vector<unsigned int>(), true, false);
+	std::pair<std::vector<unsigned int>, unsigned int> res2 = race_parallel.run(2, 1, 200, 0.05, std::vector<unsigned int>(), true, false);
+	if(res1 != res2){
+		std::cout << "\tResults depend on the number of threads: " << res1.first << " (" << res1.second << " evolutions) vs "
+			<< res2.first << " (" << res2.second << " evolutions)" << std::endl;
+		return 1;
+	}
+	std::pair<std::vector<unsigned int>, unsigned int> res3 = race_parallel.run(2, 1, 200, 0.05, std::vector<unsigned int>(), true, false);
+	if(res3.first != res1.first || res3.second != 0){
+		std::cout << "\tSecond race did not reuse the evolutions of the first one" << std::endl;
+		return 1;
+	}
+	std::cout << "Test passed [parallel race]" << std::endl;
+	return 0;
+}
+
 int main()
 {
 	int dimension = 10;
@@ -245,5 +275,6 @@ int main()
 		varied_n_gen(prob, 2) ||
 		varied_n_gen(prob_list, 1) ||
 		varied_n_gen(prob_list, 2) ||
-		test_heterogeneous_constraints();
+		test_heterogeneous_constraints() ||
+		test_parallel_race(prob);
 }
@@ -0,0 +1,297 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the pseudo-random number generators
+
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/thread/thread.hpp>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Known answers of Philox4x32-10, from the Random123 distribution.
+int test_known_answers()
+{
+	const boost::uint32_t expected[2][4] = {
+		{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+		{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}
+	};
+	rng_philox rngs[2] = {
+		rng_philox(0,0),
+		rng_philox(0xa4093822u,0x299f31d0u).split(0x0370734413198a2eull)
+	};
+	// Counter 0x0370734413198a2e85a308d3243f6a88: substream and block index.
+	for (int i = 0; i < 4; ++i) {
+		rngs[1].discard(0x85a308d3243f6a88ull);
+	}
+	for (int i = 0; i < 2; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			if (rngs[i]() != expected[i][j]) {
+				std::cout << "Known answer test " << i << " failed" << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+// Skip ahead, bulk fill and serialization must be consistent with single draws.
+int test_consistency()
+{
+	rng_philox ref(42,7);
+	std::vector<boost::uint32_t> seq(1000);
+	for (std::size_t i = 0; i < seq.size(); ++i) {
+		seq[i] = ref();
+	}
+	for (std::size_t offset = 0; offset < 9; ++offset) {
+		rng_philox r(42,7);
+		r.discard(offset);
+		if (r() != seq[offset]) {
+			std::cout << "discard(" << offset << ") is inconsistent" << std::endl;
+			return 1;
+		}
+		r.discard(offset + 100);
+		if (r() != seq[2 * offset + 101]) {
+			std::cout << "discard(" << offset << ") from the middle of a block is inconsistent" << std::endl;
+			return 1;
+		}
+		// Bulk fill from an arbitrary position.
+		rng_philox r2(42,7), r3(42,7);
+		r2.discard(offset);
+		r3.discard(offset);
+		std::vector<boost::uint32_t> bulk(offset * 37 + 5);
+		r2.fill(&bulk[0],bulk.size());
+		if (!std::equal(bulk.begin(),bulk.end(),seq.begin() + offset) || r2() != seq[offset + bulk.size()]) {
+			std::cout << "fill() is inconsistent" << std::endl;
+			return 1;
+		}
+		std::vector<double> u(offset * 11 + 3);
+		r3.fill_uniform(&u[0],u.size());
+		rng_philox r4(42,7);
+		r4.discard(offset);
+		for (std::size_t i = 0; i < u.size(); ++i) {
+			const double v = r4.uniform01();
+			if (u[i] != v || v < 0 || v >= 1) {
+				std::cout << "fill_uniform() is inconsistent" << std::endl;
+				return 1;
+			}
+		}
+		// Serialization round trip in the middle of a block.
+		std::stringstream ss;
+		{
+			boost::archive::text_oarchive oa(ss);
+			oa << r4;
+		}
+		rng_philox r5;
+		{
+			boost::archive::text_iarchive ia(ss);
+			ia >> r5;
+		}
+		if (r5 != r4 || r5() != r4()) {
+			std::cout << "Serialization round trip failed" << std::endl;
+			return 1;
+		}
+	}
+	// Different streams and substreams must differ.
+	if (rng_philox(42,7)() == rng_philox(42,8)() || rng_philox(42,7)() == rng_philox(42,7).split(1)()) {
+		std::cout << "Streams are not independent" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int test_distributions()
+{
+	rng_philox r(1,2);
+	const std::size_t n = 100001;
+	std::vector<double> x(n);
+	r.fill_normal(&x[0],n,1.,2.);
+	double mean = 0, var = 0;
+	for (std::size_t i = 0; i < n; ++i) {
+		mean += x[i] / n;
+	}
+	for (std::size_t i = 0; i < n; ++i) {
+		var += (x[i] - mean) * (x[i] - mean) / (n - 1);
+	}
+	if (std::fabs(mean - 1) > 0.05 || std::fabs(var - 4) > 0.1) {
+		std::cout << "fill_normal(): mean " << mean << ", variance " << var << std::endl;
+		return 1;
+	}
+	// Usable with the Boost distributions.
+	boost::uniform_int<int> dist(0,9);
+	boost::variate_generator<rng_philox &, boost::uniform_int<int> > die(r,dist);
+	std::vector<int> counts(10,0);
+	for (int i = 0; i < 10000; ++i) {
+		++counts[die()];
+	}
+	for (int i = 0; i < 10; ++i) {
+		if (counts[i] < 800 || counts[i] > 1200) {
+			std::cout << "Boost uniform_int over rng_philox is not uniform" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Generator serialized in the format of version 0 of rng_uint32 and rng_double.
+template <class Engine>
+struct legacy_rng: Engine
+{
+	explicit legacy_rng(const Engine &e): Engine(e) {}
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		std::stringstream ss;
+		ss << *static_cast<Engine *>(this);
+		std::string tmp(ss.str());
+		ar << tmp;
+	}
+};
+
+// rng_uint32 serialized in the format of version 1: the words of the canonical representation.
+struct mt19937_v1: boost::mt19937
+{
+	explicit mt19937_v1(const boost::mt19937 &e): boost::mt19937(e) {}
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		boost::uint32_t state[624];
+		std::stringstream ss;
+		ss << *static_cast<boost::mt19937 *>(this);
+		for (std::size_t j = 0; j < 624; ++j) {
+			ss >> state[j];
+		}
+		ar << boost::serialization::make_array(state,624);
+	}
+};
+
+BOOST_CLASS_VERSION(mt19937_v1,1)
+
+// Writes a generator after n_draws draws as a Format (Rng itself for the current format), reads it back
+// and checks that the state and the next draws are the same.
+template <class Rng, class Format, class IArchive, class OArchive>
+int test_round_trip(const Rng &orig, int n_draws)
+{
+	Rng rng(orig), restored;
+	for (int i = 0; i < n_draws; ++i) {
+		rng();
+	}
+	std::stringstream ss;
+	{
+		OArchive oa(ss);
+		const Format written(rng);
+		oa << written;
+	}
+	{
+		IArchive ia(ss);
+		ia >> restored;
+	}
+	// The stream representation checks the layout assumed by serialization.
+	std::ostringstream rng_text, restored_text;
+	rng_text << rng;
+	restored_text << restored;
+	if (rng_text.str() != restored_text.str()) {
+		std::cout << "Serialization round trip after " << n_draws << " draws changed the state" << std::endl;
+		return 1;
+	}
+	for (int i = 0; i < 2000; ++i) {
+		if (rng() != restored()) {
+			std::cout << "Serialization round trip after " << n_draws << " draws changed the next draws" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+template <class IArchive, class OArchive>
+int test_archive(int n_draws)
+{
+	return test_round_trip<rng_uint32,rng_uint32,IArchive,OArchive>(rng_uint32(5),n_draws)
+		+ test_round_trip<rng_double,rng_double,IArchive,OArchive>(rng_double(5),n_draws)
+		+ test_round_trip<rng_uint32,legacy_rng<boost::mt19937>,IArchive,OArchive>(rng_uint32(5),n_draws)
+		+ test_round_trip<rng_double,legacy_rng<boost::lagged_fibonacci607>,IArchive,OArchive>(rng_double(5),n_draws)
+		+ test_round_trip<rng_uint32,mt19937_v1,IArchive,OArchive>(rng_uint32(5),n_draws);
+}
+
+int test_serialization()
+{
+	using namespace boost::archive;
+	// Positions at the beginning, in the middle and at the end of the state of the engines.
+	const int n_draws[] = {0, 1, 606, 607, 623, 624, 1000};
+	int retval = 0;
+	for (int i = 0; i < 7; ++i) {
+		retval += test_archive<text_iarchive,text_oarchive>(n_draws[i]);
+		retval += test_archive<binary_iarchive,binary_oarchive>(n_draws[i]);
+	}
+	return retval;
+}
+
+void draw_seeds(std::vector<boost::uint32_t> &out)
+{
+	for (std::size_t i = 0; i < out.size(); ++i) {
+		out[i] = rng_generator::get<rng_uint32>()();
+	}
+}
+
+int test_rng_generator()
+{
+	// Reproducible in a single thread.
+	std::vector<boost::uint32_t> a(100), b(100);
+	rng_generator::set_seed(123);
+	draw_seeds(a);
+	rng_generator::set_seed(123);
+	draw_seeds(b);
+	if (a != b) {
+		std::cout << "rng_generator is not reproducible" << std::endl;
+		return 1;
+	}
+	// Concurrent threads get different seeds.
+	std::vector<std::vector<boost::uint32_t> > seeds(8,std::vector<boost::uint32_t>(1000));
+	boost::thread_group threads;
+	for (std::size_t i = 0; i < seeds.size(); ++i) {
+		threads.create_thread(boost::bind(draw_seeds,boost::ref(seeds[i])));
+	}
+	threads.join_all();
+	std::set<boost::uint32_t> all;
+	for (std::size_t i = 0; i < seeds.size(); ++i) {
+		all.insert(seeds[i].begin(),seeds[i].end());
+	}
+	if (all.size() < seeds.size() * seeds[0].size() - 10) {
+		std::cout << "Threads drew overlapping seeds" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_known_answers() || test_consistency() || test_distributions() || test_serialization() || test_rng_generator();
+}
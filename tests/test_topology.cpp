@@ -0,0 +1,337 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test code for the topologies
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "test.h"
+
+using namespace pagmo;
+
+typedef topology::base::vertices_size_type vertices_size_type;
+
+// Grows the topology up to n vertices.
+static void grow(topology::base &t, vertices_size_type n)
+{
+	while (t.get_number_of_vertices() < n) {
+		t.push_back();
+	}
+}
+
+// Checks the CSR snapshot against the adjacency information of the graph.
+static int check_csr(const topology::base &t, const std::string &name)
+{
+	const topology::base::csr_ptr csr = t.get_csr();
+	if (csr->get_number_of_vertices() != t.get_number_of_vertices()) {
+		std::cout << name << ": wrong number of vertices in the CSR snapshot" << std::endl;
+		return 1;
+	}
+	for (vertices_size_type v = 0; v < t.get_number_of_vertices(); ++v) {
+		const topology::base::csr_type::range_type adj = csr->get_adjacent_vertices(v);
+		const topology::base::csr_type::range_type inv_adj = csr->get_inv_adjacent_vertices(v);
+		if (std::vector<vertices_size_type>(adj.first,adj.second) != t.get_v_adjacent_vertices(v) ||
+			std::vector<vertices_size_type>(inv_adj.first,inv_adj.second) != t.get_v_inv_adjacent_vertices(v))
+		{
+			std::cout << name << ": inconsistent adjacency lists for vertex " << v << std::endl;
+			return 1;
+		}
+		for (std::ptrdiff_t i = 0; i < adj.second - adj.first; ++i) {
+			if (csr->get_adjacent_weights(v)[i] != t.get_weight(v,adj.first[i])) {
+				std::cout << name << ": inconsistent weight for edge " << v << " -> " << adj.first[i] << std::endl;
+				return 1;
+			}
+		}
+		for (std::ptrdiff_t i = 0; i < inv_adj.second - inv_adj.first; ++i) {
+			if (csr->get_inv_adjacent_weights(v)[i] != t.get_weight(inv_adj.first[i],v)) {
+				std::cout << name << ": inconsistent weight for edge " << inv_adj.first[i] << " -> " << v << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+// Reference average path length, computed with Floyd-Warshall on the adjacency information.
+static double reference_path_length(const topology::base &t)
+{
+	const vertices_size_type n = t.get_number_of_vertices();
+	if (n < 2) {
+		return 0;
+	}
+	std::vector<std::vector<double> > d(n,std::vector<double>(n,INT_MAX));
+	for (vertices_size_type i = 0; i < n; ++i) {
+		d[i][i] = 0;
+		const std::vector<vertices_size_type> adj = t.get_v_adjacent_vertices(i);
+		for (std::vector<vertices_size_type>::size_type j = 0; j < adj.size(); ++j) {
+			d[i][adj[j]] = std::min(d[i][adj[j]],1.);
+		}
+	}
+	for (vertices_size_type k = 0; k < n; ++k) {
+		for (vertices_size_type i = 0; i < n; ++i) {
+			for (vertices_size_type j = 0; j < n; ++j) {
+				d[i][j] = std::min(d[i][j],d[i][k] + d[k][j]);
+			}
+		}
+	}
+	double retval = 0;
+	for (vertices_size_type i = 0; i < n; ++i) {
+		for (vertices_size_type j = 0; j < n; ++j) {
+			retval += d[i][j];
+		}
+	}
+	return retval / (static_cast<double>(n) * (n - 1));
+}
+
+// Reference clustering coefficient, computed pairwise on the adjacency information.
+static double reference_clustering(const topology::base &t)
+{
+	double cc = 0;
+	for (vertices_size_type v = 0; v < t.get_number_of_vertices(); ++v) {
+		const std::vector<vertices_size_type> adj = t.get_v_adjacent_vertices(v);
+		if (adj.size() > 1) {
+			for (std::vector<vertices_size_type>::size_type i = 0; i < adj.size(); ++i) {
+				for (std::vector<vertices_size_type>::size_type j = i + 1; j < adj.size(); ++j) {
+					if (t.are_adjacent(adj[i],adj[j])) {
+						cc += 2. / (adj.size() * (adj.size() - 1));
+					}
+				}
+			}
+		} else {
+			cc += 1;
+		}
+	}
+	return cc / t.get_number_of_vertices();
+}
+
+static bool is_close(double a, double b)
+{
+	return std::abs(a - b) <= 1E-12 * std::max(1.,std::abs(b));
+}
+
+static int check_metrics(const topology::base &t, const std::string &name)
+{
+	if (!is_close(t.get_average_shortest_path_length(),reference_path_length(t))) {
+		std::cout << name << ": wrong average path length " << t.get_average_shortest_path_length() << " vs " << reference_path_length(t) << std::endl;
+		return 1;
+	}
+	if (!is_close(t.get_clustering_coefficient(),reference_clustering(t))) {
+		std::cout << name << ": wrong clustering coefficient " << t.get_clustering_coefficient() << " vs " << reference_clustering(t) << std::endl;
+		return 1;
+	}
+	std::vector<double> dd(1);
+	for (vertices_size_type v = 0; v < t.get_number_of_vertices(); ++v) {
+		const vertices_size_type deg = t.get_num_adjacent_vertices(v);
+		if (deg >= dd.size()) {
+			dd.resize(deg + 1);
+		}
+		dd[deg] += 1. / t.get_number_of_edges();
+	}
+	if (t.get_number_of_edges() && !is_eq_vector(t.get_degree_distribution(),dd)) {
+		std::cout << name << ": wrong degree distribution" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Checks that the metrics do not depend on the number of threads, and that they are cached until the topology changes.
+static int test_graph_metrics()
+{
+	topology::watts_strogatz t(6,0.2,300);
+	const double path_length = reference_path_length(t), clustering = reference_clustering(t);
+	for (unsigned int n_threads = 1; n_threads <= 8; n_threads *= 2) {
+		const topology::watts_strogatz copy(t);
+		const topology::base::graph_metrics m = copy.get_graph_metrics(n_threads);
+		if (!is_close(m.average_shortest_path_length,path_length) || !is_close(m.clustering_coefficient,clustering) ||
+			m.degree_distribution != copy.get_degree_distribution())
+		{
+			std::cout << "wrong graph metrics with " << n_threads << " threads" << std::endl;
+			return 1;
+		}
+		if (m.average_shortest_path_length != t.get_average_shortest_path_length() || m.clustering_coefficient != t.get_clustering_coefficient()) {
+			std::cout << "the graph metrics depend on the number of threads" << std::endl;
+			return 1;
+		}
+	}
+	// The copy shares the snapshot and its cached metrics, adding an isolated vertex must discard them.
+	topology::custom c(t);
+	c.get_graph_metrics();
+	c.push_back();
+	if (!is_close(c.get_average_shortest_path_length(),reference_path_length(c)) || !is_close(c.get_clustering_coefficient(),reference_clustering(c))) {
+		std::cout << "the graph metrics were not updated" << std::endl;
+		return 1;
+	}
+	std::cout << "graph metrics: passes" << std::endl;
+	return 0;
+}
+
+// Checks that the snapshot follows the modifications of the topology.
+static int test_invalidation()
+{
+	topology::custom t;
+	for (int i = 0; i < 4; ++i) {
+		t.push_back();
+	}
+	t.add_edge(0,1,0.5);
+	t.add_edge(1,2);
+	const topology::base::csr_ptr csr = t.get_csr();
+	if (t.get_csr() != csr) {
+		std::cout << "the CSR snapshot was rebuilt without modifications" << std::endl;
+		return 1;
+	}
+	// Copies share the snapshot.
+	const topology::custom t2(t);
+	if (t2.get_csr() != csr) {
+		std::cout << "the CSR snapshot was not shared by a copy" << std::endl;
+		return 1;
+	}
+	t.add_edge(2,3,0.25);
+	t.set_weight(0,1,0.75);
+	if (t.get_csr() == csr || check_csr(t,"custom") || t.get_csr()->get_adjacent_weights(0)[0] != 0.75) {
+		std::cout << "the CSR snapshot did not follow the modifications" << std::endl;
+		return 1;
+	}
+	// The old snapshot is untouched.
+	if (csr->get_adjacent_weights(0)[0] != 0.5 || check_csr(t2,"custom copy")) {
+		std::cout << "the old CSR snapshot was modified" << std::endl;
+		return 1;
+	}
+	t.remove_edge(1,2);
+	t.push_back();
+	if (check_csr(t,"custom")) {
+		return 1;
+	}
+	t.remove_all_edges();
+	if (t.get_csr()->get_adjacent_vertices(2).first != t.get_csr()->get_adjacent_vertices(2).second) {
+		std::cout << "the CSR snapshot was not cleared" << std::endl;
+		return 1;
+	}
+	try {
+		t.get_csr()->get_adjacent_vertices(5);
+		std::cout << "invalid vertex index not detected" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	return 0;
+}
+
+// Checks the topologies generated in one pass by the constructors.
+static int check_bulk(const topology::base &t, const std::string &name, vertices_size_type n, double min_edges, double max_edges)
+{
+	if (t.get_number_of_vertices() != n) {
+		std::cout << name << ": wrong number of vertices " << t.get_number_of_vertices() << std::endl;
+		return 1;
+	}
+	if (t.get_number_of_edges() < min_edges || t.get_number_of_edges() > max_edges) {
+		std::cout << name << ": unexpected number of edges " << t.get_number_of_edges() << std::endl;
+		return 1;
+	}
+	// The generated networks are undirected and without self loops.
+	const topology::base::csr_ptr csr = t.get_csr();
+	for (vertices_size_type v = 0; v < n; ++v) {
+		const topology::base::csr_type::range_type adj = csr->get_adjacent_vertices(v);
+		const topology::base::csr_type::range_type inv_adj = csr->get_inv_adjacent_vertices(v);
+		std::vector<vertices_size_type> a(adj.first,adj.second), b(inv_adj.first,inv_adj.second);
+		std::sort(a.begin(),a.end());
+		std::sort(b.begin(),b.end());
+		if (a != b || std::binary_search(a.begin(),a.end(),v) || std::adjacent_find(a.begin(),a.end()) != a.end()) {
+			std::cout << name << ": invalid adjacency list for vertex " << v << std::endl;
+			return 1;
+		}
+	}
+	std::cout << name << ": " << n << " vertices, " << t.get_number_of_edges() << " edges, passes" << std::endl;
+	return 0;
+}
+
+static int test_bulk_generators()
+{
+	int res = 0;
+	const vertices_size_type n = 3000;
+	// Erdos-Renyi: the number of undirected edges is binomial, check it within 6 standard deviations.
+	const double pairs = n * (n - 1) / 2., p = 0.01;
+	const double sigma = std::sqrt(pairs * p * (1 - p));
+	res += check_bulk(topology::erdos_renyi(p,n),"Erdos-Renyi",n,2 * (pairs * p - 6 * sigma),2 * (pairs * p + 6 * sigma));
+	res += check_bulk(topology::erdos_renyi(0,n),"Erdos-Renyi (p = 0)",n,0,0);
+	res += check_bulk(topology::erdos_renyi(1,100),"Erdos-Renyi (p = 1)",100,100 * 99,100 * 99);
+	// Barabasi-Albert: m edges per vertex outside the kernel, plus the kernel edges.
+	res += check_bulk(topology::barabasi_albert(5,3,n),"Barabasi-Albert",n,2 * (3 * (n - 5) + 4),2 * (3 * (n - 5) + 10));
+	res += check_bulk(topology::clustered_ba(5,3,0.5,n),"Clustered Barabasi-Albert",n,2 * (n - 1),2 * 6 * (n - 5) + 2 * 4);
+	// Watts-Strogatz: the rewiring preserves the number of edges.
+	res += check_bulk(topology::watts_strogatz(6,0.3,n),"Watts-Strogatz",n,6 * n,6 * n);
+	res += check_bulk(topology::watts_strogatz(6,0.3,5),"Watts-Strogatz (small)",5,20,20);
+	// Without rewiring we get the ring lattice.
+	const topology::watts_strogatz lattice(4,0,10);
+	if (!lattice.are_adjacent(0,2) || !lattice.are_adjacent(9,1) || lattice.are_adjacent(0,3)) {
+		std::cout << "Watts-Strogatz: wrong ring lattice" << std::endl;
+		++res;
+	}
+	// The preferential attachment produces a connected network, and it keeps growing with push_back().
+	topology::barabasi_albert ba(3,2,500);
+	if (ba.get_average_shortest_path_length() > 500) {
+		std::cout << "Barabasi-Albert: the network is not connected" << std::endl;
+		++res;
+	}
+	ba.push_back();
+	if (ba.get_number_of_vertices() != 501 || ba.get_num_adjacent_vertices(500) != 2) {
+		std::cout << "Barabasi-Albert: push_back() after bulk generation failed" << std::endl;
+		++res;
+	}
+	return res;
+}
+
+int main()
+{
+	int res = 0;
+	std::vector<topology::base_ptr> topologies;
+	topologies.push_back(topology::ring().clone());
+	topologies.push_back(topology::one_way_ring().clone());
+	topologies.push_back(topology::fully_connected().clone());
+	topologies.push_back(topology::hypercube().clone());
+	topologies.push_back(topology::pan().clone());
+	topologies.push_back(topology::rim().clone());
+	topologies.push_back(topology::erdos_renyi(0.1).clone());
+	topologies.push_back(topology::barabasi_albert(3,2).clone());
+	topologies.push_back(topology::watts_strogatz(4,0.2,0).clone());
+	topologies.push_back(topology::clustered_ba(3,2,0.5).clone());
+	topologies.push_back(topology::unconnected().clone());
+	for (std::vector<topology::base_ptr>::size_type i = 0; i < topologies.size(); ++i) {
+		const std::string name = topologies[i]->get_name();
+		grow(*topologies[i],40);
+		topologies[i]->set_weight(0.5);
+		int r = check_csr(*topologies[i],name) + check_metrics(*topologies[i],name);
+		res += r;
+		if (!r) {
+			std::cout << name << ": passes" << std::endl;
+		}
+	}
+	res += test_invalidation();
+	res += test_bulk_generators();
+	res += test_graph_metrics();
+	return res;
+}
@@ -21,12 +21,19 @@
  *   Free Software Foundation, Inc.,                                         *
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
+#include <sstream>
 #include "boost/random.hpp"
 #include "boost/generator_iterator.hpp"
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
 
 #include "../src/problem/tsp.h"
+#include "../src/algorithm/inverover.h"
+#include "../src/algorithm/nn_tsp.h"
 #include "../src/population.h"
 
 using namespace pagmo;
@@ -133,6 +140,287 @@ bool test_encoding_transformations(int repeat, boost::lagged_fibonacci607 rng)
     return false;
 }
 
+/*
+ * This test creates a symmetric TSP with each of the util::distance_matrix storages
+ * and checks that the tour lengths agree (up to single precision for the float storages),
+ * that copies share the storage and that asymmetric matrices are rejected by the triangular storages.
+ *
+ * @param[in] repeat - the number of times to repeat the test
+ */
+bool test_distance_storage(int repeat, boost::lagged_fibonacci607 rng)
+{
+    boost::uniform_real<double> uniform(0.0,1.0);
+    boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > distr(rng,uniform);
+    for (int i = 0; i < repeat; ++i) {
+        // random cities in the unit square and their (symmetric) euclidean distances
+        int n_cities = 3 + i;
+        std::vector<std::vector<double> > coords(n_cities, std::vector<double>(2));
+        for (int j = 0; j < n_cities; ++j) {
+            coords[j][0] = distr();
+            coords[j][1] = distr();
+        }
+        std::vector<std::vector<double> > weights(n_cities, std::vector<double>(n_cities, 0));
+        for (int j = 0; j < n_cities; ++j) {
+            for (int k = 0; k < n_cities; ++k) {
+                weights[j][k] = std::sqrt((coords[j][0]-coords[k][0])*(coords[j][0]-coords[k][0]) + (coords[j][1]-coords[k][1])*(coords[j][1]-coords[k][1]));
+            }
+        }
+
+        pagmo::problem::tsp prob(weights);
+        pagmo::problem::tsp prob_tri(pagmo::util::distance_matrix(weights, pagmo::util::distance_matrix::TRIANGULAR));
+        pagmo::problem::tsp prob_float(pagmo::util::distance_matrix(weights, pagmo::util::distance_matrix::FULL_FLOAT));
+        pagmo::problem::tsp prob_tri_float(pagmo::util::distance_matrix(weights, pagmo::util::distance_matrix::TRIANGULAR_FLOAT));
+        pagmo::problem::tsp prob_eucl(pagmo::util::distance_matrix::euclidean(coords));
+
+        if (prob_tri.get_weights() != weights || prob.get_weights() != weights) {
+            std::cout << "weights are not preserved by the double storages\n";
+            return true;
+        }
+        if (prob_tri.get_distance_matrix().memory_footprint() >= prob.get_distance_matrix().memory_footprint() && n_cities > 1) {
+            std::cout << "triangular storage is not smaller than the full one\n";
+            return true;
+        }
+
+        pagmo::decision_vector tour = population(prob,1).get_individual(0).cur_x;
+        double f = prob.objfun(tour)[0];
+        if (std::abs(prob_tri.objfun(tour)[0] - f) > 1e-12 * f || std::abs(prob_eucl.objfun(tour)[0] - f) > 1e-12 * f
+            || std::abs(prob_float.objfun(tour)[0] - f) > 1e-6 * f || std::abs(prob_tri_float.objfun(tour)[0] - f) > 1e-6 * f)
+        {
+            std::cout << "fitness is different across distance storages\n";
+            return true;
+        }
+
+        // clones must be equivalent
+        pagmo::problem::base_ptr clone = prob_eucl.clone();
+        if (clone->objfun(tour) != prob_eucl.objfun(tour) || clone->get_name() != prob_eucl.get_name())
+        {
+            std::cout << "clone is not equivalent\n";
+            return true;
+        }
+    }
+
+    // an asymmetric matrix cannot be stored as a triangle
+    std::vector<std::vector<double> > asym( generate_random_matrix(5,rng) );
+    try {
+        pagmo::util::distance_matrix(asym, pagmo::util::distance_matrix::TRIANGULAR);
+        std::cout << "asymmetric matrix accepted by the triangular storage\n";
+        return true;
+    } catch (const value_error &) {}
+    return false;
+}
+
+/*
+ * This test checks the incremental evaluation of inversions, 2-opt and or-opt moves against
+ * the full evaluation of the modified tours, on symmetric and asymmetric problems, and
+ * that inverover (which uses it) still returns a consistent, improved population.
+ *
+ * @param[in] repeat - the number of times to repeat the test
+ */
+bool test_incremental_evaluation(int repeat, boost::lagged_fibonacci607 rng)
+{
+    boost::uniform_real<double> uniform(0.0,1.0);
+    boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > distr(rng,uniform);
+    for (int i = 0; i < repeat; ++i) {
+        int n_cities = 4 + i;
+        std::vector<std::vector<double> > weights( generate_random_matrix(n_cities,rng) );
+        for (int symm = 0; symm < 2; ++symm) {
+            if (symm) {
+                for (int j = 0; j < n_cities; ++j) {
+                    for (int k = 0; k < j; ++k) {
+                        weights[k][j] = weights[j][k];
+                    }
+                }
+            }
+            pagmo::problem::tsp prob(weights);
+            if (prob.is_symmetric() != (symm == 1)) {
+                std::cout << "wrong symmetry detected\n";
+                return true;
+            }
+            pagmo::decision_vector tour = population(prob,1).get_individual(0).cur_x;
+            for (int k = 0; k < 20; ++k) {
+                pagmo::decision_vector::size_type a = distr() * n_cities, b = distr() * n_cities, c = distr() * n_cities;
+                if (a > b) std::swap(a,b);
+                double l0 = prob.tour_length(tour);
+                // inversion
+                pagmo::decision_vector tmp(tour);
+                std::reverse(tmp.begin() + a, tmp.begin() + b + 1);
+                if (std::abs(prob.tour_length(tmp) - l0 - prob.inversion_delta(tour,a,b)) > 1e-10) {
+                    std::cout << "wrong inversion delta\n";
+                    return true;
+                }
+                // 2-opt
+                if (a < b) {
+                    tmp = tour;
+                    std::reverse(tmp.begin() + a + 1, tmp.begin() + b + 1);
+                    if (std::abs(prob.tour_length(tmp) - l0 - prob.two_opt_delta(tour,a,b)) > 1e-10) {
+                        std::cout << "wrong 2-opt delta\n";
+                        return true;
+                    }
+                }
+                // or-opt
+                if ((c < a || c > b) && c != (a + n_cities - 1) % n_cities) {
+                    tmp = tour;
+                    if (c > b) {
+                        std::rotate(tmp.begin() + a, tmp.begin() + b + 1, tmp.begin() + c + 1);
+                    } else {
+                        std::rotate(tmp.begin() + c + 1, tmp.begin() + a, tmp.begin() + b + 1);
+                    }
+                    if (std::abs(prob.tour_length(tmp) - l0 - prob.or_opt_delta(tour,a,b,c)) > 1e-10) {
+                        std::cout << "wrong or-opt delta\n";
+                        return true;
+                    }
+                }
+                tour = tmp;
+            }
+        }
+        // inverover must return a consistent and not worse population (RANDOMKEYS so that the initial tours are feasible)
+        pagmo::problem::tsp prob(weights, pagmo::problem::tsp::RANDOMKEYS);
+        population pop(prob,20);
+        double best = pop.champion().f[0];
+        pagmo::algorithm::inverover(100, 0.05, pagmo::algorithm::inverover::random, i % 2 ? 5 : 0).evolve(pop);
+        for (population::size_type k = 0; k < pop.size(); ++k) {
+            if (pop.get_individual(k).cur_f != prob.objfun(pop.get_individual(k).cur_x)) {
+                std::cout << "inconsistent fitness after inverover\n";
+                return true;
+            }
+        }
+        if (pop.champion().f[0] > best) {
+            std::cout << "inverover worsened the champion\n";
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * This test checks the candidate lists against a brute force computation, that nn_tsp (which uses them)
+ * still builds the nearest neighbour tour, and that the local search returns an improved permutation
+ * together with the exact change in tour length.
+ *
+ * @param[in] repeat - the number of times to repeat the test
+ */
+bool test_local_search(int repeat, boost::lagged_fibonacci607 rng)
+{
+    boost::uniform_real<double> uniform(0.0,1.0);
+    boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > distr(rng,uniform);
+    for (int i = 0; i < repeat; ++i) {
+        int n_cities = 20 + 30 * i;
+        std::vector<std::vector<double> > coords(n_cities, std::vector<double>(2));
+        for (int j = 0; j < n_cities; ++j) {
+            coords[j][0] = distr();
+            coords[j][1] = distr();
+        }
+        pagmo::problem::tsp prob(pagmo::util::distance_matrix::euclidean(coords));
+
+        // candidate lists
+        const std::vector<unsigned int> &nl = prob.neighbour_lists(5);
+        if (nl.size() != 5u * n_cities) {
+            std::cout << "wrong size of the candidate lists\n";
+            return true;
+        }
+        for (int j = 0; j < n_cities; ++j) {
+            std::vector<std::pair<double,int> > d;
+            for (int l = 0; l < n_cities; ++l) {
+                if (l != j) d.push_back(std::make_pair(prob.distance(j,l),l));
+            }
+            std::sort(d.begin(),d.end());
+            for (int l = 0; l < 5; ++l) {
+                if (nl[j * 5 + l] != (unsigned int)d[l].second) {
+                    std::cout << "wrong candidate lists\n";
+                    return true;
+                }
+            }
+        }
+
+        // nearest neighbour tour from city 0
+        pagmo::decision_vector nn_tour(1,0);
+        std::vector<bool> visited(n_cities,false);
+        visited[0] = true;
+        for (int j = 1; j < n_cities; ++j) {
+            int best = -1;
+            for (int l = 0; l < n_cities; ++l) {
+                if (!visited[l] && (best < 0 || prob.distance(nn_tour.back(),l) < prob.distance(nn_tour.back(),best))) best = l;
+            }
+            visited[best] = true;
+            nn_tour.push_back(best);
+        }
+        population pop(prob,1);
+        pagmo::algorithm::nn_tsp(0).evolve(pop);
+        if (pop.get_individual(0).cur_x != nn_tour) {
+            std::cout << "nn_tsp did not return the nearest neighbour tour\n";
+            return true;
+        }
+
+        // local search from a random tour
+        pagmo::decision_vector tour(n_cities);
+        for (int j = 0; j < n_cities; ++j) tour[j] = j;
+        std::random_shuffle(tour.begin(),tour.end());
+        double l0 = prob.tour_length(tour);
+        double delta = prob.local_search(tour,8);
+        if (std::abs(prob.tour_length(tour) - l0 - delta) > 1e-9 * l0 || delta >= 0) {
+            std::cout << "wrong local search improvement\n";
+            return true;
+        }
+        if (prob.compute_constraints(tour)[0] != 0) {
+            std::cout << "local search returned an infeasible tour\n";
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * tsp serialized in the format of version 0, which stored the full weight matrix.
+ */
+struct legacy_tsp: pagmo::problem::tsp
+{
+    explicit legacy_tsp(const std::vector<std::vector<double> > &weights): pagmo::problem::tsp(weights), m_weights(weights) {}
+    template <class Archive>
+    void serialize(Archive &ar, const unsigned int)
+    {
+        ar & boost::serialization::base_object<pagmo::problem::base_tsp>(*this);
+        ar & m_weights;
+    }
+    std::vector<std::vector<double> > m_weights;
+};
+
+/**
+ * Checks that tsp archives are read back, both in the current format and in the format of version 0.
+ * @param n_cities - number of cities
+ * @param rng - random number generator
+ * @return true if a test fails
+ */
+bool test_serialization(int n_cities, boost::lagged_fibonacci607 rng)
+{
+    const std::vector<std::vector<double> > weights = generate_random_matrix(n_cities, rng);
+    const pagmo::problem::tsp prob(weights);
+    pagmo::decision_vector tour(n_cities);
+    for (int j = 0; j < n_cities; ++j) tour[j] = j;
+    std::random_shuffle(tour.begin(),tour.end());
+    for (int legacy = 0; legacy < 2; ++legacy) {
+        std::stringstream ss;
+        {
+            boost::archive::text_oarchive oa(ss);
+            if (legacy) {
+                const legacy_tsp old(weights);
+                oa << old;
+            } else {
+                oa << prob;
+            }
+        }
+        pagmo::problem::tsp loaded;
+        {
+            boost::archive::text_iarchive ia(ss);
+            ia >> loaded;
+        }
+        if (loaded.get_weights() != weights || loaded.objfun(tour) != prob.objfun(tour)) {
+            std::cout << "wrong weights read back" << (legacy ? " from a version 0 archive\n" : "\n");
+            return true;
+        }
+    }
+    return false;
+}
+
 int main()
 {
     boost::lagged_fibonacci607 rng;
@@ -142,6 +430,18 @@ int main()
     std::cout << "Testing Encoding Transformations: ";
     if (test_encoding_transformations(100,rng)) return 1;
     std::cout << "SUCCESS" << std::endl;
+    std::cout << "Testing Distance Storages: ";
+    if (test_distance_storage(50,rng)) return 1;
+    std::cout << "SUCCESS" << std::endl;
+    std::cout << "Testing Incremental Evaluation: ";
+    if (test_incremental_evaluation(30,rng)) return 1;
+    std::cout << "SUCCESS" << std::endl;
+    std::cout << "Testing Local Search: ";
+    if (test_local_search(10,rng)) return 1;
+    std::cout << "SUCCESS" << std::endl;
+    std::cout << "Testing Serialization: ";
+    if (test_serialization(20,rng)) return 1;
+    std::cout << "SUCCESS" << std::endl;
     
     // all iz well
     return 0;